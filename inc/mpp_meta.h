@@ -83,6 +83,8 @@ typedef enum MppMetaKey_e {
     KEY_INPUT_PSKIP             = FOURCC_META('i', 'p', 's', 'p'),
     KEY_INPUT_PSKIP_NON_REF     = FOURCC_META('i', 'p', 'n', 'r'),
     KEY_ENC_SSE                 = FOURCC_META('e', 's', 's', 'e'),
+    /* MppEncFrmStats of output packet, copied on set and valid with the meta */
+    KEY_ENC_FRM_STATS           = FOURCC_META('e', 'f', 's', 't'),
 
     /*
      * For vepu580 roi buffer config mode
@@ -148,6 +150,17 @@ typedef enum MppMetaKey_e {
     KEY_DEC_TBN_EN              = FOURCC_META('t', 'b', 'e', 'n'),
     KEY_DEC_TBN_Y_OFFSET        = FOURCC_META('t', 'b', 'y', 'o'),
     KEY_DEC_TBN_UV_OFFSET       = FOURCC_META('t', 'b', 'c', 'o'),
+    /* number of decoded luma rows from top which are ready in output buffer */
+    KEY_DEC_ROWS_READY          = FOURCC_META('d', 'r', 'o', 'w'),
+
+    /*
+     * Kernel hardware timing for decoder output frame and encoder output packet
+     * start / end are CLOCK_MONOTONIC nanosecond of hardware start and finish.
+     * Only set when the kernel mpp_service supports task time query.
+     */
+    KEY_HW_START_TIME           = FOURCC_META('h', 'w', 's', 't'),
+    KEY_HW_END_TIME             = FOURCC_META('h', 'w', 'e', 't'),
+    KEY_HW_CYCLES               = FOURCC_META('h', 'w', 'c', 'y'),
 
     /* combo frame */
     KEY_COMBO_FRAME             = FOURCC_META('c', 'f', 'r', 'm'),
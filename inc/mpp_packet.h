@@ -76,10 +76,17 @@ MppMeta mpp_packet_get_meta(const MppPacket packet);
  * partition - the packet is a part of a while image
  * soi - Start Of Image
  * eoi - End Of Image
+ *
+ * On decoder input eoi marks the packet as the last one of an access unit,
+ * like RTP marker bit. Split parser then closes the frame on this packet
+ * without waiting for the start of next frame. The flag stays on a reused
+ * packet until mpp_packet_clr_eoi or mpp_packet_reset.
  */
 RK_U32  mpp_packet_is_partition(const MppPacket packet);
 RK_U32  mpp_packet_is_soi(const MppPacket packet);
 RK_U32  mpp_packet_is_eoi(const MppPacket packet);
+MPP_RET mpp_packet_set_eoi(MppPacket packet);
+MPP_RET mpp_packet_clr_eoi(MppPacket packet);
 
 /*
  * packet segement pack info for
@@ -99,6 +106,28 @@ struct MppPktSeg_t {
 RK_U32 mpp_packet_get_segment_nb(const MppPacket packet);
 const MppPktSeg *mpp_packet_get_segment_info(const MppPacket packet);
 
+/*
+ * scatter-gather access interface
+ *
+ * Encoder outputs stream header as a separate chunk ahead of packet data
+ * without copy when base:pkt_iov is enabled. Then pos / length / segment
+ * info only cover the data after the chunks.
+ * iov_nb  - number of chunks including the packet data
+ * get_iov - fill at most max chunks to iov in output order, return the
+ *           filled number. The result can be passed to writev directly.
+ * flatten - copy the chunks into packet memory before the data and make
+ *           the packet contiguous. Packet data is moved only when there is
+ *           not enough room before pos.
+ */
+typedef struct MppPacketIov_t {
+    void            *base;
+    size_t          len;
+} MppPacketIov;
+
+RK_U32  mpp_packet_get_iov_nb(const MppPacket packet);
+RK_U32  mpp_packet_get_iov(const MppPacket packet, MppPacketIov *iov, RK_U32 max);
+MPP_RET mpp_packet_flatten(MppPacket packet);
+
 #ifdef __cplusplus
 }
 #endif
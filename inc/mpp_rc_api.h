@@ -95,6 +95,9 @@ typedef struct RcDebreathCfg_t {
     RK_U32      strength;
 } RcDebreathCfg;
 
+/* max stats file path length for multi-pass rate control */
+#define RC_STATS_FILE_LEN   256
+
 typedef struct RcHierQPCfg_t {
     RK_S32      hier_qp_en;
     RK_S32      hier_qp_delta[4];
@@ -178,6 +181,14 @@ typedef struct RcCfg_s {
     RK_U32          fps_chg_prop;
 
     RK_S32          rc_container;
+
+    /*
+     * multi-pass rate control
+     * pass         - 0 single pass, 1 write stats, 2 plan with stats
+     * stats_file   - stats file path written by pass 1 and read by pass 2
+     */
+    RK_S32          pass;
+    const char      *stats_file;
 } RcCfg;
 
 /*
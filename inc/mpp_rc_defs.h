@@ -221,7 +221,17 @@ typedef struct EncRcCommonInfo_t {
     /* rc stats info: real time bits */
     RK_S32          rt_bits;
 
-    RK_S32          reserve[4];
+    /*
+     * lookahead info from encoder, valid when la_cost > 0
+     * la_depth     - number of analyzed frames after current frame
+     * la_cost      - complexity of current frame
+     * la_cost_avg  - average complexity of current frame and frames ahead
+     * la_cut_dist  - distance to next scene cut, 0 - current, -1 - none
+     */
+    RK_S32          la_depth;
+    RK_S32          la_cost;
+    RK_S32          la_cost_avg;
+    RK_S32          la_cut_dist;
 } EncRcTaskInfo;
 
 typedef struct EncRcTask_s {
@@ -0,0 +1,91 @@
+/* SPDX-License-Identifier: Apache-2.0 OR MIT */
+/*
+ * Copyright (c) 2026 Rockchip Electronics Co., Ltd.
+ */
+
+#ifndef MPP_STATS_H
+#define MPP_STATS_H
+
+#include "rk_type.h"
+
+/*
+ * Per session always-on performance statistics
+ *
+ * The snapshot is read by mpp_control with MPP_GET_STATS command. When env
+ * mpp_stats_export is set the live MppStatsInfo is also placed in a memfd
+ * named mpp_stats_<type>_<coding>_<id> which can be mapped read-only by an
+ * external scraper from /proc/<pid>/fd.
+ *
+ * The counters and the timing histograms are always on. A histogram record
+ * is two clock reads and a few atomic adds to fixed log-linear buckets.
+ */
+#define MPP_STATS_VERSION           1
+
+/*
+ * Log-linear histogram in microsecond
+ * Values below 4 have their own bin. Above that each power of 2 range is
+ * split into 4 sub-bins which keeps the relative error under 25%.
+ * The last bin covers everything larger than about one second.
+ */
+#define MPP_STATS_HIST_SUB_BITS     2
+#define MPP_STATS_HIST_BINS         80
+
+typedef enum MppStatsCnt_e {
+    MPP_STATS_CNT_PKT_IN,           /* decoder input packet */
+    MPP_STATS_CNT_PKT_OUT,          /* encoder output packet */
+    MPP_STATS_CNT_FRM_IN,           /* encoder input frame */
+    MPP_STATS_CNT_FRM_OUT,          /* decoder output frame */
+    MPP_STATS_CNT_HW_RUN,           /* hardware task count */
+    MPP_STATS_CNT_BUF_ALLOC,        /* internal buffer allocation */
+    MPP_STATS_CNT_BYTES_COPY,       /* software memory copy in bytes */
+    MPP_STATS_CNT_REENC,            /* encoder reencode count */
+    MPP_STATS_CNT_BUTT,
+} MppStatsCnt;
+
+typedef enum MppStatsHist_e {
+    MPP_STATS_HIST_PARSE,           /* decoder parser time */
+    MPP_STATS_HIST_HW,              /* hal wait hardware done time */
+    MPP_STATS_HIST_QUEUE_WAIT,      /* decoder parser thread wait time for input / resource */
+    MPP_STATS_HIST_BUTT,
+} MppStatsHist;
+
+typedef struct MppStatsHistInfo_t {
+    RK_U64          count;
+    RK_U64          sum;
+    RK_U64          min;
+    RK_U64          max;
+    RK_U64          bins[MPP_STATS_HIST_BINS];
+} MppStatsHistInfo;
+
+typedef enum MppStatsThread_e {
+    MPP_STATS_THREAD_PARSER,        /* decoder parser thread or encoder thread */
+    MPP_STATS_THREAD_HAL,           /* decoder hal thread */
+    MPP_STATS_THREAD_OUTPUT,        /* decoder vproc output thread */
+    MPP_STATS_THREAD_BUTT,
+} MppStatsThread;
+
+/* cpu time of each codec thread in microsecond, -1 when the thread is not used */
+typedef struct MppStatsCpuTime_t {
+    RK_S64          time[MPP_STATS_THREAD_BUTT];
+} MppStatsCpuTime;
+
+typedef struct MppStatsInfo_t {
+    /* set by mpp, user should check version and size before reading */
+    RK_U32          version;
+    RK_U32          size;
+    RK_U64          cnt[MPP_STATS_CNT_BUTT];
+    MppStatsHistInfo hist[MPP_STATS_HIST_BUTT];
+} MppStatsInfo;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* return the percentile value upper bound in microsecond, percent in [0, 100] */
+RK_U64 mpp_stats_hist_percentile(const MppStatsHistInfo *hist, RK_U32 percent);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* MPP_STATS_H */
@@ -30,6 +30,7 @@
 
 #include "rk_mpi_cmd.h"
 #include "mpp_task.h"
+#include "mpp_stats.h"
 
 /**
  * @ingroup rk_mpi
@@ -257,6 +258,21 @@ MPP_RET mpp_destroy(MppCtx ctx);
  * @return 0 for support, -1 for unsupported.
  */
 MPP_RET mpp_check_support_format(MppCtxType type, MppCodingType coding);
+/**
+ * @ingroup rk_mpi
+ * @brief predict whether a new session fits the hardware capacity.
+ *        The prediction uses the soc throughput model and the load of the
+ *        running sessions in current process.
+ * @param[in] type specify decoder or encoder, refer to MppCtxType.
+ * @param[in] coding specify video compression coding, refer to MppCodingType.
+ * @param[in] width frame width of the new session.
+ * @param[in] height frame height of the new session.
+ * @param[in] fps frame rate of the new session, 0 for default 30 fps.
+ * @param[out] load predicted hardware load in percent, can be NULL.
+ * @return 0 for fitting, -1 for overloading or unknown hardware.
+ */
+MPP_RET mpp_check_capacity(MppCtxType type, MppCodingType coding, RK_U32 width,
+                           RK_U32 height, RK_U32 fps, RK_S32 *load);
 /**
  * @ingroup rk_mpi
  * @brief List all formats supported by MPP
@@ -70,6 +70,18 @@ typedef enum {
     MPP_SET_DISABLE_THREAD,             /* MPP no thread mode and use external thread to decode */
     MPP_SET_SELECT_TIMEOUT,             /* kmpp path select operation timeout */
     MPP_SET_VENC_INIT_KCFG,             /* kmpp path venc init cfg set */
+    MPP_GET_STATS,                      /* get MppStatsInfo structure snapshot */
+    MPP_GET_STATS_FD,                   /* get stats export memfd, parameter type RK_S32, -1 when not exported */
+    /*
+     * codec thread placement on big.LITTLE soc, set before mpp_init
+     * parameter type RK_U32, 0 - env mpp_thread_place, 1 - none,
+     * 2 - prefer big cores for parser and little cores for hal waiting,
+     * 3 - pin each thread to one core of the preferred cluster
+     */
+    MPP_SET_THREAD_PLACE,
+    /* codec thread SCHED_FIFO priority, set before mpp_init, parameter type RK_S32, 0 - env mpp_thread_prio, negative - normal */
+    MPP_SET_THREAD_PRIO,
+    MPP_GET_THREAD_CPU_TIME,            /* get cpu time of each codec thread, parameter type MppStatsCpuTime */
 
     MPP_STATE_CMD_BASE                  = MPP_FLAG_OR(CMD_MODULE_MPP, CMD_STATE_OPS),
     MPP_START,
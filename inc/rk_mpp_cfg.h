@@ -18,6 +18,22 @@ typedef enum MppCfgStrFmt_e {
 
 typedef void* MppSysCfg;
 
+/*
+ * MppCfgKey is a config entry resolved once from its name by the
+ * mpp_xxx_cfg_get_key functions. The by_key accessors then skip the name
+ * lookup on each call. A key is only valid for the config type it came from.
+ */
+typedef struct MppCfgKey_t {
+    void            *def;
+    void            *entry;
+} MppCfgKey;
+
+/* key / value pair for batch setting number entries */
+typedef struct MppCfgKeyVal_t {
+    MppCfgKey       key;
+    RK_S64          val;
+} MppCfgKeyVal;
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -38,6 +54,18 @@ MPP_RET mpp_sys_cfg_get_s64(MppSysCfg cfg, const char *name, RK_S64 *val);
 MPP_RET mpp_sys_cfg_get_u64(MppSysCfg cfg, const char *name, RK_U64 *val);
 MPP_RET mpp_sys_cfg_get_ptr(MppSysCfg cfg, const char *name, void **val);
 
+MPP_RET mpp_sys_cfg_get_key(const char *name, MppCfgKey *key);
+MPP_RET mpp_sys_cfg_set_s32_by_key(MppSysCfg cfg, MppCfgKey key, RK_S32 val);
+MPP_RET mpp_sys_cfg_set_u32_by_key(MppSysCfg cfg, MppCfgKey key, RK_U32 val);
+MPP_RET mpp_sys_cfg_set_s64_by_key(MppSysCfg cfg, MppCfgKey key, RK_S64 val);
+MPP_RET mpp_sys_cfg_set_u64_by_key(MppSysCfg cfg, MppCfgKey key, RK_U64 val);
+MPP_RET mpp_sys_cfg_get_s32_by_key(MppSysCfg cfg, MppCfgKey key, RK_S32 *val);
+MPP_RET mpp_sys_cfg_get_u32_by_key(MppSysCfg cfg, MppCfgKey key, RK_U32 *val);
+MPP_RET mpp_sys_cfg_get_s64_by_key(MppSysCfg cfg, MppCfgKey key, RK_S64 *val);
+MPP_RET mpp_sys_cfg_get_u64_by_key(MppSysCfg cfg, MppCfgKey key, RK_U64 *val);
+/* nothing is set when a key is invalid or readonly or a value does not fit */
+MPP_RET mpp_sys_cfg_set_kv(MppSysCfg cfg, const MppCfgKeyVal *kv, RK_S32 count);
+
 void mpp_sys_cfg_show(void);
 
 #ifdef __cplusplus
@@ -0,0 +1,48 @@
+/* SPDX-License-Identifier: Apache-2.0 OR MIT */
+/*
+ * Copyright (c) 2026 Rockchip Electronics Co., Ltd.
+ */
+
+#ifndef RK_VDEC_BATCH_H
+#define RK_VDEC_BATCH_H
+
+#include "rk_mpi.h"
+
+/*
+ * Batch decoder for many small jpeg images like thumbnails
+ *
+ * One MJPEG decoder session decodes an array of packets into the caller
+ * frames of the same index. Up to depth images are queued to the decoder at
+ * once, so the decoder thread starts parsing the next image as soon as the
+ * hardware finishes one instead of waiting for the caller to get the frame
+ * and put the next packet. Images with the same DQT / DHT as the previous
+ * one reuse the hardware tables.
+ *
+ * Every packet and frame needs a buffer, and the frame buffer must be large
+ * enough for the decoded image. The packets are consumed. A frame failed to
+ * decode has errinfo set and the other frames are still decoded.
+ */
+#define MPP_DEC_BATCH_DEPTH_MAX     16
+
+typedef void* MppDecBatch;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* depth 0 for the default queue depth */
+MPP_RET mpp_dec_batch_init(MppDecBatch *ctx, RK_S32 depth);
+MPP_RET mpp_dec_batch_deinit(MppDecBatch ctx);
+
+/* decoder control like MPP_DEC_SET_OUTPUT_FORMAT before decoding */
+MPP_RET mpp_dec_batch_control(MppDecBatch ctx, MpiCmd cmd, MppParam param);
+
+/* decode packets[i] to frames[i] and return when all frames are done */
+MPP_RET mpp_dec_batch_decode(MppDecBatch ctx, MppPacket *packets, MppFrame *frames,
+                             RK_S32 count);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* RK_VDEC_BATCH_H */
@@ -17,8 +17,7 @@
 #ifndef RK_VDEC_CFG_H
 #define RK_VDEC_CFG_H
 
-#include "rk_type.h"
-#include "mpp_err.h"
+#include "rk_mpp_cfg.h"
 
 typedef void* MppDecCfg;
 
@@ -41,6 +40,23 @@ MPP_RET mpp_dec_cfg_get_s64(MppDecCfg cfg, const char *name, RK_S64 *val);
 MPP_RET mpp_dec_cfg_get_u64(MppDecCfg cfg, const char *name, RK_U64 *val);
 MPP_RET mpp_dec_cfg_get_ptr(MppDecCfg cfg, const char *name, void **val);
 
+/*
+ * Resolve the name once and set / get by key in hot path. set_kv sets count
+ * number entries and the updated entries are applied together by one
+ * MPP_DEC_SET_CFG control call. All keys and values are checked first and
+ * nothing is set when a key is invalid or a value does not fit its entry.
+ */
+MPP_RET mpp_dec_cfg_get_key(const char *name, MppCfgKey *key);
+MPP_RET mpp_dec_cfg_set_s32_by_key(MppDecCfg cfg, MppCfgKey key, RK_S32 val);
+MPP_RET mpp_dec_cfg_set_u32_by_key(MppDecCfg cfg, MppCfgKey key, RK_U32 val);
+MPP_RET mpp_dec_cfg_set_s64_by_key(MppDecCfg cfg, MppCfgKey key, RK_S64 val);
+MPP_RET mpp_dec_cfg_set_u64_by_key(MppDecCfg cfg, MppCfgKey key, RK_U64 val);
+MPP_RET mpp_dec_cfg_get_s32_by_key(MppDecCfg cfg, MppCfgKey key, RK_S32 *val);
+MPP_RET mpp_dec_cfg_get_u32_by_key(MppDecCfg cfg, MppCfgKey key, RK_U32 *val);
+MPP_RET mpp_dec_cfg_get_s64_by_key(MppDecCfg cfg, MppCfgKey key, RK_S64 *val);
+MPP_RET mpp_dec_cfg_get_u64_by_key(MppDecCfg cfg, MppCfgKey key, RK_U64 *val);
+MPP_RET mpp_dec_cfg_set_kv(MppDecCfg cfg, const MppCfgKeyVal *kv, RK_S32 count);
+
 void mpp_dec_cfg_show(void);
 
 #ifdef __cplusplus
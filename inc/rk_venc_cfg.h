@@ -35,6 +35,23 @@ MPP_RET mpp_enc_cfg_get_u64(MppEncCfg cfg, const char *name, RK_U64 *val);
 MPP_RET mpp_enc_cfg_get_ptr(MppEncCfg cfg, const char *name, void **val);
 MPP_RET mpp_enc_cfg_get_st(MppEncCfg cfg, const char *name, void *val);
 
+/*
+ * Resolve the name once and set / get by key in hot path. set_kv sets count
+ * number entries and the updated entries are applied together by one
+ * MPP_ENC_SET_CFG control call. All keys and values are checked first and
+ * nothing is set when a key is invalid or a value does not fit its entry.
+ */
+MPP_RET mpp_enc_cfg_get_key(const char *name, MppCfgKey *key);
+MPP_RET mpp_enc_cfg_set_s32_by_key(MppEncCfg cfg, MppCfgKey key, RK_S32 val);
+MPP_RET mpp_enc_cfg_set_u32_by_key(MppEncCfg cfg, MppCfgKey key, RK_U32 val);
+MPP_RET mpp_enc_cfg_set_s64_by_key(MppEncCfg cfg, MppCfgKey key, RK_S64 val);
+MPP_RET mpp_enc_cfg_set_u64_by_key(MppEncCfg cfg, MppCfgKey key, RK_U64 val);
+MPP_RET mpp_enc_cfg_get_s32_by_key(MppEncCfg cfg, MppCfgKey key, RK_S32 *val);
+MPP_RET mpp_enc_cfg_get_u32_by_key(MppEncCfg cfg, MppCfgKey key, RK_U32 *val);
+MPP_RET mpp_enc_cfg_get_s64_by_key(MppEncCfg cfg, MppCfgKey key, RK_S64 *val);
+MPP_RET mpp_enc_cfg_get_u64_by_key(MppEncCfg cfg, MppCfgKey key, RK_U64 *val);
+MPP_RET mpp_enc_cfg_set_kv(MppEncCfg cfg, const MppCfgKeyVal *kv, RK_S32 count);
+
 void mpp_enc_cfg_show(void);
 MPP_RET mpp_enc_cfg_extract(MppEncCfg cfg, MppCfgStrFmt fmt, char **buf);
 MPP_RET mpp_enc_cfg_apply(MppEncCfg cfg, MppCfgStrFmt fmt, char *buf);
@@ -0,0 +1,56 @@
+/* SPDX-License-Identifier: Apache-2.0 OR MIT */
+/*
+ * Copyright (c) 2026 Rockchip Electronics Co., Ltd.
+ */
+
+#ifndef RK_VENC_CHUNK_H
+#define RK_VENC_CHUNK_H
+
+#include "rk_mpi.h"
+
+/*
+ * Chunk parallel encoder for offline transcode
+ *
+ * The input frames are split into chunks of chunk_frames frames. Chunk n is
+ * encoded by session n % sessions, and all sessions run at the same time so
+ * a multi-core encoder like rk3588 vepu580 keeps every core busy.
+ *
+ * Each chunk starts with an IDR frame, so it is a closed GOP and POC /
+ * frame_num restart at the chunk boundary. All sessions share the config
+ * set by MPP_ENC_SET_CFG, so the SPS / PPS of every chunk are the same. The
+ * packets are returned in input order, and they form one continuous stream.
+ *
+ * Input frame buffers are referenced until they are encoded. The caller
+ * needs a new buffer for each frame, and it should put its own reference
+ * after mpp_enc_chunk_put_frame. put_frame blocks when every session has a
+ * full chunk queued.
+ */
+#define MPP_ENC_CHUNK_SESSION_MAX   4
+
+typedef void* MppEncChunk;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* sessions 0 for the encoder core count of the soc */
+MPP_RET mpp_enc_chunk_init(MppEncChunk *ctx, MppCodingType coding,
+                           RK_S32 sessions, RK_S32 chunk_frames);
+MPP_RET mpp_enc_chunk_deinit(MppEncChunk ctx);
+
+/* commands are sent to all sessions */
+MPP_RET mpp_enc_chunk_control(MppEncChunk ctx, MpiCmd cmd, MppParam param);
+
+/* frame with eos flag ends the input */
+MPP_RET mpp_enc_chunk_put_frame(MppEncChunk ctx, MppFrame frame);
+/*
+ * get the next packet in stream order, NULL when no packet is ready in
+ * timeout. The last packet has eos flag and NULL is returned after it.
+ */
+MPP_RET mpp_enc_chunk_get_packet(MppEncChunk ctx, MppPacket *packet, MppPollType timeout);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* RK_VENC_CHUNK_H */
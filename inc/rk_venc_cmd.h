@@ -191,6 +191,11 @@ typedef struct MppEncBaseCfg_t {
     RK_S32  smart_en;
     RK_S32  smt1_en;
     RK_S32  smt3_en;
+    /*
+     * output stream header as a separate packet chunk instead of copying
+     * it into packet data, see mpp_packet_get_iov in mpp_packet.h
+     */
+    RK_S32  pkt_iov;
 } MppEncBaseCfg;
 
 /*
@@ -381,6 +386,28 @@ typedef struct MppEncRcCfg_t {
     RK_U32                  refresh_num;
     RK_S32                  refresh_length;
     RK_S32                  inst_br_lvl;
+
+    /*
+     * lookahead - number of frames analyzed ahead of the encoding frame
+     * 0 - disable lookahead
+     * 1~16 - delay output by lookahead frames and plan qp with the
+     *        complexity of the frames ahead. Only for async input mode.
+     * NOTE: encoder holds lookahead + 1 input frames in lookahead queue, one
+     * in input queue and one under encoding. The input buffer pool must have
+     * more than lookahead + 3 buffers. Otherwise the encoder waits for the
+     * frames ahead while the user waits for a free buffer.
+     */
+    RK_S32                  lookahead;
+
+    /*
+     * multi-pass encoding
+     * pass - 0 single pass
+     *        1 first pass, record frame type / qp / bits to stats_file
+     *        2 second pass, plan the bits of all frames with stats_file
+     * stats_file - stats file path, the string is copied on config
+     */
+    RK_S32                  pass;
+    const char              *stats_file;
 } MppEncRcCfg;
 
 /*
@@ -500,6 +527,11 @@ typedef struct MppEncPrepCfg_t {
     RK_S32              height;
     RK_S32              hor_stride;
     RK_S32              ver_stride;
+    /*
+     * max width / height - size of encoder internal buffers
+     * Set it with the first config to switch resolution below it by
+     * MPP_ENC_SET_CFG without buffer reallocation. Default is the first size.
+     */
     RK_S32              max_width;
     RK_S32              max_height;
 
@@ -1257,6 +1289,49 @@ typedef struct MppEncUserDataSet_t {
     MppEncUserDataFull  *datas;
 } MppEncUserDataSet;
 
+/*
+ * Per-frame encoder statistics attached to output packet meta by
+ * KEY_ENC_FRM_STATS. Fields are only appended, so check size / version
+ * before reading fields added by a newer version. Fields up to motion_level
+ * are mandatory, the size reported by meta is the size copied from writer.
+ */
+#define MPP_ENC_FRM_STATS_VERSION   1
+
+typedef struct MppEncFrmStats_t {
+    /* sizeof(MppEncFrmStats) and MPP_ENC_FRM_STATS_VERSION of the writer */
+    RK_U32              size;
+    RK_U32              version;
+
+    RK_S32              is_intra;
+    RK_S32              temporal_id;
+    /* coded bits of the frame */
+    RK_S32              bits;
+    /* frame level start qp and average qp of all blocks */
+    RK_S32              qp_start;
+    RK_S32              qp_avg;
+
+    /*
+     * block area ratio in 1/1000 of the frame
+     * skip is the area not covered by coded intra / inter blocks
+     */
+    RK_S32              intra_ratio;
+    RK_S32              inter_ratio;
+    RK_S32              skip_ratio;
+
+    /* mean abs difference of intra / inter prediction, motion level 0 ~ 200 */
+    RK_S32              madi;
+    RK_S32              madp;
+    RK_S32              motion_level;
+
+    /* luma sse from hardware and psnr in 1/100 dB, 0 when not reported */
+    RK_S64              sse;
+    RK_S32              psnr_y;
+
+    /* hardware time in ns and cycles of the last pass, 0 when not supported */
+    RK_S64              hw_time;
+    RK_S64              hw_cycles;
+} MppEncFrmStats;
+
 typedef enum MppEncSceneMode_e {
     MPP_ENC_SCENE_MODE_DEFAULT,
     MPP_ENC_SCENE_MODE_IPC,
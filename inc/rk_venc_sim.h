@@ -0,0 +1,62 @@
+/* SPDX-License-Identifier: Apache-2.0 OR MIT */
+/*
+ * Copyright (c) 2026 Rockchip Electronics Co., Ltd.
+ */
+
+#ifndef RK_VENC_SIM_H
+#define RK_VENC_SIM_H
+
+#include "rk_mpi.h"
+
+/*
+ * Simulcast encoder
+ *
+ * One input frame is encoded into several output rungs with different size
+ * and bitrate, e.g. a 1080p / 720p / 480p ABR ladder.
+ *
+ * All rungs share one encoder config set by MPP_ENC_SET_CFG. Prep size,
+ * stride and bitrate are replaced per rung, so the user configures the
+ * input once. Other controls are sent to every rung, so IDR requests keep
+ * the GOPs of the ladder aligned.
+ *
+ * The input is submitted to all rungs at the same time. Each smaller rung
+ * scales it in its own thread, by VDPP when it is enabled and present,
+ * otherwise by CPU, so scaling and encoding of the rungs run in parallel.
+ * Every rung encodes its own frame. Force keys such as KEY_INPUT_IDR_REQ,
+ * KEY_INPUT_PSKIP and the LTR keys are copied to every rung. OSD, ROI and
+ * user data are only copied to rungs with the input size. The input frame
+ * meta is consumed.
+ */
+#define MPP_ENC_SIM_RUNG_MAX    8
+
+typedef void* MppEncSim;
+
+typedef struct MppEncSimRung_t {
+    /* output size, 0 for the input size. Upscale is not supported. */
+    RK_S32          width;
+    RK_S32          height;
+    /* target bitrate, 0 to scale the config bitrate by (area ratio)^0.75 */
+    RK_S32          bps_target;
+} MppEncSimRung;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+MPP_RET mpp_enc_sim_init(MppEncSim *sim, MppCodingType coding,
+                         const MppEncSimRung *rungs, RK_S32 count);
+MPP_RET mpp_enc_sim_deinit(MppEncSim sim);
+
+/* MPP_ENC_SET_CFG applies the shared config, other commands go to all rungs */
+MPP_RET mpp_enc_sim_control(MppEncSim sim, MpiCmd cmd, MppParam param);
+
+/* encode one frame on all rungs and return when all rungs finish */
+MPP_RET mpp_enc_sim_encode(MppEncSim sim, MppFrame frame);
+/* take the output packet of rung idx from last encode, caller deinits it */
+MPP_RET mpp_enc_sim_get_packet(MppEncSim sim, RK_S32 idx, MppPacket *packet);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* RK_VENC_SIM_H */
@@ -123,6 +123,8 @@ rk_s32 kmpp_obj_tbl_set_u64(KmppObj obj, KmppEntry *tbl, rk_u64 val);
 rk_s32 kmpp_obj_tbl_get_u64(KmppObj obj, KmppEntry *tbl, rk_u64 *val);
 rk_s32 kmpp_obj_tbl_set_st(KmppObj obj, KmppEntry *tbl, void *val);
 rk_s32 kmpp_obj_tbl_get_st(KmppObj obj, KmppEntry *tbl, void *val);
+/* set s32 / u32 / s64 / u64 entry by its own element type */
+rk_s32 kmpp_obj_tbl_set_val(KmppObj obj, KmppEntry *tbl, rk_s64 val);
 
 /* userspace access only function */
 rk_s32 kmpp_obj_set_obj(KmppObj obj, const char *name, KmppObj val);
@@ -1571,6 +1571,37 @@ MPP_OBJ_TBL_ACCESS(obj, KmppObj)
 MPP_OBJ_TBL_ACCESS(ptr, void *)
 MPP_OBJ_TBL_ACCESS(fp, void *)
 
+rk_s32 kmpp_obj_tbl_set_val(KmppObj obj, KmppEntry *tbl, rk_s64 val)
+{
+    rk_s32 ret = rk_nok;
+
+    if (!tbl) {
+        mpp_loge_f("invalid NULL entry\n");
+        return ret;
+    }
+
+    switch (tbl->tbl.elem_type) {
+    case ELEM_TYPE_s32 : {
+        ret = kmpp_obj_tbl_set_s32(obj, tbl, (rk_s32)val);
+    } break;
+    case ELEM_TYPE_u32 : {
+        ret = kmpp_obj_tbl_set_u32(obj, tbl, (rk_u32)val);
+    } break;
+    case ELEM_TYPE_s64 : {
+        ret = kmpp_obj_tbl_set_s64(obj, tbl, val);
+    } break;
+    case ELEM_TYPE_u64 : {
+        ret = kmpp_obj_tbl_set_u64(obj, tbl, (rk_u64)val);
+    } break;
+    default : {
+        mpp_loge_f("entry %08x type %s is not a number\n", tbl->val,
+                   strof_elem_type(tbl->tbl.elem_type));
+    } break;
+    }
+
+    return ret;
+}
+
 #define MPP_OBJ_STRUCT_TBL_ACCESS(type, base_type) \
     rk_s32 kmpp_obj_tbl_set_##type(KmppObj obj, KmppEntry *tbl, base_type *val) \
     { \
@@ -66,4 +66,13 @@ RK_S32 mpp_writer_bits(MppWriteCtx *ctx);
 
 RK_S32 mpp_exp_golomb_signed(RK_S32 val);
 
+/*
+ * Move NAL payload from src bit position to dst bit position for header
+ * rewriting. Emulation prevention bytes in src are removed and inserted
+ * again on the new byte alignment. The bits before dst_bit are kept.
+ * src_size is the byte size of src from its start.
+ * Return the change of emulation prevention byte count.
+ */
+RK_S32 mpp_writer_move(RK_U8 *dst, RK_U8 *src, RK_S32 dst_bit, RK_S32 src_bit, RK_S32 src_size);
+
 #endif /* MPP_BITWRITER_H */
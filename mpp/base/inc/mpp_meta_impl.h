@@ -47,6 +47,7 @@ typedef struct MppMetaImpl_t {
     MppEncUserData      user_data;
     MppEncUserDataSet   user_data_set;
     RK_U32              datas_buf_size;
+    MppEncFrmStats      enc_stats;
     MppMetaVal          vals[0];
 } MppMetaImpl;
 
@@ -27,6 +27,7 @@
 #define MPP_PACKET_FLAG_EOI             (0x00000040)
 
 #define MPP_PKT_SEG_CNT_DEFAULT         8
+#define MPP_PKT_CHUNK_CNT_MAX           4
 
 typedef void (*ReleaseCb)(void *ctx, void *arg);
 
@@ -46,6 +47,13 @@ typedef union MppPacketStatus_t {
     };
 } MppPacketStatus;
 
+/* data chunk in a separate buffer which is output ahead of packet data */
+typedef struct MppPktChunk_t {
+    MppBuffer       buffer;
+    size_t          offset;
+    size_t          length;
+} MppPktChunk;
+
 /*
  * mpp_packet_imp structure
  *
@@ -80,6 +88,10 @@ typedef struct MppPacketImpl_t {
     MppPktSeg       *segments_ext;
     MppPktSeg       *segments;
 
+    /* prefix chunks with buffer reference */
+    RK_U32          chunk_nb;
+    MppPktChunk     chunks[MPP_PKT_CHUNK_CNT_MAX];
+
     /* release callback info */
     ReleaseCb       release;
     void            *release_ctx;
@@ -105,6 +117,12 @@ void    mpp_packet_reset_segment(MppPacket packet);
 void    mpp_packet_set_segment_nb(MppPacket packet, RK_U32 segment_nb);
 MPP_RET mpp_packet_add_segment_info(MppPacket packet, RK_S32 type, RK_S32 offset, RK_S32 len);
 void    mpp_packet_copy_segment_info(MppPacket dst, MppPacket src);
+/*
+ * add buffer range as a chunk ahead of packet data without copy
+ * the chunk is not counted in packet length and segment info
+ */
+MPP_RET mpp_packet_add_chunk(MppPacket packet, MppBuffer buffer, size_t offset, size_t length);
+void    mpp_packet_reset_chunk(MppPacket packet);
 void    mpp_packet_set_release(MppPacket packet, ReleaseCb release, void *ctx, void *arg);
 
 /* pointer check function */
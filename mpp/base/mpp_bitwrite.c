@@ -14,6 +14,8 @@
  * limitations under the License.
  */
 
+#include <string.h>
+
 #include "mpp_mem.h"
 #include "mpp_debug.h"
 
@@ -247,3 +249,136 @@ RK_S32 mpp_exp_golomb_signed(RK_S32 val)
 
     return tmp * 2 - 1;
 }
+
+#define BIT_MOVE_ONES   0x0101010101010101ULL
+#define BIT_MOVE_HIGHS  0x8080808080808080ULL
+#define BIT_MOVE_ZERO(v)    (((v) - BIT_MOVE_ONES) & ~(v) & BIT_MOVE_HIGHS)
+
+static inline RK_U64 bit_move_load_be64(const RK_U8 *p)
+{
+    return ((RK_U64)p[0] << 56) | ((RK_U64)p[1] << 48) |
+           ((RK_U64)p[2] << 40) | ((RK_U64)p[3] << 32) |
+           ((RK_U64)p[4] << 24) | ((RK_U64)p[5] << 16) |
+           ((RK_U64)p[6] << 8)  | ((RK_U64)p[7]);
+}
+
+static inline void bit_move_store_be64(RK_U8 *p, RK_U64 v)
+{
+    p[0] = (RK_U8)(v >> 56);
+    p[1] = (RK_U8)(v >> 48);
+    p[2] = (RK_U8)(v >> 40);
+    p[3] = (RK_U8)(v >> 32);
+    p[4] = (RK_U8)(v >> 24);
+    p[5] = (RK_U8)(v >> 16);
+    p[6] = (RK_U8)(v >> 8);
+    p[7] = (RK_U8)v;
+}
+
+RK_S32 mpp_writer_move(RK_U8 *dst, RK_U8 *src, RK_S32 dst_bit, RK_S32 src_bit, RK_S32 src_size)
+{
+    RK_S32 dst_bit_r = dst_bit & 7;
+    RK_S32 src_bit_r = src_bit & 7;
+    RK_S32 src_len = src_size - src_bit / 8;
+    RK_U8 *psrc = src + src_bit / 8;
+    RK_U8 *pdst = dst + dst_bit / 8;
+    RK_U16 dst_mask = (RK_U16)(0xFFFF << (8 - dst_bit_r));
+    RK_U16 last_tmp = (RK_U16)pdst[0];
+    RK_U32 loop = src_len + (src_bit_r > 0);
+    RK_U32 src_zero_cnt = 0;
+    RK_U32 dst_zero_cnt = 0;
+    RK_S32 diff_len = 0;
+    RK_U32 i = 0;
+
+    if (!src_bit_r && !dst_bit_r) {
+        memcpy(pdst, psrc, src_len);
+        return 0;
+    }
+
+    while (i < loop) {
+        RK_U16 tmp16a, tmp16b, tmp16c;
+        RK_U8 tmp0, tmp1;
+
+        /*
+         * Shift 8 bytes at once when neither side needs emulation prevention
+         * handling. A zero free source window can not contain 00 00 03 and a
+         * zero free output can not form 00 00 0x. Only the tail and windows
+         * around zero bytes go to the byte loop below.
+         */
+        while (i + 8 < loop && dst_zero_cnt < 2) {
+            RK_U64 w = bit_move_load_be64(psrc);
+            RK_U64 a;
+            RK_U64 d;
+
+            if (BIT_MOVE_ZERO(w))
+                break;
+
+            a = src_bit_r ? (w << src_bit_r) | (psrc[8] >> (8 - src_bit_r)) : w;
+            d = dst_bit_r ? (a >> dst_bit_r) |
+                ((RK_U64)(((last_tmp << 8) & dst_mask) >> 8) << 56) : a;
+
+            if (BIT_MOVE_ZERO(d))
+                break;
+
+            bit_move_store_be64(pdst, d);
+
+            /* keep the low bits of the last shifted byte for next output */
+            last_tmp = (RK_U16)((a & 0xFF) << (8 - dst_bit_r));
+            src_zero_cnt = 0;
+            dst_zero_cnt = 0;
+            psrc += 8;
+            pdst += 8;
+            i += 8;
+        }
+
+        if (i >= loop)
+            break;
+
+        if (psrc[0] == 0)
+            src_zero_cnt++;
+        else
+            src_zero_cnt = 0;
+
+        /* tmp0 tmp1 is next two non-aligned bytes from src */
+        tmp0 = psrc[0];
+        tmp1 = (i < loop - 1) ? psrc[1] : 0;
+
+        /* drop emulation prevention byte in src */
+        if (src_zero_cnt >= 2 && tmp1 == 3) {
+            psrc++;
+            i++;
+            tmp1 = psrc[1];
+            src_zero_cnt = 0;
+            diff_len--;
+        }
+
+        tmp16a = ((RK_U16)tmp0 << 8) | (RK_U16)tmp1;
+        tmp16b = src_bit_r ? (RK_U16)(tmp16a << src_bit_r) : tmp16a;
+        tmp16c = dst_bit_r ? (RK_U16)((tmp16b >> dst_bit_r) | ((last_tmp << 8) & dst_mask)) : tmp16b;
+
+        pdst[0] = (tmp16c >> 8) & 0xFF;
+        pdst[1] = tmp16c & 0xFF;
+
+        /* insert emulation prevention byte in dst */
+        if (dst_zero_cnt == 2 && pdst[0] <= 0x3) {
+            pdst[2] = pdst[1];
+            pdst[1] = pdst[0];
+            pdst[0] = 0x3;
+            pdst++;
+            diff_len++;
+            dst_zero_cnt = 0;
+        }
+
+        if (pdst[0] == 0)
+            dst_zero_cnt++;
+        else
+            dst_zero_cnt = 0;
+
+        last_tmp = tmp16c;
+
+        psrc++;
+        pdst++;
+        i++;
+    }
+
+    return diff_len;
+}
@@ -5,6 +5,7 @@
 
 #define MODULE_TAG "mpp_cfg"
 
+#include <stdint.h>
 #include <string.h>
 
 #include "mpp_env.h"
@@ -68,3 +69,117 @@ MPP_RET check_cfg_entry(KmppEntry *node, const char *name, ElemType type,
 
     return ret;
 }
+
+MPP_RET mpp_cfg_get_key(KmppObjDef def, const char *name, MppCfgKey *key)
+{
+    KmppEntry *entry = NULL;
+
+    if (!key || !name) {
+        mpp_err_f("invalid input name %p key %p\n", name, key);
+        return MPP_ERR_NULL_PTR;
+    }
+
+    key->def = NULL;
+    key->entry = NULL;
+
+    kmpp_objdef_get_entry(def, name, &entry);
+    if (!entry) {
+        mpp_err_f("cfg %s is not found\n", name);
+        return MPP_NOK;
+    }
+
+    key->def = def;
+    key->entry = entry;
+
+    return MPP_OK;
+}
+
+KmppEntry *check_cfg_key(KmppObjDef def, KmppObj cfg, MppCfgKey key, ElemType type,
+                         const char *func)
+{
+    KmppEntry *entry = (KmppEntry *)key.entry;
+
+    if (!cfg || !entry || key.def != def || kmpp_obj_to_objdef(cfg) != def) {
+        mpp_err("%s: invalid cfg %p key %p:%p\n", func, cfg, key.def, key.entry);
+        return NULL;
+    }
+
+    if (check_cfg_entry(entry, "by key", type, func))
+        return NULL;
+
+    return entry;
+}
+
+/* check the value fits the number type of the entry */
+static MPP_RET check_cfg_val(KmppEntry *entry, RK_S64 val)
+{
+    switch (entry->tbl.elem_type) {
+    case ELEM_TYPE_s32 : {
+        return (val >= INT32_MIN && val <= INT32_MAX) ? MPP_OK : MPP_NOK;
+    } break;
+    case ELEM_TYPE_u32 : {
+        return (val >= 0 && val <= UINT32_MAX) ? MPP_OK : MPP_NOK;
+    } break;
+    case ELEM_TYPE_s64 : {
+        return MPP_OK;
+    } break;
+    case ELEM_TYPE_u64 : {
+        return (val >= 0) ? MPP_OK : MPP_NOK;
+    } break;
+    default : {
+    } break;
+    }
+
+    return MPP_NOK;
+}
+
+MPP_RET mpp_cfg_set_kv(KmppObjDef def, KmppObj cfg, const MppCfgKeyVal *kv,
+                       RK_S32 count, RK_U32 ro_chk, const char *func)
+{
+    RK_S32 i;
+
+    if (!kv && count) {
+        mpp_err("%s: invalid NULL key value with count %d\n", func, count);
+        return MPP_ERR_NULL_PTR;
+    }
+
+    if (!cfg || kmpp_obj_to_objdef(cfg) != def) {
+        mpp_err("%s: invalid cfg %p\n", func, cfg);
+        return MPP_NOK;
+    }
+
+    /* check all keys and values first so an invalid pair sets nothing */
+    for (i = 0; i < count; i++) {
+        KmppEntry *entry = (KmppEntry *)kv[i].key.entry;
+
+        if (!entry || kv[i].key.def != def) {
+            mpp_err("%s: invalid key %d %p:%p\n", func, i, kv[i].key.def, entry);
+            return MPP_NOK;
+        }
+
+        if (ro_chk && !entry->tbl.flag_offset) {
+            mpp_err("%s: can not set readonly key %d\n", func, i);
+            return MPP_NOK;
+        }
+
+        if (check_cfg_entry(entry, "key value", (ElemType)entry->tbl.elem_type, func))
+            return MPP_NOK;
+
+        if (check_cfg_val(entry, kv[i].val)) {
+            mpp_err("%s: key %d value %lld does not fit %s entry\n", func, i,
+                    kv[i].val, strof_elem_type(entry->tbl.elem_type));
+            return MPP_ERR_VALUE;
+        }
+    }
+
+    /*
+     * Each changed entry sets its own update flag in the cfg object. So all
+     * the entries set here are handled together at the next SET_CFG control.
+     */
+    for (i = 0; i < count; i++) {
+        if (kmpp_obj_tbl_set_val(cfg, (KmppEntry *)kv[i].key.entry, kv[i].val))
+            return MPP_NOK;
+    }
+
+    return MPP_OK;
+}
@@ -60,6 +60,9 @@
     ENTRY(prefix, ptr, void *,     frm_rdy_cb,          FLAG_INCR,      cb, frm_rdy_cb) \
     ENTRY(prefix, ptr, void *,     frm_rdy_ctx,         FLAG_PREV,      cb, frm_rdy_ctx) \
     ENTRY(prefix, s32, rk_s32,     frm_rdy_cmd,         FLAG_PREV,      cb, frm_rdy_cmd) \
+    ENTRY(prefix, ptr, void *,     frm_part_cb,         FLAG_INCR,      cb, frm_part_cb) \
+    ENTRY(prefix, ptr, void *,     frm_part_ctx,        FLAG_PREV,      cb, frm_part_ctx) \
+    ENTRY(prefix, s32, rk_s32,     frm_part_cmd,        FLAG_PREV,      cb, frm_part_cmd) \
     STRUCT_END(cb) \
     CFG_DEF_END()
 
@@ -137,6 +140,44 @@ DEC_CFG_GET_ACCESS(mpp_dec_cfg_get_u64, RK_U64, u64)
 DEC_CFG_GET_ACCESS(mpp_dec_cfg_get_ptr, void *, ptr)
 DEC_CFG_GET_ACCESS(mpp_dec_cfg_get_st,  void  , st)
 
+MPP_RET mpp_dec_cfg_get_key(const char *name, MppCfgKey *key)
+{
+    return mpp_cfg_get_key(mpp_dec_cfg_def, name, key);
+}
+
+#define DEC_CFG_SET_KEY_ACCESS(func_name, in_type, cfg_type) \
+    MPP_RET func_name(MppDecCfg cfg, MppCfgKey key, in_type val) \
+    { \
+        KmppEntry *entry = CHECK_CFG_KEY(mpp_dec_cfg_def, cfg, key, ELEM_TYPE_##cfg_type); \
+        if (!entry) \
+            return rk_nok; \
+        return kmpp_obj_tbl_set_##cfg_type(cfg, entry, val); \
+    }
+
+DEC_CFG_SET_KEY_ACCESS(mpp_dec_cfg_set_s32_by_key, RK_S32, s32)
+DEC_CFG_SET_KEY_ACCESS(mpp_dec_cfg_set_u32_by_key, RK_U32, u32)
+DEC_CFG_SET_KEY_ACCESS(mpp_dec_cfg_set_s64_by_key, RK_S64, s64)
+DEC_CFG_SET_KEY_ACCESS(mpp_dec_cfg_set_u64_by_key, RK_U64, u64)
+
+#define DEC_CFG_GET_KEY_ACCESS(func_name, in_type, cfg_type) \
+    MPP_RET func_name(MppDecCfg cfg, MppCfgKey key, in_type *val) \
+    { \
+        KmppEntry *entry = CHECK_CFG_KEY(mpp_dec_cfg_def, cfg, key, ELEM_TYPE_##cfg_type); \
+        if (!entry) \
+            return rk_nok; \
+        return kmpp_obj_tbl_get_##cfg_type(cfg, entry, val); \
+    }
+
+DEC_CFG_GET_KEY_ACCESS(mpp_dec_cfg_get_s32_by_key, RK_S32, s32)
+DEC_CFG_GET_KEY_ACCESS(mpp_dec_cfg_get_u32_by_key, RK_U32, u32)
+DEC_CFG_GET_KEY_ACCESS(mpp_dec_cfg_get_s64_by_key, RK_S64, s64)
+DEC_CFG_GET_KEY_ACCESS(mpp_dec_cfg_get_u64_by_key, RK_U64, u64)
+
+MPP_RET mpp_dec_cfg_set_kv(MppDecCfg cfg, const MppCfgKeyVal *kv, RK_S32 count)
+{
+    return mpp_cfg_set_kv(mpp_dec_cfg_def, cfg, kv, count, 0, __FUNCTION__);
+}
+
 void mpp_dec_cfg_show(void)
 {
     MppTrie trie = kmpp_objdef_get_trie(mpp_dec_cfg_def);
@@ -34,6 +34,7 @@ static rk_s32 mpp_enc_args_impl_deinit(void *entry, KmppObj obj, const char *cal
     MPP_FREE(args->file_output);
     MPP_FREE(args->file_cfg);
     MPP_FREE(args->file_slt);
+    MPP_FREE(args->file_stats);
 
     (void) obj;
     (void) caller;
@@ -45,6 +45,7 @@
     ENTRY(prefix, s32,  rk_s32,     low_delay,              FLAG_INCR,                          base, low_delay) \
     ENTRY(prefix, s32,  rk_s32,     smt1_en,                FLAG_INCR,                          base, smt1_en) \
     ENTRY(prefix, s32,  rk_s32,     smt3_en,                FLAG_INCR,                          base, smt3_en) \
+    ENTRY(prefix, s32,  rk_s32,     pkt_iov,                FLAG_INCR,                          base, pkt_iov) \
     STRUCT_END(base) \
     STRUCT_START(rc) \
     ENTRY(prefix, s32,  rk_s32,     mode,                   FLAG_BASE(0),                       rc, rc_mode) \
@@ -97,6 +98,9 @@
     ENTRY(prefix, s32,  rk_s32,     fqp_max_p,              FLAG_PREV,                          rc, fqp_max_p) \
     ENTRY(prefix, s32,  rk_s32,     mt_st_swth_frm_qp,      FLAG_PREV,                          rc, mt_st_swth_frm_qp) \
     ENTRY(prefix, s32,  rk_s32,     inst_br_lvl,            FLAG_INCR,                          rc, inst_br_lvl) \
+    ENTRY(prefix, s32,  rk_s32,     lookahead,              FLAG_INCR,                          rc, lookahead) \
+    ENTRY(prefix, s32,  rk_s32,     pass,                   FLAG_INCR,                          rc, pass) \
+    ENTRY(prefix, ptr,  void *,     stats_file,             FLAG_INCR,                          rc, stats_file) \
     STRUCT_END(rc) \
     STRUCT_START(prep); \
     ENTRY(prefix, s32,  rk_s32,     width,                  FLAG_BASE(0),                       prep, width_set); \
@@ -431,6 +435,44 @@ ENC_CFG_GET_ACCESS(mpp_enc_cfg_get_u64, RK_U64, U64)
 ENC_CFG_GET_ACCESS(mpp_enc_cfg_get_ptr, void *, Ptr)
 ENC_CFG_GET_ACCESS(mpp_enc_cfg_get_st,  void  , St)
 
+MPP_RET mpp_enc_cfg_get_key(const char *name, MppCfgKey *key)
+{
+    return mpp_cfg_get_key(mpp_enc_cfg_def, name, key);
+}
+
+#define ENC_CFG_SET_KEY_ACCESS(func_name, in_type, cfg_type) \
+    MPP_RET func_name(MppEncCfg cfg, MppCfgKey key, in_type val) \
+    { \
+        KmppEntry *entry = CHECK_CFG_KEY(mpp_enc_cfg_def, cfg, key, ELEM_TYPE_##cfg_type); \
+        if (!entry) \
+            return rk_nok; \
+        return kmpp_obj_tbl_set_##cfg_type(cfg, entry, val); \
+    }
+
+ENC_CFG_SET_KEY_ACCESS(mpp_enc_cfg_set_s32_by_key, RK_S32, s32)
+ENC_CFG_SET_KEY_ACCESS(mpp_enc_cfg_set_u32_by_key, RK_U32, u32)
+ENC_CFG_SET_KEY_ACCESS(mpp_enc_cfg_set_s64_by_key, RK_S64, s64)
+ENC_CFG_SET_KEY_ACCESS(mpp_enc_cfg_set_u64_by_key, RK_U64, u64)
+
+#define ENC_CFG_GET_KEY_ACCESS(func_name, in_type, cfg_type) \
+    MPP_RET func_name(MppEncCfg cfg, MppCfgKey key, in_type *val) \
+    { \
+        KmppEntry *entry = CHECK_CFG_KEY(mpp_enc_cfg_def, cfg, key, ELEM_TYPE_##cfg_type); \
+        if (!entry) \
+            return rk_nok; \
+        return kmpp_obj_tbl_get_##cfg_type(cfg, entry, val); \
+    }
+
+ENC_CFG_GET_KEY_ACCESS(mpp_enc_cfg_get_s32_by_key, RK_S32, s32)
+ENC_CFG_GET_KEY_ACCESS(mpp_enc_cfg_get_u32_by_key, RK_U32, u32)
+ENC_CFG_GET_KEY_ACCESS(mpp_enc_cfg_get_s64_by_key, RK_S64, s64)
+ENC_CFG_GET_KEY_ACCESS(mpp_enc_cfg_get_u64_by_key, RK_U64, u64)
+
+MPP_RET mpp_enc_cfg_set_kv(MppEncCfg cfg, const MppCfgKeyVal *kv, RK_S32 count)
+{
+    return mpp_cfg_set_kv(mpp_enc_cfg_def, cfg, kv, count, 0, __FUNCTION__);
+}
+
 void mpp_enc_cfg_show(void)
 {
     MppTrie trie = kmpp_objdef_get_trie(mpp_enc_cfg_def);
@@ -5,6 +5,7 @@
 
 #define MODULE_TAG "mpp_meta"
 
+#include <stddef.h>
 #include <string.h>
 #include <endian.h>
 
@@ -145,6 +146,7 @@ static inline RK_U64 META_KEY_TO_U64(RK_U32 key, RK_U32 type)
     ENTRY(KEY_OUTPUT_PSKIP,         TYPE_VAL_32) \
     ENTRY(KEY_INPUT_PSKIP_NON_REF,  TYPE_VAL_32) \
     ENTRY(KEY_ENC_SSE,              TYPE_VAL_64) \
+    ENTRY(KEY_ENC_FRM_STATS,        TYPE_UPTR) \
     \
     ENTRY(KEY_ENC_MARK_LTR,         TYPE_VAL_32) \
     ENTRY(KEY_ENC_USE_LTR,          TYPE_VAL_32) \
@@ -153,7 +155,12 @@ static inline RK_U64 META_KEY_TO_U64(RK_U32 key, RK_U32 type)
     \
     ENTRY(KEY_DEC_TBN_EN,           TYPE_VAL_32) \
     ENTRY(KEY_DEC_TBN_Y_OFFSET,     TYPE_VAL_32) \
-    ENTRY(KEY_DEC_TBN_UV_OFFSET,    TYPE_VAL_32)
+    ENTRY(KEY_DEC_TBN_UV_OFFSET,    TYPE_VAL_32) \
+    ENTRY(KEY_DEC_ROWS_READY,       TYPE_VAL_32) \
+    \
+    ENTRY(KEY_HW_START_TIME,        TYPE_VAL_64) \
+    ENTRY(KEY_HW_END_TIME,          TYPE_VAL_64) \
+    ENTRY(KEY_HW_CYCLES,            TYPE_VAL_64)
 
 typedef struct MppMetaSrv_t {
     spinlock_t          lock;
@@ -171,6 +178,7 @@ static RK_U32 meta_key_count = 0;
 static RK_U32 mpp_meta_debug = 0;
 static RK_S32 user_data_index = -1;
 static RK_S32 user_datas_index = -1;
+static RK_S32 enc_stats_index = -1;
 
 RK_S32 meta_hdr_offset_index = -1;
 RK_S32 meta_hdr_size_index = -1;
@@ -206,6 +214,7 @@ static void mpp_meta_srv_init()
         mpp_trie_add_info(srv->trie, NULL, NULL, 0);
         user_data_index = get_index_of_key_f(KEY_USER_DATA, TYPE_UPTR);
         user_datas_index = get_index_of_key_f(KEY_USER_DATAS, TYPE_UPTR);
+        enc_stats_index = get_index_of_key_f(KEY_ENC_FRM_STATS, TYPE_UPTR);
         meta_hdr_offset_index = get_index_of_key_f(KEY_HDR_META_OFFSET, TYPE_VAL_32);
         meta_hdr_size_index = get_index_of_key_f(KEY_HDR_META_SIZE, TYPE_VAL_32);
     }
@@ -287,6 +296,7 @@ static MppMetaImpl *get_meta(MppMetaSrv *srv, const char *tag, const char *calle
         INIT_LIST_HEAD(&impl->list_meta);
         impl->ref_count = 1;
         impl->node_count = 0;
+        impl->enc_stats.size = 0;
 
         for (i = 0; i < meta_key_count; i++)
             impl->vals[i].state = 0;
@@ -501,6 +511,46 @@ static MPP_RET set_user_datas(MppMetaImpl *impl, void *user_data)
     return MPP_OK;
 }
 
+/* fields from sse on are optional and zero when not reported */
+#define ENC_FRM_STATS_MIN_SIZE  offsetof(MppEncFrmStats, sse)
+
+static MPP_RET set_enc_stats(MppMetaImpl *impl, void *val)
+{
+    MppEncFrmStats *src = (MppEncFrmStats *)val;
+    RK_U32 size;
+
+    if (!src) {
+        impl->enc_stats.size = 0;
+        return MPP_OK;
+    }
+
+    /* keep the previous stats on invalid input */
+    if (src->size < ENC_FRM_STATS_MIN_SIZE) {
+        mpp_err_f("invalid enc stats size %d min %d\n", src->size,
+                  (RK_U32)ENC_FRM_STATS_MIN_SIZE);
+        return MPP_ERR_VALUE;
+    }
+
+    /* older writer may have a smaller struct, report the size copied */
+    size = MPP_MIN(src->size, sizeof(impl->enc_stats));
+    memset(&impl->enc_stats, 0, sizeof(impl->enc_stats));
+    memcpy(&impl->enc_stats, src, size);
+    impl->enc_stats.size = size;
+
+    return MPP_OK;
+}
+
+static MPP_RET get_enc_stats(MppMetaImpl *impl, void **val)
+{
+    if (impl->enc_stats.size) {
+        *val = &impl->enc_stats;
+        return MPP_OK;
+    }
+
+    *val = NULL;
+    return MPP_NOK;
+}
+
 static MPP_RET get_user_data(MppMetaImpl *impl, void **val)
 {
     if (impl->user_data.pdata) {
@@ -543,6 +593,7 @@ MppMeta mpp_meta_dup(MppMeta meta)
             memset(&ret->user_data, 0, sizeof(ret->user_data));
             set_user_datas(impl, (void *)(intptr_t)&impl->user_data_set);
         }
+        ret->enc_stats = impl->enc_stats;
         ret->node_count = impl->node_count;
     }
 
@@ -621,12 +672,17 @@ MPP_RET mpp_meta_dump(MppMeta meta)
         if (index < 0) \
             return MPP_NOK; \
         meta_val = &impl->vals[index]; \
+        if (index == enc_stats_index && \
+            set_enc_stats(impl, (void *)(intptr_t)val)) \
+            return MPP_ERR_VALUE; \
         if (MPP_BOOL_CAS(&meta_val->state, META_VAL_INVALID, META_VAL_VALID)) \
             MPP_FETCH_ADD(&impl->node_count, 1); \
         if (index == user_data_index) { \
             set_user_data(impl, (void *)(intptr_t)val); \
         } else if (index == user_datas_index) { \
             set_user_datas(impl, (void *)(intptr_t)val); \
+        } else if (index == enc_stats_index) { \
+            /* copied before the state update */ \
         } else { \
             meta_val->key_field = val; \
         } \
@@ -652,6 +708,8 @@ MPP_RET mpp_meta_dump(MppMeta meta)
                 get_user_data(impl, (void**)val); \
             else if (index == user_datas_index) \
                 get_user_datas(impl, (void**)val); \
+            else if (index == enc_stats_index) \
+                get_enc_stats(impl, (void**)val); \
             else \
                 *val = meta_val->key_field; \
             MPP_FETCH_SUB(&impl->node_count, 1); \
@@ -678,6 +736,8 @@ MPP_RET mpp_meta_dump(MppMeta meta)
                 get_user_data(impl, (void**)val); \
             else if (index == user_datas_index) \
                 get_user_datas(impl, (void**)val); \
+            else if (index == enc_stats_index) \
+                get_enc_stats(impl, (void**)val); \
             else \
                 *val = meta_val->key_field; \
             MPP_FETCH_SUB(&impl->node_count, 1); \
@@ -145,14 +145,26 @@ MPP_RET mpp_packet_copy_init(MppPacket *packet, const MppPacket src)
         mpp_meta_inc_ref(src_impl->meta);
 
     if (src_impl->buffer) {
+        RK_U32 i;
+
         /* if source packet has buffer just create a new reference to buffer */
         mpp_buffer_inc_ref(src_impl->buffer);
+
+        for (i = 0; i < src_impl->chunk_nb; i++)
+            mpp_buffer_inc_ref(src_impl->chunks[i].buffer);
     } else {
         MppPacketImpl *p;
         /*
-         * NOTE: only copy valid data
+         * NOTE: only copy valid data and the chunks are copied ahead of it
          */
         size_t length = mpp_packet_get_length(src);
+        size_t chunk_len = 0;
+        RK_U32 i;
+
+        for (i = 0; i < src_impl->chunk_nb; i++)
+            chunk_len += src_impl->chunks[i].length;
+
+        length += chunk_len;
         /*
          * due to parser may be read 32 bit interface so we must alloc more size
          * then real size to avoid read carsh
@@ -160,7 +172,7 @@ MPP_RET mpp_packet_copy_init(MppPacket *packet, const MppPacket src)
         void *pos = mpp_malloc_size(void, length + 256);
 
         if (!pos) {
-            mpp_err_f("malloc failed, size %d\n", length);
+            mpp_err_f("malloc failed, size %zu\n", length);
             mpp_packet_deinit(&pkt);
             return MPP_ERR_MALLOC;
         }
@@ -169,9 +181,20 @@ MPP_RET mpp_packet_copy_init(MppPacket *packet, const MppPacket src)
         p->data = p->pos = pos;
         p->size = p->length = length;
         p->flag |= MPP_PACKET_FLAG_INTERNAL;
+        p->chunk_nb = 0;
 
         if (length) {
-            memcpy(pos, src_impl->pos, length);
+            RK_U8 *dst = (RK_U8 *)pos;
+
+            for (i = 0; i < src_impl->chunk_nb; i++) {
+                MppPktChunk *chunk = &src_impl->chunks[i];
+
+                memcpy(dst, (RK_U8 *)mpp_buffer_get_ptr(chunk->buffer) + chunk->offset,
+                       chunk->length);
+                dst += chunk->length;
+            }
+
+            memcpy(dst, src_impl->pos, length - chunk_len);
             /*
              * clean more alloc byte to zero
              */
@@ -198,6 +221,8 @@ MPP_RET mpp_packet_deinit(MppPacket *packet)
     if (p->buffer)
         mpp_buffer_put(p->buffer);
 
+    mpp_packet_reset_chunk(p);
+
     if (p->flag & MPP_PACKET_FLAG_INTERNAL)
         mpp_free(p->data);
 
@@ -305,6 +330,7 @@ MPP_RET mpp_packet_reset(MppPacketImpl *packet)
     data = packet->data;
     size = packet->size;
 
+    mpp_packet_reset_chunk(packet);
     memset(packet, 0, sizeof(*packet));
 
     packet->data = data;
@@ -420,6 +446,28 @@ RK_U32 mpp_packet_is_eoi(const MppPacket packet)
     return (p->status.eoi) || (p->flag & MPP_PACKET_FLAG_EOI);
 }
 
+MPP_RET mpp_packet_set_eoi(MppPacket packet)
+{
+    MppPacketImpl *p = (MppPacketImpl *)packet;
+
+    if (check_is_mpp_packet(p))
+        return MPP_ERR_UNKNOW;
+
+    p->flag |= MPP_PACKET_FLAG_EOI;
+    return MPP_OK;
+}
+
+MPP_RET mpp_packet_clr_eoi(MppPacket packet)
+{
+    MppPacketImpl *p = (MppPacketImpl *)packet;
+
+    if (check_is_mpp_packet(p))
+        return MPP_ERR_UNKNOW;
+
+    p->flag &= ~MPP_PACKET_FLAG_EOI;
+    return MPP_OK;
+}
+
 MPP_RET mpp_packet_read(MppPacket packet, size_t offset, void *data, size_t size)
 {
     void *src;
@@ -651,6 +699,135 @@ const MppPktSeg *mpp_packet_get_segment_info(const MppPacket packet)
     return (const MppPktSeg *)p->segments;
 }
 
+MPP_RET mpp_packet_add_chunk(MppPacket packet, MppBuffer buffer, size_t offset, size_t length)
+{
+    MppPacketImpl *p = (MppPacketImpl *)packet;
+    MppPktChunk *chunk;
+
+    if (check_is_mpp_packet(p) || !buffer)
+        return MPP_ERR_NULL_PTR;
+
+    if (p->chunk_nb >= MPP_PKT_CHUNK_CNT_MAX) {
+        mpp_err_f("packet %p chunk count reach max %d\n", p, MPP_PKT_CHUNK_CNT_MAX);
+        return MPP_NOK;
+    }
+
+    if (offset + length > mpp_buffer_get_size(buffer)) {
+        mpp_err_f("chunk offset %zu length %zu exceed buffer size %zu\n",
+                  offset, length, mpp_buffer_get_size(buffer));
+        return MPP_ERR_VALUE;
+    }
+
+    mpp_buffer_inc_ref(buffer);
+
+    chunk = &p->chunks[p->chunk_nb++];
+    chunk->buffer = buffer;
+    chunk->offset = offset;
+    chunk->length = length;
+
+    return MPP_OK;
+}
+
+void mpp_packet_reset_chunk(MppPacket packet)
+{
+    MppPacketImpl *p = (MppPacketImpl *)packet;
+    RK_U32 i;
+
+    for (i = 0; i < p->chunk_nb; i++) {
+        mpp_buffer_put(p->chunks[i].buffer);
+        p->chunks[i].buffer = NULL;
+    }
+
+    p->chunk_nb = 0;
+}
+
+RK_U32 mpp_packet_get_iov_nb(const MppPacket packet)
+{
+    MppPacketImpl *p = (MppPacketImpl *)packet;
+
+    if (check_is_mpp_packet(p))
+        return 0;
+
+    return p->chunk_nb + 1;
+}
+
+RK_U32 mpp_packet_get_iov(const MppPacket packet, MppPacketIov *iov, RK_U32 max)
+{
+    MppPacketImpl *p = (MppPacketImpl *)packet;
+    RK_U32 cnt = 0;
+    RK_U32 i;
+
+    if (check_is_mpp_packet(p) || !iov)
+        return 0;
+
+    for (i = 0; i < p->chunk_nb && cnt < max; i++, cnt++) {
+        MppPktChunk *chunk = &p->chunks[i];
+
+        iov[cnt].base = (RK_U8 *)mpp_buffer_get_ptr(chunk->buffer) + chunk->offset;
+        iov[cnt].len = chunk->length;
+    }
+
+    if (cnt < max) {
+        iov[cnt].base = p->pos;
+        iov[cnt].len = p->length;
+        cnt++;
+    }
+
+    return cnt;
+}
+
+MPP_RET mpp_packet_flatten(MppPacket packet)
+{
+    MppPacketImpl *p = (MppPacketImpl *)packet;
+    size_t chunk_len = 0;
+    size_t head;
+    RK_U8 *dst;
+    RK_U32 i;
+
+    if (check_is_mpp_packet(p))
+        return MPP_ERR_UNKNOW;
+
+    if (!p->chunk_nb)
+        return MPP_OK;
+
+    for (i = 0; i < p->chunk_nb; i++)
+        chunk_len += p->chunks[i].length;
+
+    head = (RK_U8 *)p->pos - (RK_U8 *)p->data;
+    if (head < chunk_len) {
+        size_t shift = chunk_len - head;
+
+        if (head + shift + p->length > p->size) {
+            mpp_err_f("packet size %zu is not enough for data %zu and chunks %zu\n",
+                      p->size, p->length, chunk_len);
+            return MPP_NOK;
+        }
+
+        memmove((RK_U8 *)p->pos + shift, p->pos, p->length);
+        p->pos = (RK_U8 *)p->pos + shift;
+    }
+
+    dst = (RK_U8 *)p->pos - chunk_len;
+    p->pos = dst;
+    p->length += chunk_len;
+
+    for (i = 0; i < p->chunk_nb; i++) {
+        MppPktChunk *chunk = &p->chunks[i];
+
+        memcpy(dst, (RK_U8 *)mpp_buffer_get_ptr(chunk->buffer) + chunk->offset,
+               chunk->length);
+        dst += chunk->length;
+    }
+
+    /* segment offset is relative to pos */
+    for (i = 0; i < p->segment_nb; i++)
+        p->segments[i].offset += chunk_len;
+
+    mpp_packet_reset_chunk(p);
+
+    return MPP_OK;
+}
+
 void mpp_packet_set_release(MppPacket packet, ReleaseCb release, void *ctx, void *arg)
 {
     MppPacketImpl *p = (MppPacketImpl *)packet;
@@ -578,6 +578,48 @@ MPP_CFG_GET_ACCESS(mpp_sys_cfg_get_u64, RK_U64, u64);
 MPP_CFG_GET_ACCESS(mpp_sys_cfg_get_ptr, void *, ptr);
 MPP_CFG_GET_ACCESS(mpp_sys_cfg_get_st,  void  , st);
 
+MPP_RET mpp_sys_cfg_get_key(const char *name, MppCfgKey *key)
+{
+    return mpp_cfg_get_key(mpp_sys_cfg_def, name, key);
+}
+
+#define MPP_CFG_SET_KEY_ACCESS(func_name, in_type, cfg_type) \
+    MPP_RET func_name(MppSysCfg cfg, MppCfgKey key, in_type val) \
+    { \
+        KmppEntry *entry = CHECK_CFG_KEY(mpp_sys_cfg_def, cfg, key, ELEM_TYPE_##cfg_type); \
+        if (!entry) \
+            return rk_nok; \
+        if (!entry->tbl.flag_offset) { \
+            mpp_loge_f("can not set readonly cfg by key\n"); \
+            return rk_nok; \
+        } \
+        return kmpp_obj_tbl_set_##cfg_type(cfg, entry, val); \
+    }
+
+MPP_CFG_SET_KEY_ACCESS(mpp_sys_cfg_set_s32_by_key, RK_S32, s32);
+MPP_CFG_SET_KEY_ACCESS(mpp_sys_cfg_set_u32_by_key, RK_U32, u32);
+MPP_CFG_SET_KEY_ACCESS(mpp_sys_cfg_set_s64_by_key, RK_S64, s64);
+MPP_CFG_SET_KEY_ACCESS(mpp_sys_cfg_set_u64_by_key, RK_U64, u64);
+
+#define MPP_CFG_GET_KEY_ACCESS(func_name, in_type, cfg_type) \
+    MPP_RET func_name(MppSysCfg cfg, MppCfgKey key, in_type *val) \
+    { \
+        KmppEntry *entry = CHECK_CFG_KEY(mpp_sys_cfg_def, cfg, key, ELEM_TYPE_##cfg_type); \
+        if (!entry) \
+            return rk_nok; \
+        return kmpp_obj_tbl_get_##cfg_type(cfg, entry, val); \
+    }
+
+MPP_CFG_GET_KEY_ACCESS(mpp_sys_cfg_get_s32_by_key, RK_S32, s32);
+MPP_CFG_GET_KEY_ACCESS(mpp_sys_cfg_get_u32_by_key, RK_U32, u32);
+MPP_CFG_GET_KEY_ACCESS(mpp_sys_cfg_get_s64_by_key, RK_S64, s64);
+MPP_CFG_GET_KEY_ACCESS(mpp_sys_cfg_get_u64_by_key, RK_U64, u64);
+
+MPP_RET mpp_sys_cfg_set_kv(MppSysCfg cfg, const MppCfgKeyVal *kv, RK_S32 count)
+{
+    return mpp_cfg_set_kv(mpp_sys_cfg_def, cfg, kv, count, 1, __FUNCTION__);
+}
+
 void mpp_sys_cfg_show(void)
 {
     MppTrie *trie = kmpp_objdef_get_trie(mpp_sys_cfg_def);
@@ -0,0 +1,211 @@
+/* SPDX-License-Identifier: Apache-2.0 OR MIT */
+/*
+ * Copyright (c) 2026 Rockchip Electronics Co., Ltd.
+ */
+
+#define MODULE_TAG "mpp_bit_move_test"
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "mpp_log.h"
+#include "mpp_time.h"
+#include "mpp_common.h"
+#include "mpp_bitwrite.h"
+
+#define BIT_MOVE_CHECK_SIZE     (64 * 1024)
+#define BIT_MOVE_BENCH_SIZE     (4 * 1024 * 1024)
+#define BIT_MOVE_BENCH_LOOP     8
+/* room for emulation prevention bytes and over read on the tail */
+#define BIT_MOVE_BUF_SIZE(n)    ((n) * 3 / 2 + 64)
+
+/* byte by byte reference which is the original h264e_slice_move */
+static RK_S32 bit_move_ref(RK_U8 *dst, RK_U8 *src, RK_S32 dst_bit, RK_S32 src_bit, RK_S32 src_size)
+{
+    RK_S32 dst_bit_r = dst_bit & 7;
+    RK_S32 src_bit_r = src_bit & 7;
+    RK_S32 src_len = src_size - src_bit / 8;
+    RK_U8 *psrc = src + src_bit / 8;
+    RK_U8 *pdst = dst + dst_bit / 8;
+    RK_U16 tmp16a, tmp16b, tmp16c, last_tmp, dst_mask;
+    RK_U8 tmp0, tmp1;
+    RK_U32 loop = src_len + (src_bit_r > 0);
+    RK_U32 src_zero_cnt = 0;
+    RK_U32 dst_zero_cnt = 0;
+    RK_S32 diff_len = 0;
+    RK_U32 i;
+
+    if (!src_bit_r && !dst_bit_r) {
+        memcpy(pdst, psrc, src_len);
+        return 0;
+    }
+
+    last_tmp = (RK_U16)pdst[0];
+    dst_mask = 0xFFFF << (8 - dst_bit_r);
+
+    for (i = 0; i < loop; i++) {
+        if (psrc[0] == 0)
+            src_zero_cnt++;
+        else
+            src_zero_cnt = 0;
+
+        tmp0 = psrc[0];
+        tmp1 = (i < loop - 1) ? psrc[1] : 0;
+
+        if (src_zero_cnt >= 2 && tmp1 == 3) {
+            psrc++;
+            i++;
+            tmp1 = psrc[1];
+            src_zero_cnt = 0;
+            diff_len--;
+        }
+
+        tmp16a = ((RK_U16)tmp0 << 8) | (RK_U16)tmp1;
+        tmp16b = src_bit_r ? tmp16a << src_bit_r : tmp16a;
+        tmp16c = dst_bit_r ? tmp16b >> dst_bit_r | ((last_tmp << 8) & dst_mask) : tmp16b;
+
+        pdst[0] = (tmp16c >> 8) & 0xFF;
+        pdst[1] = tmp16c & 0xFF;
+
+        if (dst_zero_cnt == 2 && pdst[0] <= 0x3) {
+            pdst[2] = pdst[1];
+            pdst[1] = pdst[0];
+            pdst[0] = 0x3;
+            pdst++;
+            diff_len++;
+            dst_zero_cnt = 0;
+        }
+
+        if (pdst[0] == 0)
+            dst_zero_cnt++;
+        else
+            dst_zero_cnt = 0;
+
+        last_tmp = tmp16c;
+        psrc++;
+        pdst++;
+    }
+
+    return diff_len;
+}
+
+/* random payload with emulation prevention, one zero byte per zero_rate bytes */
+static RK_S32 bit_move_gen(RK_U8 *buf, RK_S32 size, RK_S32 zero_rate)
+{
+    RK_S32 zero_cnt = 0;
+    RK_S32 len = 0;
+
+    while (len < size) {
+        RK_U8 val = (rand() % zero_rate) ? (RK_U8)(rand() & 0xFF) : 0;
+
+        if (zero_cnt >= 2 && val <= 3) {
+            buf[len++] = 3;
+            zero_cnt = 0;
+            if (len >= size)
+                break;
+        }
+
+        buf[len++] = val;
+        zero_cnt = val ? 0 : zero_cnt + 1;
+    }
+
+    /* rbsp trailing bit */
+    buf[size - 1] = 0x80;
+
+    return size;
+}
+
+static MPP_RET bit_move_check(RK_U8 *src, RK_U8 *dst0, RK_U8 *dst1, RK_S32 size)
+{
+    RK_S32 buf_size = BIT_MOVE_BUF_SIZE(size);
+    RK_S32 dst_bit;
+    RK_S32 src_bit;
+
+    for (src_bit = 0; src_bit < 24; src_bit++) {
+        for (dst_bit = 0; dst_bit < 24; dst_bit++) {
+            RK_S32 ret0, ret1;
+
+            memset(dst0, 0x5a, buf_size);
+            memset(dst1, 0x5a, buf_size);
+
+            ret0 = bit_move_ref(dst0, src, dst_bit, src_bit, size);
+            ret1 = mpp_writer_move(dst1, src, dst_bit, src_bit, size);
+
+            if (ret0 != ret1 || memcmp(dst0, dst1, buf_size)) {
+                mpp_err("mismatch on src bit %d dst bit %d diff %d vs %d\n",
+                        src_bit, dst_bit, ret0, ret1);
+                return MPP_NOK;
+            }
+        }
+    }
+
+    return MPP_OK;
+}
+
+static void bit_move_bench(RK_U8 *src, RK_U8 *dst, RK_S32 size)
+{
+    RK_S64 time_ref;
+    RK_S64 time_new;
+    RK_S64 start;
+    RK_S32 i;
+
+    start = mpp_time();
+    for (i = 0; i < BIT_MOVE_BENCH_LOOP; i++)
+        bit_move_ref(dst, src, 13, 35, size);
+    time_ref = mpp_time() - start;
+
+    start = mpp_time();
+    for (i = 0; i < BIT_MOVE_BENCH_LOOP; i++)
+        mpp_writer_move(dst, src, 13, 35, size);
+    time_new = mpp_time() - start;
+
+    time_ref = MPP_MAX(time_ref, 1);
+    time_new = MPP_MAX(time_new, 1);
+
+    mpp_log("move %d KB x %d byte loop %lld us word loop %lld us speedup %.2f\n",
+            size / 1024, BIT_MOVE_BENCH_LOOP, time_ref, time_new,
+            (float)time_ref / time_new);
+}
+
+int main(void)
+{
+    RK_S32 buf_size = BIT_MOVE_BUF_SIZE(BIT_MOVE_BENCH_SIZE);
+    RK_U8 *src = calloc(1, buf_size);
+    RK_U8 *dst0 = calloc(1, buf_size);
+    RK_U8 *dst1 = calloc(1, buf_size);
+    /* dense zero to stress emulation prevention and sparse zero like cavlc data */
+    static const RK_S32 zero_rates[] = { 2, 4, 64, 256 };
+    MPP_RET ret = MPP_NOK;
+    RK_U32 i;
+
+    mpp_log("mpp_bit_move_test start\n");
+
+    if (!src || !dst0 || !dst1) {
+        mpp_err("malloc failed\n");
+        goto DONE;
+    }
+
+    srand(0x264);
+
+    for (i = 0; i < MPP_ARRAY_ELEMS(zero_rates); i++) {
+        bit_move_gen(src, BIT_MOVE_CHECK_SIZE, zero_rates[i]);
+
+        if (bit_move_check(src, dst0, dst1, BIT_MOVE_CHECK_SIZE)) {
+            mpp_err("check failed with zero rate %d\n", zero_rates[i]);
+            goto DONE;
+        }
+    }
+
+    bit_move_gen(src, BIT_MOVE_BENCH_SIZE, 256);
+    bit_move_bench(src, dst0, BIT_MOVE_BENCH_SIZE);
+
+    ret = MPP_OK;
+DONE:
+    free(src);
+    free(dst0);
+    free(dst1);
+
+    mpp_log("mpp_bit_move_test %s\n", ret ? "failed" : "success");
+
+    return ret;
+}
@@ -30,6 +30,11 @@ int main(void)
     MppDecCfg cfg;
     RK_S64 end = 0;
     RK_S64 start = 0;
+    RK_U32 fast_out = 1;
+    RK_U32 split_parse = 0;
+    MppCfgKey key_fast_out;
+    MppCfgKey key_split_parse;
+    MppCfgKeyVal kv[2];
 
     mpp_dec_cfg_show();
 
@@ -41,19 +46,57 @@ int main(void)
         goto DONE;
     }
 
-    RK_S32 fast_out = 1;
-
-    MppDecCfgSet *impl = (MppDecCfgSet *)cfg;
-
-    mpp_log("before set: fast_out %d\n", impl->base.fast_out);
-
     start = mpp_time();
     ret = mpp_dec_cfg_set_u32(cfg, "base:fast_out", fast_out);
     end = mpp_time();
     mpp_log("set u32 time %lld us\n", end - start);
 
+    ret = mpp_dec_cfg_get_u32(cfg, "base:fast_out", &fast_out);
     mpp_log("after  get: fast_out %d\n", fast_out);
 
+    ret = mpp_dec_cfg_get_key("base:fast_out", &key_fast_out);
+    ret |= mpp_dec_cfg_get_key("base:split_parse", &key_split_parse);
+    if (ret) {
+        mpp_err("mpp_dec_cfg_get_key failed\n");
+        goto DONE;
+    }
+
+    kv[0].key = key_fast_out;
+    kv[0].val = 0;
+    kv[1].key = key_split_parse;
+    kv[1].val = 1;
+
+    start = mpp_time();
+    ret = mpp_dec_cfg_set_kv(cfg, kv, MPP_ARRAY_ELEMS(kv));
+    end = mpp_time();
+    mpp_log("set kv time %lld us\n", end - start);
+
+    ret |= mpp_dec_cfg_get_u32_by_key(cfg, key_fast_out, &fast_out);
+    ret |= mpp_dec_cfg_get_u32_by_key(cfg, key_split_parse, &split_parse);
+    mpp_log("after  kv : fast_out %d split_parse %d\n", fast_out, split_parse);
+    if (ret || fast_out != 0 || split_parse != 1) {
+        mpp_err("mpp_dec_cfg_set_kv failed\n");
+        ret = MPP_NOK;
+        goto DONE;
+    }
+
+    /* negative value does not fit u32 and nothing should be set */
+    kv[0].val = 1;
+    kv[1].val = -1;
+    if (!mpp_dec_cfg_set_kv(cfg, kv, MPP_ARRAY_ELEMS(kv))) {
+        mpp_err("mpp_dec_cfg_set_kv with u32 underflow should fail\n");
+        ret = MPP_NOK;
+        goto DONE;
+    }
+
+    ret = mpp_dec_cfg_get_u32_by_key(cfg, key_fast_out, &fast_out);
+    ret |= mpp_dec_cfg_get_u32_by_key(cfg, key_split_parse, &split_parse);
+    if (ret || fast_out != 0 || split_parse != 1) {
+        mpp_err("mpp_dec_cfg_set_kv applied part of invalid pairs\n");
+        ret = MPP_NOK;
+        goto DONE;
+    }
+
     ret = mpp_dec_cfg_deinit(cfg);
     if (ret) {
         mpp_err("mpp_dec_cfg_deinit failed\n");
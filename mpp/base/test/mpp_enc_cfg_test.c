@@ -10,6 +10,7 @@
 #include "mpp_time.h"
 #include "mpp_common.h"
 
+#include "rk_vdec_cfg.h"
 #include "rk_venc_cfg.h"
 #include "mpp_enc_cfg.h"
 
@@ -19,17 +20,6 @@ int main(void)
     MppEncCfg cfg;
     RK_S64 end = 0;
     RK_S64 start = 0;
-
-    mpp_enc_cfg_show();
-
-    mpp_log("mpp_enc_cfg_test start\n");
-
-    ret = mpp_enc_cfg_init(&cfg);
-    if (ret) {
-        mpp_err("mpp_enc_cfg_init failed\n");
-        goto DONE;
-    }
-
     RK_S32 rc_mode = 1;
     RK_S32 bps_target = 400000;
     RK_S32 aq_thrd_i[16] = {
@@ -38,15 +28,30 @@ int main(void)
         8,  8,  8,  15,
         15, 20, 25, 35
     };
-
     RK_S32 aq_thrd_i_ret[16] = {
         -1, -1, -1, -1,
         -1, -1, -1, -1,
         -1, -1, -1, -1,
         -1, -1, -1, -1,
     };
+    MppEncCfgSet *impl = NULL;
+    MppCfgKey key_mode;
+    MppCfgKey key_bps;
+    MppCfgKey key_aq;
+    MppCfgKey key_dec;
+    MppCfgKeyVal kv[2];
+
+    mpp_enc_cfg_show();
+
+    mpp_log("mpp_enc_cfg_test start\n");
+
+    ret = mpp_enc_cfg_init(&cfg);
+    if (ret) {
+        mpp_err("mpp_enc_cfg_init failed\n");
+        goto DONE;
+    }
 
-    MppEncCfgSet *impl = (MppEncCfgSet *)kmpp_obj_to_entry(cfg);
+    impl = (MppEncCfgSet *)kmpp_obj_to_entry(cfg);
 
     mpp_log("before set: rc mode %d bps_target %d\n",
             impl->rc.rc_mode, impl->rc.bps_target);
@@ -86,6 +91,68 @@ int main(void)
             aq_thrd_i_ret[8], aq_thrd_i_ret[9], aq_thrd_i_ret[10], aq_thrd_i_ret[11],
             aq_thrd_i_ret[12], aq_thrd_i_ret[13], aq_thrd_i_ret[14], aq_thrd_i_ret[15]);
 
+    ret = mpp_enc_cfg_get_key("rc:mode", &key_mode);
+    ret |= mpp_enc_cfg_get_key("rc:bps_target", &key_bps);
+    ret |= mpp_enc_cfg_get_key("hw:aq_step_i", &key_aq);
+    ret |= mpp_dec_cfg_get_key("base:fast_out", &key_dec);
+    if (ret) {
+        mpp_err("mpp_enc_cfg_get_key failed\n");
+        goto DONE;
+    }
+
+    kv[0].key = key_mode;
+    kv[0].val = 2;
+    kv[1].key = key_bps;
+    kv[1].val = 800000;
+
+    start = mpp_time();
+    ret = mpp_enc_cfg_set_kv(cfg, kv, MPP_ARRAY_ELEMS(kv));
+    end = mpp_time();
+    mpp_log("set kv time %lld us\n", end - start);
+
+    ret |= mpp_enc_cfg_get_s32_by_key(cfg, key_mode, &rc_mode);
+    ret |= mpp_enc_cfg_get_s32_by_key(cfg, key_bps, &bps_target);
+    mpp_log("after  kv : rc mode %d bps_target %d\n", rc_mode, bps_target);
+    if (ret || rc_mode != 2 || bps_target != 800000) {
+        mpp_err("mpp_enc_cfg_set_kv failed\n");
+        ret = MPP_NOK;
+        goto DONE;
+    }
+
+    /* the valid first pair must not be set when the second one is invalid */
+    kv[0].val = 1;
+    kv[1].key = key_dec;
+    kv[1].val = 1;
+    if (!mpp_enc_cfg_set_kv(cfg, kv, MPP_ARRAY_ELEMS(kv))) {
+        mpp_err("mpp_enc_cfg_set_kv with decoder key should fail\n");
+        ret = MPP_NOK;
+        goto DONE;
+    }
+
+    kv[1].key = key_aq;
+    if (!mpp_enc_cfg_set_kv(cfg, kv, MPP_ARRAY_ELEMS(kv))) {
+        mpp_err("mpp_enc_cfg_set_kv with struct key should fail\n");
+        ret = MPP_NOK;
+        goto DONE;
+    }
+
+    kv[1].key = key_bps;
+    kv[1].val = (RK_S64)1 << 32;
+    if (!mpp_enc_cfg_set_kv(cfg, kv, MPP_ARRAY_ELEMS(kv))) {
+        mpp_err("mpp_enc_cfg_set_kv with s32 overflow should fail\n");
+        ret = MPP_NOK;
+        goto DONE;
+    }
+
+    ret = mpp_enc_cfg_get_s32_by_key(cfg, key_mode, &rc_mode);
+    ret |= mpp_enc_cfg_get_s32_by_key(cfg, key_bps, &bps_target);
+    mpp_log("after  bad kv : rc mode %d bps_target %d\n", rc_mode, bps_target);
+    if (ret || rc_mode != 2 || bps_target != 800000) {
+        mpp_err("mpp_enc_cfg_set_kv applied part of invalid pairs\n");
+        ret = MPP_NOK;
+        goto DONE;
+    }
+
     ret = mpp_enc_cfg_deinit(cfg);
     if (ret) {
         mpp_err("mpp_enc_cfg_deinit failed\n");
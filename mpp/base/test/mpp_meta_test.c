@@ -6,6 +6,8 @@
 #define MODULE_TAG "mpp_meta_test"
 
 #include <pthread.h>
+#include <stddef.h>
+#include <string.h>
 
 #include "mpp_time.h"
 #include "mpp_debug.h"
@@ -16,8 +18,14 @@
 
 static MPP_RET meta_set(MppMeta meta)
 {
+    MppEncFrmStats stats;
     MPP_RET ret = MPP_OK;
 
+    memset(&stats, 0, sizeof(stats));
+    stats.size = sizeof(stats);
+    stats.version = MPP_ENC_FRM_STATS_VERSION;
+    stats.bits = 1000;
+
     ret |= mpp_meta_set_frame(meta,  KEY_INPUT_FRAME, NULL);
     ret |= mpp_meta_set_packet(meta, KEY_INPUT_PACKET, NULL);
     ret |= mpp_meta_set_frame(meta,  KEY_OUTPUT_FRAME, NULL);
@@ -48,6 +56,7 @@ static MPP_RET meta_set(MppMeta meta)
     ret |= mpp_meta_set_s32(meta, KEY_ENC_USE_LTR, 0);
     ret |= mpp_meta_set_s32(meta, KEY_ENC_FRAME_QP, 0);
     ret |= mpp_meta_set_s32(meta, KEY_ENC_BASE_LAYER_PID, 0);
+    ret |= mpp_meta_set_ptr(meta, KEY_ENC_FRM_STATS, &stats);
 
     return ret;
 }
@@ -92,9 +101,40 @@ static MPP_RET meta_get(MppMeta meta)
     ret |= mpp_meta_get_s32(meta, KEY_ENC_FRAME_QP, &val);
     ret |= mpp_meta_get_s32(meta, KEY_ENC_BASE_LAYER_PID, &val);
 
+    ret |= mpp_meta_get_ptr(meta, KEY_ENC_FRM_STATS, &ptr);
+    if (!ptr || ((MppEncFrmStats *)ptr)->bits != 1000)
+        ret = MPP_NOK;
+
     return ret;
 }
 
+/* enc stats from an older writer keeps its size and short one is rejected */
+static MPP_RET meta_enc_stats_test(MppMeta meta)
+{
+    MppEncFrmStats stats;
+    MppEncFrmStats *dst = NULL;
+    RK_U32 size = offsetof(MppEncFrmStats, hw_time);
+    void *ptr = NULL;
+
+    memset(&stats, 0, sizeof(stats));
+    stats.size = size;
+    stats.bits = 2000;
+    stats.hw_time = 1;
+    if (mpp_meta_set_ptr(meta, KEY_ENC_FRM_STATS, &stats) ||
+        mpp_meta_get_ptr(meta, KEY_ENC_FRM_STATS, &ptr))
+        return MPP_NOK;
+
+    dst = (MppEncFrmStats *)ptr;
+    if (dst->size != size || dst->bits != 2000 || dst->hw_time)
+        return MPP_NOK;
+
+    stats.size = offsetof(MppEncFrmStats, motion_level);
+    if (!mpp_meta_set_ptr(meta, KEY_ENC_FRM_STATS, &stats))
+        return MPP_NOK;
+
+    return MPP_OK;
+}
+
 void *meta_test(void *param)
 {
     RK_S32 loop_max = LOOP_MAX;
@@ -137,6 +177,7 @@ int main(void)
     RK_S64 avg_time = 0;
     pthread_attr_t attr;
     MppMeta meta = NULL;
+    MPP_RET ret = MPP_OK;
     RK_S32 i;
 
     pthread_attr_init(&attr);
@@ -148,9 +189,15 @@ int main(void)
     if (meta) {
         meta_set(meta);
         mpp_meta_dump(meta);
+        ret = meta_enc_stats_test(meta);
         mpp_meta_put(meta);
     }
 
+    if (ret) {
+        mpp_err("mpp_meta_test enc stats size check failed\n");
+        return ret;
+    }
+
     for (i = 0; i < thd_cnt; i++)
         pthread_create(&thds[i], &attr, meta_test, &times[i]);
 
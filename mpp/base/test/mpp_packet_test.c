@@ -17,12 +17,109 @@
 #define MODULE_TAG "mpp_packet_test"
 
 #include <stdlib.h>
+#include <string.h>
 
 #include "mpp_log.h"
-#include "mpp_packet.h"
+#include "mpp_common.h"
+#include "mpp_packet_impl.h"
 
 #define MPP_PACKET_TEST_SIZE    1024
 
+static const char test_hdr[] = "header";
+static const char test_dat[] = "payload";
+
+static MPP_RET mpp_packet_test_chunk(void)
+{
+    MPP_RET ret = MPP_NOK;
+    MppBufferGroup group = NULL;
+    MppBufferInfo info;
+    RK_U8 *mem = NULL;
+    MppBuffer hdr = NULL;
+    MppBuffer buf = NULL;
+    MppPacket packet = NULL;
+    MppPacket copy = NULL;
+    MppPacketIov iov[MPP_PKT_CHUNK_CNT_MAX + 1];
+    size_t hdr_len = strlen(test_hdr);
+    size_t dat_len = strlen(test_dat);
+    RK_U32 cnt;
+
+    mem = malloc(MPP_PACKET_TEST_SIZE * 2);
+    if (!mem) {
+        mpp_err("mpp_packet_test malloc failed\n");
+        goto DONE;
+    }
+
+    memset(&info, 0, sizeof(info));
+    info.type = MPP_BUFFER_TYPE_NORMAL;
+    info.size = MPP_PACKET_TEST_SIZE;
+    info.ptr = mem;
+    info.fd = -1;
+
+    /* commit external memory to avoid dependence on platform allocator */
+    mpp_buffer_group_get_external(&group, MPP_BUFFER_TYPE_NORMAL);
+    mpp_buffer_commit(group, &info);
+    info.ptr = mem + MPP_PACKET_TEST_SIZE;
+    mpp_buffer_commit(group, &info);
+    mpp_buffer_get(group, &hdr, hdr_len);
+    mpp_buffer_get(group, &buf, MPP_PACKET_TEST_SIZE);
+    if (!hdr || !buf) {
+        mpp_err("mpp_packet_test import buffer failed\n");
+        goto DONE;
+    }
+
+    mpp_buffer_write(hdr, 0, (void *)test_hdr, hdr_len);
+    mpp_packet_init_with_buffer(&packet, buf);
+    mpp_packet_write(packet, 0, (void *)test_dat, dat_len);
+    mpp_packet_set_length(packet, dat_len);
+    mpp_packet_add_chunk(packet, hdr, 0, hdr_len);
+
+    /* chunk is output ahead of packet data without copy */
+    cnt = mpp_packet_get_iov(packet, iov, MPP_ARRAY_ELEMS(iov));
+    if (cnt != 2 || mpp_packet_get_iov_nb(packet) != 2 ||
+        iov[0].base != mpp_buffer_get_ptr(hdr) || iov[0].len != hdr_len ||
+        iov[1].base != mpp_buffer_get_ptr(buf) || iov[1].len != dat_len) {
+        mpp_err("mpp_packet_test get iov failed\n");
+        goto DONE;
+    }
+
+    /* copy without buffer flattens the chunks */
+    mpp_packet_set_buffer(packet, NULL);
+    mpp_packet_copy_init(&copy, packet);
+    mpp_packet_set_buffer(packet, buf);
+    if (!copy || mpp_packet_get_iov_nb(copy) != 1 ||
+        mpp_packet_get_length(copy) != hdr_len + dat_len ||
+        memcmp(mpp_packet_get_pos(copy), test_hdr, hdr_len)) {
+        mpp_err("mpp_packet_test copy chunk failed\n");
+        goto DONE;
+    }
+
+    /* no room before data then data is moved behind the chunk */
+    if (mpp_packet_flatten(packet) || mpp_packet_get_iov_nb(packet) != 1 ||
+        mpp_packet_get_length(packet) != hdr_len + dat_len ||
+        memcmp(mpp_packet_get_pos(packet), test_hdr, hdr_len) ||
+        memcmp((char *)mpp_packet_get_pos(packet) + hdr_len, test_dat, dat_len)) {
+        mpp_err("mpp_packet_test flatten failed\n");
+        goto DONE;
+    }
+
+    ret = MPP_OK;
+DONE:
+    if (copy)
+        mpp_packet_deinit(&copy);
+    if (packet)
+        mpp_packet_deinit(&packet);
+    if (hdr)
+        mpp_buffer_put(hdr);
+    if (buf)
+        mpp_buffer_put(buf);
+    if (group)
+        mpp_buffer_group_put(group);
+    if (mem)
+        free(mem);
+
+    return ret;
+}
+
 int main(void)
 {
     MPP_RET ret = MPP_ERR_UNKNOW;
@@ -50,6 +147,12 @@ int main(void)
     }
     mpp_packet_deinit(&packet);
 
+    ret = mpp_packet_test_chunk();
+    if (MPP_OK != ret) {
+        mpp_err("mpp_packet_test chunk failed\n");
+        goto MPP_PACKET_failed;
+    }
+
     free(data);
     mpp_log("mpp_packet_test success\n");
     return ret;
@@ -28,6 +28,11 @@ int main(void)
     RK_U32 size_total;
     RK_U32 size_fbc_hdr;
     RK_U32 size_fbc_bdy;
+    RK_U32 val = 0;
+    MppCfgKey key_width;
+    MppCfgKey key_height;
+    MppCfgKey key_cap_fbc;
+    MppCfgKeyVal kv[2];
 
     mpp_sys_cfg_show();
 
@@ -59,6 +64,42 @@ int main(void)
         goto DONE;
     }
 
+    /* readonly key in batch fails and the width before it is not set */
+    ret = mpp_sys_cfg_get_key("dec_buf_chk:width", &key_width);
+    ret |= mpp_sys_cfg_get_key("dec_buf_chk:height", &key_height);
+    ret |= mpp_sys_cfg_get_key("dec_buf_chk:cap_fbc", &key_cap_fbc);
+    if (ret) {
+        mpp_log("mpp_sys_cfg_get_key failed\n");
+        goto DONE;
+    }
+
+    kv[0].key = key_width;
+    kv[0].val = width / 2;
+    kv[1].key = key_cap_fbc;
+    kv[1].val = 1;
+    ret = mpp_sys_cfg_set_kv(cfg, kv, MPP_ARRAY_ELEMS(kv));
+    if (!ret) {
+        mpp_log("set_kv readonly success, should be a failure\n");
+        ret = MPP_NOK;
+        goto DONE;
+    }
+
+    ret = mpp_sys_cfg_get_u32_by_key(cfg, key_width, &val);
+    if (ret || val != width) {
+        mpp_log("set_kv failure changed width to %d\n", val);
+        ret = MPP_NOK;
+        goto DONE;
+    }
+
+    kv[0].val = width;
+    kv[1].key = key_height;
+    kv[1].val = height;
+    ret = mpp_sys_cfg_set_kv(cfg, kv, MPP_ARRAY_ELEMS(kv));
+    if (ret) {
+        mpp_log("mpp_sys_cfg_set_kv failed\n");
+        goto DONE;
+    }
+
     /* get result */
     mpp_sys_cfg_ioctl(cfg);
 
@@ -1757,9 +1757,7 @@ static MPP_RET read_uncompressed_header(Av1Codec *ctx, BitReadCtx_t *gb,
         f->primary_ref_frame == AV1_PRIMARY_REF_NONE) {
         // Init non-coeff CDFs.
         // Setup past independence.
-        ctx->cdfs = &ctx->default_cdfs;
-        ctx->cdfs_ndvc = &ctx->default_cdfs_ndvc;
-        av1d_set_default_coeff_probs(f->base_q_idx, ctx->cdfs);
+        av1d_set_cur_cdfs(ctx, av1d_get_default_cdfs(f->base_q_idx));
     } else {
         // Load CDF tables from previous frame.
         // Load params from previous frame.
@@ -563,6 +563,19 @@ typedef struct AV1FrameInfo_t {
     Av1RefInfo *ref;
 } AV1FrameIInfo;
 
+/*
+ * Refcounted immutable cdf context
+ * Reference slots share one snapshot and refresh only takes a reference.
+ * A snapshot is copied before write when it is shared. The default snapshots
+ * are built once per process and never freed.
+ */
+typedef struct Av1CdfSnap_t {
+    RK_S32 ref_count;
+    RK_U32 is_default;
+    AV1CDFs cdfs;
+    Av1MvCDFs cdfs_ndvc;
+} Av1CdfSnap;
+
 typedef struct Av1Codec_t {
     BitReadCtx_t gb;
 
@@ -608,12 +621,11 @@ typedef struct Av1Codec_t {
     RK_U32 fist_tile_group;
     RK_U32 tile_offset;
 
+    /* cdfs of current frame point to the read-only snapshot cdf_cur */
     AV1CDFs *cdfs;
     Av1MvCDFs  *cdfs_ndvc;
-    AV1CDFs default_cdfs;
-    Av1MvCDFs  default_cdfs_ndvc;
-    AV1CDFs cdfs_last[AV1_NUM_REF_FRAMES];
-    Av1MvCDFs  cdfs_last_ndvc[AV1_NUM_REF_FRAMES];
+    Av1CdfSnap *cdf_cur;
+    Av1CdfSnap *cdf_last[AV1_NUM_REF_FRAMES];
     RK_U8 disable_frame_end_update_cdf;
     RK_U8 frame_is_intra;
     RK_U8 refresh_frame_flags;
@@ -645,10 +657,13 @@ MPP_RET av1d_get_fragment_units(Av1UnitFragment *frag);
 MPP_RET av1d_read_fragment_uints(Av1Codec *ctx, Av1UnitFragment *frag);
 MPP_RET av1d_fragment_reset(Av1UnitFragment *frag);
 
+MPP_RET av1d_set_cur_cdfs(Av1Codec *ctx, Av1CdfSnap *snap);
 MPP_RET av1d_get_cdfs(Av1Codec *ctx, RK_U32 ref_idx);
 MPP_RET av1d_store_cdfs(Av1Codec *ctx, RK_U32 refresh_frame_flags);
+MPP_RET av1d_put_cdfs(Av1Codec *ctx);
 MPP_RET av1d_set_default_cdfs(AV1CDFs *cdfs, Av1MvCDFs *cdfs_ndvc);
 MPP_RET av1d_set_default_coeff_probs(RK_U32 base_qindex, AV1CDFs *cdfs);
+Av1CdfSnap *av1d_get_default_cdfs(RK_U32 base_qindex);
 
 #ifdef  __cplusplus
 }
@@ -4,6 +4,7 @@
  */
 
 #include <string.h>
+#include <pthread.h>
 
 #include "av1d_parser.h"
 
@@ -4385,3 +4386,32 @@ MPP_RET av1d_set_default_cdfs(AV1CDFs *cdfs, Av1MvCDFs *cdfs_ndvc)
 
     return MPP_OK;
 }
+
+static Av1CdfSnap av1d_default_snaps[AV1_TOKEN_CDF_Q_CTXS];
+static pthread_once_t av1d_default_snaps_once = PTHREAD_ONCE_INIT;
+
+static void av1d_init_default_snaps(void)
+{
+    /* the first base_qindex of each coeff cdf q context */
+    static const RK_U32 base_qindex[AV1_TOKEN_CDF_Q_CTXS] = { 0, 21, 61, 121 };
+    RK_U32 i;
+
+    for (i = 0; i < AV1_TOKEN_CDF_Q_CTXS; i++) {
+        Av1CdfSnap *snap = &av1d_default_snaps[i];
+
+        av1d_set_default_cdfs(&snap->cdfs, &snap->cdfs_ndvc);
+        av1d_set_default_coeff_probs(base_qindex[i], &snap->cdfs);
+        snap->is_default = 1;
+    }
+}
+
+Av1CdfSnap *av1d_get_default_cdfs(RK_U32 base_qindex)
+{
+    RK_S32 index = (base_qindex <= 20) ? 0 :
+                   (base_qindex <= 60) ? 1 :
+                   (base_qindex <= 120) ? 2 : 3;
+
+    pthread_once(&av1d_default_snaps_once, av1d_init_default_snaps);
+
+    return &av1d_default_snaps[index];
+}
@@ -10,6 +10,7 @@
 
 #include "mpp_env.h"
 #include "mpp_mem.h"
+#include "mpp_lock.h"
 #include "mpp_debug.h"
 #include "mpp_common.h"
 #include "mpp_compat_impl.h"
@@ -805,9 +806,7 @@ MPP_RET av1d_parser_init(Av1DecCtx *ctx, ParserCfg *init)
         mpp_err("Failed to allocate frame buffer %d\n", i);
         return MPP_ERR_NOMEM;
     }
-    s->cdfs = &s->default_cdfs;
-    s->cdfs_ndvc = &s->default_cdfs_ndvc;
-    av1d_set_default_cdfs(s->cdfs, s->cdfs_ndvc);
+    av1d_set_cur_cdfs(s, av1d_get_default_cdfs(0));
 
     return MPP_OK;
 
@@ -833,6 +832,7 @@ MPP_RET av1d_parser_deinit(Av1DecCtx *ctx)
         av1d_frame_unref(ctx, &s->cur_frame);
     }
     mpp_frame_deinit(&s->cur_frame.f);
+    av1d_put_cdfs(s);
 
     av1d_fragment_reset(&s->current_obu);
     MPP_FREE(s->current_obu.units);
@@ -1333,27 +1333,105 @@ end:
     return ret;
 }
 
+static Av1CdfSnap *av1d_ref_cdfs(Av1CdfSnap *snap)
+{
+    if (snap && !snap->is_default)
+        MPP_FETCH_ADD(&snap->ref_count, 1);
+
+    return snap;
+}
+
+static void av1d_unref_cdfs(Av1CdfSnap *snap)
+{
+    if (snap && !snap->is_default && !MPP_SUB_FETCH(&snap->ref_count, 1))
+        mpp_free(snap);
+}
+
+MPP_RET av1d_set_cur_cdfs(Av1Codec *ctx, Av1CdfSnap *snap)
+{
+    Av1CdfSnap *old = ctx->cdf_cur;
+
+    ctx->cdf_cur = av1d_ref_cdfs(snap);
+    ctx->cdfs = &snap->cdfs;
+    ctx->cdfs_ndvc = &snap->cdfs_ndvc;
+    av1d_unref_cdfs(old);
+
+    return MPP_OK;
+}
+
+static void av1d_store_snap(Av1Codec *ctx, Av1CdfSnap *snap, RK_U32 refresh_frame_flags)
+{
+    RK_U32 i;
+
+    for (i = 0; i < AV1_NUM_REF_FRAMES; i++) {
+        if ((refresh_frame_flags & (1 << i)) && ctx->cdf_last[i] != snap) {
+            av1d_unref_cdfs(ctx->cdf_last[i]);
+            ctx->cdf_last[i] = av1d_ref_cdfs(snap);
+        }
+    }
+}
+
+/* return a writable snapshot for slot ref_idx, copy it when it is shared */
+static Av1CdfSnap *av1d_write_cdfs(Av1Codec *ctx, RK_U32 ref_idx)
+{
+    Av1CdfSnap *snap = ctx->cdf_last[ref_idx];
+    Av1CdfSnap *copy;
+
+    if (snap && !snap->is_default &&
+        __atomic_load_n(&snap->ref_count, __ATOMIC_ACQUIRE) == 1)
+        return snap;
+
+    copy = mpp_malloc(Av1CdfSnap, 1);
+    if (!copy) {
+        mpp_err_f("failed to malloc cdfs\n");
+        return NULL;
+    }
+
+    if (!snap)
+        snap = av1d_get_default_cdfs(0);
+
+    memcpy(&copy->cdfs, &snap->cdfs, sizeof(copy->cdfs));
+    memcpy(&copy->cdfs_ndvc, &snap->cdfs_ndvc, sizeof(copy->cdfs_ndvc));
+    copy->ref_count = 1;
+    copy->is_default = 0;
+
+    av1d_unref_cdfs(ctx->cdf_last[ref_idx]);
+    ctx->cdf_last[ref_idx] = copy;
+
+    return copy;
+}
+
 MPP_RET av1d_get_cdfs(Av1Codec *ctx, RK_U32 ref_idx)
 {
-    ctx->cdfs = &ctx->cdfs_last[ref_idx];
-    ctx->cdfs_ndvc = &ctx->cdfs_last_ndvc[ref_idx];
+    Av1CdfSnap *snap = ctx->cdf_last[ref_idx];
+
+    /* broken stream may refer to a slot never refreshed */
+    av1d_set_cur_cdfs(ctx, snap ? snap : av1d_get_default_cdfs(0));
 
     return MPP_OK;
 }
 
 MPP_RET av1d_store_cdfs(Av1Codec *ctx, RK_U32 refresh_frame_flags)
+{
+    av1d_store_snap(ctx, ctx->cdf_cur, refresh_frame_flags);
+
+    return MPP_OK;
+}
+
+MPP_RET av1d_put_cdfs(Av1Codec *ctx)
 {
     RK_U32 i;
 
     for (i = 0; i < AV1_NUM_REF_FRAMES; i++) {
-        if (refresh_frame_flags & (1 << i)) {
-            if (&ctx->cdfs_last[i] != ctx->cdfs) {
-                ctx->cdfs_last[i] = *ctx->cdfs;
-                ctx->cdfs_last_ndvc[i] = *ctx->cdfs_ndvc;
-            }
-        }
+        av1d_unref_cdfs(ctx->cdf_last[i]);
+        ctx->cdf_last[i] = NULL;
     }
 
+    av1d_unref_cdfs(ctx->cdf_cur);
+    ctx->cdf_cur = NULL;
+    ctx->cdfs = NULL;
+    ctx->cdfs_ndvc = NULL;
+
     return MPP_OK;
 }
 
@@ -1372,11 +1450,14 @@ MPP_RET av1d_parser_update(Av1DecCtx *ctx, void *info)
     if (!c_ctx->disable_frame_end_update_cdf) {
         for (i = 0; i < AV1_NUM_REF_FRAMES; i++) {
             if (c_ctx->refresh_frame_flags & (1 << i)) {
-                /* 1. get cdfs */
-                av1d_get_cdfs(c_ctx, i);
+                /* 1. get writable cdfs */
+                Av1CdfSnap *snap = av1d_write_cdfs(c_ctx, i);
+
+                if (!snap)
+                    break;
                 {
-                    RK_U8 *cdf_base = (RK_U8 *)c_ctx->cdfs;
-                    RK_U8 *cdf_ndvc_base = (RK_U8 *)c_ctx->cdfs_ndvc;
+                    RK_U8 *cdf_base = (RK_U8 *)&snap->cdfs;
+                    RK_U8 *cdf_ndvc_base = (RK_U8 *)&snap->cdfs_ndvc;
                     /* 2. read cdfs from memory*/
                     if (c_ctx->frame_is_intra) {
                         memcpy(cdf_base, data, mv_cdf_offset);
@@ -1388,8 +1469,8 @@ MPP_RET av1d_parser_update(Av1DecCtx *ctx, void *info)
                         memcpy(cdf_base, data, cdf_size);
                     }
                 }
-                /* 3. store cdfs*/
-                av1d_store_cdfs(c_ctx, c_ctx->refresh_frame_flags);
+                /* 3. share cdfs to the other refreshed slots */
+                av1d_store_snap(c_ctx, snap, c_ctx->refresh_frame_flags);
                 break;
             }
         }
@@ -547,6 +547,7 @@ MPP_RET h264d_prepare(void *decoder, MppPacket pkt, HalDecTask *task)
     p_Inp->in_dts = mpp_packet_get_dts(pkt);
     p_Inp->in_length = mpp_packet_get_length(pkt);
     p_Inp->pkt_eos = mpp_packet_get_eos(pkt);
+    p_Inp->pkt_eoi = mpp_packet_is_eoi(pkt);
     p_Inp->in_buf = (RK_U8 *)mpp_packet_get_pos(pkt);
 
     if (p_Inp->pkt_eos && p_Inp->in_length < 4) {
@@ -646,21 +646,8 @@ static void free_dpb_mark(H264_DecCtx_t *p_Dec, H264_DpbMark_t *p_mark, RK_S32 s
     }
 }
 
-static MPP_RET remove_frame_from_dpb(H264_DpbBuf_t *p_Dpb, RK_S32 pos)
+static MPP_RET release_frame_store(H264_DecCtx_t *p_Dec, H264_FrameStore_t *fs)
 {
-    RK_U32  i = 0;
-    MPP_RET ret = MPP_ERR_UNKNOW;
-    H264_FrameStore_t* tmp = NULL;
-    H264_FrameStore_t* fs = NULL;
-    H264_DecCtx_t *p_Dec = NULL;
-
-    INP_CHECK(ret, !p_Dpb);
-    fs = p_Dpb->fs[pos];
-    INP_CHECK(ret, !fs);
-    INP_CHECK(ret, !p_Dpb->p_Vid);
-    p_Dec = p_Dpb->p_Vid->p_Dec;
-    INP_CHECK(ret, !p_Dec);
-
     switch (fs->is_used) {
     case 3:
         if (fs->frame)           free_storable_picture(p_Dec, fs->frame);
@@ -682,7 +669,7 @@ static MPP_RET remove_frame_from_dpb(H264_DpbBuf_t *p_Dpb, RK_S32 pos)
         break;
     default:
         H264D_ERR("invalid frame store type.");
-        goto __FAILED;
+        return MPP_NOK;
     }
 
     fs->is_used = 0;
@@ -690,6 +677,26 @@ static MPP_RET remove_frame_from_dpb(H264_DpbBuf_t *p_Dpb, RK_S32 pos)
     fs->is_reference = 0;
     fs->is_orig_reference = 0;
 
+    return MPP_OK;
+}
+
+static MPP_RET remove_frame_from_dpb(H264_DpbBuf_t *p_Dpb, RK_S32 pos)
+{
+    RK_U32  i = 0;
+    MPP_RET ret = MPP_ERR_UNKNOW;
+    H264_FrameStore_t* tmp = NULL;
+    H264_FrameStore_t* fs = NULL;
+    H264_DecCtx_t *p_Dec = NULL;
+
+    INP_CHECK(ret, !p_Dpb);
+    fs = p_Dpb->fs[pos];
+    INP_CHECK(ret, !fs);
+    INP_CHECK(ret, !p_Dpb->p_Vid);
+    p_Dec = p_Dpb->p_Vid->p_Dec;
+    INP_CHECK(ret, !p_Dec);
+
+    FUN_CHECK(ret = release_frame_store(p_Dec, fs));
+
     // move empty framestore to end of buffer
     tmp = p_Dpb->fs[pos];
 
@@ -728,6 +735,45 @@ __FAILED:
     return ret;
 }
 
+/*
+ * remove all output and unreferenced frames in one pass
+ * same result as looping remove_unused_frame_from_dpb: the remaining frames
+ * keep their order and the empty stores follow in reverse removal order.
+ */
+static void remove_unused_frames_from_dpb(H264_DpbBuf_t *p_Dpb)
+{
+    H264_FrameStore_t **unused = NULL;
+    H264_DecCtx_t *p_Dec = NULL;
+    RK_U32 used_size = 0;
+    RK_U32 failed = 0;
+    RK_U32 i = 0, j = 0, k = 0;
+
+    if (!p_Dpb || !p_Dpb->fs_out || !p_Dpb->p_Vid || !p_Dpb->p_Vid->p_Dec)
+        return;
+
+    unused = p_Dpb->fs_out;
+    p_Dec = p_Dpb->p_Vid->p_Dec;
+    used_size = p_Dpb->used_size;
+
+    for (i = 0; i < used_size; i++) {
+        H264_FrameStore_t *fs = p_Dpb->fs[i];
+
+        if (!failed && fs && fs->is_output && !is_used_for_reference(fs)) {
+            if (!release_frame_store(p_Dec, fs)) {
+                unused[k++] = fs;
+                continue;
+            }
+            failed = 1;
+        }
+        p_Dpb->fs[j++] = fs;
+    }
+
+    for (i = 0; i < k; i++)
+        p_Dpb->fs[j + i] = unused[k - 1 - i];
+
+    p_Dpb->used_size = j;
+}
+
 static RK_S32 get_smallest_poc(H264_DpbBuf_t *p_Dpb, RK_S32 *poc, RK_S32 *pos)
 {
     RK_U32 i = 0;
@@ -756,6 +802,34 @@ static RK_S32 get_smallest_poc(H264_DpbBuf_t *p_Dpb, RK_S32 *poc, RK_S32 *pos)
     return find_flag;
 }
 
+/*
+ * collect the frames waiting for output in POC order into fs_out
+ * ties keep the dpb order to match the selection of get_smallest_poc
+ */
+static RK_U32 get_output_order(H264_DpbBuf_t *p_Dpb)
+{
+    H264_FrameStore_t **out = p_Dpb->fs_out;
+    RK_U32 cnt = 0;
+    RK_U32 i;
+
+    for (i = 0; i < p_Dpb->used_size; i++) {
+        H264_FrameStore_t *fs = p_Dpb->fs[i];
+        RK_U32 j = cnt++;
+
+        if (fs->is_output) {
+            cnt--;
+            continue;
+        }
+        while (j > 0 && out[j - 1]->poc > fs->poc) {
+            out[j] = out[j - 1];
+            j--;
+        }
+        out[j] = fs;
+    }
+
+    return cnt;
+}
+
 static H264_FrameStore_t *alloc_frame_store()
 {
     MPP_RET ret = MPP_ERR_UNKNOW;
@@ -1309,21 +1383,28 @@ static MPP_RET output_dpb_normal(H264_DpbBuf_t *p_Dpb)
 {
     MPP_RET ret = MPP_NOK;
     RK_S32 min_poc = 0;
-    RK_S32 min_pos = 0;
     RK_S32 poc_inc = 0;
+    RK_U32 cnt = 0;
+    RK_U32 i = 0;
 
-    while ((p_Dpb->last_output_poc > INT_MIN)
-           && (get_smallest_poc(p_Dpb, &min_poc, &min_pos))) {
+    /* writing frames does not reorder dpb so sort the pending frames once */
+    if (p_Dpb->last_output_poc > INT_MIN)
+        cnt = get_output_order(p_Dpb);
+
+    for (i = 0; i < cnt && p_Dpb->last_output_poc > INT_MIN; i++) {
+        H264_FrameStore_t *fs = p_Dpb->fs_out[i];
+
+        min_poc = fs->poc;
         poc_inc = min_poc - p_Dpb->last_output_poc;
-        if ((p_Dpb->last_output_poc > INT_MIN) && (abs(poc_inc) & 0x1))
+        if (abs(poc_inc) & 0x1)
             p_Dpb->poc_interval = 1;
         if ((min_poc - p_Dpb->last_output_poc) <= p_Dpb->poc_interval) {
-            FUN_CHECK(ret = write_stored_frame(p_Dpb->p_Vid, p_Dpb, p_Dpb->fs[min_pos]));
+            FUN_CHECK(ret = write_stored_frame(p_Dpb->p_Vid, p_Dpb, fs));
         } else {
             break;
         }
     }
-    while (!remove_unused_frame_from_dpb(p_Dpb));
+    remove_unused_frames_from_dpb(p_Dpb);
 
     return MPP_OK;
 __FAILED:
@@ -1470,7 +1551,7 @@ MPP_RET store_picture_in_dpb(H264_DpbBuf_t *p_Dpb, H264_StorePic_t *p)
         sliding_window_memory_management(p_Dpb);
         p->is_long_term = 0;
     }
-    while (!remove_unused_frame_from_dpb(p_Dpb));
+    remove_unused_frames_from_dpb(p_Dpb);
     H264D_DBG(H264D_DBG_DPB_INFO, "before out, dpb[%d] used_size %d, size %d",
               p_Dpb->layer_id, p_Dpb->used_size, p_Dpb->size);
     //!< when full output one frame or more then setting max_buf_size
@@ -1577,6 +1658,7 @@ void free_dpb(H264_DpbBuf_t *p_Dpb)
     }
     MPP_FREE(p_Dpb->fs_ref);
     MPP_FREE(p_Dpb->fs_ltref);
+    MPP_FREE(p_Dpb->fs_out);
     if (p_Dpb->fs_ilref) {
         for (i = 0; i < 1; i++) {
             free_frame_store(p_Vid->p_Dec, p_Dpb->fs_ilref[i]);
@@ -1897,6 +1979,10 @@ static MPP_RET enlarge_dpb(H264_DpbBuf_t *p_Dpb, RK_U32 size)
     mpp_free(p_Dpb->fs_ilref);
     p_Dpb->fs_ilref = tmp;
 
+    MPP_FREE(p_Dpb->fs_out);
+    p_Dpb->fs_out = mpp_calloc(H264_FrameStore_t*, size);
+    MEM_CHECK(ret, p_Dpb->fs_out);
+
     for (i = p_Dpb->size; i < size; i++) {
         p_Dpb->fs[i] = alloc_frame_store();
         MEM_CHECK(ret, p_Dpb->fs[i]);
@@ -1984,7 +2070,8 @@ MPP_RET init_dpb(H264dVideoCtx_t *p_Vid, H264_DpbBuf_t *p_Dpb, RK_S32 type)  //
     p_Dpb->fs_ref   = mpp_calloc(H264_FrameStore_t*, p_Dpb->size);
     p_Dpb->fs_ltref = mpp_calloc(H264_FrameStore_t*, p_Dpb->size);
     p_Dpb->fs_ilref = mpp_calloc(H264_FrameStore_t*, 1);  //!< inter-layer reference (for multi-layered codecs)
-    MEM_CHECK(ret, p_Dpb->fs && p_Dpb->fs_ref && p_Dpb->fs_ltref && p_Dpb->fs_ilref);
+    p_Dpb->fs_out   = mpp_calloc(H264_FrameStore_t*, p_Dpb->size);
+    MEM_CHECK(ret, p_Dpb->fs && p_Dpb->fs_ref && p_Dpb->fs_ltref && p_Dpb->fs_ilref && p_Dpb->fs_out);
     for (i = 0; i < p_Dpb->size; i++) {
         p_Dpb->fs[i] = alloc_frame_store();
         MEM_CHECK(ret, p_Dpb->fs[i]);
@@ -2049,7 +2136,7 @@ MPP_RET flush_dpb(H264_DpbBuf_t *p_Dpb, RK_S32 type)
             unmark_for_reference(p_Dpb->p_Vid->p_Dec, p_Dpb->fs[i]);
         }
     }
-    while (!remove_unused_frame_from_dpb(p_Dpb));
+    remove_unused_frames_from_dpb(p_Dpb);
     //!< output frames in POC order
     while (p_Dpb->used_size) {
         FUN_CHECK(ret = output_one_frame_from_dpb(p_Dpb));
@@ -2072,7 +2159,7 @@ MPP_RET output_dpb(H264_DecCtx_t *p_Dec, H264_DpbBuf_t *p_Dpb)
 {
     MPP_RET ret = MPP_ERR_UNKNOW;
 
-    while (!remove_unused_frame_from_dpb(p_Dpb));
+    remove_unused_frames_from_dpb(p_Dpb);
 
     (void)p_Dec;
     return ret = MPP_OK;
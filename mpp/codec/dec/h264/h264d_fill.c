@@ -130,6 +130,7 @@ void fill_picparams(H264dVideoCtx_t *p_Vid, DXVA_PicParams_H264_MVC *pp)
     }
 
     pp->spspps_update = p_Vid->spspps_update;
+    pp->spspps_gen = p_Vid->spspps_gen;
     if (pp->spspps_update) {
         pp->wFrameWidthInMbsMinus1         = p_Vid->active_sps->pic_width_in_mbs_minus1;
         pp->wFrameHeightInMbsMinus1        = p_Vid->active_sps->pic_height_in_map_units_minus1;
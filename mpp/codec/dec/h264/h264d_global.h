@@ -413,6 +413,7 @@ typedef struct h264_dpb_buf_t {
     struct h264_frame_store_t  **fs_ref;
     struct h264_frame_store_t  **fs_ltref;
     struct h264_frame_store_t  **fs_ilref;   //!< inter-layer reference (for multi-layered codecs)
+    struct h264_frame_store_t  **fs_out;     //!< scratch list for output order and unused frame removal
     struct h264_frame_store_t   *last_picture;
 
     struct h264d_video_ctx_t   *p_Vid;
@@ -893,6 +894,7 @@ typedef struct h264d_input_ctx_t {
     RK_U8  *in_buf;
     size_t in_length;
     RK_U32 pkt_eos;
+    RK_U32 pkt_eoi;     //!< packet ends an access unit, like rtp marker
 
     MppPacket in_pkt;
 
@@ -1061,6 +1063,8 @@ typedef struct h264d_video_ctx_t {
     MppMemPool pic_st;
     //!< spspps data update
     RK_U32     spspps_update;
+    //!< sps / pps generation, bumped on each sps / pps parsed
+    RK_U32     spspps_gen;
 
     RK_U32     dpb_fast_out;
     RK_U32     dpb_first_fast_played;
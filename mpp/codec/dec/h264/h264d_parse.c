@@ -720,6 +720,23 @@ MPP_RET parse_prepare(H264dInputCtx_t *p_Inp, H264dCurCtx_t *p_Cur)
         p_Dec->nalu_ret = HaveNoStream;
     }
 
+    //!< last packet of access unit, close the frame without next start code
+    if (p_Inp->pkt_eoi && !p_Inp->pkt_eos && !p_Inp->in_length &&
+        !p_Inp->task_valid && p_Dec->have_slice_data) {
+        FUN_CHECK(ret = store_cur_nalu(p_Cur, p_strm, p_Dec->dxva_ctx));
+        FUN_CHECK(ret = add_empty_nalu(p_strm));
+        p_strm->head_offset = 0;
+        p_strm->first_mb_in_slice = 0;
+        p_strm->startcode_found = 0;
+        p_strm->endcode_found = 0;
+        p_strm->nalu_len = 0;
+        p_strm->nalu_type = H264_NALU_TYPE_NULL;
+        p_strm->prefixdata = 0xffffffff;
+        p_Dec->have_slice_data = 0;
+        p_Inp->task_valid = 1;
+        H264D_LOG("----- end of image in packet ----");
+    }
+
     if (p_Inp->pkt_eos && p_Inp->in_length < 4) {
         FUN_CHECK(ret = store_cur_nalu(p_Cur, p_strm, p_Dec->dxva_ctx));
         FUN_CHECK(ret = add_empty_nalu(p_strm));
@@ -142,10 +142,16 @@ MPP_RET process_pps(H264_SLICE_t *currSlice)
     ASSERT(cur_pps->Valid == 1);
     if (!currSlice->p_Vid->ppsSet[cur_pps->pic_parameter_set_id]) {
         currSlice->p_Vid->ppsSet[cur_pps->pic_parameter_set_id] = mpp_calloc(H264_PPS_t, 1);
+    } else if (!memcmp(currSlice->p_Vid->ppsSet[cur_pps->pic_parameter_set_id],
+                       cur_pps, sizeof(H264_PPS_t))) {
+        //!< repeated pps keeps generation then packed hal data is reused
+        p_Cur->p_Vid->spspps_update = 1;
+        return ret = MPP_OK;
     }
 
     memcpy(currSlice->p_Vid->ppsSet[cur_pps->pic_parameter_set_id], cur_pps, sizeof(H264_PPS_t));
     p_Cur->p_Vid->spspps_update = 1;
+    p_Cur->p_Vid->spspps_gen++;
 
     return ret = MPP_OK;
 __FAILED:
@@ -470,13 +470,20 @@ MPP_RET process_sps(H264_SLICE_t *currSlice)
     FUN_CHECK(ret = get_max_dec_frame_buf_size(cur_sps));
     //!< make SPS available, copy
     if (cur_sps->Valid) {
-        if (!currSlice->p_Vid->spsSet[cur_sps->seq_parameter_set_id]) {
-            currSlice->p_Vid->spsSet[cur_sps->seq_parameter_set_id] = mpp_calloc(H264_SPS_t, 1);
+        H264_SPS_t *sps = currSlice->p_Vid->spsSet[cur_sps->seq_parameter_set_id];
+
+        if (!sps) {
+            sps = mpp_calloc(H264_SPS_t, 1);
+            currSlice->p_Vid->spsSet[cur_sps->seq_parameter_set_id] = sps;
+        } else if (!memcmp(sps, cur_sps, sizeof(H264_SPS_t))) {
+            //!< repeated sps keeps generation then packed hal data is reused
+            p_Cur->p_Vid->spspps_update = 1;
+            return ret = MPP_OK;
         }
-        memcpy(currSlice->p_Vid->spsSet[cur_sps->seq_parameter_set_id],
-               cur_sps, sizeof(H264_SPS_t));
+        memcpy(sps, cur_sps, sizeof(H264_SPS_t));
     }
     p_Cur->p_Vid->spspps_update = 1;
+    p_Cur->p_Vid->spspps_gen++;
 
     return ret = MPP_OK;
 __FAILED:
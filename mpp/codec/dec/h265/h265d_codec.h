@@ -75,6 +75,7 @@ typedef struct SplitContext {
      */
     RK_S32 key_frame;
     RK_S32 eos;
+    RK_S32 eoi;               ///< current packet is the last one of access unit
 } SplitContext_t;
 
 typedef struct H265dContext {
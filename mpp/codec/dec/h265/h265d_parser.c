@@ -251,6 +251,13 @@ static RK_S32 h265d_split_frame(void *sc,
         next = buf_size;
     }
 
+    /* access unit ends with this packet, output it without next start code */
+    if (s->eoi && buf_size && next == END_NOT_FOUND && s->frame_start_found) {
+        next = buf_size;
+        s->frame_start_found = 0;
+        s->state64 = (RK_U64) - 1;
+    }
+
     if (mpp_combine_frame(s, next, &buf, &buf_size) < 0) {
         *poutbuf      = NULL;
         *poutbuf_size = 0;
@@ -1552,19 +1559,8 @@ RK_S32 mpp_hevc_extract_rbsp(HEVCContext *s, const RK_U8 *src, int length,
 
     //skip extract rbsp for cap_hw_h265_rps
     if (s->cap_hw_h265_rps && cur_nalu_type < NAL_VPS && b_first_slice_in_pic) {
-        if (rbsp_buf_min_size > nal->rbsp_buffer_size) {
-            mpp_free(nal->rbsp_buffer);
-            nal->rbsp_buffer = NULL;
-            nal->rbsp_buffer = mpp_malloc(RK_U8, rbsp_buf_min_size);
-            nal->rbsp_buffer_size = nal->rbsp_buffer == NULL ? 0 : rbsp_buf_min_size;
-        }
-        if (nal->rbsp_buffer) {
-            memcpy(nal->rbsp_buffer, src, length);
-            nal->data = nal->rbsp_buffer;
-            nal->size = length;
-        } else {
-            mpp_err_f("malloc nal rbsp buffer failed, size %d\n", rbsp_buf_min_size);
-        }
+        nal->data = src;
+        nal->size = length;
         return length;
     }
 
@@ -1605,6 +1601,16 @@ RK_S32 mpp_hevc_extract_rbsp(HEVCContext *s, const RK_U8 *src, int length,
     }
 #endif
 
+    /*
+     * slice payload is copied only once, to the stream buffer in
+     * h265d_syntax_fill_slice(), which then points nal->data at that copy
+     */
+    if (cur_nalu_type < NAL_VPS) {
+        nal->data = src;
+        nal->size = length;
+        return length;
+    }
+
     if (rbsp_buf_min_size > nal->rbsp_buffer_size) {
         rbsp_buf_min_size = MPP_MAX(17 * rbsp_buf_min_size / 16 + 32, rbsp_buf_min_size);
         mpp_free(nal->rbsp_buffer);
@@ -1994,9 +2000,7 @@ MPP_RET h265d_prepare(void *ctx, MppPacket pkt, HalDecTask *task)
     task->valid = 0;
     s->eos = mpp_packet_get_eos(pkt);
 
-    if (sc != NULL) {
-        sc->eos = s->eos;
-    } else if (h265dctx->cfg->base.split_parse) {
+    if (sc == NULL && h265dctx->cfg->base.split_parse) {
         h265d_split_init((void**)&sc);
         if (sc == NULL) {
             mpp_err("split contxt malloc fail");
@@ -2005,6 +2009,11 @@ MPP_RET h265d_prepare(void *ctx, MppPacket pkt, HalDecTask *task)
         h265dctx->split_cxt = sc;
     }
 
+    if (sc != NULL) {
+        sc->eos = s->eos;
+        sc->eoi = mpp_packet_is_eoi(pkt);
+    }
+
     buf = (RK_U8 *)mpp_packet_get_pos(pkt);
     pts = mpp_packet_get_pts(pkt);
     dts = mpp_packet_get_dts(pkt);
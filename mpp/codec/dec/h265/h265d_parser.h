@@ -633,6 +633,8 @@ typedef struct HEVCContext {
     RK_U8  ps_need_upate;
     RK_U8  sps_need_upate;
     RK_U8  rps_need_upate;
+    /* parameter set generation, bumped on each vps / sps / pps change */
+    RK_U32 ps_gen;
 
     /*temporary storage for slice_cut_param*/
     RK_U32  start_bit;
@@ -166,6 +166,7 @@ static void fill_picture_parameters(const HEVCContext *h,
     pp->CurrPicOrderCntVal               = h->poc;
     pp->ps_update_flag                   = h->ps_need_upate;
     pp->rps_update_flag                  = h->rps_need_upate || h->ps_need_upate;
+    pp->ps_gen                           = h->ps_gen;
 
     if (pp->rps_update_flag) {
         for (i = 0; i < 32; i++) {
@@ -434,6 +435,8 @@ RK_S32 h265d_syntax_fill_slice(void *ctx, RK_S32 input_index)
         current += start_code_size;
         position += start_code_size;
         memcpy(current, h->nals[i].data, h->nals[i].size);
+        /* input packet is released after prepare, parse from the copy */
+        h->nals[i].data = current;
         // mpp_log("h->nals[%d].size = %d", i, h->nals[i].size);
         fill_slice_short(&ctx_pic->slice_short[count], position, h->nals[i].size);
         init_slice_cut_param(&ctx_pic->slice_cut_param[count]);
@@ -441,6 +444,10 @@ RK_S32 h265d_syntax_fill_slice(void *ctx, RK_S32 input_index)
         position += h->nals[i].size;
         count++;
     }
+    /* zero tail after the last slice as the rbsp buffer had */
+    if (-1 == input_index ||
+        position + MPP_INPUT_BUFFER_PADDING_SIZE <= mpp_buffer_get_size(streambuf))
+        memset(current, 0, MPP_INPUT_BUFFER_PADDING_SIZE);
     ctx_pic->slice_count    = count;
     ctx_pic->bitstream_size = position;
     if (-1 != input_index) {
@@ -1150,6 +1150,7 @@ int mpp_hevc_decode_nal_vps(HEVCContext *s)
         }
         s->vps_list[vps_id] = vps_buf;
         s->ps_need_upate = 1;
+        s->ps_gen++;
     }
 
     return 0;
@@ -1883,6 +1884,7 @@ RK_S32 mpp_hevc_decode_nal_sps(HEVCContext *s)
             mpp_mem_pool_put_f(s->sps_pool, s->sps_list[sps_id]);
         s->sps_list[sps_id] = sps_buf;
         s->sps_need_upate = 1;
+        s->ps_gen++;
     }
 
     if (s->sps_list[sps_id])
@@ -2207,10 +2209,21 @@ int mpp_hevc_decode_nal_pps(HEVCContext *s)
     }
 
     if (s->pps_list[pps_id]) {
+        /*
+         * a repeated pps keeps the generation so packed hal data is reused
+         * explicit tile sizes are parsed into the shared bufs in place and
+         * can not be compared, so they always count as a change
+         */
+        RK_U32 repeat = (!pps->tiles_enabled_flag || pps->uniform_spacing_flag) &&
+                        !memcmp(s->pps_list[pps_id], pps, sizeof(*pps) - sizeof(pps->bufs));
+
         memcpy(s->pps_list[pps_id], pps, sizeof(*pps) - sizeof(pps->bufs));
         mpp_hevc_pps_free((RK_U8 *)pps);
+        if (!repeat)
+            s->ps_gen++;
     } else {
         s->pps_list[pps_id] = (RK_U8 *)pps;
+        s->ps_gen++;
     }
     s->ps_need_upate = 1;
 
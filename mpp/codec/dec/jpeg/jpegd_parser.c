@@ -30,6 +30,10 @@
 #include "jpegd_parser.h"
 #include "mpp_dec_cb_param.h"
 
+/* enough for four DQT and four DHT of baseline image */
+#define JPEGD_TBL_SEG_SIZE      (SZ_4K)
+#define JPEGD_TBL_SEG_INVALID   ((RK_U32)-1)
+
 /* return the 8 bit start code value and update the search
    state. Return 0 if no start code found */
 static RK_U8 jpegd_find_marker(const RK_U8 **pbuf_ptr, const RK_U8 *buf_end)
@@ -594,6 +598,53 @@ __BITREAD_ERR:
     return ret;
 }
 
+/* append raw DQT / DHT segment for table change check */
+static void jpegd_record_tbl(JpegdCtx *ctx, RK_U8 marker, const RK_U8 *seg, const RK_U8 *end)
+{
+    RK_U32 idx = ctx->tbl_cur;
+    RK_U32 pos = ctx->tbl_len[idx];
+    RK_U32 len = 0;
+
+    if (pos == JPEGD_TBL_SEG_INVALID)
+        return;
+
+    if (seg) {
+        if (end - seg < 2)
+            return;
+
+        len = (seg[0] << 8) | seg[1];
+        len = MPP_MIN(len, (RK_U32)(end - seg));
+    }
+
+    if (pos + len + 1 > JPEGD_TBL_SEG_SIZE) {
+        ctx->tbl_len[idx] = JPEGD_TBL_SEG_INVALID;
+        return;
+    }
+
+    ctx->tbl_seg[idx][pos] = marker;
+    if (len)
+        memcpy(ctx->tbl_seg[idx] + pos + 1, seg, len);
+    ctx->tbl_len[idx] = pos + len + 1;
+}
+
+/* bump table generation when the tables differ from previous image */
+static void jpegd_update_tbl_gen(JpegdCtx *ctx)
+{
+    RK_U32 cur = ctx->tbl_cur;
+    RK_U32 prev = !cur;
+    RK_U32 len = ctx->tbl_len[cur];
+
+    if (len == JPEGD_TBL_SEG_INVALID || len != ctx->tbl_len[prev] ||
+        memcmp(ctx->tbl_seg[cur], ctx->tbl_seg[prev], len)) {
+        ctx->tbl_gen++;
+        ctx->tbl_cur = prev;
+        jpegd_dbg_table("table changed gen %d\n", ctx->tbl_gen);
+    }
+
+    ctx->syntax->tbl_gen = ctx->tbl_gen;
+    ctx->tbl_len[ctx->tbl_cur] = 0;
+}
+
 static MPP_RET jpegd_setup_default_dht(JpegdCtx *ctx)
 {
     jpegd_dbg_func("enter\n");
@@ -744,6 +795,7 @@ static MPP_RET jpegd_decode_frame(JpegdCtx *ctx)
 
     syntax->htbl_entry = 0;
     syntax->qtbl_entry = 0;
+    ctx->tbl_len[ctx->tbl_cur] = 0;
 
     if (strm_len < 8 || !memchr(buf_ptr, start_code, 8)) {
         // not jpeg
@@ -790,8 +842,10 @@ static MPP_RET jpegd_decode_frame(JpegdCtx *ctx)
             syntax->qtable_cnt = 0;
             syntax->qtbl_entry = 0;
             syntax->htbl_entry = 0;
+            ctx->tbl_len[ctx->tbl_cur] = 0;
             break;
         case DHT:
+            jpegd_record_tbl(ctx, DHT, buf_ptr, buf_end);
             if ((ret = jpegd_decode_dht(ctx)) != MPP_OK) {
                 mpp_err_f("huffman table decode error\n");
                 goto fail;
@@ -799,6 +853,7 @@ static MPP_RET jpegd_decode_frame(JpegdCtx *ctx)
             syntax->dht_found = 1;
             break;
         case DQT:
+            jpegd_record_tbl(ctx, DQT, buf_ptr, buf_end);
             if ((ret = jpegd_decode_dqt(ctx)) != MPP_OK) {
                 mpp_err_f("quantize tables decode error\n");
                 goto fail;
@@ -890,7 +945,10 @@ done:
         jpegd_dbg_marker("sorry, DHT is not found!\n");
         jpegd_setup_default_dht(ctx);
         syntax->htbl_entry = 0x0f;
+        /* default tables are marked by an empty DHT */
+        jpegd_record_tbl(ctx, SOI, NULL, NULL);
     }
+    jpegd_update_tbl_gen(ctx);
     if (!syntax->sof0_found) {
         mpp_err_f("sof marker not found!\n");
         ret = MPP_ERR_STREAM;
@@ -1126,6 +1184,7 @@ static MPP_RET jpegd_parse(void *ctx, HalDecTask *task)
     JpegCtx->buffer = (RK_U8 *)mpp_packet_get_data(JpegCtx->input_packet);
 
     memset(JpegCtx->syntax, 0, sizeof(JpegdSyntax));
+    JpegCtx->syntax->tbl_gen = JpegCtx->tbl_gen;
 
     ret = jpegd_decode_frame(JpegCtx);
     if (MPP_OK == ret) {
@@ -1177,6 +1236,9 @@ static MPP_RET jpegd_deinit(void *ctx)
         JpegCtx->syntax = NULL;
     }
 
+    MPP_FREE(JpegCtx->tbl_seg[0]);
+    JpegCtx->tbl_seg[1] = NULL;
+
     JpegCtx->pts = 0;
     JpegCtx->eos = 0;
     JpegCtx->input_jpeg_count = 0;
@@ -1252,6 +1314,18 @@ static MPP_RET jpegd_init(void *ctx, ParserCfg *parser_cfg)
     }
     memset(JpegCtx->syntax, 0, sizeof(JpegdSyntax));
 
+    JpegCtx->tbl_seg[0] = mpp_malloc(RK_U8, JPEGD_TBL_SEG_SIZE * 2);
+    if (JpegCtx->tbl_seg[0] == NULL) {
+        mpp_err_f("allocate table segment failed\n");
+        return MPP_ERR_MALLOC;
+    }
+    JpegCtx->tbl_seg[1] = JpegCtx->tbl_seg[0] + JPEGD_TBL_SEG_SIZE;
+    /* no previous image so the first image always gets a new generation */
+    JpegCtx->tbl_len[0] = 0;
+    JpegCtx->tbl_len[1] = JPEGD_TBL_SEG_INVALID;
+    JpegCtx->tbl_cur = 0;
+    JpegCtx->tbl_gen = 0;
+
     JpegCtx->pts = 0;
     JpegCtx->eos = 0;
     JpegCtx->input_jpeg_count = 0;
@@ -146,6 +146,13 @@ typedef struct JpegdCtx {
     /* bit read context */
     BitReadCtx_t             *bit_ctx;
     JpegdSyntax              *syntax;
+
+    /* raw DQT / DHT segments of current and previous image */
+    RK_U8                    *tbl_seg[2];
+    RK_U32                   tbl_len[2];
+    RK_U32                   tbl_cur;
+    /* table generation kept across images, copied to syntax->tbl_gen */
+    RK_U32                   tbl_gen;
 } JpegdCtx;
 
 #endif /* JPEGD_PARSER_H */
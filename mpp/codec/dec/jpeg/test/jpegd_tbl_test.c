@@ -0,0 +1,154 @@
+/* SPDX-License-Identifier: Apache-2.0 OR MIT */
+/*
+ * Copyright (c) 2026 Rockchip Electronics Co., Ltd.
+ */
+
+#define MODULE_TAG "jpegd_tbl_test"
+
+#include <string.h>
+
+#include "mpp_mem.h"
+#include "mpp_common.h"
+#include "mpp_log.h"
+
+#include "parser_api.h"
+#include "jpegd_syntax.h"
+
+#define TEST_JPEG_MAX_SIZE  256
+
+extern const ParserApi mpp_jpegd;
+
+/* 16x16 grey baseline image with one DQT of constant q and default DHT */
+static RK_U32 test_make_jpeg(RK_U8 *buf, RK_U8 q)
+{
+    static const RK_U8 sof0[] = {
+        0xff, 0xc0, 0x00, 0x0b, 0x08, 0x00, 0x10, 0x00, 0x10,
+        0x01, 0x01, 0x11, 0x00,
+    };
+    static const RK_U8 sos[] = {
+        0xff, 0xda, 0x00, 0x08, 0x01, 0x01, 0x00, 0x00, 0x3f, 0x00,
+    };
+    static const RK_U8 scan[] = {
+        0xf8, 0x0a, 0x28, 0xa0, 0x0f, 0xff, 0xd9,
+    };
+    RK_U32 pos = 0;
+
+    buf[pos++] = 0xff;
+    buf[pos++] = 0xd8;
+
+    /* DQT: length 67, 8 bit precision table 0 */
+    buf[pos++] = 0xff;
+    buf[pos++] = 0xdb;
+    buf[pos++] = 0x00;
+    buf[pos++] = 0x43;
+    buf[pos++] = 0x00;
+    memset(buf + pos, q, 64);
+    pos += 64;
+
+    memcpy(buf + pos, sof0, sizeof(sof0));
+    pos += sizeof(sof0);
+    memcpy(buf + pos, sos, sizeof(sos));
+    pos += sizeof(sos);
+    memcpy(buf + pos, scan, sizeof(scan));
+    pos += sizeof(scan);
+
+    return pos;
+}
+
+static MPP_RET test_decode(void *ctx, MppBufSlots frm_slots, RK_U8 q,
+                           RK_U32 *gen)
+{
+    RK_U8 buf[TEST_JPEG_MAX_SIZE];
+    MppPacket pkt = NULL;
+    HalDecTask task;
+    JpegdSyntax *syntax;
+    MPP_RET ret;
+
+    mpp_packet_init(&pkt, buf, test_make_jpeg(buf, q));
+    memset(&task, 0, sizeof(task));
+
+    ret = mpp_jpegd.prepare(ctx, pkt, &task);
+    if (!ret)
+        ret = mpp_jpegd.parse(ctx, &task);
+    mpp_packet_deinit(&pkt);
+
+    if (ret || !task.valid) {
+        mpp_err("image q %d parse failed ret %d\n", q, ret);
+        return MPP_NOK;
+    }
+
+    /* hal done, release the output slot for next image */
+    mpp_buf_slot_clr_flag(frm_slots, task.output, SLOT_HAL_OUTPUT);
+
+    syntax = (JpegdSyntax *)task.syntax.data;
+    if (syntax->quant_matrixes[0][0] != q) {
+        mpp_err("image q %d got qtbl %d\n", q, syntax->quant_matrixes[0][0]);
+        return MPP_NOK;
+    }
+
+    *gen = syntax->tbl_gen;
+    return MPP_OK;
+}
+
+int main(void)
+{
+    /* image DQT and whether its tables differ from the previous image */
+    static const RK_U8 q[] = { 16, 16, 32, 32, 16, 16 };
+    static const RK_U32 reload[] = { 1, 0, 1, 0, 1, 0 };
+    MppBufSlots frm_slots = NULL;
+    MppBufSlots pkt_slots = NULL;
+    ParserCfg cfg;
+    void *ctx = NULL;
+    RK_U32 prev = 0;
+    RK_U32 gen = 0;
+    RK_U32 i;
+    MPP_RET ret = MPP_NOK;
+
+    mpp_log("jpegd table reuse test start\n");
+
+    mpp_buf_slot_init(&frm_slots);
+    mpp_buf_slot_init(&pkt_slots);
+    ctx = mpp_calloc_size(void, mpp_jpegd.ctx_size);
+    if (!frm_slots || !pkt_slots || !ctx) {
+        mpp_err("failed to alloc test context\n");
+        goto DONE;
+    }
+
+    memset(&cfg, 0, sizeof(cfg));
+    cfg.coding = MPP_VIDEO_CodingMJPEG;
+    cfg.frame_slots = frm_slots;
+    cfg.packet_slots = pkt_slots;
+
+    if (mpp_jpegd.init(ctx, &cfg)) {
+        mpp_err("jpegd init failed\n");
+        goto DONE;
+    }
+
+    for (i = 0; i < MPP_ARRAY_ELEMS(q); i++) {
+        if (test_decode(ctx, frm_slots, q[i], &gen))
+            break;
+
+        mpp_log("image %d q %2d tbl_gen %d\n", i, q[i], gen);
+
+        if (!gen || (gen != prev) != reload[i]) {
+            mpp_err("image %d tbl_gen %d prev %d expect %s\n", i, gen, prev,
+                    reload[i] ? "reload" : "reuse");
+            break;
+        }
+        prev = gen;
+    }
+    if (i == MPP_ARRAY_ELEMS(q))
+        ret = MPP_OK;
+
+    mpp_jpegd.deinit(ctx);
+
+DONE:
+    MPP_FREE(ctx);
+    if (pkt_slots)
+        mpp_buf_slot_deinit(pkt_slots);
+    if (frm_slots)
+        mpp_buf_slot_deinit(frm_slots);
+
+    mpp_log("jpegd table reuse test %s\n", ret ? "failed" : "success");
+    return ret;
+}
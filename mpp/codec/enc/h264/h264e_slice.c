@@ -974,120 +974,10 @@ RK_S32 h264e_slice_write_pskip(H264eSlice *slice, void *p, RK_U32 size)
 
 RK_S32 h264e_slice_move(RK_U8 *dst, RK_U8 *src, RK_S32 dst_bit, RK_S32 src_bit, RK_S32 src_size)
 {
-    RK_S32 dst_byte = dst_bit / 8;
-    RK_S32 src_byte = src_bit / 8;
-    RK_S32 dst_bit_r = dst_bit & 7;
-    RK_S32 src_bit_r = src_bit & 7;
-    RK_S32 src_len = src_size - src_byte;
-    RK_S32 diff_len = 0;
-    static RK_S32 frame_no = 0;
-
-    if (src_bit_r == 0 && dst_bit_r == 0) {
-        // direct copy
-        if (h264e_debug & H264E_DBG_SLICE)
-            mpp_log_f("direct copy %p -> %p %d\n", src, dst, src_len);
-
-        h264e_dbg_slice("bit [%d %d] [%d %d] [%d %d] len %d\n",
-                        src_bit, dst_bit, src_byte, dst_byte,
-                        src_bit_r, dst_bit_r, src_len);
-
-        memcpy(dst + dst_byte, src + src_byte, src_len);
-        return diff_len;
-    }
-
-    RK_U8 *psrc = src + src_byte;
-    RK_U8 *pdst = dst + dst_byte;
-
-    RK_U16 tmp16a, tmp16b, tmp16c, last_tmp, dst_mask;
-    RK_U8 tmp0, tmp1;
-    RK_U32 loop = src_len + (src_bit_r > 0);
-    RK_U32 i = 0;
-    RK_U32 src_zero_cnt = 0;
-    RK_U32 dst_zero_cnt = 0;
-    RK_U32 dst_len = 0;
-
-    last_tmp = (RK_U16)pdst[0];
-    dst_mask = 0xFFFF << (8 - dst_bit_r);
-
-    h264e_dbg_slice("bit [%d %d] [%d %d] [%d %d] loop %d mask %04x last %04x\n",
-                    src_bit, dst_bit, src_byte, dst_byte,
-                    src_bit_r, dst_bit_r, loop, dst_mask, last_tmp);
-
-    for (i = 0; i < loop; i++) {
-        if (psrc[0] == 0) {
-            src_zero_cnt++;
-        } else {
-            src_zero_cnt = 0;
-        }
-
-        // tmp0 tmp1 is next two non-aligned bytes from src
-        tmp0 = psrc[0];
-        tmp1 = (i < loop - 1) ? psrc[1] : 0;
-
-        if (src_zero_cnt >= 2 && tmp1 == 3) {
-            if (h264e_debug & H264E_DBG_SLICE)
-                mpp_log("found 03 at src pos %d %02x %02x %02x %02x %02x %02x %02x %02x\n",
-                        i, psrc[-2], psrc[-1], psrc[0], psrc[1], psrc[2],
-                        psrc[3], psrc[4], psrc[5]);
-
-            psrc++;
-            i++;
-            tmp1 = psrc[1];
-            src_zero_cnt = 0;
-            diff_len--;
-        }
-        // get U16 data
-        tmp16a = ((RK_U16)tmp0 << 8) | (RK_U16)tmp1;
-
-        if (src_bit_r) {
-            tmp16b = tmp16a << src_bit_r;
-        } else {
-            tmp16b = tmp16a;
-        }
-
-        if (dst_bit_r)
-            tmp16c = tmp16b >> dst_bit_r | ((last_tmp << 8) & dst_mask);
-        else
-            tmp16c = tmp16b;
-
-        pdst[0] = (tmp16c >> 8) & 0xFF;
-        pdst[1] = tmp16c & 0xFF;
-
-        if (h264e_debug & H264E_DBG_SLICE) {
-            if (i < 10) {
-                mpp_log("%03d src [%04x] -> [%04x] + last [%04x] -> %04x\n", i, tmp16a, tmp16b, last_tmp, tmp16c);
-            }
-            if (i >= loop - 10) {
-                mpp_log("%03d src [%04x] -> [%04x] + last [%04x] -> %04x\n", i, tmp16a, tmp16b, last_tmp, tmp16c);
-            }
-        }
-
-        if (dst_zero_cnt == 2 && pdst[0] <= 0x3) {
-            if (h264e_debug & H264E_DBG_SLICE)
-                mpp_log("found 03 at dst frame %d pos %d\n", frame_no, dst_len);
-
-            pdst[2] = pdst[1];
-            pdst[1] = pdst[0];
-            pdst[0] = 0x3;
-            pdst++;
-            diff_len++;
-            dst_len++;
-            dst_zero_cnt = 0;
-        }
-
-        if (pdst[0] == 0)
-            dst_zero_cnt++;
-        else
-            dst_zero_cnt = 0;
-
-        last_tmp = tmp16c;
-
-        psrc++;
-        pdst++;
-        dst_len++;
-    }
+    RK_S32 diff_len = mpp_writer_move(dst, src, dst_bit, src_bit, src_size);
 
-    frame_no++;
+    h264e_dbg_slice("move bit %d -> %d size %d diff %d\n",
+                    src_bit, dst_bit, src_size, diff_len);
 
     return diff_len;
 }
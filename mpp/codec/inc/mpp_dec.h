@@ -21,10 +21,12 @@
 #include "mpp_err.h"
 #include "rk_mpi_cmd.h"
 #include "mpp_dec_cfg.h"
+#include "mpp_stats.h"
 
 typedef enum MppDecEvent_e {
     MPP_DEC_EVENT_ON_PKT_RELEASE,
     MPP_DEC_EVENT_ON_FRM_READY,
+    MPP_DEC_EVENT_ON_FRM_PART,
 
     MPP_DEC_EVENT_BUTT,
 } MppDecEvent;
@@ -66,6 +68,9 @@ MPP_RET mpp_dec_decode(MppDec ctx, MppPacket packet);
 
 MppDecCfg mpp_dec_to_cfg(MppDec ctx);
 
+/* cpu time of parser, hal and vproc threads */
+void mpp_dec_get_cpu_time(MppDec ctx, MppStatsCpuTime *time);
+
 #ifdef __cplusplus
 }
 #endif
@@ -141,6 +141,8 @@ struct MppDecImpl_t {
     // statistics data
     RK_U32              statistics_en;
     MppClock            clocks[DEC_TIMING_BUTT];
+    /* session id for pipeline event trace */
+    RK_U32              trace_sid;
 
     // query data
     RK_U32              dec_in_pkt_count;
@@ -240,6 +242,9 @@ void dec_task_init(DecTask *task);
 MPP_RET mpp_dec_proc_cfg(MppDecImpl *dec, MpiCmd cmd, void *param);
 
 MPP_RET update_dec_hal_info(MppDecImpl *dec, MppFrame frame);
+/* attach kernel hardware timing of the last task to the output frame meta */
+void mpp_dec_set_hw_time(MppDecImpl *dec, RK_S32 index);
+void mpp_dec_report_rows(MppDecImpl *dec, RK_S32 index, HalDecTaskFlag flags);
 void mpp_dec_put_frame(Mpp *mpp, RK_S32 index, HalDecTaskFlag flags);
 RK_S32 mpp_dec_push_display(Mpp *mpp, HalDecTaskFlag flags);
 
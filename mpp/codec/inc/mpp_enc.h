@@ -20,6 +20,7 @@
 #include "rk_type.h"
 #include "mpp_err.h"
 #include "rk_mpi_cmd.h"
+#include "mpp_stats.h"
 
 /*
  * Configure of encoder is separated into four parts.
@@ -174,6 +175,9 @@ MPP_RET mpp_enc_reset_v2(MppEnc ctx);
 
 MppEncCfg mpp_enc_to_cfg(MppEnc ctx);
 
+/* cpu time of encoder thread */
+void mpp_enc_get_cpu_time(MppEnc ctx, MppStatsCpuTime *time);
+
 #ifdef __cplusplus
 }
 #endif
@@ -21,6 +21,7 @@
 #include "mpp_enc_hal.h"
 #include "mpp_enc_ref.h"
 #include "mpp_enc_refs.h"
+#include "mpp_enc_la.h"
 #include "mpp_device.h"
 #include "mpp_task_impl.h"
 
@@ -63,6 +64,8 @@ typedef struct MppEncImpl_t {
     RK_S64              time_end;
     RK_S32              frame_count;
     RK_S32              hal_info_updated;
+    /* hardware wait clock for always-on statistics */
+    MppClock            hw_clk;
 
     /*
      * Rate control plugin parameters
@@ -124,6 +127,8 @@ typedef struct MppEncImpl_t {
     MppPacket           hdr_pkt;
     void                *hdr_buf;
     RK_U32              hdr_len;
+    /* header snapshot shared by output packets in pkt_iov mode */
+    MppBuffer           hdr_chunk;
     MppEncHeaderStatus  hdr_status;
     MppEncHeaderMode    hdr_mode;
     MppEncSeiMode       sei_mode;
@@ -140,6 +145,12 @@ typedef struct MppEncImpl_t {
     MppEncRefs          refs;
     MppEncRefFrmUsrCfg  frm_cfg;
 
+    /* lookahead queue for async input mode */
+    MppEncLa            la;
+
+    /* multi-pass stats file path copied from user config */
+    char                rc_stats_file[RC_STATS_FILE_LEN];
+
     /* two-pass deflicker parameters */
     RK_U32              support_hw_deflicker;
     EncRcTaskInfo       rc_info_prev;
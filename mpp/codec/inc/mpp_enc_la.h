@@ -0,0 +1,58 @@
+/* SPDX-License-Identifier: Apache-2.0 OR MIT */
+/*
+ * Copyright (c) 2026 Rockchip Electronics Co., Ltd.
+ */
+
+#ifndef MPP_ENC_LA_H
+#define MPP_ENC_LA_H
+
+#include "mpp_frame.h"
+#include "mpp_enc.h"
+
+/* max frame number analyzed ahead of the encoding frame */
+#define MPP_ENC_LA_MAX_DEPTH        16
+
+/*
+ * Encoder lookahead
+ *
+ * Input frames are queued here before encoding. A worker thread analyzes
+ * the frames on a 4x4 down scaled luma plane and the encoder pops a frame
+ * when depth frames after it are analyzed or the queue is flushed by eos.
+ *
+ * The complexity is the average residual per down scaled pixel in 1/16
+ * unit. It is the smaller one of intra (left / top prediction) and inter
+ * (co-located pixel of previous frame) residual on each 8x8 block.
+ */
+typedef void* MppEncLa;
+
+typedef struct MppEncLaInfo_t {
+    /* number of analyzed frames after the current frame */
+    RK_S32          depth;
+    /* complexity of the current frame */
+    RK_S32          cost;
+    /* average complexity of the current frame and the frames ahead */
+    RK_S32          cost_avg;
+    /* distance to the next scene cut, 0 - current frame, -1 - not found */
+    RK_S32          cut_dist;
+} MppEncLaInfo;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* enc is notified when a frame is analyzed, NULL for standalone use */
+MPP_RET mpp_enc_la_init(MppEncLa *ctx, MppEnc enc);
+MPP_RET mpp_enc_la_deinit(MppEncLa ctx);
+
+/* queue frame for analysis, return MPP_NOK when depth + 1 frames are queued */
+MPP_RET mpp_enc_la_push(MppEncLa ctx, RK_S32 depth, MppFrame frame);
+/* get the head frame when depth frames after it are analyzed */
+MPP_RET mpp_enc_la_pop(MppEncLa ctx, RK_S32 depth, MppFrame *frame, MppEncLaInfo *info);
+/* get the head frame without analysis for skip on reset */
+MPP_RET mpp_enc_la_drop(MppEncLa ctx, MppFrame *frame);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* MPP_ENC_LA_H */
@@ -56,6 +56,8 @@ MPP_RET rc_deinit(RcCtx ctx);
 
 /* update rc control  */
 MPP_RET rc_update_usr_cfg(RcCtx ctx, RcCfg *cfg);
+/* restart the frame sequence on encoder reset */
+MPP_RET rc_reset(RcCtx ctx);
 
 /* Frame rate convertion */
 MPP_RET rc_frm_check_drop(RcCtx ctx, EncRcTask *task);
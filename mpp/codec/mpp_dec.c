@@ -8,6 +8,7 @@
 #include <string.h>
 
 #include "mpp_env.h"
+#include "mpp_trace.h"
 
 #include "mpp_buffer_impl.h"
 #include "mpp_frame_impl.h"
@@ -284,6 +285,11 @@ void mpp_dec_put_frame(Mpp *mpp, RK_S32 index, HalDecTaskFlag flags)
         mpp_frame_set_discard(frame, 0);
     }
 
+    /* decoder does not know the frame rate then load is counted by default fps */
+    if (change)
+        mpp_load_update(mpp->mLoad, mpp_frame_get_width(frame),
+                        mpp_frame_get_height(frame), 0);
+
     if (!change) {
         if (dec->cfg->base.sort_pts) {
             MppPktTs *pkt_ts;
@@ -364,6 +370,8 @@ void mpp_dec_put_frame(Mpp *mpp, RK_S32 index, HalDecTaskFlag flags)
         mpp_frame_copy(out, frame);
 
         sys_dbg_pts("output frame pts %lld\n", mpp_frame_get_pts(out));
+        mpp_trace_evt(MPP_TRACE_EVT_FRM_OUT, dec->trace_sid, index);
+        mpp_stats_add(mpp->mStats, MPP_STATS_CNT_FRM_OUT, 1);
 
         mpp_mutex_cond_lock(&list->cond_lock);
         mpp_list_add_at_tail(list, &out, sizeof(out));
@@ -445,6 +453,64 @@ MPP_RET update_dec_hal_info(MppDecImpl *dec, MppFrame frame)
     return MPP_OK;
 }
 
+void mpp_dec_set_hw_time(MppDecImpl *dec, RK_S32 index)
+{
+    MppDevHwTime time;
+    MppFrame frame = NULL;
+    MppMeta meta;
+
+    if (index < 0 || !dec->dev)
+        return;
+
+    if (mpp_dev_ioctl(dec->dev, MPP_DEV_GET_HW_TIME, &time))
+        return;
+
+    mpp_buf_slot_get_prop(dec->frame_slots, index, SLOT_FRAME_PTR, &frame);
+    if (!frame)
+        return;
+
+    meta = mpp_frame_get_meta(frame);
+    if (!meta)
+        return;
+
+    mpp_meta_set_s64(meta, KEY_HW_START_TIME, time.start);
+    mpp_meta_set_s64(meta, KEY_HW_END_TIME, time.end);
+    mpp_meta_set_s64(meta, KEY_HW_CYCLES, time.cycles);
+}
+
+/*
+ * Report the frame in slot index as ready for sub-frame consumer. No hal
+ * reports row progress so the rows ready are always the whole frame.
+ * The frame is not displayable yet and the consumer must not hold it after
+ * the callback returns.
+ * It must be called after hw_wait so that the hal has marked the frame error.
+ * Frames with task error or errinfo / discard are not reported.
+ */
+void mpp_dec_report_rows(MppDecImpl *dec, RK_S32 index, HalDecTaskFlag flags)
+{
+    MppFrame frame = NULL;
+    MppMeta meta;
+
+    if (index < 0 || !dec->cfg->cb.frm_part_cb)
+        return;
+
+    if (flags.parse_err || flags.ref_err)
+        return;
+
+    mpp_buf_slot_get_prop(dec->frame_slots, index, SLOT_FRAME_PTR, &frame);
+    if (!frame)
+        return;
+
+    if (mpp_frame_get_errinfo(frame) || mpp_frame_get_discard(frame))
+        return;
+
+    meta = mpp_frame_get_meta(frame);
+    if (meta)
+        mpp_meta_set_s32(meta, KEY_DEC_ROWS_READY, mpp_frame_get_height(frame));
+
+    mpp_dec_callback(dec, MPP_DEC_EVENT_ON_FRM_PART, frame);
+}
+
 static MppDecModeApi *dec_api[] = {
     &dec_api_normal,
     &dec_api_no_thread,
@@ -520,6 +586,7 @@ MPP_RET mpp_dec_init(MppDec *dec, MppDecInitCfg *cfg)
     }
 
     p->mpp = mpp;
+    p->trace_sid = mpp_trace_evt_sid();
     mpp_dec_cfg_init(&p->cfg_obj);
     dec_cfg = (MppDecCfgSet *)kmpp_obj_to_entry(p->cfg_obj);
     p->cfg = dec_cfg;
@@ -638,6 +705,11 @@ MPP_RET mpp_dec_init(MppDec *dec, MppDecInitCfg *cfg)
             mpp_clock_enable(p->clocks[i], p->statistics_en);
         }
 
+        /* always-on statistics histogram, the clocks stay disabled */
+        mpp_clock_set_stats(p->clocks[DEC_PRS_PARSE], mpp->mStats, MPP_STATS_HIST_PARSE);
+        mpp_clock_set_stats(p->clocks[DEC_HW_WAIT], mpp->mStats, MPP_STATS_HIST_HW);
+        mpp_clock_set_stats(p->clocks[DEC_PRS_WAIT], mpp->mStats, MPP_STATS_HIST_QUEUE_WAIT);
+
         mpp_mutex_cond_init(&p->cmd_lock);
         sem_init(&p->parser_reset, 0, 0);
         sem_init(&p->hal_reset, 0, 0);
@@ -812,6 +884,21 @@ MPP_RET mpp_dec_stop(MppDec ctx)
     return ret;
 }
 
+void mpp_dec_get_cpu_time(MppDec ctx, MppStatsCpuTime *time)
+{
+    MppDecImpl *dec = (MppDecImpl *)ctx;
+
+    if (!dec)
+        return;
+
+    if (dec->thread_parser)
+        time->time[MPP_STATS_THREAD_PARSER] = mpp_thread_get_cpu_time(dec->thread_parser);
+    if (dec->thread_hal)
+        time->time[MPP_STATS_THREAD_HAL] = mpp_thread_get_cpu_time(dec->thread_hal);
+    if (dec->vproc)
+        time->time[MPP_STATS_THREAD_OUTPUT] = dec_vproc_get_cpu_time(dec->vproc);
+}
+
 MPP_RET mpp_dec_reset(MppDec ctx)
 {
     MppDecImpl *dec = (MppDecImpl *)ctx;
@@ -883,6 +970,10 @@ MPP_RET mpp_dec_callback(MppDec ctx, MppDecEvent event, void *arg)
         if (cb->frm_rdy_cb)
             ret = cb->frm_rdy_cb(cb->frm_rdy_ctx, mpp->mCtx, cb->frm_rdy_cmd, arg);
     } break;
+    case MPP_DEC_EVENT_ON_FRM_PART : {
+        if (cb->frm_part_cb)
+            ret = cb->frm_part_cb(cb->frm_part_ctx, mpp->mCtx, cb->frm_part_cmd, arg);
+    } break;
     default : {
     } break;
     }
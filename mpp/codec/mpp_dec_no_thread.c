@@ -7,6 +7,7 @@
 
 #include <string.h>
 
+#include "mpp_trace.h"
 #include "mpp_buffer_impl.h"
 
 #include "mpp_dec_debug.h"
@@ -163,9 +164,11 @@ MPP_RET mpp_dec_decode(MppDec ctx, MppPacket packet)
      * 7. parse the stream in input buffer and generate task
      */
     if (!status->task_parsed_rdy) {
+        mpp_trace_evt(MPP_TRACE_EVT_PARSE_BEG, dec->trace_sid, task_dec->input);
         mpp_clock_start(dec->clocks[DEC_PRS_PARSE]);
         mpp_parser_parse(dec->parser, task_dec);
         mpp_clock_pause(dec->clocks[DEC_PRS_PARSE]);
+        mpp_trace_evt(MPP_TRACE_EVT_PARSE_END, dec->trace_sid, task_dec->output);
         status->task_parsed_rdy = 1;
 
         /* add extra output slot operaton for jpeg decoding */
@@ -306,9 +309,15 @@ MPP_RET mpp_dec_decode(MppDec ctx, MppPacket packet)
         return MPP_NOK;
     }
 
+    mpp_trace_evt(MPP_TRACE_EVT_REG_GEN_BEG, dec->trace_sid, task_dec->output);
     mpp_hal_reg_gen(dec->hal, &task->info);
+    mpp_trace_evt(MPP_TRACE_EVT_REG_GEN_END, dec->trace_sid, task_dec->output);
     mpp_hal_hw_start(dec->hal, &task->info);
+    mpp_trace_evt(MPP_TRACE_EVT_HW_START, dec->trace_sid, task_dec->output);
     mpp_hal_hw_wait(dec->hal, &task->info);
+    mpp_trace_evt(MPP_TRACE_EVT_HW_DONE, dec->trace_sid, task_dec->output);
+    mpp_dec_set_hw_time(dec, task_dec->output);
+    mpp_dec_report_rows(dec, task_dec->output, task_dec->flags);
     dec->dec_hw_run_count++;
 
     /*
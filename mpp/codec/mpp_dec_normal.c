@@ -7,6 +7,7 @@
 
 #include <string.h>
 
+#include "mpp_trace.h"
 #include "mpp_buffer_impl.h"
 
 #include "mpp_dec_debug.h"
@@ -297,6 +298,8 @@ static MPP_RET try_get_input_packet(Mpp *mpp, DecTask *task)
     dec->mpp_pkt_in = packet;
     mpp->mPacketGetCount++;
     dec->dec_in_pkt_count++;
+    mpp_trace_evt(MPP_TRACE_EVT_PKT_IN, dec->trace_sid, dec->dec_in_pkt_count);
+    mpp_stats_add(mpp->mStats, MPP_STATS_CNT_PKT_IN, 1);
 
     task->status.mpp_pkt_in_rdy = 1;
     task->wait.dec_pkt_in = 0;
@@ -416,6 +419,7 @@ static MPP_RET try_proc_dec_task(Mpp *mpp, DecTask *task)
     if (NULL == hal_buf_in) {
         mpp_buffer_get(mpp->mPacketGroup, &hal_buf_in, stream_size);
         if (hal_buf_in) {
+            mpp_stats_add(mpp->mStats, MPP_STATS_CNT_BUF_ALLOC, 1);
             mpp_buf_slot_set_prop(packet_slots, task_dec->input, SLOT_BUFFER, hal_buf_in);
             mpp_buffer_attach_dev(hal_buf_in, dec->dev);
             mpp_buffer_put(hal_buf_in);
@@ -438,6 +442,7 @@ static MPP_RET try_proc_dec_task(Mpp *mpp, DecTask *task)
 
         mpp_buffer_write(hal_buf_in, 0, src, length);
         mpp_buffer_sync_partial_end(hal_buf_in, 0, length);
+        mpp_stats_add(mpp->mStats, MPP_STATS_CNT_BYTES_COPY, length);
         mpp_buf_slot_set_flag(packet_slots, task_dec->input, SLOT_CODEC_READY);
         mpp_buf_slot_set_flag(packet_slots, task_dec->input, SLOT_HAL_INPUT);
         task->status.dec_pkt_copy_rdy = 1;
@@ -499,9 +504,11 @@ static MPP_RET try_proc_dec_task(Mpp *mpp, DecTask *task)
      *    4. detect whether output index has MppBuffer and task valid
      */
     if (!task->status.task_parsed_rdy) {
+        mpp_trace_evt(MPP_TRACE_EVT_PARSE_BEG, dec->trace_sid, task_dec->input);
         mpp_clock_start(dec->clocks[DEC_PRS_PARSE]);
         mpp_parser_parse(dec->parser, task_dec);
         mpp_clock_pause(dec->clocks[DEC_PRS_PARSE]);
+        mpp_trace_evt(MPP_TRACE_EVT_PARSE_END, dec->trace_sid, task_dec->output);
         task->status.task_parsed_rdy = 1;
     }
 
@@ -606,9 +613,11 @@ static MPP_RET try_proc_dec_task(Mpp *mpp, DecTask *task)
             size = downscale_width * downscale_height * 3 / 2;
         }
         mpp_buffer_get(mpp->mFrameGroup, &hal_buf_out, size);
-        if (hal_buf_out)
+        if (hal_buf_out) {
+            mpp_stats_add(mpp->mStats, MPP_STATS_CNT_BUF_ALLOC, 1);
             mpp_buf_slot_set_prop(frame_slots, output, SLOT_BUFFER,
                                   hal_buf_out);
+        }
     }
 
     dec_dbg_detail("detail: %p check output buffer %p\n", dec, hal_buf_out);
@@ -655,14 +664,17 @@ static MPP_RET try_proc_dec_task(Mpp *mpp, DecTask *task)
     }
 
     /* generating registers table */
+    mpp_trace_evt(MPP_TRACE_EVT_REG_GEN_BEG, dec->trace_sid, task_dec->output);
     mpp_clock_start(dec->clocks[DEC_HAL_GEN_REG]);
     mpp_hal_reg_gen(dec->hal, &task->info);
     mpp_clock_pause(dec->clocks[DEC_HAL_GEN_REG]);
+    mpp_trace_evt(MPP_TRACE_EVT_REG_GEN_END, dec->trace_sid, task_dec->output);
 
     /* send current register set to hardware */
     mpp_clock_start(dec->clocks[DEC_HW_START]);
     mpp_hal_hw_start(dec->hal, &task->info);
     mpp_clock_pause(dec->clocks[DEC_HW_START]);
+    mpp_trace_evt(MPP_TRACE_EVT_HW_START, dec->trace_sid, task_dec->output);
 
     /*
      * 12. send dxva output information and buffer information to hal thread
@@ -862,6 +874,10 @@ void *mpp_dec_hal_thread(void *data)
             mpp_clock_start(dec->clocks[DEC_HW_WAIT]);
             mpp_hal_hw_wait(dec->hal, &task_info);
             mpp_clock_pause(dec->clocks[DEC_HW_WAIT]);
+            mpp_trace_evt(MPP_TRACE_EVT_HW_DONE, dec->trace_sid, task_dec->output);
+            mpp_stats_add(mpp->mStats, MPP_STATS_CNT_HW_RUN, 1);
+            mpp_dec_set_hw_time(dec, task_dec->output);
+            mpp_dec_report_rows(dec, task_dec->output, task_dec->flags);
             dec->dec_hw_run_count++;
 
             /*
@@ -1103,6 +1119,7 @@ void *mpp_dec_advanced_thread(void *data)
             mpp_mutex_cond_lock(&list->cond_lock);
             mpp_list_add_at_tail(list, &frame, sizeof(frame));
             mpp->mFramePutCount++;
+            mpp_stats_add(mpp->mStats, MPP_STATS_CNT_FRM_OUT, 1);
             mpp_list_signal(list);
             mpp_mutex_cond_unlock(&list->cond_lock);
 
@@ -1144,17 +1161,25 @@ void *mpp_dec_advanced_thread(void *data)
 
 MPP_RET mpp_dec_start_normal(MppDecImpl *dec)
 {
+    Mpp *mpp = (Mpp *)dec->mpp;
+
     if (dec->coding != MPP_VIDEO_CodingMJPEG) {
         dec->thread_parser = mpp_thread_create(mpp_dec_parser_thread,
                                                dec->mpp, "mpp_dec_parser");
+        mpp_thread_set_policy(dec->thread_parser, MPP_THREAD_ROLE_COMPUTE,
+                              mpp->mThreadPlace, mpp->mThreadPrio);
         mpp_thread_start(dec->thread_parser);
         dec->thread_hal = mpp_thread_create(mpp_dec_hal_thread,
                                             dec->mpp, "mpp_dec_hal");
+        mpp_thread_set_policy(dec->thread_hal, MPP_THREAD_ROLE_WAIT,
+                              mpp->mThreadPlace, mpp->mThreadPrio);
 
         mpp_thread_start(dec->thread_hal);
     } else {
         dec->thread_parser = mpp_thread_create(mpp_dec_advanced_thread,
                                                dec->mpp, "mpp_dec_parser");
+        mpp_thread_set_policy(dec->thread_parser, MPP_THREAD_ROLE_COMPUTE,
+                              mpp->mThreadPlace, mpp->mThreadPrio);
         mpp_thread_start(dec->thread_parser);
     }
 
@@ -5,6 +5,7 @@
 
 #define  MODULE_TAG "mpp_enc"
 
+#include <math.h>
 #include <string.h>
 #include <stdarg.h>
 #include <limits.h>
@@ -283,6 +284,50 @@ static void check_low_delay_output(MppEncImpl *enc)
     enc->low_delay_output = 1;
 }
 
+static void mpp_enc_gen_hdr(MppEncImpl *enc)
+{
+    enc_impl_gen_hdr(enc->impl, enc->hdr_pkt);
+    enc->hdr_len = mpp_packet_get_length(enc->hdr_pkt);
+    enc->hdr_status.ready = 1;
+
+    /* output packets still hold the reference of the old header chunk */
+    if (enc->hdr_chunk) {
+        mpp_buffer_put(enc->hdr_chunk);
+        enc->hdr_chunk = NULL;
+    }
+}
+
+/*
+ * Add stream header ahead of the hardware stream. In pkt_iov mode the header
+ * is attached as a packet chunk which refers to a snapshot buffer shared by
+ * all packets until the header changes. Low delay output splits the packet
+ * memory into parts so it always copies the header.
+ */
+static void mpp_enc_add_hdr(MppEncImpl *enc, HalEncTask *hal_task, MppPacket packet)
+{
+    Mpp *mpp = (Mpp *)enc->mpp;
+
+    hal_task->header_length = enc->hdr_len;
+
+    if (enc->cfg->base.pkt_iov && !enc->low_delay_output &&
+        !enc->low_delay_part_mode && enc->hdr_len) {
+        if (!enc->hdr_chunk) {
+            mpp_buffer_get(mpp->mPacketGroup, &enc->hdr_chunk, enc->hdr_len);
+            if (enc->hdr_chunk)
+                mpp_buffer_write(enc->hdr_chunk, 0, mpp_packet_get_pos(enc->hdr_pkt),
+                                 enc->hdr_len);
+        }
+
+        if (enc->hdr_chunk &&
+            !mpp_packet_add_chunk(packet, enc->hdr_chunk, 0, enc->hdr_len))
+            return;
+    }
+
+    mpp_packet_append(packet, enc->hdr_pkt);
+    mpp_stats_add(mpp->mStats, MPP_STATS_CNT_BYTES_COPY, enc->hdr_len);
+    hal_task->length += enc->hdr_len;
+}
+
 MPP_RET mpp_enc_callback(const char *caller, void *ctx, RK_S32 cmd, void *param)
 {
     MppEncImpl *enc = (MppEncImpl *)ctx;
@@ -791,6 +836,25 @@ static void proc_rc_cfg(MppEncImpl *enc)
         mpp_loge("warning: bitrate statistic time %d is larger than 60s\n",
                  set->stats_time);
     }
+    if (set->lookahead < 0 || set->lookahead > MPP_ENC_LA_MAX_DEPTH) {
+        mpp_loge("invalid lookahead %d should be in range [0:%d] restore to %d\n",
+                 set->lookahead, MPP_ENC_LA_MAX_DEPTH, cfg->lookahead);
+        set->lookahead = cfg->lookahead;
+    }
+    if (set->pass < 0 || set->pass > 2) {
+        mpp_loge("invalid pass %d should be in range [0:2] restore to %d\n",
+                 set->pass, cfg->pass);
+        set->pass = cfg->pass;
+    }
+    /* user string may be released after config so keep a copy */
+    if (set->stats_file && set->stats_file != enc->rc_stats_file) {
+        strncpy(enc->rc_stats_file, set->stats_file, sizeof(enc->rc_stats_file) - 1);
+        set->stats_file = enc->rc_stats_file;
+    }
+    if (set->pass && !enc->rc_stats_file[0]) {
+        mpp_loge("pass %d without stats file restore to %d\n", set->pass, cfg->pass);
+        set->pass = cfg->pass;
+    }
 
     /* 2. check rc cfg done now check rc cfg change */
     if (set->rc_mode != cfg->rc_mode)
@@ -1282,6 +1346,22 @@ MPP_RET mpp_enc_proc_cfg(MppEncImpl *enc, MpiCmd cmd, void *param)
             set->base.coding = enc->coding;
         }
 
+        /* update load on size or fps change, reject overloading in strict mode */
+        if (set->prep.width && set->prep.height && set->rc.fps_out_denom &&
+            (set->prep.width != cfg->prep.width ||
+             set->prep.height != cfg->prep.height ||
+             set->rc.fps_out_num != cfg->rc.fps_out_num ||
+             set->rc.fps_out_denom != cfg->rc.fps_out_denom)) {
+            MppLoad load = ((Mpp *)enc->mpp)->mLoad;
+
+            if (mpp_load_update(load, set->prep.width, set->prep.height,
+                                set->rc.fps_out_num / set->rc.fps_out_denom) &&
+                mpp_load_is_strict(load)) {
+                ret = MPP_NOK;
+                break;
+            }
+        }
+
         /* check all date status in set_obj */
         /* 1. base cfg -> no check */
         memcpy(&cfg->base, &set->base, sizeof(cfg->base));
@@ -1341,11 +1421,8 @@ MPP_RET mpp_enc_proc_cfg(MppEncImpl *enc, MpiCmd cmd, void *param)
          * So encoder always write its header to external buffer
          * which is provided by user.
          */
-        if (!enc->hdr_status.ready) {
-            enc_impl_gen_hdr(enc->impl, enc->hdr_pkt);
-            enc->hdr_len = mpp_packet_get_length(enc->hdr_pkt);
-            enc->hdr_status.ready = 1;
-        }
+        if (!enc->hdr_status.ready)
+            mpp_enc_gen_hdr(enc);
 
         if (cmd == MPP_ENC_GET_EXTRA_INFO) {
             mpp_err("Please use MPP_ENC_GET_HDR_SYNC instead of unsafe MPP_ENC_GET_EXTRA_INFO\n");
@@ -1643,7 +1720,8 @@ static void set_rc_cfg(RcCfg *cfg, MppEncCfgSet *cfg_set)
     cfg->layer_bit_prop[2] = 0;
     cfg->layer_bit_prop[3] = 0;
 
-    cfg->max_reencode_times = rc->max_reenc_times;
+    /* first pass only records stats so skip the reencode cost */
+    cfg->max_reencode_times = rc->pass == 1 ? 0 : rc->max_reenc_times;
     cfg->drop_mode = rc->drop_mode;
     cfg->drop_thd = rc->drop_threshold;
     cfg->drop_gap = rc->drop_gap;
@@ -1658,6 +1736,9 @@ static void set_rc_cfg(RcCfg *cfg, MppEncCfgSet *cfg_set)
 
     cfg->refresh_len = rc->refresh_length;
 
+    cfg->pass = rc->pass;
+    cfg->stats_file = rc->stats_file;
+
     if (info->st_gop) {
         cfg->vgop = info->st_gop;
         if (cfg->vgop >= rc->fps_out_num / rc->fps_out_denom &&
@@ -1750,9 +1831,11 @@ static MPP_RET mpp_enc_check_frm_pkt(MppEncImpl *enc)
     enc->frm_buf = NULL;
     enc->pkt_buf = NULL;
 
-    if (enc->packet)
+    if (enc->packet) {
         enc->pkt_buf = mpp_packet_get_buffer(enc->packet);
-    else
+        /* drop chunks left in user packet by last frame */
+        mpp_packet_reset_chunk(enc->packet);
+    } else
         mpp_packet_new(&enc->packet);
 
     if (enc->frame) {
@@ -1791,6 +1874,7 @@ static MPP_RET mpp_enc_check_pkt_buf(MppEncImpl *enc)
         mpp_buffer_get(mpp->mPacketGroup, &buffer, size);
         mpp_buffer_attach_dev(buffer, enc->dev);
         mpp_assert(buffer);
+        mpp_stats_add(mpp->mStats, MPP_STATS_CNT_BUF_ALLOC, 1);
         enc->pkt_buf = buffer;
         pkt->data   = mpp_buffer_get_ptr(buffer);
         pkt->pos    = pkt->data;
@@ -1851,7 +1935,10 @@ static MPP_RET mpp_enc_proc_two_pass(Mpp *mpp, EncAsyncTaskInfo *task)
         ENC_RUN_FUNC2(mpp_enc_hal_start, hal, hal_task, mpp, ret);
 
         enc_dbg_detail("task %d hal wait\n", frm->seq_idx);
+        mpp_clock_start(enc->hw_clk);
         ENC_RUN_FUNC2(mpp_enc_hal_wait,  hal, hal_task, mpp, ret);
+        mpp_clock_pause(enc->hw_clk);
+        mpp_stats_add(mpp->mStats, MPP_STATS_CNT_HW_RUN, 1);
 
         enc_dbg_detail("task %d hal ret task\n", frm->seq_idx);
         ENC_RUN_FUNC2(mpp_enc_hal_ret_task, hal, hal_task, mpp, ret);
@@ -2031,10 +2118,7 @@ static void mpp_enc_add_sw_header(MppEncImpl *enc, HalEncTask *hal_task)
             enc_dbg_detail("task %d IDR header length %d\n",
                            frm->seq_idx, enc->hdr_len);
 
-            mpp_packet_append(packet, enc->hdr_pkt);
-
-            hal_task->header_length = enc->hdr_len;
-            hal_task->length += enc->hdr_len;
+            mpp_enc_add_hdr(enc, hal_task, packet);
             hdr_status->added_by_mode = 1;
         }
 
@@ -2156,7 +2240,10 @@ static MPP_RET mpp_enc_normal(Mpp *mpp, EncAsyncTaskInfo *task)
     ENC_RUN_FUNC2(mpp_enc_hal_start, hal, hal_task, mpp, ret);
 
     enc_dbg_detail("task %d hal wait\n", frm->seq_idx);
+    mpp_clock_start(enc->hw_clk);
     ENC_RUN_FUNC2(mpp_enc_hal_wait,  hal, hal_task, mpp, ret);
+    mpp_clock_pause(enc->hw_clk);
+    mpp_stats_add(mpp->mStats, MPP_STATS_CNT_HW_RUN, 1);
 
     mpp_stopwatch_record(hal_task->stopwatch, "encode hal finish");
 
@@ -2187,6 +2274,10 @@ static void mpp_enc_clr_rc_cb_info(EncRcTask *rc_task)
     hal_rc->quality_target = bak.quality_target;
     hal_rc->quality_max = bak.quality_max;
     hal_rc->quality_min = bak.quality_min;
+    hal_rc->la_depth = bak.la_depth;
+    hal_rc->la_cost = bak.la_cost;
+    hal_rc->la_cost_avg = bak.la_cost_avg;
+    hal_rc->la_cut_dist = bak.la_cut_dist;
 }
 
 static MPP_RET mpp_enc_reenc_simple(Mpp *mpp, EncAsyncTaskInfo *task)
@@ -2218,7 +2309,10 @@ static MPP_RET mpp_enc_reenc_simple(Mpp *mpp, EncAsyncTaskInfo *task)
     ENC_RUN_FUNC2(mpp_enc_hal_start, hal, hal_task, mpp, ret);
 
     enc_dbg_detail("task %d hal wait\n", frm->seq_idx);
+    mpp_clock_start(enc->hw_clk);
     ENC_RUN_FUNC2(mpp_enc_hal_wait,  hal, hal_task, mpp, ret);
+    mpp_clock_pause(enc->hw_clk);
+    mpp_stats_add(mpp->mStats, MPP_STATS_CNT_HW_RUN, 1);
 
     enc_dbg_detail("task %d rc hal end\n", frm->seq_idx);
     ENC_RUN_FUNC2(rc_hal_end, enc->rc_ctx, rc_task, mpp, ret);
@@ -2469,16 +2563,12 @@ static MPP_RET try_get_enc_task(MppEncImpl *enc, EncAsyncTaskInfo *task, EncAsyn
     // 12. generate header before hardware stream
     if (!hdr_status->ready) {
         /* config cpb before generating header */
-        enc_impl_gen_hdr(enc->impl, enc->hdr_pkt);
-        enc->hdr_len = mpp_packet_get_length(enc->hdr_pkt);
-        hdr_status->ready = 1;
+        mpp_enc_gen_hdr(enc);
 
         enc_dbg_detail("task %d update header length %d\n",
                        frm->seq_idx, enc->hdr_len);
 
-        mpp_packet_append(enc->packet, enc->hdr_pkt);
-        hal_task->header_length = enc->hdr_len;
-        hal_task->length += enc->hdr_len;
+        mpp_enc_add_hdr(enc, hal_task, enc->packet);
         hdr_status->added_by_change = 1;
     }
 
@@ -2708,8 +2798,51 @@ TASK_DONE:
     return ret;
 }
 
+static void set_enc_frm_stats(MppEncImpl *enc, EncRcTask *rc_task, MppEncFrmStats *stats)
+{
+    EncRcTaskInfo *info = &rc_task->info;
+    MppEncPrepCfg *prep = &enc->cfg->prep;
+    RK_S64 area = (RK_S64)MPP_ALIGN(prep->width, 16) * MPP_ALIGN(prep->height, 16);
+    RK_S64 inter = (RK_S64)info->lvl64_inter_num * 64 * 64 +
+                   (RK_S64)info->lvl32_inter_num * 32 * 32 +
+                   (RK_S64)info->lvl16_inter_num * 16 * 16 +
+                   (RK_S64)info->lvl8_inter_num * 8 * 8;
+    RK_S64 intra = (RK_S64)info->lvl32_intra_num * 32 * 32 +
+                   (RK_S64)info->lvl16_intra_num * 16 * 16 +
+                   (RK_S64)info->lvl8_intra_num * 8 * 8 +
+                   (RK_S64)info->lvl4_intra_num * 4 * 4;
+
+    stats->size = sizeof(*stats);
+    stats->version = MPP_ENC_FRM_STATS_VERSION;
+    stats->is_intra = rc_task->frm.is_intra;
+    stats->temporal_id = rc_task->frm.temporal_id;
+    stats->bits = info->bit_real;
+    stats->qp_start = info->quality_target;
+    stats->qp_avg = info->quality_real;
+
+    /* only h.264 / h.265 report block counts, area without coded block is skipped */
+    if (area > 0 && (enc->coding == MPP_VIDEO_CodingAVC ||
+                     enc->coding == MPP_VIDEO_CodingHEVC)) {
+        stats->intra_ratio = (RK_S32)MPP_MIN(intra * 1000 / area, 1000);
+        stats->inter_ratio = (RK_S32)MPP_MIN(inter * 1000 / area, 1000 - stats->intra_ratio);
+        stats->skip_ratio = 1000 - stats->intra_ratio - stats->inter_ratio;
+    }
+
+    stats->madi = info->madi;
+    stats->madp = info->madp;
+    stats->motion_level = info->motion_level;
+
+    stats->sse = info->sse;
+    if (info->sse > 0 && prep->width > 0 && prep->height > 0) {
+        double mse = (double)info->sse / ((RK_S64)prep->width * prep->height);
+
+        stats->psnr_y = (RK_S32)(1000.0 * log10(255.0 * 255.0 / mse) + 0.5);
+    }
+}
+
 static MPP_RET set_enc_info_to_packet(MppEncImpl *enc, HalEncTask *hal_task)
 {
+    MppEncFrmStats stats;
     Mpp *mpp = (Mpp*)enc->mpp;
     EncRcTask *rc_task = hal_task->rc_task;
     EncFrmStatus *frm = &rc_task->frm;
@@ -2759,6 +2892,25 @@ static MPP_RET set_enc_info_to_packet(MppEncImpl *enc, HalEncTask *hal_task)
     if (hal_task->md_info)
         mpp_meta_set_buffer(meta, KEY_MOTION_INFO, hal_task->md_info);
 
+    memset(&stats, 0, sizeof(stats));
+    set_enc_frm_stats(enc, rc_task, &stats);
+
+    /* kernel hardware timing of the last encoding pass */
+    if (enc->dev) {
+        MppDevHwTime time;
+
+        if (!mpp_dev_ioctl(enc->dev, MPP_DEV_GET_HW_TIME, &time)) {
+            mpp_meta_set_s64(meta, KEY_HW_START_TIME, time.start);
+            mpp_meta_set_s64(meta, KEY_HW_END_TIME, time.end);
+            mpp_meta_set_s64(meta, KEY_HW_CYCLES, time.cycles);
+
+            stats.hw_time = time.end - time.start;
+            stats.hw_cycles = time.cycles;
+        }
+    }
+
+    mpp_meta_set_ptr(meta, KEY_ENC_FRM_STATS, &stats);
+
     if (mpp->mEncAyncIo)
         mpp_meta_set_frame(meta, KEY_INPUT_FRAME, hal_task->frame);
 
@@ -2783,6 +2935,7 @@ static MPP_RET try_proc_normal_task(MppEncImpl *enc, EncAsyncTaskInfo *task)
 
     // 18. drop, force pskip and reencode  process
     while (frm->reencode && frm->reencode_times < enc->cfg->rc.max_reenc_times) {
+        mpp_stats_add(mpp->mStats, MPP_STATS_CNT_REENC, 1);
         hal_task->length -= hal_task->hw_length;
         hal_task->hw_length = 0;
 
@@ -2829,6 +2982,7 @@ TASK_DONE:
         enc->frm_cfg.force_flag |= ENC_FORCE_IDR;
         enc->hdr_status.val = 0;
         mpp_packet_set_length(packet, 0);
+        mpp_packet_reset_chunk(packet);
         mpp_err_f("enc failed force idr!\n");
     } else
         set_enc_info_to_packet(enc, hal_task);
@@ -2919,6 +3073,7 @@ void *mpp_enc_thread(void *data)
 
                 enc->frm_cfg.force_flag |= ENC_FORCE_IDR;
                 enc->frm_cfg.force_idr++;
+                rc_reset(enc->rc_ctx);
 
                 mpp_thread_lock(thd_enc, THREAD_CONTROL);
                 enc->reset_flag = 0;
@@ -3014,7 +3169,7 @@ static void async_task_terminate(MppEncImpl *enc, EncAsyncTaskInfo *async)
     async_task_reset(async);
 }
 
-static void async_task_skip(MppEncImpl *enc)
+static MPP_RET async_task_skip(MppEncImpl *enc)
 {
     Mpp *mpp = (Mpp*)enc->mpp;
     MppStopwatch stopwatch = NULL;
@@ -3022,8 +3177,14 @@ static void async_task_skip(MppEncImpl *enc)
     MppFrame frm = NULL;
     MppPacket pkt = NULL;
 
-    mpp_list_del_at_head(mpp->mFrmIn, &frm, sizeof(frm));
-    mpp->mFrameGetCount++;
+    /* frames in lookahead queue are older than the input queue */
+    if (!enc->la || mpp_enc_la_drop(enc->la, &frm)) {
+        if (!mpp_list_size(mpp->mFrmIn))
+            return MPP_NOK;
+
+        mpp_list_del_at_head(mpp->mFrmIn, &frm, sizeof(frm));
+        mpp->mFrameGetCount++;
+    }
 
     mpp_assert(frm);
 
@@ -3044,6 +3205,7 @@ static void async_task_skip(MppEncImpl *enc)
     mpp_assert(pkt);
 
     mpp_packet_set_length(pkt, 0);
+    mpp_packet_reset_chunk(pkt);
     mpp_packet_set_pts(pkt, mpp_frame_get_pts(frm));
     mpp_packet_set_dts(pkt, mpp_frame_get_dts(frm));
 
@@ -3069,6 +3231,8 @@ static void async_task_skip(MppEncImpl *enc)
     }
 
     enc_dbg_detail("packet skip ready\n");
+
+    return MPP_OK;
 }
 
 static MPP_RET check_async_frm_pkt(EncAsyncTaskInfo *async)
@@ -3080,9 +3244,11 @@ static MPP_RET check_async_frm_pkt(EncAsyncTaskInfo *async)
     hal_task->input = NULL;
     hal_task->output = NULL;
 
-    if (packet)
+    if (packet) {
         hal_task->output = mpp_packet_get_buffer(packet);
-    else {
+        /* drop chunks left in user packet by last frame */
+        mpp_packet_reset_chunk(packet);
+    } else {
         mpp_packet_new(&packet);
         hal_task->packet = packet;
     }
@@ -3124,6 +3290,7 @@ static MPP_RET check_async_pkt_buf(MppEncImpl *enc, EncAsyncTaskInfo *async)
         mpp_buffer_get(mpp->mPacketGroup, &buffer, size);
         mpp_buffer_attach_dev(buffer, enc->dev);
         mpp_assert(buffer);
+        mpp_stats_add(mpp->mStats, MPP_STATS_CNT_BUF_ALLOC, 1);
         enc->pkt_buf = buffer;
         pkt->data   = mpp_buffer_get_ptr(buffer);
         pkt->pos    = pkt->data;
@@ -3143,6 +3310,40 @@ static MPP_RET check_async_pkt_buf(MppEncImpl *enc, EncAsyncTaskInfo *async)
     return MPP_OK;
 }
 
+/* move input frames to lookahead queue and get one analyzed frame */
+static MppFrame try_get_la_frame(MppEncImpl *enc, EncRcTaskInfo *info)
+{
+    Mpp *mpp = (Mpp *)enc->mpp;
+    MppList *frm_in = mpp->mFrmIn;
+    MppEncLaInfo la_info;
+    MppFrame frame = NULL;
+
+    while (mpp_list_size(frm_in)) {
+        mpp_list_del_at_head(frm_in, &frame, sizeof(frame));
+        if (mpp_enc_la_push(enc->la, enc->cfg->rc.lookahead, frame)) {
+            mpp_list_add_at_head(frm_in, &frame, sizeof(frame));
+            break;
+        }
+
+        mpp_list_signal(frm_in);
+        mpp->mFrameGetCount++;
+    }
+
+    frame = NULL;
+    if (mpp_enc_la_pop(enc->la, enc->cfg->rc.lookahead, &frame, &la_info))
+        return NULL;
+
+    info->la_depth = la_info.depth;
+    info->la_cost = la_info.cost;
+    info->la_cost_avg = la_info.cost_avg;
+    info->la_cut_dist = la_info.cut_dist;
+
+    enc_dbg_detail("lookahead depth %d cost %d avg %d cut %d\n", la_info.depth,
+                   la_info.cost, la_info.cost_avg, la_info.cut_dist);
+
+    return frame;
+}
+
 static MPP_RET try_get_async_task(MppEncImpl *enc, EncAsyncWait *wait)
 {
     Mpp *mpp = (Mpp *)enc->mpp;
@@ -3187,16 +3388,21 @@ static MPP_RET try_get_async_task(MppEncImpl *enc, EncAsyncWait *wait)
         if (mpp->mFrmIn) {
             MppList *frm_in = mpp->mFrmIn;
 
+            if (enc->cfg->rc.lookahead && !enc->la)
+                mpp_enc_la_init(&enc->la, enc);
+
             mpp_mutex_cond_lock(&frm_in->cond_lock);
 
-            if (mpp_list_size(frm_in)) {
+            if (enc->la) {
+                frame = try_get_la_frame(enc, &rc_task->info);
+            } else if (mpp_list_size(frm_in)) {
                 mpp_list_del_at_head(frm_in, &frame, sizeof(frame));
                 mpp_list_signal(frm_in);
 
                 mpp->mFrameGetCount++;
+            }
 
-                mpp_assert(frame);
-
+            if (frame) {
                 status->task_in_rdy = 1;
                 wait->enc_frm_in = 0;
 
@@ -3313,16 +3519,12 @@ static MPP_RET try_get_async_task(MppEncImpl *enc, EncAsyncWait *wait)
     // 12. generate header before hardware stream
     if (!hdr_status->ready) {
         /* config cpb before generating header */
-        enc_impl_gen_hdr(enc->impl, enc->hdr_pkt);
-        enc->hdr_len = mpp_packet_get_length(enc->hdr_pkt);
-        hdr_status->ready = 1;
+        mpp_enc_gen_hdr(enc);
 
         enc_dbg_detail("task %d update header length %d\n",
                        seq_idx, enc->hdr_len);
 
-        mpp_packet_append(hal_task->packet, enc->hdr_pkt);
-        hal_task->header_length = enc->hdr_len;
-        hal_task->length += enc->hdr_len;
+        mpp_enc_add_hdr(enc, hal_task, hal_task->packet);
         hdr_status->added_by_change = 1;
     }
 
@@ -3530,7 +3732,10 @@ static MPP_RET enc_async_wait_task(MppEncImpl *enc, EncAsyncTaskInfo *info)
         goto TASK_DONE;
 
     enc_dbg_detail("task %d hal wait\n", frm->seq_idx);
+    mpp_clock_start(enc->hw_clk);
     ENC_RUN_FUNC2(mpp_enc_hal_wait, hal, hal_task, mpp, ret);
+    mpp_clock_pause(enc->hw_clk);
+    mpp_stats_add(mpp->mStats, MPP_STATS_CNT_HW_RUN, 1);
 
     mpp_stopwatch_record(hal_task->stopwatch, "encode hal finish");
 
@@ -3559,6 +3764,7 @@ TASK_DONE:
      */
     if (enc->enc_failed_drop && !hal_task->rc_task->frm.is_idr) {
         mpp_packet_set_length(pkt, 0);
+        mpp_packet_reset_chunk(pkt);
         mpp_err_f("last frame enc failed, drop this P frame\n");
         enc->frm_cfg.force_flag |= ENC_FORCE_IDR;
         enc->hdr_status.val = 0;
@@ -3569,6 +3775,7 @@ TASK_DONE:
         enc->frm_cfg.force_flag |= ENC_FORCE_IDR;
         enc->hdr_status.val = 0;
         mpp_packet_set_length(pkt, 0);
+        mpp_packet_reset_chunk(pkt);
         enc->enc_failed_drop = 1;
 
         mpp_err_f("enc failed force idr!\n");
@@ -3654,9 +3861,9 @@ void *mpp_enc_async_thread(void *data)
             if (enc->reset_flag) {
                 enc_dbg_detail("thread reset start\n");
 
-                /* skip the frames in input queue */
-                while (mpp_list_size(frm_in))
-                    async_task_skip(enc);
+                /* skip the frames in lookahead and input queue */
+                while (MPP_OK == async_task_skip(enc))
+                    ;
 
                 {
                     mpp_thread_lock(thd_enc, THREAD_WORK);
@@ -3666,6 +3873,7 @@ void *mpp_enc_async_thread(void *data)
 
                 enc->frm_cfg.force_flag |= ENC_FORCE_IDR;
                 enc->frm_cfg.force_idr++;
+                rc_reset(enc->rc_ctx);
 
                 mpp_thread_lock(thd_enc, THREAD_CONTROL);
                 enc->reset_flag = 0;
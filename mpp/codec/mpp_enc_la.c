@@ -0,0 +1,477 @@
+/* SPDX-License-Identifier: Apache-2.0 OR MIT */
+/*
+ * Copyright (c) 2026 Rockchip Electronics Co., Ltd.
+ */
+
+#define MODULE_TAG "mpp_enc_la"
+
+#include <string.h>
+
+#include "mpp_env.h"
+#include "mpp_mem.h"
+#include "mpp_debug.h"
+#include "mpp_common.h"
+#include "mpp_thread.h"
+#include "mpp_buffer.h"
+
+#include "mpp.h"
+#include "mpp_enc_la.h"
+
+#define LA_DBG_FUNC                 (0x00000001)
+#define LA_DBG_INFO                 (0x00000002)
+
+#define la_dbg_func(fmt, ...)       mpp_dbg_f(mpp_enc_la_debug, LA_DBG_FUNC, fmt, ## __VA_ARGS__)
+#define la_dbg_info(fmt, ...)       mpp_dbg_f(mpp_enc_la_debug, LA_DBG_INFO, fmt, ## __VA_ARGS__)
+
+/* current frame plus the frames ahead */
+#define LA_QUEUE_SIZE               (MPP_ENC_LA_MAX_DEPTH + 1)
+/* down scale ratio and the block size on down scaled plane */
+#define LA_DS_SHIFT                 2
+#define LA_BLK_SIZE                 8
+
+typedef struct MppEncLaNode_t {
+    MppFrame        frame;
+    RK_S32          cost;
+    RK_S32          cut;
+} MppEncLaNode;
+
+typedef struct MppEncLaImpl_t {
+    MppEnc          enc;
+    MppSThd         thd;
+
+    /* lock for the queue fields below, signaled on push, analysis done and quit */
+    MppMutexCond    cond;
+    MppEncLaNode    nodes[LA_QUEUE_SIZE];
+    RK_S32          head;
+    RK_S32          count;
+    /* analyzed node count from head */
+    RK_S32          done;
+    /* node at head + done is under analysis */
+    RK_S32          busy;
+    /* eos frame count in queue */
+    RK_S32          flush;
+    RK_U32          quit;
+
+    /* worker only: down scaled luma of current and previous frame */
+    RK_U8           *ds[2];
+    RK_U16          *acc;
+    RK_S32          ds_idx;
+    RK_S32          ds_w;
+    RK_S32          ds_h;
+    RK_S32          prev_valid;
+    /* moving average of inter cost for scene cut check */
+    RK_S32          inter_avg;
+} MppEncLaImpl;
+
+static RK_U32 mpp_enc_la_debug = 0;
+
+static RK_U32 la_fmt_support(MppFrameFormat fmt)
+{
+    MppFrameFormat base = (MppFrameFormat)(fmt & MPP_FRAME_FMT_MASK);
+
+    if (!MPP_FRAME_FMT_IS_YUV(fmt) || MPP_FRAME_FMT_IS_FBC(fmt) ||
+        MPP_FRAME_FMT_IS_TILE(fmt) || MPP_FRAME_FMT_IS_YUV_10BIT(fmt))
+        return 0;
+
+    /* packed yuv has no separated luma plane */
+    if (base >= MPP_FMT_YUV422_YUYV && base <= MPP_FMT_YUV422_VYUY)
+        return 0;
+
+    return 1;
+}
+
+/* average each 4x4 luma block, the loops are kept simple for vectorization */
+static void la_downscale(MppEncLaImpl *p, RK_U8 *dst, const RK_U8 *src, RK_S32 stride)
+{
+    RK_S32 w = p->ds_w << LA_DS_SHIFT;
+    RK_U16 *acc = p->acc;
+    RK_S32 x, y;
+
+    for (y = 0; y < p->ds_h; y++) {
+        const RK_U8 *s0 = src;
+        const RK_U8 *s1 = s0 + stride;
+        const RK_U8 *s2 = s1 + stride;
+        const RK_U8 *s3 = s2 + stride;
+
+        for (x = 0; x < w; x++)
+            acc[x] = s0[x] + s1[x] + s2[x] + s3[x];
+
+        for (x = 0; x < p->ds_w; x++) {
+            const RK_U16 *a = acc + (x << LA_DS_SHIFT);
+
+            dst[x] = (a[0] + a[1] + a[2] + a[3] + 8) >> 4;
+        }
+
+        src += stride << LA_DS_SHIFT;
+        dst += p->ds_w;
+    }
+}
+
+static RK_U32 la_inter_sad(const RK_U8 *cur, const RK_U8 *ref)
+{
+    RK_U32 sad = 0;
+    RK_S32 x;
+
+    for (x = 0; x < LA_BLK_SIZE; x++)
+        sad += MPP_ABS(cur[x] - ref[x]);
+
+    return sad;
+}
+
+/* residual of left / top average prediction, top is NULL on first row */
+static RK_U32 la_intra_sad(const RK_U8 *cur, const RK_U8 *top, RK_S32 x0)
+{
+    RK_U32 sad = 0;
+    RK_S32 x;
+
+    for (x = x0; x < x0 + LA_BLK_SIZE; x++) {
+        RK_S32 left = x ? cur[x - 1] : (top ? top[x] : 128);
+        RK_S32 up = top ? top[x] : left;
+        RK_S32 pred = (left + up + 1) >> 1;
+
+        sad += MPP_ABS(cur[x] - pred);
+    }
+
+    return sad;
+}
+
+static void la_analyze(MppEncLaImpl *p, MppEncLaNode *node)
+{
+    MppFrame frame = node->frame;
+    MppBuffer buf = mpp_frame_get_buffer(frame);
+    MppFrameFormat fmt = mpp_frame_get_fmt(frame);
+    RK_S32 width = mpp_frame_get_width(frame);
+    RK_S32 height = mpp_frame_get_height(frame);
+    RK_S32 stride = mpp_frame_get_hor_stride(frame);
+    RK_S32 ds_w = width >> LA_DS_SHIFT;
+    RK_S32 ds_h = height >> LA_DS_SHIFT;
+    RK_S32 blk_w = ds_w / LA_BLK_SIZE;
+    RK_S32 blk_h = ds_h / LA_BLK_SIZE;
+    RK_S64 intra_sum = 0;
+    RK_S64 inter_sum = 0;
+    RK_S64 cost_sum = 0;
+    RK_S32 intra, inter, cost, pixels;
+    RK_U8 *src, *cur, *prev;
+    RK_S32 bx, by, y;
+
+    node->cost = 0;
+    node->cut = 0;
+
+    if (!buf || !blk_w || !blk_h || !la_fmt_support(fmt)) {
+        p->prev_valid = 0;
+        return;
+    }
+
+    if (ds_w != p->ds_w || ds_h != p->ds_h) {
+        MPP_FREE(p->ds[0]);
+        MPP_FREE(p->ds[1]);
+        MPP_FREE(p->acc);
+
+        p->ds[0] = mpp_malloc(RK_U8, ds_w * ds_h);
+        p->ds[1] = mpp_malloc(RK_U8, ds_w * ds_h);
+        p->acc = mpp_malloc(RK_U16, ds_w << LA_DS_SHIFT);
+        p->ds_w = ds_w;
+        p->ds_h = ds_h;
+        p->prev_valid = 0;
+
+        if (!p->ds[0] || !p->ds[1] || !p->acc) {
+            mpp_err_f("failed to malloc down scale buffer %dx%d\n", ds_w, ds_h);
+            MPP_FREE(p->ds[0]);
+            MPP_FREE(p->ds[1]);
+            MPP_FREE(p->acc);
+            p->ds_w = 0;
+            p->ds_h = 0;
+            return;
+        }
+    }
+
+    src = (RK_U8 *)mpp_buffer_get_ptr(buf);
+    if (!src)
+        return;
+
+    src += mpp_frame_get_offset_y(frame) * stride + mpp_frame_get_offset_x(frame);
+    cur = p->ds[p->ds_idx];
+    prev = p->ds[!p->ds_idx];
+
+    mpp_buffer_sync_ro_begin(buf);
+    la_downscale(p, cur, src, stride);
+    mpp_buffer_sync_ro_end(buf);
+
+    for (by = 0; by < blk_h; by++) {
+        for (bx = 0; bx < blk_w; bx++) {
+            RK_S32 x0 = bx * LA_BLK_SIZE;
+            RK_U32 intra_blk = 0;
+            RK_U32 inter_blk = 0;
+
+            for (y = 0; y < LA_BLK_SIZE; y++) {
+                RK_S32 row = by * LA_BLK_SIZE + y;
+                RK_U8 *line = cur + row * ds_w;
+                RK_U8 *top = row ? line - ds_w : NULL;
+
+                intra_blk += la_intra_sad(line, top, x0);
+                if (p->prev_valid)
+                    inter_blk += la_inter_sad(line + x0, prev + row * ds_w + x0);
+            }
+
+            if (!p->prev_valid)
+                inter_blk = intra_blk;
+
+            intra_sum += intra_blk;
+            inter_sum += inter_blk;
+            cost_sum += MPP_MIN(intra_blk, inter_blk);
+        }
+    }
+
+    pixels = blk_w * blk_h * LA_BLK_SIZE * LA_BLK_SIZE;
+    intra = (RK_S32)(intra_sum * 16 / pixels);
+    inter = (RK_S32)(inter_sum * 16 / pixels);
+    cost = (RK_S32)(cost_sum * 16 / pixels);
+
+    /*
+     * Scene cut when inter prediction hardly helps on most blocks and the
+     * temporal difference jumps over the recent level.
+     */
+    if (!p->prev_valid) {
+        p->inter_avg = 0;
+    } else if (!p->inter_avg) {
+        p->inter_avg = MPP_MAX(inter, 1);
+    } else {
+        if (cost * 10 > intra * 7 && inter > p->inter_avg * 2 && cost > 32)
+            node->cut = 1;
+
+        p->inter_avg = (p->inter_avg * 7 + inter) >> 3;
+    }
+
+    node->cost = MPP_MAX(cost, 1);
+    p->prev_valid = 1;
+    p->ds_idx = !p->ds_idx;
+
+    la_dbg_info("frame pts %lld cost %d intra %d inter %d avg %d cut %d\n",
+                mpp_frame_get_pts(frame), node->cost, intra, inter,
+                p->inter_avg, node->cut);
+}
+
+static void *la_worker(MppSThdCtx *ctx)
+{
+    MppEncLaImpl *p = (MppEncLaImpl *)ctx->ctx;
+
+    mpp_mutex_cond_lock(&p->cond);
+    while (!p->quit) {
+        if (p->done < p->count) {
+            MppEncLaNode *node = &p->nodes[(p->head + p->done) % LA_QUEUE_SIZE];
+
+            p->busy = 1;
+            mpp_mutex_cond_unlock(&p->cond);
+
+            la_analyze(p, node);
+
+            mpp_mutex_cond_lock(&p->cond);
+            p->busy = 0;
+            p->done++;
+            mpp_mutex_cond_broadcast(&p->cond);
+            mpp_mutex_cond_unlock(&p->cond);
+
+            /* wake up encoder thread waiting for input frame */
+            if (p->enc)
+                mpp_enc_notify_v2(p->enc, MPP_ENC_NOTIFY_FRAME_ENQUEUE);
+
+            mpp_mutex_cond_lock(&p->cond);
+            continue;
+        }
+
+        mpp_mutex_cond_wait(&p->cond);
+    }
+    mpp_mutex_cond_unlock(&p->cond);
+
+    return NULL;
+}
+
+MPP_RET mpp_enc_la_init(MppEncLa *ctx, MppEnc enc)
+{
+    MppEncLaImpl *p = NULL;
+
+    if (!ctx) {
+        mpp_err_f("invalid NULL input ctx\n");
+        return MPP_ERR_NULL_PTR;
+    }
+
+    *ctx = NULL;
+
+    mpp_env_get_u32("mpp_enc_la_debug", &mpp_enc_la_debug, 0);
+
+    p = mpp_calloc(MppEncLaImpl, 1);
+    if (!p) {
+        mpp_err_f("failed to malloc lookahead context\n");
+        return MPP_ERR_NOMEM;
+    }
+
+    p->thd = mpp_sthd_get("mpp_enc_la");
+    if (!p->thd) {
+        mpp_free(p);
+        return MPP_NOK;
+    }
+
+    p->enc = enc;
+    mpp_mutex_cond_init(&p->cond);
+
+    mpp_sthd_setup(p->thd, la_worker, p);
+    mpp_sthd_set_policy(p->thd, MPP_THREAD_ROLE_COMPUTE, MPP_THREAD_PLACE_DEFAULT, 0);
+    mpp_sthd_start(p->thd);
+
+    la_dbg_func("lookahead %p init\n", p);
+
+    *ctx = p;
+
+    return MPP_OK;
+}
+
+MPP_RET mpp_enc_la_deinit(MppEncLa ctx)
+{
+    MppEncLaImpl *p = (MppEncLaImpl *)ctx;
+
+    if (!p)
+        return MPP_OK;
+
+    mpp_mutex_cond_lock(&p->cond);
+    p->quit = 1;
+    mpp_mutex_cond_broadcast(&p->cond);
+    mpp_mutex_cond_unlock(&p->cond);
+
+    mpp_sthd_stop(p->thd);
+    mpp_sthd_stop_sync(p->thd);
+    mpp_sthd_put(p->thd);
+
+    while (p->count) {
+        MppEncLaNode *node = &p->nodes[p->head];
+
+        if (node->frame)
+            mpp_frame_deinit(&node->frame);
+
+        p->head = (p->head + 1) % LA_QUEUE_SIZE;
+        p->count--;
+    }
+
+    MPP_FREE(p->ds[0]);
+    MPP_FREE(p->ds[1]);
+    MPP_FREE(p->acc);
+
+    mpp_mutex_cond_destroy(&p->cond);
+    mpp_free(p);
+
+    return MPP_OK;
+}
+
+MPP_RET mpp_enc_la_push(MppEncLa ctx, RK_S32 depth, MppFrame frame)
+{
+    MppEncLaImpl *p = (MppEncLaImpl *)ctx;
+    MppEncLaNode *node;
+
+    if (!p || !frame)
+        return MPP_ERR_NULL_PTR;
+
+    depth = mpp_clip(depth, 0, MPP_ENC_LA_MAX_DEPTH);
+
+    mpp_mutex_cond_lock(&p->cond);
+    /* hold no more input buffers than the pop window needs */
+    if (p->count > depth) {
+        mpp_mutex_cond_unlock(&p->cond);
+        return MPP_NOK;
+    }
+
+    node = &p->nodes[(p->head + p->count) % LA_QUEUE_SIZE];
+    node->frame = frame;
+    node->cost = 0;
+    node->cut = 0;
+    p->count++;
+
+    if (mpp_frame_get_eos(frame))
+        p->flush++;
+
+    mpp_mutex_cond_broadcast(&p->cond);
+    mpp_mutex_cond_unlock(&p->cond);
+
+    return MPP_OK;
+}
+
+static MppFrame la_take_head(MppEncLaImpl *p)
+{
+    MppEncLaNode *node = &p->nodes[p->head];
+    MppFrame frame = node->frame;
+
+    if (mpp_frame_get_eos(frame))
+        p->flush--;
+
+    node->frame = NULL;
+    p->head = (p->head + 1) % LA_QUEUE_SIZE;
+    p->count--;
+    if (p->done)
+        p->done--;
+
+    return frame;
+}
+
+MPP_RET mpp_enc_la_pop(MppEncLa ctx, RK_S32 depth, MppFrame *frame, MppEncLaInfo *info)
+{
+    MppEncLaImpl *p = (MppEncLaImpl *)ctx;
+    RK_S64 cost_sum = 0;
+    RK_S32 window;
+    RK_S32 i;
+
+    if (!p || !frame || !info)
+        return MPP_ERR_NULL_PTR;
+
+    depth = mpp_clip(depth, 0, MPP_ENC_LA_MAX_DEPTH);
+
+    mpp_mutex_cond_lock(&p->cond);
+
+    /* wait for the frames ahead or all queued frames when eos is queued */
+    if (!p->done || (p->done <= depth && (!p->flush || p->done < p->count))) {
+        mpp_mutex_cond_unlock(&p->cond);
+        return MPP_NOK;
+    }
+
+    window = MPP_MIN(p->done, depth + 1);
+    info->depth = window - 1;
+    info->cost = p->nodes[p->head].cost;
+    info->cut_dist = -1;
+
+    for (i = 0; i < window; i++) {
+        MppEncLaNode *node = &p->nodes[(p->head + i) % LA_QUEUE_SIZE];
+
+        cost_sum += node->cost;
+        if (node->cut && info->cut_dist < 0)
+            info->cut_dist = i;
+    }
+    info->cost_avg = (RK_S32)(cost_sum / window);
+
+    *frame = la_take_head(p);
+
+    mpp_mutex_cond_unlock(&p->cond);
+
+    return MPP_OK;
+}
+
+MPP_RET mpp_enc_la_drop(MppEncLa ctx, MppFrame *frame)
+{
+    MppEncLaImpl *p = (MppEncLaImpl *)ctx;
+
+    if (!p || !frame)
+        return MPP_ERR_NULL_PTR;
+
+    mpp_mutex_cond_lock(&p->cond);
+
+    /* head frame may be under analysis */
+    while (p->count && !p->done && p->busy)
+        mpp_mutex_cond_wait(&p->cond);
+
+    if (!p->count) {
+        mpp_mutex_cond_unlock(&p->cond);
+        return MPP_NOK;
+    }
+
+    *frame = la_take_head(p);
+
+    mpp_mutex_cond_unlock(&p->cond);
+
+    return MPP_OK;
+}
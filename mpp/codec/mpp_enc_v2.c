@@ -132,6 +132,8 @@ MPP_RET mpp_enc_init_v2(MppEnc *enc, MppEncInitCfg *cfg)
     p->version_length = strlen(p->version_info);
     p->rc_cfg_size = SZ_1K;
     p->rc_cfg_info = mpp_calloc_size(char, p->rc_cfg_size);
+    p->hw_clk = mpp_clock_get("enc_hw");
+    mpp_clock_set_stats(p->hw_clk, ((Mpp *)p->mpp)->mStats, MPP_STATS_HIST_HW);
 
     if (enc_hal_cfg.cap_recn_out)
         p->support_hw_deflicker = 1;
@@ -187,6 +189,11 @@ MPP_RET mpp_enc_deinit_v2(MppEnc ctx)
 
     mpp_mutex_destroy(&enc->lock);
 
+    if (enc->la) {
+        mpp_enc_la_deinit(enc->la);
+        enc->la = NULL;
+    }
+
     if (enc->hal_info) {
         hal_info_deinit(enc->hal_info);
         enc->hal_info = NULL;
@@ -207,6 +214,11 @@ MPP_RET mpp_enc_deinit_v2(MppEnc ctx)
 
     MPP_FREE(enc->hdr_buf);
 
+    if (enc->hdr_chunk) {
+        mpp_buffer_put(enc->hdr_chunk);
+        enc->hdr_chunk = NULL;
+    }
+
     if (enc->set->ref_cfg) {
         mpp_enc_ref_cfg_deinit(&enc->set->ref_cfg);
         enc->set->ref_cfg = NULL;
@@ -241,6 +253,11 @@ MPP_RET mpp_enc_deinit_v2(MppEnc ctx)
     enc->rc_cfg_size = 0;
     enc->rc_cfg_length = 0;
 
+    if (enc->hw_clk) {
+        mpp_clock_put(enc->hw_clk);
+        enc->hw_clk = NULL;
+    }
+
     sem_destroy(&enc->enc_reset);
     sem_destroy(&enc->cmd_start);
     sem_destroy(&enc->cmd_done);
@@ -252,6 +269,7 @@ MPP_RET mpp_enc_deinit_v2(MppEnc ctx)
 MPP_RET mpp_enc_start_v2(MppEnc ctx)
 {
     MppEncImpl *enc = (MppEncImpl *)ctx;
+    Mpp *mpp = (Mpp *)enc->mpp;
     char name[16];
 
     enc_dbg_func("%p in\n", enc);
@@ -260,6 +278,9 @@ MPP_RET mpp_enc_start_v2(MppEnc ctx)
              strof_coding_type(enc->coding), getpid());
 
     enc->thread_enc = mpp_thread_create(mpp_enc_thread, enc->mpp, name);
+    /* encoder thread generates registers and waits hardware in turn */
+    mpp_thread_set_policy(enc->thread_enc, MPP_THREAD_ROLE_COMPUTE,
+                          mpp->mThreadPlace, mpp->mThreadPrio);
     mpp_thread_start(enc->thread_enc);
 
     enc_dbg_func("%p out\n", enc);
@@ -270,6 +291,7 @@ MPP_RET mpp_enc_start_v2(MppEnc ctx)
 MPP_RET mpp_enc_start_async(MppEnc ctx)
 {
     MppEncImpl *enc = (MppEncImpl *)ctx;
+    Mpp *mpp = (Mpp *)enc->mpp;
     char name[16];
 
     enc_dbg_func("%p in\n", enc);
@@ -278,6 +300,9 @@ MPP_RET mpp_enc_start_async(MppEnc ctx)
              strof_coding_type(enc->coding), getpid());
 
     enc->thread_enc = mpp_thread_create(mpp_enc_async_thread, enc->mpp, name);
+    /* encoder thread generates registers and waits hardware in turn */
+    mpp_thread_set_policy(enc->thread_enc, MPP_THREAD_ROLE_COMPUTE,
+                          mpp->mThreadPlace, mpp->mThreadPrio);
     mpp_thread_start(enc->thread_enc);
 
     enc_dbg_func("%p out\n", enc);
@@ -303,6 +328,16 @@ MPP_RET mpp_enc_stop_v2(MppEnc ctx)
 
 }
 
+void mpp_enc_get_cpu_time(MppEnc ctx, MppStatsCpuTime *time)
+{
+    MppEncImpl *enc = (MppEncImpl *)ctx;
+
+    if (!enc || !enc->thread_enc)
+        return;
+
+    time->time[MPP_STATS_THREAD_PARSER] = mpp_thread_get_cpu_time(enc->thread_enc);
+}
+
 MPP_RET mpp_enc_reset_v2(MppEnc ctx)
 {
     MppEncImpl *enc = (MppEncImpl *)ctx;
@@ -178,3 +178,25 @@ MPP_ENC_RC_FUNC(frm, start)
 MPP_ENC_RC_FUNC(frm, end)
 MPP_ENC_RC_FUNC(hal, start)
 MPP_ENC_RC_FUNC(hal, end)
+
+MPP_RET rc_reset(RcCtx ctx)
+{
+    MppRcImpl *p = (MppRcImpl *)ctx;
+    const RcImplApi *api;
+
+    if (!p || !p->cfg.pass)
+        return MPP_OK;
+
+    /*
+     * Multi-pass stats live in the rc api context and restart from the
+     * first record on init. Other sessions keep the rc state on reset.
+     */
+    api = p->api;
+    if (!api || !api->init || !p->ctx)
+        return MPP_OK;
+
+    if (api->deinit)
+        api->deinit(p->ctx);
+
+    return api->init(p->ctx, &p->cfg);
+}
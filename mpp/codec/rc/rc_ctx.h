@@ -18,6 +18,7 @@
 
 #include "mpp_rc_api.h"
 #include "rc_base.h"
+#include "rc_stats.h"
 
 typedef struct RcModelV2Ctx_t {
     RcCfg           usr_cfg;
@@ -95,6 +96,14 @@ typedef struct RcModelV2Ctx_t {
     RK_S32          gop_qp_sum;
     RK_S32          gop_frm_cnt;
     RK_S32          pre_iblk4_prop;
+    /* lookahead planned cost of previous P frame */
+    RK_S32          la_cost_prev;
+    /* multi-pass stats of pass and file in usr_cfg */
+    RcStats         stats;
+    RK_S32          stats_pass;
+    char            stats_file[RC_STATS_FILE_LEN];
+    /* multi-pass real bits minus planned bits */
+    RK_S64          mp_drift;
 
     RK_S32          reenc_cnt;
     RK_U32          drop_cnt;
@@ -1358,6 +1358,26 @@ MPP_RET check_re_enc(RcModelV2Ctx *ctx, EncRcTaskInfo *cfg)
 }
 
 
+static void rc_model_v2_update_stats(RcModelV2Ctx *p, RcCfg *cfg)
+{
+    const char *path = cfg->stats_file ? cfg->stats_file : "";
+
+    if (p->stats_pass != cfg->pass ||
+        strncmp(p->stats_file, path, sizeof(p->stats_file) - 1)) {
+        rc_stats_deinit(p->stats);
+        p->stats = NULL;
+        p->stats_pass = cfg->pass;
+        strncpy(p->stats_file, path, sizeof(p->stats_file) - 1);
+        p->mp_drift = 0;
+
+        if (cfg->pass && rc_stats_init(&p->stats, cfg->pass, path))
+            mpp_err_f("failed to init pass %d stats use single pass\n", cfg->pass);
+    }
+
+    /* replan on every config update for the bitrate may change */
+    rc_stats_plan(p->stats, cfg);
+}
+
 MPP_RET rc_model_v2_init(void *ctx, RcCfg *cfg)
 {
     RcModelV2Ctx *p = (RcModelV2Ctx*)ctx;
@@ -1369,6 +1389,7 @@ MPP_RET rc_model_v2_init(void *ctx, RcCfg *cfg)
               cfg->fqp_min_p, cfg->fqp_max_p);
 
     bits_model_init(p);
+    rc_model_v2_update_stats(p, cfg);
 
     rc_dbg_func("leave %p\n", ctx);
     return MPP_OK;
@@ -1381,6 +1402,11 @@ MPP_RET rc_model_v2_deinit(void *ctx)
     rc_dbg_func("enter %p\n", ctx);
     bits_model_param_deinit(p);
 
+    rc_stats_deinit(p->stats);
+    p->stats = NULL;
+    p->stats_pass = 0;
+    p->stats_file[0] = '\0';
+
     rc_dbg_func("leave %p\n", ctx);
     return MPP_OK;
 }
@@ -1391,9 +1417,12 @@ MPP_RET rc_model_v2_start(void *ctx, EncRcTask *task)
     EncFrmStatus *frm = &task->frm;
     EncRcTaskInfo *info = &task->info;
     RcCfg *usr_cfg = &p->usr_cfg;
+    RcStatsPlan plan;
 
     rc_dbg_func("enter %p\n", ctx);
 
+    rc_stats_read(p->stats, task, &plan);
+
     if (usr_cfg->mode == RC_FIXQP) {
         if (usr_cfg->init_quality <= 0) {
             mpp_log("invalid fix %d qp found set default qp 26\n",
@@ -1461,6 +1490,10 @@ MPP_RET rc_model_v2_start(void *ctx, EncRcTask *task)
         info->quality_min = usr_cfg->min_quality;
     }
 
+    /* multi-pass plan replaces the bits allocated by the model */
+    if (plan.bits > 0)
+        info->bit_target = plan.bits;
+
     bits_model_preset(p, info);
 
     rc_dbg_rc("seq_idx %d intra %d\n", frm->seq_idx, frm->is_intra);
@@ -1560,6 +1593,64 @@ static RK_S32 derive_min_qp_from_complexity(RcModelV2Ctx *ctx, EncRcTaskInfo *in
     return qp_min;
 }
 
+/*
+ * Feed forward qp change from lookahead complexity. The planned cost mixes
+ * the current frame with the frames ahead so qp rises before a complex
+ * scene arrives instead of reencoding after it. The ratio of planned cost
+ * to the planned cost of previous P frame maps to qp scale by the log table
+ * where tab_lnx[32 * ratio - 1] is zero at equal cost.
+ */
+static RK_S32 calc_la_ratio(RcModelV2Ctx *p, EncRcTaskInfo *info)
+{
+    RK_S32 ratio = 0;
+    RK_S32 cost;
+
+    if (info->la_cost <= 0) {
+        p->la_cost_prev = 0;
+        return 0;
+    }
+
+    if (p->reenc_cnt)
+        return 0;
+
+    cost = (info->la_cost + info->la_cost_avg + 1) >> 1;
+
+    if (p->la_cost_prev > 0) {
+        RK_S32 idx = mpp_clip((cost << 5) / p->la_cost_prev - 1, 0, 63);
+
+        /* scene cut frame has more intra blocks so allow larger step */
+        ratio = mpp_clip(tab_lnx[idx], -128, info->la_cut_dist ? 128 : 256);
+
+        rc_dbg_qp("lookahead cost %d avg %d plan %d prev %d cut %d ratio %d\n",
+                  info->la_cost, info->la_cost_avg, cost, p->la_cost_prev,
+                  info->la_cut_dist, ratio);
+    }
+
+    p->la_cost_prev = cost;
+
+    return ratio;
+}
+
+/*
+ * Multi-pass planned qp replaces the feedback qp. The plan already spends
+ * the whole budget so only the drift between real and planned bits is fed
+ * back, one qp for every quarter second of bits away from the plan.
+ */
+static void calc_mp_qp(RcModelV2Ctx *p, RcStatsPlan *plan, EncRcTaskInfo *info,
+                       EncFrmStatus *frm)
+{
+    RK_S64 bits_per_qp = MPP_MAX(p->target_bps >> 2, 1);
+    RK_S32 delta = (RK_S32)MPP_CLIP3(-6, 6, p->mp_drift / bits_per_qp);
+    RK_S32 qp = mpp_clip(plan->qp + delta, info->quality_min, info->quality_max);
+
+    rc_dbg_qp("multi-pass qp plan %d drift %lld delta %d -> %d\n",
+              plan->qp, p->mp_drift, delta, qp);
+
+    p->start_qp = qp;
+    if (!p->reenc_cnt)
+        p->cur_scale_qp = (frm->is_intra ? qp + p->usr_cfg.i_quality_delta : qp) << 6;
+}
+
 MPP_RET rc_model_v2_hal_start(void *ctx, EncRcTask *task)
 {
     RcModelV2Ctx *p = (RcModelV2Ctx *)ctx;
@@ -1575,6 +1666,7 @@ MPP_RET rc_model_v2_hal_start(void *ctx, EncRcTask *task)
     RK_S32 quality_min = info->quality_min;
     RK_S32 quality_max = info->quality_max;
     RK_S32 quality_target = info->quality_target;
+    RcStatsPlan plan;
 
     rc_dbg_func("enter p %p task %p\n", p, task);
     rc_dbg_rc("seq_idx %d intra %d\n", frm->seq_idx, frm->is_intra);
@@ -1673,7 +1765,9 @@ MPP_RET rc_model_v2_hal_start(void *ctx, EncRcTask *task)
 
             p->gop_frm_cnt = 0;
             p->gop_qp_sum = 0;
+            p->la_cost_prev = 0;
         } else {
+            qp_scale += calc_la_ratio(p, info);
             qp_scale = mpp_clip(qp_scale, (qpmin << 6), (info->quality_max << 6));
             qp_scale = mpp_clip(qp_scale, (info->quality_min << 6), (info->quality_max << 6));
             p->cur_scale_qp = qp_scale;
@@ -1695,6 +1789,9 @@ MPP_RET rc_model_v2_hal_start(void *ctx, EncRcTask *task)
         p->start_qp = mpp_clip(p->start_qp, qpmin, 51);
     }
 
+    if (!rc_stats_get_plan(p->stats, task, &plan) && plan.bits > 0)
+        calc_mp_qp(p, &plan, info, frm);
+
     if (usr_cfg->hier_qp_cfg.hier_qp_en && !p->reenc_cnt) {
         rc_hier_calc_dealt_qp(p, info);
         if (p->qp_layer_id) {
@@ -1801,6 +1898,7 @@ MPP_RET rc_model_v2_end(void *ctx, EncRcTask *task)
     RcModelV2Ctx *p = (RcModelV2Ctx *)ctx;
     EncRcTaskInfo *cfg = (EncRcTaskInfo *)&task->info;
     RcCfg *usr_cfg = &p->usr_cfg;
+    RcStatsPlan plan;
 
     rc_dbg_func("enter ctx %p cfg %p\n", ctx, cfg);
 
@@ -1832,11 +1930,14 @@ MPP_RET rc_model_v2_end(void *ctx, EncRcTask *task)
     p->pre_target_bits = cfg->bit_target;
     p->pre_target_bits_fix = cfg->bit_target_fix;
     p->pre_real_bits = cfg->bit_real;
+    if (!rc_stats_get_plan(p->stats, task, &plan) && plan.bits > 0)
+        p->mp_drift += cfg->bit_real - plan.bits;
 
     p->on_drop = 0;
     p->on_pskip = 0;
 
 DONE:
+    rc_stats_write(p->stats, task);
     rc_dbg_func("leave %p\n", ctx);
     return MPP_OK;
 }
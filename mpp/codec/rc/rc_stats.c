@@ -0,0 +1,416 @@
+/* SPDX-License-Identifier: Apache-2.0 OR MIT */
+/*
+ * Copyright (c) 2026 Rockchip Electronics Co., Ltd.
+ */
+
+#define MODULE_TAG "rc_stats"
+
+#include <math.h>
+#include <stdio.h>
+#include <limits.h>
+#include <string.h>
+
+#include "mpp_mem.h"
+#include "mpp_common.h"
+
+#include "rc_debug.h"
+#include "rc_stats.h"
+
+#define RC_STATS_HEADER         "#mpp rc stats v1"
+#define RC_STATS_LINE_SIZE      256
+#define RC_STATS_INIT_COUNT     1024
+/* max tasks started and not ended at the same time */
+#define RC_STATS_TASK_MAX       8
+
+/* rate of complexity change passed to qscale, same as x264 qcomp */
+#define RC_STATS_QCOMP          0.6
+
+typedef struct RcStatsFrm_t {
+    RK_S32          intra;
+    RK_S32          qp;
+    RK_S32          bits;
+    RK_S32          madi;
+    RK_S32          madp;
+
+    /* complexity as bits at qscale 1 */
+    double          cplx;
+    /* planned result */
+    RK_S32          plan_qp;
+    RK_S32          plan_bits;
+} RcStatsFrm;
+
+/* record assigned to a started task */
+typedef struct RcStatsTask_t {
+    EncRcTask       *task;
+    RK_S32          idx;
+} RcStatsTask;
+
+typedef struct RcStatsImpl_t {
+    RK_S32          pass;
+    FILE            *fp;
+    char            *path;
+
+    RcStatsFrm      *frms;
+    RK_S32          count;
+    RK_S32          size;
+
+    /* record count assigned to started frames */
+    RK_S32          idx;
+    RcStatsTask     tasks[RC_STATS_TASK_MAX];
+    RK_S32          mismatch;
+} RcStatsImpl;
+
+/* bits are inversely proportional to qscale and qscale doubles every 6 qp */
+static double qp2qscale(double qp)
+{
+    return pow(2.0, (qp - 12.0) / 6.0);
+}
+
+static MPP_RET rc_stats_load(RcStatsImpl *p)
+{
+    char line[RC_STATS_LINE_SIZE];
+    RK_S32 line_cnt = 0;
+
+    if (!fgets(line, sizeof(line), p->fp) ||
+        strncmp(line, RC_STATS_HEADER, strlen(RC_STATS_HEADER))) {
+        mpp_err_f("invalid stats file header\n");
+        return MPP_NOK;
+    }
+
+    while (fgets(line, sizeof(line), p->fp)) {
+        RcStatsFrm *frm;
+        RK_S32 idx, intra, qp, bits, madi, madp;
+
+        line_cnt++;
+        if (line[0] == '#' || line[0] == '\n')
+            continue;
+
+        if (sscanf(line, "frm:%d intra:%d qp:%d bits:%d madi:%d madp:%d",
+                   &idx, &intra, &qp, &bits, &madi, &madp) != 6 ||
+            idx != p->count || bits < 0) {
+            mpp_err_f("invalid stats record at line %d: %s", line_cnt + 1, line);
+            return MPP_NOK;
+        }
+
+        if (p->count >= p->size) {
+            RK_S32 size = p->size ? p->size * 2 : RC_STATS_INIT_COUNT;
+            RcStatsFrm *frms = mpp_realloc(p->frms, RcStatsFrm, size);
+
+            if (!frms) {
+                mpp_err_f("failed to realloc %d frame records\n", size);
+                return MPP_ERR_MALLOC;
+            }
+
+            p->frms = frms;
+            p->size = size;
+        }
+
+        frm = &p->frms[p->count++];
+        memset(frm, 0, sizeof(*frm));
+        frm->intra = intra;
+        frm->qp = qp;
+        frm->bits = bits;
+        frm->madi = madi;
+        frm->madp = madp;
+        frm->cplx = MPP_MAX(bits, 1) * qp2qscale(qp);
+    }
+
+    if (!p->count) {
+        mpp_err_f("no frame record in stats file\n");
+        return MPP_NOK;
+    }
+
+    rc_dbg_rc("stats loaded %d frames\n", p->count);
+
+    return MPP_OK;
+}
+
+MPP_RET rc_stats_init(RcStats *ctx, RK_S32 pass, const char *path)
+{
+    RcStatsImpl *p = NULL;
+    MPP_RET ret = MPP_NOK;
+
+    if (!ctx || !path || !path[0] || pass < 1 || pass > 2) {
+        mpp_err_f("invalid pass %d stats file %s\n", pass, path ? path : "null");
+        return MPP_ERR_VALUE;
+    }
+
+    *ctx = NULL;
+
+    p = mpp_calloc(RcStatsImpl, 1);
+    if (!p) {
+        mpp_err_f("failed to malloc context\n");
+        return MPP_ERR_MALLOC;
+    }
+
+    p->pass = pass;
+    p->path = mpp_malloc(char, strlen(path) + 1);
+    if (!p->path) {
+        mpp_err_f("failed to malloc stats file path\n");
+        ret = MPP_ERR_MALLOC;
+        goto DONE;
+    }
+    strcpy(p->path, path);
+
+    p->fp = fopen(path, pass == 1 ? "w" : "r");
+    if (!p->fp) {
+        mpp_err_f("failed to open stats file %s for pass %d\n", path, pass);
+        goto DONE;
+    }
+
+    if (pass == 1) {
+        fprintf(p->fp, "%s\n", RC_STATS_HEADER);
+        ret = MPP_OK;
+    } else {
+        ret = rc_stats_load(p);
+        fclose(p->fp);
+        p->fp = NULL;
+    }
+
+DONE:
+    if (ret) {
+        rc_stats_deinit(p);
+        return ret;
+    }
+
+    mpp_log("rc pass %d stats file %s\n", pass, path);
+    *ctx = p;
+
+    return MPP_OK;
+}
+
+MPP_RET rc_stats_deinit(RcStats ctx)
+{
+    RcStatsImpl *p = (RcStatsImpl *)ctx;
+
+    if (!p)
+        return MPP_OK;
+
+    if (p->fp) {
+        fclose(p->fp);
+        p->fp = NULL;
+    }
+
+    MPP_FREE(p->frms);
+    MPP_FREE(p->path);
+    MPP_FREE(p);
+
+    return MPP_OK;
+}
+
+/* plan all frames with qscale offset and return the total planned bits */
+static double rc_stats_plan_frames(RcStatsImpl *p, RcCfg *cfg, double offset)
+{
+    RK_S32 qp_max = cfg->max_quality > 0 ? cfg->max_quality : 51;
+    RK_S32 qp_min = cfg->min_quality > 0 ? cfg->min_quality : 1;
+    RK_S32 qp_max_i = cfg->max_i_quality > 0 ? cfg->max_i_quality : qp_max;
+    RK_S32 qp_min_i = cfg->min_i_quality > 0 ? cfg->min_i_quality : qp_min;
+    double total = 0;
+    RK_S32 i;
+
+    for (i = 0; i < p->count; i++) {
+        RcStatsFrm *frm = &p->frms[i];
+        double qp = offset + 6.0 * (1.0 - RC_STATS_QCOMP) * log2(frm->cplx);
+        double bits;
+
+        if (frm->intra) {
+            qp -= cfg->i_quality_delta;
+            qp = MPP_CLIP3(qp_min_i, qp_max_i, qp);
+        } else {
+            qp = MPP_CLIP3(qp_min, qp_max, qp);
+        }
+
+        bits = frm->cplx / qp2qscale(qp);
+        total += bits;
+
+        frm->plan_qp = (RK_S32)(qp + 0.5);
+        frm->plan_bits = (RK_S32)MPP_MIN(bits, (double)INT_MAX);
+    }
+
+    return total;
+}
+
+MPP_RET rc_stats_plan(RcStats ctx, RcCfg *cfg)
+{
+    RcStatsImpl *p = (RcStatsImpl *)ctx;
+    RcFpsCfg *fps = &cfg->fps;
+    double budget;
+    double lo = -128.0;
+    double hi = 128.0;
+    double total = 0;
+    RK_S32 i;
+
+    if (!p || p->pass != 2)
+        return MPP_OK;
+
+    if (cfg->mode == RC_FIXQP || cfg->bps_target <= 0 ||
+        fps->fps_out_num <= 0 || fps->fps_out_denom <= 0) {
+        for (i = 0; i < p->count; i++) {
+            p->frms[i].plan_qp = 0;
+            p->frms[i].plan_bits = 0;
+        }
+        return MPP_OK;
+    }
+
+    budget = (double)cfg->bps_target * p->count * fps->fps_out_denom / fps->fps_out_num;
+
+    /*
+     * The planned qp of each frame is offset + (1 - qcomp) * 6 * log2(cplx)
+     * then clipped by the qp range. Total bits decrease with the offset so
+     * search the offset which spends the whole budget.
+     */
+    for (i = 0; i < 64; i++) {
+        double mid = (lo + hi) / 2;
+
+        total = rc_stats_plan_frames(p, cfg, mid);
+        if (total > budget)
+            lo = mid;
+        else
+            hi = mid;
+    }
+
+    total = rc_stats_plan_frames(p, cfg, hi);
+
+    mpp_log("rc pass 2 plan %d frames bits %.0f budget %.0f\n",
+            p->count, total, budget);
+
+    return MPP_OK;
+}
+
+MPP_RET rc_stats_reset(RcStats ctx)
+{
+    RcStatsImpl *p = (RcStatsImpl *)ctx;
+
+    if (!p)
+        return MPP_OK;
+
+    p->idx = 0;
+    p->mismatch = 0;
+    memset(p->tasks, 0, sizeof(p->tasks));
+
+    if (p->pass != 1)
+        return MPP_OK;
+
+    /* restart the records from the first frame */
+    if (p->fp)
+        fclose(p->fp);
+
+    p->fp = fopen(p->path, "w");
+    if (!p->fp) {
+        mpp_err_f("failed to reopen stats file %s\n", p->path);
+        return MPP_NOK;
+    }
+
+    fprintf(p->fp, "%s\n", RC_STATS_HEADER);
+
+    return MPP_OK;
+}
+
+static RcStatsTask *rc_stats_find(RcStatsImpl *p, EncRcTask *task)
+{
+    RK_S32 i;
+
+    for (i = 0; i < RC_STATS_TASK_MAX; i++) {
+        if (p->tasks[i].task == task)
+            return &p->tasks[i];
+    }
+
+    return NULL;
+}
+
+static void rc_stats_fill_plan(RcStatsImpl *p, RcStatsTask *t, RcStatsPlan *plan)
+{
+    memset(plan, 0, sizeof(*plan));
+
+    if (p->pass != 2 || t->idx >= p->count)
+        return;
+
+    plan->bits = p->frms[t->idx].plan_bits;
+    plan->qp = p->frms[t->idx].plan_qp;
+}
+
+MPP_RET rc_stats_read(RcStats ctx, EncRcTask *task, RcStatsPlan *plan)
+{
+    RcStatsImpl *p = (RcStatsImpl *)ctx;
+    RcStatsTask *t;
+    RcStatsFrm *frm;
+
+    memset(plan, 0, sizeof(*plan));
+
+    if (!p)
+        return MPP_OK;
+
+    /* reencode restarts the frame with the record already assigned */
+    t = rc_stats_find(p, task);
+    if (t) {
+        rc_stats_fill_plan(p, t, plan);
+        return MPP_OK;
+    }
+
+    t = rc_stats_find(p, NULL);
+    if (!t) {
+        mpp_err_f("too many started frames without end\n");
+        return MPP_NOK;
+    }
+
+    t->task = task;
+    t->idx = p->idx++;
+
+    if (p->pass != 2)
+        return MPP_OK;
+
+    if (t->idx >= p->count) {
+        if (t->idx == p->count)
+            mpp_log("rc pass 2 runs out of %d stats records\n", p->count);
+        return MPP_OK;
+    }
+
+    frm = &p->frms[t->idx];
+    if (frm->intra != !!task->frm.is_intra && !p->mismatch) {
+        mpp_log("rc pass 2 frame %d type mismatch with stats\n", t->idx);
+        p->mismatch = 1;
+    }
+
+    rc_stats_fill_plan(p, t, plan);
+
+    rc_dbg_rc("stats frm %d intra %d pass 1 qp %d bits %d -> plan qp %d bits %d\n",
+              t->idx, frm->intra, frm->qp, frm->bits, frm->plan_qp, frm->plan_bits);
+
+    return MPP_OK;
+}
+
+MPP_RET rc_stats_get_plan(RcStats ctx, EncRcTask *task, RcStatsPlan *plan)
+{
+    RcStatsImpl *p = (RcStatsImpl *)ctx;
+    RcStatsTask *t = p ? rc_stats_find(p, task) : NULL;
+
+    memset(plan, 0, sizeof(*plan));
+
+    if (!t)
+        return MPP_NOK;
+
+    rc_stats_fill_plan(p, t, plan);
+
+    return MPP_OK;
+}
+
+MPP_RET rc_stats_write(RcStats ctx, EncRcTask *task)
+{
+    RcStatsImpl *p = (RcStatsImpl *)ctx;
+    EncRcTaskInfo *info = &task->info;
+    RcStatsTask *t = p ? rc_stats_find(p, task) : NULL;
+
+    /* frame end without start or the record has been written */
+    if (!t)
+        return MPP_OK;
+
+    if (p->pass == 1 && p->fp)
+        fprintf(p->fp, "frm:%d intra:%d qp:%d bits:%d madi:%d madp:%d\n",
+                t->idx, task->frm.is_intra ? 1 : 0, info->quality_real,
+                info->bit_real, info->madi, info->madp);
+
+    t->task = NULL;
+    t->idx = 0;
+
+    return MPP_OK;
+}
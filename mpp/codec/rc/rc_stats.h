@@ -0,0 +1,59 @@
+/* SPDX-License-Identifier: Apache-2.0 OR MIT */
+/*
+ * Copyright (c) 2026 Rockchip Electronics Co., Ltd.
+ */
+
+#ifndef RC_STATS_H
+#define RC_STATS_H
+
+#include "mpp_rc_api.h"
+
+/*
+ * Multi-pass rate control stats
+ *
+ * Pass 1 writes one text record per encoded frame with its frame type, qp
+ * and real bits. Pass 2 loads all records, converts them to complexity
+ * (bits at qscale 1) and plans qp and bits of every frame so that the sum
+ * of the planned bits matches the target bitrate over the whole sequence.
+ *
+ * Record format:
+ * frm:<index> intra:<0/1> qp:<qp> bits:<bits> madi:<madi> madp:<madp>
+ */
+typedef void* RcStats;
+
+/* planned result of one frame, valid when bits > 0 */
+typedef struct RcStatsPlan_t {
+    RK_S32          bits;
+    RK_S32          qp;
+} RcStatsPlan;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* pass 1 opens stats file for write, pass 2 opens and loads all records */
+MPP_RET rc_stats_init(RcStats *ctx, RK_S32 pass, const char *path);
+MPP_RET rc_stats_deinit(RcStats ctx);
+
+/* pass 2 plans all frames with bitrate, frame rate and qp range in cfg */
+MPP_RET rc_stats_plan(RcStats ctx, RcCfg *cfg);
+
+/* restart from the first record, pass 1 truncates the stats file */
+MPP_RET rc_stats_reset(RcStats ctx);
+
+/*
+ * Read on frame start assigns the next record to the task and returns the
+ * plan in pass 2. Reencode reads again and gets the same record until the
+ * frame is written. Get plan only looks up the record of a started task.
+ * Write on frame end records the encoded frame in pass 1 and releases the
+ * record, repeated frame end of the same frame is ignored.
+ */
+MPP_RET rc_stats_read(RcStats ctx, EncRcTask *task, RcStatsPlan *plan);
+MPP_RET rc_stats_get_plan(RcStats ctx, EncRcTask *task, RcStatsPlan *plan);
+MPP_RET rc_stats_write(RcStats ctx, EncRcTask *task);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* RC_STATS_H */
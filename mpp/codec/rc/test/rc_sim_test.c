@@ -0,0 +1,489 @@
+/* SPDX-License-Identifier: Apache-2.0 OR MIT */
+/*
+ * Copyright (c) 2026 Rockchip Electronics Co., Ltd.
+ */
+
+#define MODULE_TAG "rc_sim_test"
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "mpp_mem.h"
+#include "mpp_log.h"
+#include "mpp_common.h"
+
+#include "rc.h"
+
+/*
+ * Closed-loop rate control simulator
+ *
+ * Replays per-frame records through a registered rc api without hardware.
+ * The records use the rc stats format written by rc:pass=1 encoding:
+ * frm:<index> intra:<0/1> qp:<qp> bits:<bits> madi:<madi> madp:<madp>
+ *
+ * Each record gives the frame complexity as bits at qscale 1. The simulated
+ * hardware encodes the frame at the start qp from rc and returns
+ * complexity / qscale(qp) bits, then the rc reencode and drop decisions are
+ * followed like mpp_enc does. Without input a synthetic sequence is used.
+ *
+ * usage: rc_sim_test [-i stats.log] [-t coding] [-n rc name] [-m rc mode]
+ *                    [-b bps] [-f fps] [-g gop] [-w width] [-h height]
+ */
+
+#define SIM_LINE_SIZE       256
+#define SIM_INIT_COUNT      1024
+
+#define SIM_FRAME_COUNT     300
+#define SIM_WIDTH           1920
+#define SIM_HEIGHT          1080
+#define SIM_FPS             30
+#define SIM_GOP             60
+#define SIM_BPS             (4 * 1024 * 1024)
+
+/*
+ * Pass limits of the default synthetic cbr run
+ * SIM_BPS_DEV_MAX  - average bitrate deviation from target in 1/1000
+ * SIM_WIN_DEV_MAX  - worst one second window deviation in 1/1000, the
+ *                    first second before rc converges peaks near 19%
+ * overflow of the one second vbv buffer is never allowed
+ */
+#define SIM_BPS_DEV_MAX     100
+#define SIM_WIN_DEV_MAX     200
+
+typedef struct SimFrm_t {
+    RK_S32          intra;
+    RK_S32          madi;
+    RK_S32          madp;
+    /* complexity as bits at qscale 1 */
+    double          cplx;
+} SimFrm;
+
+typedef struct SimCfg_t {
+    const char      *file;
+    MppCodingType   coding;
+    const char      *name;
+    RcMode          mode;
+    RK_S32          bps;
+    RK_S32          fps;
+    RK_S32          gop;
+    RK_S32          width;
+    RK_S32          height;
+} SimCfg;
+
+typedef struct SimResult_t {
+    RK_S32          frames;
+    /* frames not dropped, the qp stats only count these */
+    RK_S32          coded;
+    RK_S32          reenc;
+    RK_S32          drop;
+    RK_S32          pskip;
+    RK_S64          bits;
+
+    /* vbv buffer of one second at the peak bitrate */
+    RK_S64          vbv_size;
+    RK_S64          vbv_level;
+    RK_S64          vbv_peak;
+    RK_S32          vbv_overflow;
+
+    /* worst deviation of one second window from target in 1/1000 */
+    RK_S32          win_dev_max;
+
+    double          qp_sum;
+    double          qp_sqr;
+    RK_S32          qp_min;
+    RK_S32          qp_max;
+} SimResult;
+
+/* bits are inversely proportional to qscale and qscale doubles every 6 qp */
+static double qp2qscale(double qp)
+{
+    return pow(2.0, (qp - 12.0) / 6.0);
+}
+
+static MPP_RET sim_add_frm(SimFrm **frms, RK_S32 *count, RK_S32 *size, SimFrm *frm)
+{
+    if (*count >= *size) {
+        RK_S32 new_size = *size ? *size * 2 : SIM_INIT_COUNT;
+        SimFrm *p = mpp_realloc(*frms, SimFrm, new_size);
+
+        if (!p) {
+            mpp_err_f("failed to realloc %d frames\n", new_size);
+            return MPP_ERR_MALLOC;
+        }
+
+        *frms = p;
+        *size = new_size;
+    }
+
+    (*frms)[(*count)++] = *frm;
+
+    return MPP_OK;
+}
+
+static MPP_RET sim_load(const char *file, SimFrm **frms, RK_S32 *count)
+{
+    char line[SIM_LINE_SIZE];
+    RK_S32 size = 0;
+    RK_S32 line_cnt = 0;
+    MPP_RET ret = MPP_OK;
+    FILE *fp = fopen(file, "r");
+
+    if (!fp) {
+        mpp_err_f("failed to open %s\n", file);
+        return MPP_NOK;
+    }
+
+    while (!ret && fgets(line, sizeof(line), fp)) {
+        RK_S32 idx, intra, qp, bits, madi, madp;
+        SimFrm frm;
+
+        line_cnt++;
+        if (line[0] == '#' || line[0] == '\n')
+            continue;
+
+        if (sscanf(line, "frm:%d intra:%d qp:%d bits:%d madi:%d madp:%d",
+                   &idx, &intra, &qp, &bits, &madi, &madp) != 6 || bits < 0) {
+            mpp_err_f("invalid record at line %d: %s", line_cnt, line);
+            ret = MPP_NOK;
+            break;
+        }
+
+        frm.intra = intra;
+        frm.madi = madi;
+        frm.madp = madp;
+        frm.cplx = MPP_MAX(bits, 1) * qp2qscale(qp);
+        ret = sim_add_frm(frms, count, &size, &frm);
+    }
+
+    fclose(fp);
+
+    if (!ret && !*count) {
+        mpp_err_f("no frame record in %s\n", file);
+        ret = MPP_NOK;
+    }
+
+    return ret;
+}
+
+/*
+ * qp 30 sequence with a twice complex segment in the middle, intra frames
+ * take three times the bits of inter frames
+ */
+static MPP_RET sim_synth(SimCfg *cfg, SimFrm **frms, RK_S32 *count)
+{
+    RK_S32 size = 0;
+    RK_S32 i;
+
+    for (i = 0; i < SIM_FRAME_COUNT; i++) {
+        RK_S32 bits = (i >= 120 && i < 180) ? 80000 : 40000;
+        SimFrm frm;
+
+        frm.intra = !(i % cfg->gop);
+        if (frm.intra)
+            bits *= 3;
+
+        frm.madi = 0;
+        frm.madp = 0;
+        frm.cplx = bits * qp2qscale(30);
+
+        if (sim_add_frm(frms, count, &size, &frm))
+            return MPP_NOK;
+    }
+
+    return MPP_OK;
+}
+
+static void sim_rc_cfg(SimCfg *cfg, RcCfg *rc)
+{
+    memset(rc, 0, sizeof(*rc));
+
+    rc->width = cfg->width;
+    rc->height = cfg->height;
+    rc->mode = cfg->mode;
+    rc->fps.fps_in_num = cfg->fps;
+    rc->fps.fps_in_denom = 1;
+    rc->fps.fps_out_num = cfg->fps;
+    rc->fps.fps_out_denom = 1;
+    rc->igop = cfg->gop;
+    rc->bps_target = cfg->bps;
+    rc->bps_max = cfg->mode == RC_CBR ? cfg->bps * 17 / 16 : cfg->bps * 3 / 2;
+    rc->bps_min = cfg->mode == RC_CBR ? cfg->bps * 15 / 16 : cfg->bps / 16;
+    /* rc statistics window matches the checked one second window */
+    rc->stats_time = 1;
+
+    /* same as the h.264 / h.265 encoder defaults */
+    rc->max_i_bit_prop = 30;
+    rc->min_i_bit_prop = 10;
+    rc->init_ip_ratio = 160;
+    rc->init_quality = -1;
+    rc->max_quality = 48;
+    rc->min_quality = 8;
+    rc->max_i_quality = 48;
+    rc->min_i_quality = 8;
+    rc->i_quality_delta = 2;
+    rc->fqp_min_i = rc->min_i_quality;
+    rc->fqp_min_p = rc->min_quality;
+    rc->fqp_max_i = rc->max_i_quality;
+    rc->fqp_max_p = rc->max_quality;
+    rc->layer_bit_prop[0] = 256;
+    rc->max_reencode_times = 1;
+}
+
+/* dropped frame is a zero bits frame in time without qp */
+static void sim_update(SimResult *res, RcCfg *rc, RK_S32 *win, RK_S32 fps,
+                       RK_S32 bits, RK_S32 qp, RK_S32 drop)
+{
+    RK_S64 drain = (RK_S64)rc->bps_max / fps;
+    RK_S32 idx = res->frames % fps;
+    RK_S64 win_bits = 0;
+    RK_S32 i;
+
+    res->bits += bits;
+
+    res->vbv_level += bits;
+    if (res->vbv_level > res->vbv_size)
+        res->vbv_overflow++;
+    res->vbv_peak = MPP_MAX(res->vbv_peak, res->vbv_level);
+    res->vbv_level = MPP_MAX(res->vbv_level - drain, 0);
+
+    win[idx] = bits;
+    res->frames++;
+    if (res->frames >= fps) {
+        RK_S32 dev;
+
+        for (i = 0; i < fps; i++)
+            win_bits += win[i];
+
+        dev = (RK_S32)(llabs(win_bits - rc->bps_target) * 1000 / rc->bps_target);
+        res->win_dev_max = MPP_MAX(res->win_dev_max, dev);
+    }
+
+    if (drop)
+        return;
+
+    res->coded++;
+    res->qp_sum += qp;
+    res->qp_sqr += (double)qp * qp;
+    res->qp_min = MPP_MIN(res->qp_min, qp);
+    res->qp_max = MPP_MAX(res->qp_max, qp);
+}
+
+static MPP_RET sim_run(SimCfg *cfg, SimFrm *frms, RK_S32 count, SimResult *res)
+{
+    const char *name = cfg->name;
+    RK_S32 mbs = MPP_ALIGN(cfg->width, 16) * MPP_ALIGN(cfg->height, 16) / 256;
+    RK_S32 *win = mpp_calloc(RK_S32, cfg->fps);
+    RcCtx ctx = NULL;
+    RcCfg rc;
+    RK_S32 i;
+
+    if (!win)
+        return MPP_ERR_MALLOC;
+
+    if (rc_init(&ctx, cfg->coding, &name) || !ctx) {
+        mpp_err("failed to init rc %s for coding %x\n", cfg->name, cfg->coding);
+        MPP_FREE(win);
+        return MPP_NOK;
+    }
+
+    sim_rc_cfg(cfg, &rc);
+    rc_update_usr_cfg(ctx, &rc);
+
+    memset(res, 0, sizeof(*res));
+    res->vbv_size = rc.bps_max;
+    res->qp_min = 100;
+
+    for (i = 0; i < count; i++) {
+        SimFrm *frm = &frms[i];
+        EncRcTask task;
+        EncFrmStatus *status = &task.frm;
+        EncRcTaskInfo *info = &task.info;
+
+        memset(&task, 0, sizeof(task));
+        status->valid = 1;
+        status->seq_idx = i;
+        status->is_intra = frm->intra;
+        status->is_idr = frm->intra;
+
+        rc_frm_check_drop(ctx, &task);
+        if (status->drop) {
+            res->drop++;
+            sim_update(res, &rc, win, cfg->fps, 0, 0, 1);
+            continue;
+        }
+
+        rc_frm_start(ctx, &task);
+
+        do {
+            EncRcTaskInfo bak = *info;
+
+            /* clear hardware feedback like mpp_enc_clr_rc_cb_info */
+            memset(info, 0, sizeof(*info));
+            info->frame_type = bak.frame_type;
+            info->bit_target = bak.bit_target;
+            info->bit_max = bak.bit_max;
+            info->bit_min = bak.bit_min;
+            info->quality_target = bak.quality_target;
+            info->quality_max = bak.quality_max;
+            info->quality_min = bak.quality_min;
+
+            if (status->reencode) {
+                status->reencode_times++;
+                res->reenc++;
+            }
+
+            rc_hal_start(ctx, &task);
+
+            info->quality_real = info->quality_target;
+            info->bit_real = (RK_S32)MPP_MIN(frm->cplx / qp2qscale(info->quality_real),
+                                             (double)0x7fffffff);
+            info->madi = frm->madi;
+            info->madp = frm->madp;
+
+            rc_hal_end(ctx, &task);
+            rc_check_reenc(ctx, &task);
+
+            if (status->reencode && status->drop) {
+                info->bit_real = 0;
+                res->drop++;
+                break;
+            }
+
+            if (status->reencode && status->force_pskip && !status->is_idr) {
+                /* about one bit per skipped macroblock */
+                info->bit_real = mbs;
+                res->pskip++;
+                break;
+            }
+            status->force_pskip = 0;
+        } while (status->reencode && status->reencode_times < (RK_U32)rc.max_reencode_times);
+
+        rc_frm_end(ctx, &task);
+
+        sim_update(res, &rc, win, cfg->fps, info->bit_real, info->quality_real,
+                   status->reencode && status->drop);
+
+        if (i < 8 || !(i % cfg->fps))
+            mpp_log("frm %4d intra %d qp %2d bits %8d target %8d reenc %d\n",
+                    i, frm->intra, info->quality_real, info->bit_real,
+                    info->bit_target, status->reencode_times);
+    }
+
+    rc_deinit(ctx);
+    MPP_FREE(win);
+
+    return MPP_OK;
+}
+
+static void sim_report(SimCfg *cfg, SimResult *res)
+{
+    RK_S64 bps = res->frames ? res->bits * cfg->fps / res->frames : 0;
+    double qp_avg = res->coded ? res->qp_sum / res->coded : 0;
+    double qp_var = res->coded ? res->qp_sqr / res->coded - qp_avg * qp_avg : 0;
+
+    mpp_log("rc %s mode %d frames %d coded %d drop %d pskip %d reenc %d\n",
+            cfg->name, cfg->mode, res->frames, res->coded, res->drop, res->pskip,
+            res->reenc);
+    mpp_log("bps %lld target %d deviation %.1f%% worst 1s window %.1f%%\n",
+            bps, cfg->bps, (bps - cfg->bps) * 100.0 / cfg->bps,
+            res->win_dev_max / 10.0);
+    mpp_log("vbv size %lld peak %lld overflow %d frames\n",
+            res->vbv_size, res->vbv_peak, res->vbv_overflow);
+    mpp_log("qp avg %.2f stddev %.2f range [%d:%d]\n",
+            qp_avg, sqrt(MPP_MAX(qp_var, 0)), res->qp_min, res->qp_max);
+}
+
+int main(int argc, char **argv)
+{
+    SimCfg cfg;
+    SimResult res;
+    SimFrm *frms = NULL;
+    RK_S32 count = 0;
+    RK_S64 bps;
+    MPP_RET ret = MPP_NOK;
+    RK_S32 i;
+
+    cfg.file = NULL;
+    cfg.coding = MPP_VIDEO_CodingAVC;
+    cfg.name = "default";
+    cfg.mode = RC_CBR;
+    cfg.bps = SIM_BPS;
+    cfg.fps = SIM_FPS;
+    cfg.gop = SIM_GOP;
+    cfg.width = SIM_WIDTH;
+    cfg.height = SIM_HEIGHT;
+
+    for (i = 1; i + 1 < argc; i += 2) {
+        if (!strcmp(argv[i], "-i"))
+            cfg.file = argv[i + 1];
+        else if (!strcmp(argv[i], "-t"))
+            cfg.coding = (MppCodingType)atoi(argv[i + 1]);
+        else if (!strcmp(argv[i], "-n"))
+            cfg.name = argv[i + 1];
+        else if (!strcmp(argv[i], "-m"))
+            cfg.mode = (RcMode)atoi(argv[i + 1]);
+        else if (!strcmp(argv[i], "-b"))
+            cfg.bps = atoi(argv[i + 1]);
+        else if (!strcmp(argv[i], "-f"))
+            cfg.fps = atoi(argv[i + 1]);
+        else if (!strcmp(argv[i], "-g"))
+            cfg.gop = atoi(argv[i + 1]);
+        else if (!strcmp(argv[i], "-w"))
+            cfg.width = atoi(argv[i + 1]);
+        else if (!strcmp(argv[i], "-h"))
+            cfg.height = atoi(argv[i + 1]);
+    }
+
+    if (cfg.bps <= 0 || cfg.fps <= 0 || cfg.gop <= 0 ||
+        cfg.width <= 0 || cfg.height <= 0 || cfg.mode >= RC_MODE_BUTT) {
+        mpp_err("invalid bps %d fps %d gop %d size %dx%d mode %d\n",
+                cfg.bps, cfg.fps, cfg.gop, cfg.width, cfg.height, cfg.mode);
+        return -1;
+    }
+
+    mpp_log("rc sim test start\n");
+
+    if (cfg.file)
+        ret = sim_load(cfg.file, &frms, &count);
+    else
+        ret = sim_synth(&cfg, &frms, &count);
+
+    if (ret)
+        goto DONE;
+
+    ret = sim_run(&cfg, frms, count, &res);
+    if (ret)
+        goto DONE;
+
+    sim_report(&cfg, &res);
+
+    /* the default synthetic cbr run must stay close to the target bitrate */
+    if (!cfg.file && cfg.mode == RC_CBR) {
+        bps = res.frames ? res.bits * cfg.fps / res.frames : 0;
+        if (llabs(bps - cfg.bps) * 1000 > (RK_S64)cfg.bps * SIM_BPS_DEV_MAX) {
+            mpp_err("bps %lld deviates over %d/1000 from target %d\n",
+                    bps, SIM_BPS_DEV_MAX, cfg.bps);
+            ret = MPP_NOK;
+        }
+
+        if (res.win_dev_max > SIM_WIN_DEV_MAX) {
+            mpp_err("worst 1s window deviation %d over %d/1000\n",
+                    res.win_dev_max, SIM_WIN_DEV_MAX);
+            ret = MPP_NOK;
+        }
+
+        if (res.vbv_overflow) {
+            mpp_err("vbv overflow %d frames\n", res.vbv_overflow);
+            ret = MPP_NOK;
+        }
+    }
+
+DONE:
+    MPP_FREE(frms);
+
+    mpp_log("rc sim test %s\n", ret ? "failed" : "success");
+
+    return ret;
+}
@@ -0,0 +1,165 @@
+/* SPDX-License-Identifier: Apache-2.0 OR MIT */
+/*
+ * Copyright (c) 2026 Rockchip Electronics Co., Ltd.
+ */
+
+#define MODULE_TAG "rc_stats_test"
+
+#include <stdio.h>
+#include <string.h>
+
+#include "mpp_log.h"
+#include "rc_stats.h"
+
+#define TEST_STATS_FILE     "rc_stats_test.log"
+#define TEST_FRAME_COUNT    120
+#define TEST_GOP            30
+#define TEST_FPS            30
+#define TEST_BPS            (2 * 1024 * 1024)
+
+/* pass 1 at fixed qp 30 with a complex segment in the middle */
+static RK_S32 test_pass1_bits(RK_S32 idx)
+{
+    RK_S32 bits = (idx >= 40 && idx < 80) ? 120000 : 30000;
+
+    if (!(idx % TEST_GOP))
+        bits *= 4;
+
+    return bits;
+}
+
+/* pass 1 frame with reencode and the repeated frame end of reencode drop */
+static void test_pass1_frame(RcStats stats, EncRcTask *task, RK_S32 idx)
+{
+    RcStatsPlan plan;
+
+    memset(task, 0, sizeof(*task));
+    task->frm.is_intra = !(idx % TEST_GOP);
+    rc_stats_read(stats, task, &plan);
+    rc_stats_read(stats, task, &plan);
+
+    task->info.quality_real = 30;
+    task->info.bit_real = test_pass1_bits(idx);
+    rc_stats_write(stats, task);
+    rc_stats_write(stats, task);
+}
+
+int main(void)
+{
+    RcStats stats = NULL;
+    EncRcTask task;
+    RcStatsPlan plan;
+    RcStatsPlan reenc;
+    RcCfg cfg;
+    RK_S32 plan_bits = 0;
+    RK_S64 total = 0;
+    RK_S64 budget;
+    RK_S32 qp_simple = 0;
+    RK_S32 qp_complex = 0;
+    RK_S32 i;
+    MPP_RET ret = MPP_NOK;
+
+    mpp_log("rc stats test start\n");
+
+    if (rc_stats_init(&stats, 1, TEST_STATS_FILE)) {
+        mpp_err("failed to init pass 1 stats\n");
+        return -1;
+    }
+
+    /* records before reset are dropped */
+    for (i = 0; i < TEST_GOP; i++)
+        test_pass1_frame(stats, &task, i);
+    rc_stats_reset(stats);
+
+    /* pass 2 load fails on any duplicated or missing record */
+    for (i = 0; i < TEST_FRAME_COUNT; i++)
+        test_pass1_frame(stats, &task, i);
+    rc_stats_deinit(stats);
+    stats = NULL;
+
+    if (rc_stats_init(&stats, 2, TEST_STATS_FILE)) {
+        mpp_err("failed to init pass 2 stats\n");
+        goto DONE;
+    }
+
+    memset(&cfg, 0, sizeof(cfg));
+    cfg.mode = RC_VBR;
+    cfg.bps_target = TEST_BPS;
+    cfg.fps.fps_out_num = TEST_FPS;
+    cfg.fps.fps_out_denom = 1;
+    cfg.min_quality = 10;
+    cfg.max_quality = 51;
+    cfg.i_quality_delta = 2;
+    rc_stats_plan(stats, &cfg);
+
+    for (i = 0; i < TEST_FRAME_COUNT; i++) {
+        memset(&task, 0, sizeof(task));
+        task.frm.is_intra = !(i % TEST_GOP);
+        rc_stats_read(stats, &task, &plan);
+        if (plan.bits <= 0) {
+            mpp_err("frame %d has no plan\n", i);
+            goto DONE;
+        }
+
+        /* reencode gets the plan of the same frame */
+        rc_stats_read(stats, &task, &reenc);
+        if (reenc.bits != plan.bits || reenc.qp != plan.qp) {
+            mpp_err("frame %d reencode plan %d:%d mismatch %d:%d\n", i,
+                    reenc.bits, reenc.qp, plan.bits, plan.qp);
+            goto DONE;
+        }
+
+        /* the record is released on frame end */
+        rc_stats_write(stats, &task);
+        if (!rc_stats_get_plan(stats, &task, &reenc)) {
+            mpp_err("frame %d keeps the record after frame end\n", i);
+            goto DONE;
+        }
+
+        if (!i)
+            plan_bits = plan.bits;
+
+        total += plan.bits;
+        if (i == 20)
+            qp_simple = plan.qp;
+        if (i == 61)
+            qp_complex = plan.qp;
+    }
+
+    budget = (RK_S64)TEST_BPS * TEST_FRAME_COUNT / TEST_FPS;
+    mpp_log("planned bits %lld budget %lld qp simple %d complex %d\n",
+            total, budget, qp_simple, qp_complex);
+
+    /* the plan spends the budget and gives complex frames a higher qp */
+    if (total * 100 < budget * 99 || total * 100 > budget * 101) {
+        mpp_err("planned bits %lld mismatch budget %lld\n", total, budget);
+        goto DONE;
+    }
+
+    if (qp_complex <= qp_simple) {
+        mpp_err("complex qp %d should be larger than simple qp %d\n",
+                qp_complex, qp_simple);
+        goto DONE;
+    }
+
+    /* reset restarts the plan from the first frame */
+    rc_stats_reset(stats);
+    memset(&task, 0, sizeof(task));
+    task.frm.is_intra = 1;
+    rc_stats_read(stats, &task, &plan);
+    if (plan.bits != plan_bits) {
+        mpp_err("plan bits %d after reset mismatch first frame %d\n",
+                plan.bits, plan_bits);
+        goto DONE;
+    }
+
+    ret = MPP_OK;
+
+DONE:
+    rc_stats_deinit(stats);
+    remove(TEST_STATS_FILE);
+
+    mpp_log("rc stats test %s\n", ret ? "failed" : "success");
+
+    return ret;
+}
@@ -0,0 +1,151 @@
+/* SPDX-License-Identifier: Apache-2.0 OR MIT */
+/*
+ * Copyright (c) 2026 Rockchip Electronics Co., Ltd.
+ */
+
+#define MODULE_TAG "mpp_dec_rows_test"
+
+#include <string.h>
+
+#include "mpp_log.h"
+#include "mpp_common.h"
+
+#include "mpp.h"
+#include "mpp_dec_impl.h"
+
+#define TEST_WIDTH          64
+#define TEST_HEIGHT         48
+#define TEST_CB_CMD         0x1234
+
+#define TEST_CHECK(cond) \
+    do { \
+        if (!(cond)) { \
+            mpp_err("check %s failed at line %d\n", #cond, __LINE__); \
+            goto DONE; \
+        } \
+    } while (0)
+
+typedef struct TestCbCtx_t {
+    RK_S32          count;
+    RK_S32          cmd;
+    RK_S32          rows;
+    MppFrame        frame;
+} TestCbCtx;
+
+static MPP_RET test_frm_part_cb(void *ctx, MppCtx mpp_ctx, RK_S32 cmd, void *arg)
+{
+    TestCbCtx *p = (TestCbCtx *)ctx;
+    MppFrame frame = (MppFrame)arg;
+
+    (void)mpp_ctx;
+
+    p->count++;
+    p->cmd = cmd;
+    p->frame = frame;
+    p->rows = -1;
+    mpp_meta_get_s32(mpp_frame_get_meta(frame), KEY_DEC_ROWS_READY, &p->rows);
+
+    return MPP_OK;
+}
+
+static void test_set_frame(MppBufSlots slots, RK_S32 index)
+{
+    MppFrame frame = NULL;
+
+    mpp_frame_init(&frame);
+    mpp_frame_set_width(frame, TEST_WIDTH);
+    mpp_frame_set_height(frame, TEST_HEIGHT);
+    mpp_frame_set_hor_stride(frame, TEST_WIDTH);
+    mpp_frame_set_ver_stride(frame, TEST_HEIGHT);
+    mpp_frame_set_fmt(frame, MPP_FMT_YUV420SP);
+    mpp_buf_slot_set_prop(slots, index, SLOT_FRAME, frame);
+    mpp_frame_deinit(&frame);
+}
+
+int main(void)
+{
+    Mpp mpp;
+    MppDecImpl dec;
+    MppDecCfgSet cfg;
+    TestCbCtx cb_ctx;
+    HalDecTaskFlag flags;
+    MppBufSlots slots = NULL;
+    MppFrame slot_frame = NULL;
+    RK_S32 index = -1;
+    MPP_RET ret = MPP_NOK;
+
+    mpp_log("mpp_dec rows ready callback test start\n");
+
+    memset(&mpp, 0, sizeof(mpp));
+    memset(&dec, 0, sizeof(dec));
+    memset(&cfg, 0, sizeof(cfg));
+    memset(&cb_ctx, 0, sizeof(cb_ctx));
+    memset(&flags, 0, sizeof(flags));
+
+    mpp_buf_slot_init(&slots);
+    TEST_CHECK(slots);
+    mpp_buf_slot_setup(slots, 2);
+    mpp_buf_slot_get_unused(slots, &index);
+    TEST_CHECK(index >= 0);
+    mpp_buf_slot_set_flag(slots, index, SLOT_CODEC_USE);
+    test_set_frame(slots, index);
+    mpp_buf_slot_set_flag(slots, index, SLOT_CODEC_READY);
+    mpp_buf_slot_get_prop(slots, index, SLOT_FRAME_PTR, &slot_frame);
+
+    dec.mpp = &mpp;
+    dec.cfg = &cfg;
+    dec.frame_slots = slots;
+
+    /* no callback registered */
+    mpp_dec_report_rows(&dec, index, flags);
+    TEST_CHECK(!cb_ctx.count);
+
+    cfg.cb.frm_part_cb = test_frm_part_cb;
+    cfg.cb.frm_part_ctx = &cb_ctx;
+    cfg.cb.frm_part_cmd = TEST_CB_CMD;
+
+    /* decoded frame is reported once with the whole height */
+    mpp_dec_report_rows(&dec, index, flags);
+    TEST_CHECK(cb_ctx.count == 1);
+    TEST_CHECK(cb_ctx.cmd == TEST_CB_CMD);
+    TEST_CHECK(cb_ctx.frame == slot_frame);
+    TEST_CHECK(cb_ctx.rows == TEST_HEIGHT);
+
+    /* task without output slot */
+    mpp_dec_report_rows(&dec, -1, flags);
+    TEST_CHECK(cb_ctx.count == 1);
+
+    /* task with parse or reference error */
+    flags.parse_err = 1;
+    mpp_dec_report_rows(&dec, index, flags);
+    flags.parse_err = 0;
+    flags.ref_err = 1;
+    mpp_dec_report_rows(&dec, index, flags);
+    flags.ref_err = 0;
+    TEST_CHECK(cb_ctx.count == 1);
+
+    /* frame marked error by hal */
+    mpp_frame_set_errinfo(slot_frame, 1);
+    mpp_dec_report_rows(&dec, index, flags);
+    mpp_frame_set_errinfo(slot_frame, 0);
+    mpp_frame_set_discard(slot_frame, 1);
+    mpp_dec_report_rows(&dec, index, flags);
+    mpp_frame_set_discard(slot_frame, 0);
+    TEST_CHECK(cb_ctx.count == 1);
+
+    mpp_dec_report_rows(&dec, index, flags);
+    TEST_CHECK(cb_ctx.count == 2);
+    TEST_CHECK(cb_ctx.rows == TEST_HEIGHT);
+
+    ret = MPP_OK;
+
+DONE:
+    if (index >= 0)
+        mpp_buf_slot_clr_flag(slots, index, SLOT_CODEC_USE);
+    if (slots)
+        mpp_buf_slot_deinit(slots);
+
+    mpp_log("mpp_dec rows ready callback test %s\n", ret ? "failed" : "success");
+
+    return ret;
+}
@@ -0,0 +1,216 @@
+/* SPDX-License-Identifier: Apache-2.0 OR MIT */
+/*
+ * Copyright (c) 2026 Rockchip Electronics Co., Ltd.
+ */
+
+#define MODULE_TAG "mpp_enc_la_test"
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "mpp_log.h"
+#include "mpp_time.h"
+#include "mpp_common.h"
+#include "mpp_buffer.h"
+
+#include "mpp_enc_la.h"
+
+#define TEST_WIDTH          64
+#define TEST_HEIGHT         64
+#define TEST_DEPTH          4
+#define TEST_FRM_SIZE       (TEST_WIDTH * TEST_HEIGHT * 3 / 2)
+/*
+ * queue holds depth + 1 frames and one more is rejected when full so any
+ * frame not released by lookahead runs the pool out
+ */
+#define TEST_BUF_CNT        (TEST_DEPTH + 2)
+/* analysis wait timeout in ms */
+#define TEST_TIMEOUT        1000
+
+#define TEST_CHECK(cond) \
+    do { \
+        if (!(cond)) { \
+            mpp_err("check %s failed at line %d\n", #cond, __LINE__); \
+            return MPP_NOK; \
+        } \
+    } while (0)
+
+static MppBufferGroup grp = NULL;
+
+static MppFrame test_frame(RK_S64 pts, RK_U32 eos)
+{
+    MppFrame frame = NULL;
+    MppBuffer buf = NULL;
+    RK_U8 *ptr;
+    RK_S32 x, y;
+
+    mpp_buffer_get(grp, &buf, TEST_FRM_SIZE);
+    if (!buf)
+        return NULL;
+
+    /* moving gradient so every frame has intra and inter residual */
+    ptr = (RK_U8 *)mpp_buffer_get_ptr(buf);
+    for (y = 0; y < TEST_HEIGHT; y++)
+        for (x = 0; x < TEST_WIDTH; x++)
+            ptr[y * TEST_WIDTH + x] = (RK_U8)(x * 3 + y * 2 + pts * 5);
+    memset(ptr + TEST_WIDTH * TEST_HEIGHT, 128, TEST_WIDTH * TEST_HEIGHT / 2);
+
+    mpp_frame_init(&frame);
+    mpp_frame_set_width(frame, TEST_WIDTH);
+    mpp_frame_set_height(frame, TEST_HEIGHT);
+    mpp_frame_set_hor_stride(frame, TEST_WIDTH);
+    mpp_frame_set_ver_stride(frame, TEST_HEIGHT);
+    mpp_frame_set_fmt(frame, MPP_FMT_YUV420SP);
+    mpp_frame_set_buffer(frame, buf);
+    mpp_frame_set_pts(frame, pts);
+    mpp_frame_set_eos(frame, eos);
+    mpp_buffer_put(buf);
+
+    return frame;
+}
+
+static MPP_RET test_push(MppEncLa la, RK_S64 pts, RK_U32 eos)
+{
+    MppFrame frame = test_frame(pts, eos);
+    MPP_RET ret;
+
+    if (!frame)
+        return MPP_NOK;
+
+    ret = mpp_enc_la_push(la, TEST_DEPTH, frame);
+    if (ret)
+        mpp_frame_deinit(&frame);
+
+    return ret;
+}
+
+/* pop and check the frame order, wait for the worker up to timeout */
+static MPP_RET test_pop(MppEncLa la, RK_S64 pts, RK_S32 depth)
+{
+    MppEncLaInfo info;
+    MppFrame frame = NULL;
+    RK_S32 i;
+
+    for (i = 0; i < TEST_TIMEOUT; i++) {
+        if (!mpp_enc_la_pop(la, TEST_DEPTH, &frame, &info))
+            break;
+        msleep(1);
+    }
+    TEST_CHECK(frame);
+
+    mpp_log("pop pts %lld depth %d cost %d avg %d cut %d\n",
+            mpp_frame_get_pts(frame), info.depth, info.cost,
+            info.cost_avg, info.cut_dist);
+
+    TEST_CHECK(mpp_frame_get_pts(frame) == pts);
+    TEST_CHECK(info.depth == depth);
+    TEST_CHECK(info.cost > 0);
+    mpp_frame_deinit(&frame);
+
+    return MPP_OK;
+}
+
+static MPP_RET test_queue(MppEncLa la)
+{
+    MppEncLaInfo info;
+    MppFrame frame = NULL;
+    RK_S64 pts;
+
+    /* less than depth + 1 frames never pop */
+    for (pts = 0; pts < TEST_DEPTH; pts++)
+        TEST_CHECK(!test_push(la, pts, 0));
+    msleep(50);
+    TEST_CHECK(mpp_enc_la_pop(la, TEST_DEPTH, &frame, &info));
+
+    /* queue holds depth + 1 frames */
+    TEST_CHECK(!test_push(la, pts++, 0));
+    TEST_CHECK(test_push(la, pts, 0));
+
+    /* steady state pops in input order with full window */
+    for (; pts < 12; pts++) {
+        TEST_CHECK(!test_pop(la, pts - TEST_DEPTH - 1, TEST_DEPTH));
+        TEST_CHECK(!test_push(la, pts, 0));
+    }
+
+    /* eos flushes the rest with shrinking window */
+    TEST_CHECK(!test_pop(la, pts - TEST_DEPTH - 1, TEST_DEPTH));
+    TEST_CHECK(!test_push(la, pts, 1));
+    for (pts -= TEST_DEPTH; pts <= 12; pts++)
+        TEST_CHECK(!test_pop(la, pts, 12 - pts));
+
+    TEST_CHECK(mpp_enc_la_pop(la, TEST_DEPTH, &frame, &info));
+
+    return MPP_OK;
+}
+
+static MPP_RET test_reset(MppEncLa la)
+{
+    MppFrame frame = NULL;
+    RK_S64 pts;
+
+    /* reset drops queued frames in order whether analyzed or not */
+    for (pts = 20; pts < 20 + TEST_DEPTH + 1; pts++)
+        TEST_CHECK(!test_push(la, pts, 0));
+
+    for (pts = 20; pts < 20 + TEST_DEPTH + 1; pts++) {
+        TEST_CHECK(!mpp_enc_la_drop(la, &frame));
+        TEST_CHECK(mpp_frame_get_pts(frame) == pts);
+        mpp_frame_deinit(&frame);
+    }
+    TEST_CHECK(mpp_enc_la_drop(la, &frame));
+
+    /* queue restarts after reset */
+    for (pts = 30; pts < 30 + TEST_DEPTH + 1; pts++)
+        TEST_CHECK(!test_push(la, pts, 0));
+    TEST_CHECK(!test_pop(la, 30, TEST_DEPTH));
+
+    return MPP_OK;
+}
+
+int main(void)
+{
+    MppEncLa la = NULL;
+    MppBufferInfo info;
+    RK_U8 *mem = NULL;
+    MPP_RET ret = MPP_NOK;
+    RK_S32 i;
+
+    mpp_log("mpp_enc_la test start\n");
+
+    mem = malloc(TEST_FRM_SIZE * TEST_BUF_CNT);
+    mpp_buffer_group_get_external(&grp, MPP_BUFFER_TYPE_NORMAL);
+    if (!mem || !grp) {
+        mpp_err("failed to get buffer group\n");
+        goto DONE;
+    }
+
+    /* commit external memory to avoid dependence on platform allocator */
+    memset(&info, 0, sizeof(info));
+    info.type = MPP_BUFFER_TYPE_NORMAL;
+    info.size = TEST_FRM_SIZE;
+    info.fd = -1;
+    for (i = 0; i < TEST_BUF_CNT; i++) {
+        info.ptr = mem + i * TEST_FRM_SIZE;
+        mpp_buffer_commit(grp, &info);
+    }
+
+    if (mpp_enc_la_init(&la, NULL))
+        goto DONE;
+
+    ret = test_queue(la);
+    if (!ret)
+        ret = test_reset(la);
+
+    /* deinit releases the frames left in queue */
+    test_push(la, 40, 0);
+    mpp_enc_la_deinit(la);
+
+DONE:
+    if (grp)
+        mpp_buffer_group_put(grp);
+    if (mem)
+        free(mem);
+
+    mpp_log("mpp_enc_la test %s\n", ret ? "failed" : "success");
+    return ret;
+}
@@ -0,0 +1,146 @@
+/* SPDX-License-Identifier: Apache-2.0 OR MIT */
+/*
+ * Copyright (c) 2026 Rockchip Electronics Co., Ltd.
+ */
+
+#define MODULE_TAG "mpp_parser_eoi_test"
+
+#include <string.h>
+
+#include "mpp_log.h"
+#include "mpp_common.h"
+
+#include "mpp_parser.h"
+
+#define TEST_CHECK(cond) \
+    do { \
+        if (!(cond)) { \
+            mpp_err("check %s failed at line %d\n", #cond, __LINE__); \
+            goto DONE; \
+        } \
+    } while (0)
+
+/*
+ * One access unit with a single slice. The split parser only reads the nal
+ * header and the first bits of the slice header, so the payload is filler.
+ */
+static RK_U8 avc_au[] = {
+    /* idr slice, first_mb_in_slice 0 */
+    0x00, 0x00, 0x00, 0x01, 0x65, 0x88, 0x84, 0x21,
+    0xa0, 0x5a, 0x5a, 0x5a, 0x5a, 0x5a, 0x5a, 0x5a,
+};
+
+static RK_U8 hevc_au[] = {
+    /* idr_w_radl slice, first_slice_segment_in_pic_flag 1 */
+    0x00, 0x00, 0x00, 0x01, 0x26, 0x01, 0xaf, 0x09,
+    0x40, 0x5a, 0x5a, 0x5a, 0x5a, 0x5a, 0x5a, 0x5a,
+};
+
+typedef struct TestCase_t {
+    const char      *name;
+    MppCodingType   coding;
+    RK_U8           *data;
+    size_t          size;
+} TestCase;
+
+static TestCase test_cases[] = {
+    { "h264d", MPP_VIDEO_CodingAVC,  avc_au,  sizeof(avc_au)  },
+    { "h265d", MPP_VIDEO_CodingHEVC, hevc_au, sizeof(hevc_au) },
+};
+
+/* put one access unit to a new split parser and return the task valid flag */
+static MPP_RET test_prepare(TestCase *c, RK_U32 eoi, RK_U32 *valid)
+{
+    MppDecCfgSet cfg;
+    MppDecHwCap hw_info;
+    ParserCfg parser_cfg;
+    HalDecTask task;
+    Parser parser = NULL;
+    MppBufSlots frame_slots = NULL;
+    MppBufSlots packet_slots = NULL;
+    MppPacket packet = NULL;
+    MPP_RET ret = MPP_NOK;
+
+    memset(&cfg, 0, sizeof(cfg));
+    memset(&hw_info, 0, sizeof(hw_info));
+    memset(&parser_cfg, 0, sizeof(parser_cfg));
+    memset(&task, 0, sizeof(task));
+    cfg.base.split_parse = 1;
+
+    mpp_buf_slot_init(&frame_slots);
+    mpp_buf_slot_init(&packet_slots);
+    TEST_CHECK(frame_slots && packet_slots);
+
+    parser_cfg.coding = c->coding;
+    parser_cfg.frame_slots = frame_slots;
+    parser_cfg.packet_slots = packet_slots;
+    parser_cfg.cfg = &cfg;
+    parser_cfg.hw_info = &hw_info;
+    TEST_CHECK(!mpp_parser_init(&parser, &parser_cfg));
+
+    mpp_packet_init(&packet, c->data, c->size);
+    TEST_CHECK(packet);
+    if (eoi)
+        mpp_packet_set_eoi(packet);
+
+    task.input = -1;
+    mpp_parser_prepare(parser, packet, &task);
+    TEST_CHECK(!mpp_packet_get_length(packet));
+
+    *valid = task.valid;
+    ret = MPP_OK;
+
+DONE:
+    if (packet)
+        mpp_packet_deinit(&packet);
+    if (parser)
+        mpp_parser_deinit(parser);
+    if (packet_slots)
+        mpp_buf_slot_deinit(packet_slots);
+    if (frame_slots)
+        mpp_buf_slot_deinit(frame_slots);
+
+    return ret;
+}
+
+int main(void)
+{
+    MppPacket packet = NULL;
+    RK_U32 valid = 0;
+    MPP_RET ret = MPP_NOK;
+    RK_U32 i;
+
+    mpp_log("mpp_parser eoi test start\n");
+
+    /* eoi is cleared on the reused packet */
+    mpp_packet_init(&packet, avc_au, sizeof(avc_au));
+    TEST_CHECK(packet);
+    mpp_packet_set_eoi(packet);
+    TEST_CHECK(mpp_packet_is_eoi(packet));
+    mpp_packet_clr_eoi(packet);
+    TEST_CHECK(!mpp_packet_is_eoi(packet));
+
+    for (i = 0; i < MPP_ARRAY_ELEMS(test_cases); i++) {
+        TestCase *c = &test_cases[i];
+
+        /* without eoi the split parser waits for the next start code */
+        TEST_CHECK(!test_prepare(c, 0, &valid));
+        mpp_log("%s access unit without eoi valid %d\n", c->name, valid);
+        TEST_CHECK(!valid);
+
+        /* eoi packet closes the access unit */
+        TEST_CHECK(!test_prepare(c, 1, &valid));
+        mpp_log("%s access unit with eoi valid %d\n", c->name, valid);
+        TEST_CHECK(valid);
+    }
+
+    ret = MPP_OK;
+
+DONE:
+    if (packet)
+        mpp_packet_deinit(&packet);
+
+    mpp_log("mpp_parser eoi test %s\n", ret ? "failed" : "success");
+
+    return ret;
+}
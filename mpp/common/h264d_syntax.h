@@ -415,6 +415,8 @@ typedef struct DXVA_PicParams_H264_MVC_t {
 
     //!< extensive
     RK_U32  spspps_update;
+    //!< bumped by parser on each sps / pps change
+    RK_U32  spspps_gen;
 
     //!< for fpga test
     RK_U16 seq_parameter_set_id;
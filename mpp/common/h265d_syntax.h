@@ -171,6 +171,8 @@ typedef struct DXVA_PicParams_HEVC_t {
     RK_U8   scaling_list_data_present_flag;
     RK_U8   ps_update_flag;
     RK_U8   rps_update_flag;
+    /* bumped by parser on each vps / sps / pps change */
+    RK_U32  ps_gen;
 } DXVA_PicParams_HEVC, *LPDXVA_PicParams_HEVC;
 
 /* HEVC Quantizatiuon Matrix structure */
@@ -188,6 +188,9 @@ typedef struct JpegdSyntax {
     RK_U8          sample_precision;
     RK_U8          qtbl_entry;
     RK_U8          htbl_entry;
+
+    /* increased when DQT / DHT content differs from previous image */
+    RK_U32         tbl_gen;
 } JpegdSyntax;
 
 #endif /* JPEGD_SYNTAX_H */
@@ -282,13 +282,10 @@ MPP_RET h264e_vepu_stream_amend_proc(HalH264eVepuStreamAmend *ctx, MppEncH264HwC
 
         mpp_assert(tail_0bit < 8);
 
-        // move the reset slice data from src buffer to dst buffer
-        diff_size = h264e_slice_move(dst_buf, ctx->src_buf,
-                                     sw_len_bit, hw_len_bit, nal_len);
-
-        hal_h264e_dbg_amend("tail 0x%02x %d hw_hdr %d sw_hdr %d len %d hw_byte %d sw_byte %d diff %d\n",
-                            tail_byte, tail_0bit, hw_len_bit, sw_len_bit, nal_len, hw_len_byte, sw_len_byte, diff_size);
+        hal_h264e_dbg_amend("tail 0x%02x %d hw_hdr %d sw_hdr %d len %d hw_byte %d sw_byte %d\n",
+                            tail_byte, tail_0bit, hw_len_bit, sw_len_bit, nal_len, hw_len_byte, sw_len_byte);
 
+        /* cabac slice header is byte aligned so slice data is copied directly */
         if (slice->entropy_coding_mode) {
             memcpy(dst_buf + sw_len_byte, ctx->src_buf + hw_len_byte,
                    nal_len - hw_len_byte);
@@ -297,7 +294,12 @@ MPP_RET h264e_vepu_stream_amend_proc(HalH264eVepuStreamAmend *ctx, MppEncH264HwC
         } else {
             RK_S32 hdr_diff_bit = sw_len_bit - hw_len_bit;
             RK_S32 bit_len = nal_len * 8 - tail_0bit + hdr_diff_bit;
-            RK_S32 new_len = (bit_len + diff_size * 8 + 7) / 8;
+            RK_S32 new_len;
+
+            // move the reset slice data from src buffer to dst buffer
+            diff_size = h264e_slice_move(dst_buf, ctx->src_buf,
+                                         sw_len_bit, hw_len_bit, nal_len);
+            new_len = (bit_len + diff_size * 8 + 7) / 8;
 
             hal_h264e_dbg_amend("frm %4d %c len %d bit hw %d sw %d byte hw %d sw %d diff %d -> %d\n",
                                 slice->frame_num, (slice->idr_flag ? 'I' : 'P'),
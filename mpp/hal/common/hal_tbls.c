@@ -0,0 +1,177 @@
+/* SPDX-License-Identifier: Apache-2.0 OR MIT */
+/*
+ * Copyright (c) 2026 Rockchip Electronics Co., Ltd.
+ */
+
+#define MODULE_TAG "hal_tbls"
+
+#include <string.h>
+#include <pthread.h>
+
+#include "mpp_env.h"
+#include "mpp_mem.h"
+#include "mpp_list.h"
+#include "mpp_soc.h"
+#include "mpp_debug.h"
+#include "mpp_common.h"
+#include "mpp_buffer_impl.h"
+
+#include "hal_tbls.h"
+
+#define HAL_TBLS_DBG_INFO               (0x00000001)
+
+#define hal_tbls_dbg_info(fmt, ...)     mpp_dbg_f(hal_tbls_debug, HAL_TBLS_DBG_INFO, fmt, ## __VA_ARGS__)
+
+typedef struct HalTblNode_t {
+    struct list_head    list;
+    RockchipSocType     soc;
+    MppCodingType       coding;
+    RK_U32              id;
+    size_t              size;
+    MppBuffer           buf;
+    RK_S32              ref_count;
+} HalTblNode;
+
+static RK_U32 hal_tbls_debug = 0;
+static pthread_mutex_t tbls_lock = PTHREAD_MUTEX_INITIALIZER;
+static MppBufferGroup tbls_group = NULL;
+static LIST_HEAD(tbls_list);
+
+static HalTblNode *tbl_node_create(RockchipSocType soc, MppCodingType coding, RK_U32 id,
+                                   const void *data, size_t size, HalTblInit init)
+{
+    HalTblNode *node = NULL;
+    void *ptr;
+
+    if (!tbls_group && mpp_buffer_group_get_internal(&tbls_group, MPP_BUFFER_TYPE_ION)) {
+        mpp_err_f("failed to get table group\n");
+        return NULL;
+    }
+
+    node = mpp_calloc(HalTblNode, 1);
+    if (!node)
+        return NULL;
+
+    /* align to page and clear the tail for hardware prefetch */
+    if (mpp_buffer_get(tbls_group, &node->buf, MPP_ALIGN(size, SZ_4K))) {
+        mpp_err_f("failed to get table %d:%d size %d\n", coding, id, (RK_S32)size);
+        mpp_free(node);
+        return NULL;
+    }
+
+    ptr = mpp_buffer_get_ptr(node->buf);
+    memset(ptr, 0, MPP_ALIGN(size, SZ_4K));
+    if (data)
+        memcpy(ptr, data, size);
+    if (init)
+        init(ptr, size);
+    mpp_buffer_sync_end(node->buf);
+
+    INIT_LIST_HEAD(&node->list);
+    node->soc = soc;
+    node->coding = coding;
+    node->id = id;
+    node->size = size;
+    list_add_tail(&node->list, &tbls_list);
+
+    hal_tbls_dbg_info("create table %d:%d size %d\n", coding, id, (RK_S32)size);
+
+    return node;
+}
+
+MPP_RET hal_tbl_get(MppBuffer *buf, MppDev dev, MppCodingType coding, RK_U32 id,
+                    const void *data, size_t size, HalTblInit init)
+{
+    RockchipSocType soc = mpp_get_soc_type();
+    HalTblNode *node = NULL;
+    HalTblNode *pos, *n;
+
+    if (!buf || !size) {
+        mpp_err_f("invalid input buf %p size %d\n", buf, (RK_S32)size);
+        return MPP_ERR_NULL_PTR;
+    }
+
+    *buf = NULL;
+
+    mpp_env_get_u32("hal_tbls_debug", &hal_tbls_debug, 0);
+
+    pthread_mutex_lock(&tbls_lock);
+
+    list_for_each_entry_safe(pos, n, &tbls_list, HalTblNode, list) {
+        if (pos->soc == soc && pos->coding == coding && pos->id == id) {
+            node = pos;
+            break;
+        }
+    }
+
+    if (node && node->size < size) {
+        mpp_err_f("table %d:%d size %d mismatch with %d\n", coding, id,
+                  (RK_S32)size, (RK_S32)node->size);
+        node = NULL;
+    } else if (!node) {
+        node = tbl_node_create(soc, coding, id, data, size, init);
+    }
+
+    if (node)
+        node->ref_count++;
+
+    if (list_empty(&tbls_list) && tbls_group) {
+        mpp_buffer_group_put(tbls_group);
+        tbls_group = NULL;
+    }
+
+    pthread_mutex_unlock(&tbls_lock);
+
+    if (!node)
+        return MPP_NOK;
+
+    if (dev)
+        mpp_buffer_attach_dev(node->buf, dev);
+
+    *buf = node->buf;
+
+    return MPP_OK;
+}
+
+MPP_RET hal_tbl_put(MppBuffer buf, MppDev dev)
+{
+    HalTblNode *node = NULL;
+    HalTblNode *pos, *n;
+
+    if (!buf)
+        return MPP_OK;
+
+    if (dev)
+        mpp_buffer_detach_dev(buf, dev);
+
+    pthread_mutex_lock(&tbls_lock);
+
+    list_for_each_entry_safe(pos, n, &tbls_list, HalTblNode, list) {
+        if (pos->buf == buf) {
+            node = pos;
+            break;
+        }
+    }
+
+    if (node && !--node->ref_count) {
+        hal_tbls_dbg_info("release table %d:%d\n", node->coding, node->id);
+
+        list_del_init(&node->list);
+        mpp_buffer_put(node->buf);
+        mpp_free(node);
+    }
+
+    if (list_empty(&tbls_list) && tbls_group) {
+        mpp_buffer_group_put(tbls_group);
+        tbls_group = NULL;
+    }
+
+    pthread_mutex_unlock(&tbls_lock);
+
+    if (!node) {
+        mpp_err_f("invalid table buffer %p\n", buf);
+        return MPP_NOK;
+    }
+
+    return MPP_OK;
+}
@@ -0,0 +1,41 @@
+/* SPDX-License-Identifier: Apache-2.0 OR MIT */
+/*
+ * Copyright (c) 2026 Rockchip Electronics Co., Ltd.
+ */
+
+#ifndef HAL_TBLS_H
+#define HAL_TBLS_H
+
+#include "rk_type.h"
+#include "mpp_buffer.h"
+#include "mpp_device.h"
+
+/*
+ * Process-wide shared read-only hardware tables
+ *
+ * Constant tables like cabac init table or default probability are the same
+ * for all sessions. Each table is allocated once per (soc, coding, id) in a
+ * shared buffer group, refcounted by sessions and attached to the device of
+ * each session. Hal must not write the returned buffer.
+ */
+typedef void (*HalTblInit)(void *ptr, size_t size);
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * get a shared table, the content is built on first get by copying size
+ * bytes from data when data is not NULL and then calling init when init is
+ * not NULL. The buffer is aligned to 4K and the tail is cleared.
+ */
+MPP_RET hal_tbl_get(MppBuffer *buf, MppDev dev, MppCodingType coding, RK_U32 id,
+                    const void *data, size_t size, HalTblInit init);
+/* detach from device and release the session reference, NULL is ignored */
+MPP_RET hal_tbl_put(MppBuffer buf, MppDev dev);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* HAL_TBLS_H */
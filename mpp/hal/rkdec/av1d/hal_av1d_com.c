@@ -939,6 +939,16 @@ const RK_U32 g_av1d_default_prob[7400] = {
     0x20006000, 0x0c000800, 0x01000400, 0x00800180, 0x00300020, 0x00040010, 0x80020006, 0x80000000,
 };
 
+MPP_RET vdpu38x_av1d_get_def_cdf(Av1dHalCtx *p_hal, Vdpu38xAv1dDefCdf id,
+                                 HalTblInit init)
+{
+    Vdpu38xAv1dRegCtx *reg_ctx = (Vdpu38xAv1dRegCtx *)p_hal->reg_ctx;
+
+    return hal_tbl_get(&reg_ctx->cdf_rd_def_base, p_hal->cfg->dev,
+                       MPP_VIDEO_CodingAV1, id, g_av1d_default_prob,
+                       sizeof(g_av1d_default_prob), init);
+}
+
 static void hal_av1d_release_res(void *hal)
 {
     Av1dHalCtx *p_hal = (Av1dHalCtx *)hal;
@@ -949,7 +959,7 @@ static void hal_av1d_release_res(void *hal)
     for (i = 0; i < max_cnt; i++)
         MPP_FREE(reg_ctx->reg_buf[i].regs);
 
-    BUF_PUT(reg_ctx->cdf_rd_def_base);
+    hal_tbl_put(reg_ctx->cdf_rd_def_base, p_hal->cfg->dev);
     BUF_PUT(reg_ctx->bufs);
     for (i = 0; i < max_cnt; i++)
         BUF_PUT(reg_ctx->rcb_bufs[i]);
@@ -8,6 +8,7 @@
 
 #include "rk_mpi_cmd.h"
 #include "av1d_syntax.h"
+#include "hal_tbls.h"
 #include "hal_av1d_common.h"
 #include "vdpu38x_com.h"
 
@@ -17,6 +18,15 @@
 
 extern const RK_U32 g_av1d_default_prob[7400];
 
+/* hal_tbls id of the shared default cdf for each hardware variant */
+typedef enum Vdpu38xAv1dDefCdf_e {
+    VDPU38X_AV1D_DEF_CDF_383,
+    VDPU38X_AV1D_DEF_CDF_384B,
+    VDPU38X_AV1D_DEF_CDF_BUTT,
+} Vdpu38xAv1dDefCdf;
+
+MPP_RET vdpu38x_av1d_get_def_cdf(Av1dHalCtx *p_hal, Vdpu38xAv1dDefCdf id,
+                                 HalTblInit init);
 MPP_RET vdpu38x_av1d_deinit(void *hal);
 MPP_RET vdpu38x_av1d_reset(void *hal);
 MPP_RET vdpu38x_av1d_flush(void *hal);
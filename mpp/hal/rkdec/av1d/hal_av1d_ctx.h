@@ -49,6 +49,7 @@ typedef struct Vdpu38xAv1dRegCtx_t {
 
     Vdpu38xRefInfo      ref_info_tbl[AV1_NUM_REF_FRAMES];
 
+    /* process-wide shared read-only default cdf from hal_tbls */
     MppBuffer           cdf_rd_def_base;
     HalBufs             cdf_segid_bufs;
     RK_U32              cdf_segid_count;
@@ -61,12 +62,6 @@ typedef struct Vdpu38xAv1dRegCtx_t {
     MppBuffer           filter_mem;
     MppBuffer           tile_buf;
 
-    AV1CDFs             *cdfs;
-    Av1MvCDFs           *cdfs_ndvc;
-    AV1CDFs             default_cdfs;
-    Av1MvCDFs           default_cdfs_ndvc;
-    AV1CDFs             cdfs_last[AV1_NUM_REF_FRAMES];
-    Av1MvCDFs           cdfs_last_ndvc[AV1_NUM_REF_FRAMES];
     RK_U32              refresh_frame_flags;
 
     RK_U32              width;
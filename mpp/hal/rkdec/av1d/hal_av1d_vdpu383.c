@@ -35,7 +35,6 @@ static MPP_RET hal_av1d_alloc_res(void *hal)
     Av1dHalCtx *p_hal = (Av1dHalCtx *)hal;
     RK_U32 max_cnt = (p_hal->fast_mode != 0) ? VDPU_FAST_REG_SET_CNT : 1;
     RK_U32 i = 0;
-    void *cdf_ptr;
     INP_CHECK(ret, NULL == p_hal);
 
     MEM_CHECK(ret, p_hal->reg_ctx = mpp_calloc_size(void, sizeof(Vdpu38xAv1dRegCtx) +
@@ -59,12 +58,7 @@ static MPP_RET hal_av1d_alloc_res(void *hal)
         reg_ctx->offset_uncomps = reg_ctx->uncmps_offset[0];
     }
 
-    BUF_CHECK(ret, mpp_buffer_get(p_hal->cfg->buf_group, &reg_ctx->cdf_rd_def_base,
-                                  MPP_ALIGN(sizeof(g_av1d_default_prob), SZ_2K)));
-    mpp_buffer_attach_dev(reg_ctx->cdf_rd_def_base, p_hal->cfg->dev);
-    cdf_ptr = mpp_buffer_get_ptr(reg_ctx->cdf_rd_def_base);
-    memcpy(cdf_ptr, g_av1d_default_prob, sizeof(g_av1d_default_prob));
-    mpp_buffer_sync_end(reg_ctx->cdf_rd_def_base);
+    FUN_CHECK(ret = vdpu38x_av1d_get_def_cdf(p_hal, VDPU38X_AV1D_DEF_CDF_383, NULL));
 
 __RETURN:
     return ret;
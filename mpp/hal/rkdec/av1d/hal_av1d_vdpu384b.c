@@ -226,11 +226,26 @@ static struct {
     },
 };
 
+/* update vdpu384b def cdf */
+static void vdpu384b_av1d_def_cdf_init(void *ptr, size_t size)
+{
+    RK_U8 *src, *dst;
+    RK_U32 i;
+
+    (void)size;
+
+    for (i = 0; i < VDPU384B_DEF_CDF_UPDATE_ARRAY_SIZE; i++) {
+        src = (RK_U8 *)vdpu384b_def_prob_update_info[i].data;
+        dst = (RK_U8 *)ptr;
+        dst += vdpu384b_def_prob_update_info[i].org_data_off;
+        memcpy(dst, src, vdpu384b_def_prob_update_info[i].new_data_sz);
+    }
+}
+
 static MPP_RET hal_av1d_alloc_res(void *hal)
 {
     Av1dHalCtx *p_hal = (Av1dHalCtx *)hal;
     RK_U32 max_cnt = p_hal->fast_mode ? VDPU_FAST_REG_SET_CNT : 1;
-    void *cdf_ptr;
     Vdpu38xAv1dRegCtx *reg_ctx = NULL;
     RK_U32 i = 0;
     MPP_RET ret = MPP_OK;
@@ -259,22 +274,8 @@ static MPP_RET hal_av1d_alloc_res(void *hal)
         reg_ctx->offset_uncomps = reg_ctx->uncmps_offset[0];
     }
 
-    BUF_CHECK(ret, mpp_buffer_get(p_hal->cfg->buf_group, &reg_ctx->cdf_rd_def_base, MPP_ALIGN(sizeof(g_av1d_default_prob), 2048)));
-    mpp_buffer_attach_dev(reg_ctx->cdf_rd_def_base, p_hal->cfg->dev);
-    cdf_ptr = mpp_buffer_get_ptr(reg_ctx->cdf_rd_def_base);
-    memcpy(cdf_ptr, g_av1d_default_prob, sizeof(g_av1d_default_prob));
-    /* update vdpu384b def cdf */
-    {
-        RK_U8 *src, *dst;
-
-        for (i = 0; i < VDPU384B_DEF_CDF_UPDATE_ARRAY_SIZE; i++) {
-            src = (RK_U8 *)vdpu384b_def_prob_update_info[i].data;
-            dst = (RK_U8 *)cdf_ptr;
-            dst += vdpu384b_def_prob_update_info[i].org_data_off;
-            memcpy(dst, src, vdpu384b_def_prob_update_info[i].new_data_sz);
-        }
-    }
-    mpp_buffer_sync_end(reg_ctx->cdf_rd_def_base);
+    FUN_CHECK(ret = vdpu38x_av1d_get_def_cdf(p_hal, VDPU38X_AV1D_DEF_CDF_384B,
+                                             vdpu384b_av1d_def_cdf_init));
 
 __RETURN:
     return ret;
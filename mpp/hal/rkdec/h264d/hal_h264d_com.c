@@ -185,6 +185,9 @@ MPP_RET vdpu3xx_h264d_deinit(void *hal)
         reg_ctx->bufs = NULL;
     }
 
+    hal_tbl_put(reg_ctx->cabac_tbl, p_hal->cfg->dev);
+    reg_ctx->cabac_tbl = NULL;
+
     if (reg_ctx->vdpu382_is_used == 1) {
         for (i = 0; i < loop; i++)
             MPP_FREE(reg_ctx->reg_382_buf[i].regs);
@@ -270,6 +273,49 @@ __RETURN:
     return ret = MPP_OK;
 }
 
+/*
+ * The sps / pps head only depends on the parameter sets and the picture
+ * structure. It is cached by pps id so that fast mode and pps switching do
+ * not repack it. The parser bumps spspps_gen on any sps / pps parsed which
+ * drops all the cached heads. MVC streams are not cached.
+ */
+static RK_U32 vdpu38x_h264d_spspps_key(DXVA_PicParams_H264_MVC *pp)
+{
+    return pp->pps_pic_parameter_set_id | (pp->seq_parameter_set_id << 8) |
+           (pp->field_pic_flag << 16) | (pp->MbaffFrameFlag << 17);
+}
+
+static RK_U32 vdpu38x_h264d_spspps_cache_hit(H264dHalCtx_t *p_hal, RK_U64 *data)
+{
+    DXVA_PicParams_H264_MVC *pp = p_hal->pp;
+    H264dSpsPpsCache *cache;
+
+    if (pp->mvc_extension_enable || !pp->spspps_gen)
+        return 0;
+
+    cache = &p_hal->spspps_cache[pp->pps_pic_parameter_set_id & (H264D_SPSPPS_CACHE_CNT - 1)];
+    if (cache->gen != pp->spspps_gen || cache->key != vdpu38x_h264d_spspps_key(pp))
+        return 0;
+
+    memcpy(data, cache->data, sizeof(cache->data));
+
+    return 1;
+}
+
+static void vdpu38x_h264d_spspps_cache_store(H264dHalCtx_t *p_hal, RK_U64 *data)
+{
+    DXVA_PicParams_H264_MVC *pp = p_hal->pp;
+    H264dSpsPpsCache *cache;
+
+    if (pp->mvc_extension_enable)
+        return;
+
+    cache = &p_hal->spspps_cache[pp->pps_pic_parameter_set_id & (H264D_SPSPPS_CACHE_CNT - 1)];
+    memcpy(cache->data, data, sizeof(cache->data));
+    cache->gen = pp->spspps_gen;
+    cache->key = vdpu38x_h264d_spspps_key(pp);
+}
+
 MPP_RET vdpu38x_h264d_prepare_spspps(H264dHalCtx_t *p_hal, RK_U64 *data, RK_U32 len)
 {
     RockchipSocType soc_type = mpp_get_soc_type();
@@ -281,9 +327,10 @@ MPP_RET vdpu38x_h264d_prepare_spspps(H264dHalCtx_t *p_hal, RK_U64 *data, RK_U32
 
     mpp_set_bitput_ctx(&bp, data, len);
 
-    if (!p_hal->fast_mode && !pp->spspps_update) {
-        bp.index = 2;
-        bp.bitpos = 24;
+    if ((!p_hal->fast_mode && !pp->spspps_update) ||
+        vdpu38x_h264d_spspps_cache_hit(p_hal, data)) {
+        bp.index = H264D_SPSPPS_HEAD_INDEX;
+        bp.bitpos = H264D_SPSPPS_HEAD_BITS;
         bp.bvalue = bp.pbuf[bp.index] & 0xFFFFFF;
     } else {
         RK_U32 pic_width, pic_height;
@@ -339,6 +386,8 @@ MPP_RET vdpu38x_h264d_prepare_spspps(H264dHalCtx_t *p_hal, RK_U64 *data, RK_U32
         mpp_put_bits(&bp, pp->transform_8x8_mode_flag, 1);
         mpp_put_bits(&bp, pp->second_chroma_qp_index_offset, 5);
         mpp_put_bits(&bp, pp->scaleing_list_enable_flag, 1);
+
+        vdpu38x_h264d_spspps_cache_store(p_hal, data);
     }
 
     //!< set dpb
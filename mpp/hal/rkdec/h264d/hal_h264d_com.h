@@ -7,10 +7,14 @@
 #define HAL_H264D_COM_H
 
 #include "rk_mpi_cmd.h"
+#include "hal_tbls.h"
 #include "vdpu38x_com.h"
 
 #define H264_CTU_SIZE      16
 
+/* hal_tbls id of shared h264 tables */
+#define HAL_H264D_TBL_RKV_CABAC     0
+
 extern const RK_U32 rkv_cabac_table[928];
 
 MPP_RET vdpu3xx_h264d_deinit(void *hal);
@@ -29,8 +29,9 @@ typedef struct Vdpu3xxH264dRegCtx_t {
     MppBuffer           bufs;
     RK_S32              bufs_fd;
     void                *bufs_ptr;
-    RK_U32              offset_cabac;
     RK_U32              offset_errinfo;
+    /* process-wide shared read-only cabac table from hal_tbls */
+    MppBuffer           cabac_tbl;
     RK_U32              offset_spspps[VDPU_FAST_REG_SET_CNT];
     RK_U32              offset_rps[VDPU_FAST_REG_SET_CNT];
     RK_U32              offset_sclst[VDPU_FAST_REG_SET_CNT];
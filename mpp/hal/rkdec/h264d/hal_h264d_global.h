@@ -93,6 +93,18 @@ do{\
 }} while (0)
 
 
+/* vdpu38x packed sps / pps head is 152 bits, cached by pps id */
+#define H264D_SPSPPS_CACHE_CNT      16
+#define H264D_SPSPPS_CACHE_LEN      3
+#define H264D_SPSPPS_HEAD_INDEX     2
+#define H264D_SPSPPS_HEAD_BITS      24
+
+typedef struct H264dSpsPpsCache_t {
+    RK_U32                   gen;
+    RK_U32                   key;
+    RK_U64                   data[H264D_SPSPPS_CACHE_LEN];
+} H264dSpsPpsCache;
+
 typedef struct h264d_hal_ctx_t {
     DXVA_PicParams_H264_MVC  *pp;
     DXVA_Qmatrix_H264        *qm;
@@ -112,6 +124,8 @@ typedef struct h264d_hal_ctx_t {
 
     void                     *reg_ctx;
     RK_U32                   fast_mode;
+    //!< packed sps / pps head, valid when spspps_gen matches
+    H264dSpsPpsCache         spspps_cache[H264D_SPSPPS_CACHE_CNT];
 } H264dHalCtx_t;
 
 extern const RK_U32 h264_cabac_table[928];
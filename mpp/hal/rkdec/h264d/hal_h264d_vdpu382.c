@@ -41,14 +41,12 @@
 /* Number registers for the decoder */
 #define DEC_VDPU382_REGISTERS               276
 
-#define VDPU382_CABAC_TAB_SIZE              (928*4 + 128)       /* bytes */
 #define VDPU382_SPSPPS_UNIT_SIZE            (48)                /* bytes */
 #define VDPU382_SPSPPS_SIZE                 (256*48 + 128)      /* bytes */
 #define VDPU382_RPS_SIZE                    (128 + 128 + 128)   /* bytes */
 #define VDPU382_SCALING_LIST_SIZE           (6*16+2*64 + 128)   /* bytes */
 #define VDPU382_ERROR_INFO_SIZE             (256*144*4)         /* bytes */
 
-#define VDPU382_CABAC_TAB_ALIGNED_SIZE      (MPP_ALIGN(VDPU382_CABAC_TAB_SIZE, SZ_4K))
 #define VDPU382_ERROR_INFO_ALIGNED_SIZE     (0)
 #define VDPU382_SPSPPS_ALIGNED_SIZE         (MPP_ALIGN(VDPU382_SPSPPS_SIZE, SZ_4K))
 #define VDPU382_RPS_ALIGNED_SIZE            (MPP_ALIGN(VDPU382_RPS_SIZE, SZ_4K))
@@ -57,8 +55,7 @@
                                              VDPU382_RPS_ALIGNED_SIZE + \
                                              VDPU382_SCALING_LIST_ALIGNED_SIZE)
 
-#define VDPU382_CABAC_TAB_OFFSET            (0)
-#define VDPU382_ERROR_INFO_OFFSET           (VDPU382_CABAC_TAB_OFFSET + VDPU382_CABAC_TAB_ALIGNED_SIZE)
+#define VDPU382_ERROR_INFO_OFFSET           (0)
 #define VDPU382_STREAM_INFO_OFFSET_BASE     (VDPU382_ERROR_INFO_OFFSET + VDPU382_ERROR_INFO_ALIGNED_SIZE)
 #define VDPU382_SPSPPS_OFFSET(pos)          (VDPU382_STREAM_INFO_OFFSET_BASE + (VDPU382_STREAM_INFO_SET_SIZE * pos))
 #define VDPU382_RPS_OFFSET(pos)             (VDPU382_SPSPPS_OFFSET(pos) + VDPU382_SPSPPS_ALIGNED_SIZE)
@@ -445,8 +442,7 @@ static MPP_RET set_registers(H264dHalCtx_t *p_hal, Vdpu382H264dRegSet *regs, Hal
         regs->common_addr.reg128_rlc_base = mpp_buffer_get_fd(mbuffer);
         regs->common_addr.reg129_rlcwrite_base = regs->common_addr.reg128_rlc_base;
 
-        regs->h264d_addr.cabactbl_base = reg_ctx->bufs_fd;
-        mpp_dev_set_reg_offset(cfg->dev, 197, reg_ctx->offset_cabac);
+        regs->h264d_addr.cabactbl_base = mpp_buffer_get_fd(reg_ctx->cabac_tbl);
     }
 
     return MPP_OK;
@@ -527,7 +523,6 @@ MPP_RET vdpu382_h264d_init(void *hal, MppHalCfg *cfg)
                                    VDPU382_INFO_BUFFER_SIZE(max_cnt)));
     reg_ctx->bufs_fd = mpp_buffer_get_fd(reg_ctx->bufs);
     reg_ctx->bufs_ptr = mpp_buffer_get_ptr(reg_ctx->bufs);
-    reg_ctx->offset_cabac = VDPU382_CABAC_TAB_OFFSET;
     reg_ctx->offset_errinfo = VDPU382_ERROR_INFO_OFFSET;
     reg_ctx->vdpu382_is_used = 1;
     for (i = 0; i < max_cnt; i++) {
@@ -545,9 +540,10 @@ MPP_RET vdpu382_h264d_init(void *hal, MppHalCfg *cfg)
         reg_ctx->sclst_offset = reg_ctx->offset_sclst[0];
     }
 
-    //!< copy cabac table bytes
-    memcpy((char *)reg_ctx->bufs_ptr + reg_ctx->offset_cabac,
-           (void *)rkv_cabac_table, sizeof(rkv_cabac_table));
+    //!< shared cabac table
+    FUN_CHECK(ret = hal_tbl_get(&reg_ctx->cabac_tbl, cfg->dev, MPP_VIDEO_CodingAVC,
+                                HAL_H264D_TBL_RKV_CABAC, rkv_cabac_table,
+                                sizeof(rkv_cabac_table), NULL));
 
     mpp_slots_set_prop(cfg->frame_slots, SLOTS_HOR_ALIGN, mpp_align_16);
     mpp_slots_set_prop(cfg->frame_slots, SLOTS_VER_ALIGN, mpp_align_16);
@@ -25,13 +25,11 @@
 /* Number registers for the decoder */
 #define DEC_VDPU383_REGISTERS               276
 
-#define VDPU383_CABAC_TAB_SIZE              (928*4 + 128)       /* bytes */
 #define VDPU383_SPSPPS_SIZE                 (168 + 128)     /* bytes */
 #define VDPU383_RPS_SIZE                    (128 + 128 + 128)   /* bytes */
 #define VDPU383_SCALING_LIST_SIZE           (6*16+2*64 + 128)   /* bytes */
 #define VDPU383_ERROR_INFO_SIZE             (256*144*4)         /* bytes */
 
-#define VDPU383_CABAC_TAB_ALIGNED_SIZE      (MPP_ALIGN(VDPU383_CABAC_TAB_SIZE, SZ_4K))
 #define VDPU383_ERROR_INFO_ALIGNED_SIZE     (0)
 #define VDPU383_SPSPPS_ALIGNED_SIZE         (MPP_ALIGN(VDPU383_SPSPPS_SIZE, SZ_4K))
 #define VDPU383_RPS_ALIGNED_SIZE            (MPP_ALIGN(VDPU383_RPS_SIZE, SZ_4K))
@@ -40,8 +38,7 @@
                                              VDPU383_RPS_ALIGNED_SIZE + \
                                              VDPU383_SCALING_LIST_ALIGNED_SIZE)
 
-#define VDPU383_CABAC_TAB_OFFSET            (0)
-#define VDPU383_ERROR_INFO_OFFSET           (VDPU383_CABAC_TAB_OFFSET + VDPU383_CABAC_TAB_ALIGNED_SIZE)
+#define VDPU383_ERROR_INFO_OFFSET           (0)
 #define VDPU383_STREAM_INFO_OFFSET_BASE     (VDPU383_ERROR_INFO_OFFSET + VDPU383_ERROR_INFO_ALIGNED_SIZE)
 #define VDPU383_SPSPPS_OFFSET(pos)          (VDPU383_STREAM_INFO_OFFSET_BASE + (VDPU383_STREAM_INFO_SET_SIZE * pos))
 #define VDPU383_RPS_OFFSET(pos)             (VDPU383_SPSPPS_OFFSET(pos) + VDPU383_SPSPPS_ALIGNED_SIZE)
@@ -261,8 +258,7 @@ static MPP_RET set_registers(H264dHalCtx_t *p_hal, Vdpu383RegSet *regs, HalTaskI
         }
 #endif
 
-        regs->comm_addrs.reg130_cabactbl_base = reg_ctx->bufs_fd;
-        mpp_dev_set_reg_offset(cfg->dev, 130, reg_ctx->offset_cabac);
+        regs->comm_addrs.reg130_cabactbl_base = mpp_buffer_get_fd(reg_ctx->cabac_tbl);
     }
 
     {
@@ -327,7 +323,6 @@ MPP_RET vdpu383_h264d_init(void *hal, MppHalCfg *cfg)
                                    VDPU383_INFO_BUFFER_SIZE(max_cnt)));
     reg_ctx->bufs_fd = mpp_buffer_get_fd(reg_ctx->bufs);
     reg_ctx->bufs_ptr = mpp_buffer_get_ptr(reg_ctx->bufs);
-    reg_ctx->offset_cabac = VDPU383_CABAC_TAB_OFFSET;
     reg_ctx->offset_errinfo = VDPU383_ERROR_INFO_OFFSET;
     for (i = 0; i < max_cnt; i++) {
         reg_ctx->reg_buf[i].regs = mpp_calloc(Vdpu383RegSet, 1);
@@ -346,9 +341,10 @@ MPP_RET vdpu383_h264d_init(void *hal, MppHalCfg *cfg)
         reg_ctx->sclst_offset = reg_ctx->offset_sclst[0];
     }
 
-    //!< copy cabac table bytes
-    memcpy((char *)reg_ctx->bufs_ptr + reg_ctx->offset_cabac,
-           (void *)rkv_cabac_table, sizeof(rkv_cabac_table));
+    //!< shared cabac table
+    FUN_CHECK(ret = hal_tbl_get(&reg_ctx->cabac_tbl, cfg->dev, MPP_VIDEO_CodingAVC,
+                                HAL_H264D_TBL_RKV_CABAC, rkv_cabac_table,
+                                sizeof(rkv_cabac_table), NULL));
 
     mpp_slots_set_prop(cfg->frame_slots, SLOTS_HOR_ALIGN, mpp_align_128_odd_plus_64);
     mpp_slots_set_prop(cfg->frame_slots, SLOTS_VER_ALIGN, mpp_align_16);
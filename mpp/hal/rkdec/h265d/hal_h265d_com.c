@@ -216,85 +216,176 @@ void hal_record_scaling_list(scalingFactor_t *pScalingFactor_out, scalingList_t
     }
 }
 
-int hal_h265d_slice_rpl(void *dxva, SliceHeader_t *sh, RefPicListTab_t *ref)
+/*
+ * Candidate lists of the frame for ref list construction. The order is
+ * ST_CURR_BEF - ST_CURR_AFT - LT_CURR for the L0 and
+ * ST_CURR_AFT - ST_CURR_BEF - LT_CURR for the L1.
+ * They only depend on the frame RPS so they are built once per frame.
+ */
+typedef struct H265dRplCand_t {
+    RK_U8   dpb_index[2][MAX_REFS];
+    RK_U32  nb_refs;
+} H265dRplCand;
+
+/* ref list inputs of a slice, slices with the same inputs share the result */
+typedef struct H265dRplKey_t {
+    RK_U32  slice_type;
+    RK_U32  nb_refs[2];
+    RK_U32  rpl_modification_flag[2];
+    RK_U32  list_entry_lx[2][MAX_REFS];
+} H265dRplKey;
+
+/* per slice output, entry is is_long_term | dpb_index << 1 */
+typedef struct H265dSliceRps_t {
+    RK_U8   entry[2][15];
+    RK_U8   lowdelay_flag;
+    RK_U8   nb_rps_poc;
+    RK_U8   rps_bit_offset;
+    RK_U8   rps_bit_offset_st;
+} H265dSliceRps;
+
+static void hal_h265d_rpl_cand(DXVA_PicParams_HEVC *pp, H265dRplCand *cand)
 {
-    RK_U8 nb_list = sh->slice_type == B_SLICE ? 2 : 1;
-    RK_U8 list_idx;
-    RK_U8 bef_nb_refs = 0, aft_nb_refs = 0, lt_cur_nb_refs = 0;
-    h265d_dxva2_picture_context_t *dxva_cxt = NULL;
-    RK_S32 cand_lists[3];
-    RK_U32 i, j;
-
-    memset(ref, 0, sizeof(RefPicListTab_t));
-    dxva_cxt = (h265d_dxva2_picture_context_t*)dxva;
+    RK_U8 *rps[2][3] = {
+        { pp->RefPicSetStCurrBefore, pp->RefPicSetStCurrAfter, pp->RefPicSetLtCurr },
+        { pp->RefPicSetStCurrAfter, pp->RefPicSetStCurrBefore, pp->RefPicSetLtCurr },
+    };
+    RK_U32 nb_refs[3] = {0, 0, 0};
+    RK_U32 list, i, j, k;
+
+    for (i = 0; i < 8; i++) {
+        nb_refs[0] += pp->RefPicSetStCurrBefore[i] != 0xff;
+        nb_refs[1] += pp->RefPicSetStCurrAfter[i] != 0xff;
+        nb_refs[2] += pp->RefPicSetLtCurr[i] != 0xff;
+    }
 
-    for (i = 0; i < 8; i++ ) {
-        if (dxva_cxt->pp.RefPicSetStCurrBefore[i] != 0xff) {
-            bef_nb_refs ++;
-        }
+    cand->nb_refs = nb_refs[0] + nb_refs[1] + nb_refs[2];
+    if (!cand->nb_refs)
+        return;
 
-        if (dxva_cxt->pp.RefPicSetStCurrAfter[i] != 0xff) {
-            aft_nb_refs ++;
-        }
+    /* repeat the candidates up to MAX_REFS as the concatenation loop does */
+    for (list = 0; list < 2; list++) {
+        RK_U32 cnt[3] = { nb_refs[list], nb_refs[!list], nb_refs[2] };
 
-        if (dxva_cxt->pp.RefPicSetLtCurr[i] != 0xff) {
-            lt_cur_nb_refs ++;
+        k = 0;
+        while (k < MAX_REFS) {
+            for (i = 0; i < 3; i++)
+                for (j = 0; j < cnt[i] && k < MAX_REFS; j++)
+                    cand->dpb_index[list][k++] = rps[list][i][j];
         }
     }
+}
 
-    if (!(bef_nb_refs + aft_nb_refs +
-          lt_cur_nb_refs)) {
-        mpp_err( "Zero refs in the frame RPS.\n");
-        return  MPP_ERR_STREAM;
-    }
+static void hal_h265d_slice_rpl(H265dRplCand *cand, SliceHeader_t *sh, RefPicListTab_t *ref)
+{
+    RK_U8 nb_list = sh->slice_type == B_SLICE ? 2 : 1;
+    RK_U8 list_idx;
+    RK_U32 i;
+
+    memset(ref, 0, sizeof(RefPicListTab_t));
+
+    if (!cand->nb_refs)
+        return;
 
     for (list_idx = 0; list_idx < nb_list; list_idx++) {
-        RefPicList_t  rpl_tmp;
-        RefPicList_t *rpl     = &ref->refPicList[list_idx];
-        memset(&rpl_tmp, 0, sizeof(RefPicList_t));
-
-        /* The order of the elements is
-         * ST_CURR_BEF - ST_CURR_AFT - LT_CURR for the L0 and
-         * ST_CURR_AFT - ST_CURR_BEF - LT_CURR for the L1 */
-
-        cand_lists[0] = (list_idx != 0) ? ST_CURR_AFT : ST_CURR_BEF;
-        cand_lists[1] = (list_idx != 0) ? ST_CURR_BEF : ST_CURR_AFT;
-        cand_lists[2] = LT_CURR;
-        /* concatenate the candidate lists for the current frame */
-        while ((RK_U32)rpl_tmp.nb_refs < sh->nb_refs[list_idx]) {
-            for (i = 0; i < MPP_ARRAY_ELEMS(cand_lists); i++) {
-                RK_U8 *rps = NULL;
-                RK_U32 nb_refs = 0;
-                if (cand_lists[i] == ST_CURR_BEF) {
-                    rps = &dxva_cxt->pp.RefPicSetStCurrBefore[0];
-                    nb_refs = bef_nb_refs;
-                } else if (cand_lists[i] == ST_CURR_AFT) {
-                    rps = &dxva_cxt->pp.RefPicSetStCurrAfter[0];
-                    nb_refs = aft_nb_refs;
-                } else {
-                    rps = &dxva_cxt->pp.RefPicSetLtCurr[0];
-                    nb_refs = lt_cur_nb_refs;
-                }
-                for (j = 0; j < nb_refs && rpl_tmp.nb_refs < MAX_REFS; j++) {
-                    rpl_tmp.dpb_index[rpl_tmp.nb_refs]       = rps[j];
-                    rpl_tmp.nb_refs++;
-                }
-            }
-        }
+        RefPicList_t *rpl = &ref->refPicList[list_idx];
+        /* candidates are concatenated by whole rounds until nb_refs reached */
+        RK_U32 rounds = (sh->nb_refs[list_idx] + cand->nb_refs - 1) / cand->nb_refs;
+        RK_U32 nb_tmp = MPP_MIN(rounds * cand->nb_refs, MAX_REFS);
 
         /* reorder the references if necessary */
         if (sh->rpl_modification_flag[list_idx]) {
             for (i = 0; i < sh->nb_refs[list_idx]; i++) {
-                int idx = sh->list_entry_lx[list_idx][i];
-                rpl->dpb_index[i]        = rpl_tmp.dpb_index[idx];
+                RK_U32 idx = sh->list_entry_lx[list_idx][i];
+
+                rpl->dpb_index[i] = (idx < nb_tmp) ? cand->dpb_index[list_idx][idx] : 0;
                 rpl->nb_refs++;
             }
         } else {
-            memcpy(rpl, &rpl_tmp, sizeof(*rpl));
-            rpl->nb_refs = MPP_MIN((RK_U32)rpl->nb_refs, sh->nb_refs[list_idx]);
+            rpl->nb_refs = MPP_MIN(nb_tmp, sh->nb_refs[list_idx]);
+            for (i = 0; i < rpl->nb_refs; i++)
+                rpl->dpb_index[i] = cand->dpb_index[list_idx][i];
+        }
+    }
+}
+
+static void hal_h265d_rpl_key(SliceHeader_t *sh, H265dRplKey *key)
+{
+    RK_U32 i;
+
+    memset(key, 0, sizeof(*key));
+    key->slice_type = sh->slice_type;
+    for (i = 0; i < 2; i++) {
+        key->nb_refs[i] = sh->nb_refs[i];
+        key->rpl_modification_flag[i] = sh->rpl_modification_flag[i];
+        if (sh->rpl_modification_flag[i])
+            memcpy(key->list_entry_lx[i], sh->list_entry_lx[i],
+                   sh->nb_refs[i] * sizeof(sh->list_entry_lx[i][0]));
+    }
+}
+
+static void hal_h265d_slice_rps_build(DXVA_PicParams_HEVC *pp, H265dRplCand *cand,
+                                      SliceHeader_t *sh, H265dSliceRps *out)
+{
+    RK_U32 nb_list = I_SLICE - sh->slice_type;
+    RefPicListTab_t ref;
+    RK_U32 i, j;
+
+    hal_h265d_slice_rpl(cand, sh, &ref);
+    out->lowdelay_flag = 1;
+
+    for (j = 0; j < nb_list; j++) {
+        for (i = 0; i < ref.refPicList[j].nb_refs && i < 15; i++) {
+            RK_U8 index = ref.refPicList[j].dpb_index[i];
+
+            if (index != 0xff) {
+                out->entry[j][i] = (pp->RefPicList[index].AssociatedFlag & 1) |
+                                   ((index & 0xf) << 1);
+                if (pp->PicOrderCntValList[index] > pp->CurrPicOrderCntVal)
+                    out->lowdelay_flag = 0;
+            }
         }
     }
-    return 0;
+}
+
+/* one slice takes 256 bit, see the hardware rps layout in the comment below */
+static void hal_h265d_slice_rps_pack(H265dSliceRps *rps, RK_U64 *w)
+{
+    RK_U64 e;
+    RK_U32 i;
+
+    /*
+     * bit   0 -  94 : L0 entry 0 - 14, L1 entry 0 - 3, 5 bit each
+     * bit  95       : L1 entry 4 is_long_term
+     * bit 128 - 131 : L1 entry 4 dpb_index
+     * bit 132 - 181 : L1 entry 5 - 14
+     * bit 182 - 205 : lowdelay 1, bit_offset 10, bit_offset_st 9, nb_rps_poc 4
+     */
+    w[0] = w[1] = w[2] = w[3] = 0;
+
+    for (i = 0; i < 12; i++)
+        w[0] |= (RK_U64)rps->entry[0][i] << (i * 5);
+
+    /* L0 entry 12 straddles the first two words */
+    e = rps->entry[0][12];
+    w[0] |= e << 60;
+    w[1] = e >> 4;
+    w[1] |= (RK_U64)rps->entry[0][13] << 1;
+    w[1] |= (RK_U64)rps->entry[0][14] << 6;
+    for (i = 0; i < 4; i++)
+        w[1] |= (RK_U64)rps->entry[1][i] << (11 + i * 5);
+
+    e = rps->entry[1][4];
+    w[1] |= (e & 1) << 31;
+    w[2] = e >> 1;
+    for (i = 5; i < 15; i++)
+        w[2] |= (RK_U64)rps->entry[1][i] << (4 + (i - 5) * 5);
+
+    w[2] |= (RK_U64)(rps->lowdelay_flag & 1) << 54;
+    w[2] |= (RK_U64)rps->rps_bit_offset << 55;
+    /* rps_bit_offset has 10 bit in hardware, the top bit is always zero */
+    w[3] = (RK_U64)(rps->rps_bit_offset_st & 0x1ff) << 1;
+    w[3] |= (RK_U64)(rps->nb_rps_poc & 0xf) << 10;
 }
 
 RK_S32 hal_h265d_slice_hw_rps(void *dxva, void *rps_buf, void* sw_rps_buf, RK_U32 fast_mode)
@@ -365,25 +456,23 @@ RK_S32 hal_h265d_slice_output_rps(void *dxva, void *rps_buf)
     RK_S32 slice_idx = 0;
     BitReadCtx_t gb_cxt, *gb;
     SliceHeader_t sh;
-    RK_U8 rps_bit_offset[600];
-    RK_U8 rps_bit_offset_st[600];
-    RK_U8 slice_nb_rps_poc[600];
-    RK_U8 lowdelay_flag[600];
-    slice_ref_map_t rps_pic_info[600][2][15];
+    H265dSliceRps slice_rps[MAX_SLICES];
+    RK_U64 rps_packet[MAX_SLICES][4];
+    H265dRplCand cand;
+    H265dRplKey key[2];
+    RK_S32 last_rpl = -1;
+    RK_U32 key_idx = 0;
     RK_U32 nb_refs = 0;
     RK_S32 bit_begin;
     h265d_dxva2_picture_context_t *dxva_cxt = NULL;
-    RK_U32 i, j, k;
-
-    memset(&rps_pic_info,   0, sizeof(rps_pic_info));
-    memset(&slice_nb_rps_poc, 0, sizeof(slice_nb_rps_poc));
-    memset(&rps_bit_offset, 0, sizeof(rps_bit_offset));
-    memset(&rps_bit_offset_st, 0, sizeof(rps_bit_offset_st));
-    memset(&lowdelay_flag, 0, sizeof(lowdelay_flag));
+    RK_U32 i, k;
 
     dxva_cxt = (h265d_dxva2_picture_context_t*)dxva;
+
+    hal_h265d_rpl_cand(&dxva_cxt->pp, &cand);
+    memset(&slice_rps[0], 0, sizeof(slice_rps[0]));
+
     for (k = 0; k < dxva_cxt->slice_count; k++) {
-        RefPicListTab_t ref;
         memset(&sh, 0, sizeof(SliceHeader_t));
         // mpp_err("data[%d]= 0x%x,size[%d] = %d \n",
         //   k,dxva_cxt->slice_short[k].BSNALunitDataLocation, k,dxva_cxt->slice_short[k].SliceBytesInBuffer);
@@ -448,10 +537,17 @@ RK_S32 hal_h265d_slice_output_rps(void *dxva, void *rps_buf)
             if (!sh.dependent_slice_segment_flag) {
                 sh.slice_addr = sh.slice_segment_addr;
                 slice_idx++;
+                if (slice_idx >= MAX_SLICES) {
+                    mpp_err("too many slices %d\n", slice_idx);
+                    return MPP_ERR_STREAM;
+                }
+                memset(&slice_rps[slice_idx], 0, sizeof(slice_rps[slice_idx]));
             }
         } else {
             sh.slice_segment_addr = sh.slice_addr = 0;
             slice_idx           = 0;
+            last_rpl            = -1;
+            memset(&slice_rps[0], 0, sizeof(slice_rps[0]));
         }
 
         if (!sh.dependent_slice_segment_flag) {
@@ -500,8 +596,8 @@ RK_S32 hal_h265d_slice_output_rps(void *dxva, void *rps_buf)
                         READ_BITS(gb, numbits, &rps_idx);
                 }
 
-                rps_bit_offset_st[slice_idx] = gb->used_bits - bit_begin;
-                rps_bit_offset[slice_idx] = rps_bit_offset_st[slice_idx];
+                slice_rps[slice_idx].rps_bit_offset_st = gb->used_bits - bit_begin;
+                slice_rps[slice_idx].rps_bit_offset = slice_rps[slice_idx].rps_bit_offset_st;
                 if (dxva_cxt->pp.long_term_ref_pics_present_flag) {
 
 //                    RK_S32 max_poc_lsb    = 1 << (dxva_cxt->pp.log2_max_pic_order_cnt_lsb_minus4 + 4);
@@ -534,7 +630,7 @@ RK_S32 hal_h265d_slice_output_rps(void *dxva, void *rps_buf)
                             READ_UE(gb, &delta);
                         }
                     }
-                    rps_bit_offset[slice_idx] += (gb->used_bits - bit_begin);
+                    slice_rps[slice_idx].rps_bit_offset += (gb->used_bits - bit_begin);
 
                 }
 
@@ -614,67 +710,42 @@ RK_S32 hal_h265d_slice_output_rps(void *dxva, void *rps_buf)
 
         if (!sh.dependent_slice_segment_flag &&
             sh.slice_type != I_SLICE) {
-            RK_U32 nb_list = I_SLICE - sh.slice_type;
-
-            hal_h265d_slice_rpl(dxva, &sh, &ref);
-            lowdelay_flag[slice_idx]  =  1;
-
-            for (j = 0; j < nb_list; j++) {
-                for (i = 0; i < ref.refPicList[j].nb_refs; i++) {
-                    RK_U8 index = 0;
-                    index = ref.refPicList[j].dpb_index[i];
-                    // mpp_err("slice_idx = %d index = %d,j = %d i = %d",slice_idx,index,j,i);
-                    if (index != 0xff) {
-                        rps_pic_info[slice_idx][j][i].dpb_index = index;
-                        rps_pic_info[slice_idx][j][i].is_long_term
-                            = dxva_cxt->pp.RefPicList[index].AssociatedFlag;
-                        if (dxva_cxt->pp.PicOrderCntValList[index] > dxva_cxt->pp.CurrPicOrderCntVal)
-                            lowdelay_flag[slice_idx] = 0;
-                    }
-                }
-            }
+            H265dSliceRps *cur = &slice_rps[slice_idx];
+            H265dRplKey *cur_key = &key[key_idx];
 
-            if (sh.slice_type == I_SLICE)
-                slice_nb_rps_poc[slice_idx] = 0;
-            else
-                slice_nb_rps_poc[slice_idx] = nb_refs;
+            if (!cand.nb_refs)
+                mpp_err("Zero refs in the frame RPS.\n");
 
+            /* broadcast streams repeat the same ref lists on all slices */
+            hal_h265d_rpl_key(&sh, cur_key);
+            if (last_rpl >= 0 && !memcmp(cur_key, &key[!key_idx], sizeof(*cur_key))) {
+                memcpy(cur->entry, slice_rps[last_rpl].entry, sizeof(cur->entry));
+                cur->lowdelay_flag = slice_rps[last_rpl].lowdelay_flag;
+            } else {
+                hal_h265d_slice_rps_build(&dxva_cxt->pp, &cand, &sh, cur);
+                key_idx = !key_idx;
+            }
+            last_rpl = slice_idx;
+            cur->nb_rps_poc = nb_refs;
         }
     }
-//out put for rk format
-    {
-        RK_S32  nb_slice = slice_idx + 1;
-        RK_S32  fifo_len   = nb_slice * 4 + 1;//size of rps_packet alloc more 1 64 bit invoid buffer no enought
-        RK_U64 *rps_packet = mpp_malloc(RK_U64, fifo_len);
-        BitputCtx_t bp;
-        mpp_set_bitput_ctx(&bp, rps_packet, fifo_len);
-        for (k = 0; k < (RK_U32)nb_slice; k++) {
-            for (j = 0; j < 2; j++) {
-                for (i = 0; i < 15; i++) {
-                    mpp_put_bits(&bp, rps_pic_info[k][j][i].is_long_term, 1);
-                    if (j == 1 && i == 4) {
-                        mpp_put_align (&bp, 64, 0);
-                    }
-                    mpp_put_bits(&bp, rps_pic_info[k][j][i].dpb_index,    4);
-                }
-            }
-            mpp_put_bits(&bp, lowdelay_flag      [k], 1);
-            h265h_dbg(H265H_DBG_RPS, "lowdelay_flag = %d \n", lowdelay_flag[k]);
-            mpp_put_bits(&bp, rps_bit_offset     [k], 10);
 
-            h265h_dbg(H265H_DBG_RPS, "rps_bit_offset = %d \n", rps_bit_offset[k]);
-            mpp_put_bits(&bp, rps_bit_offset_st  [k], 9);
+    /* output for rk format, reuse the packet of the same slice rps */
+    {
+        RK_S32 nb_slice = slice_idx + 1;
 
-            h265h_dbg(H265H_DBG_RPS, "rps_bit_offset_st = %d \n", rps_bit_offset_st[k]);
-            mpp_put_bits(&bp, slice_nb_rps_poc   [k], 4);
+        for (k = 0; k < (RK_U32)nb_slice; k++) {
+            if (k && !memcmp(&slice_rps[k], &slice_rps[k - 1], sizeof(slice_rps[k])))
+                memcpy(rps_packet[k], rps_packet[k - 1], sizeof(rps_packet[k]));
+            else
+                hal_h265d_slice_rps_pack(&slice_rps[k], rps_packet[k]);
 
-            h265h_dbg(H265H_DBG_RPS, "slice_nb_rps_poc = %d \n", slice_nb_rps_poc[k]);
-            mpp_put_align   (&bp, 64, 0);
+            h265h_dbg(H265H_DBG_RPS, "slice %d lowdelay %d offset %d st %d nb_rps_poc %d\n",
+                      k, slice_rps[k].lowdelay_flag, slice_rps[k].rps_bit_offset,
+                      slice_rps[k].rps_bit_offset_st, slice_rps[k].nb_rps_poc);
         }
-        if (rps_buf != NULL) {
+        if (rps_buf != NULL)
             memcpy(rps_buf, rps_packet, nb_slice * 32);
-        }
-        mpp_free(rps_packet);
     }
 
     return 0;
@@ -713,6 +784,7 @@ void hal_h265d_output_scalinglist_packet(void *hal, void *ptr, void *dxva)
                 sl.sl_dc[1][i] =  dxva_cxt->qm.ucScalingListDCCoefSizeID3[i];
         }
         hal_record_scaling_list((scalingFactor_t *)reg_ctx->scaling_rk, &sl);
+        memcpy(reg_ctx->scaling_qm, &dxva_cxt->qm, sizeof(DXVA_Qmatrix_HEVC));
     }
     memcpy(ptr, reg_ctx->scaling_rk, sizeof(scalingFactor_t));
 }
@@ -2666,6 +2738,7 @@ MPP_RET hal_h265d_vdpu38x_scalinglist_packet(void *hal, void *ptr, void *dxva)
                 sl.sl_dc[1][i] =  dxva_ctx->qm.ucScalingListDCCoefSizeID2[i];
         }
         hal_vdpu38x_record_scaling_list((scalingFactor_t *)reg_ctx->scaling_rk, &sl);
+        memcpy(reg_ctx->scaling_qm, &dxva_ctx->qm, sizeof(DXVA_Qmatrix_HEVC));
     }
 
     memcpy(ptr, reg_ctx->scaling_rk, sizeof(scalingFactor_t));
@@ -2673,6 +2746,36 @@ MPP_RET hal_h265d_vdpu38x_scalinglist_packet(void *hal, void *ptr, void *dxva)
     return MPP_OK;
 }
 
+/*
+ * The sps / pps head of the packet only depends on the parameter sets. It is
+ * kept per pps id so that switching between pps does not repack the head.
+ * The parser bumps ps_gen on any vps / sps / pps change which drops all the
+ * cached heads at once.
+ */
+static RK_U32 hal_h265d_vdpu38x_ps_cache_hit(HalH265dCtx *reg_ctx, DXVA_PicParams_HEVC *pp)
+{
+    RK_U32 id = pp->pps_id;
+
+    if (id >= H265D_PS_CACHE_CNT || !pp->ps_gen || reg_ctx->ps_cache_gen[id] != pp->ps_gen)
+        return 0;
+
+    memcpy(reg_ctx->pps_buf, reg_ctx->ps_cache[id], sizeof(reg_ctx->ps_cache[id]));
+    h265h_dbg(H265H_DBG_PPS, "pps %d head hit gen %d\n", id, pp->ps_gen);
+
+    return 1;
+}
+
+static void hal_h265d_vdpu38x_ps_cache_store(HalH265dCtx *reg_ctx, DXVA_PicParams_HEVC *pp)
+{
+    RK_U32 id = pp->pps_id;
+
+    if (id >= H265D_PS_CACHE_CNT)
+        return;
+
+    memcpy(reg_ctx->ps_cache[id], reg_ctx->pps_buf, sizeof(reg_ctx->ps_cache[id]));
+    reg_ctx->ps_cache_gen[id] = pp->ps_gen;
+}
+
 RK_S32 hal_h265d_vdpu38x_output_pps_packet(void *hal, void *dxva, RK_U32 *scanlist_addr)
 {
     HalH265dCtx *reg_ctx = ( HalH265dCtx *)hal;
@@ -2705,7 +2808,7 @@ RK_S32 hal_h265d_vdpu38x_output_pps_packet(void *hal, void *dxva, RK_U32 *scanli
 
         mpp_set_bitput_ctx(&bp, pps_packet, reg_ctx->pps_buf_sz / 8);
 
-        if (dxva_ctx->pp.ps_update_flag) {
+        if (dxva_ctx->pp.ps_update_flag && !hal_h265d_vdpu38x_ps_cache_hit(reg_ctx, &dxva_ctx->pp)) {
             mpp_put_bits(&bp, dxva_ctx->pp.vps_id, 4);
             mpp_put_bits(&bp, dxva_ctx->pp.sps_id, 4);
             mpp_put_bits(&bp, dxva_ctx->pp.chroma_format_idc, 2);
@@ -2813,9 +2916,11 @@ RK_S32 hal_h265d_vdpu38x_output_pps_packet(void *hal, void *dxva, RK_U32 *scanli
             mpp_put_bits(&bp, 0, 6);
             mpp_put_bits(&bp, 0, 1);
             mpp_put_bits(&bp, 0, 1);
+
+            hal_h265d_vdpu38x_ps_cache_store(reg_ctx, &dxva_ctx->pp);
         } else {
-            bp.index = 4;
-            bp.bitpos = 41;
+            bp.index = H265D_PS_HEAD_INDEX;
+            bp.bitpos = H265D_PS_HEAD_BITS;
             bp.bvalue = bp.pbuf[bp.index] & MPP_GENMASK(bp.bitpos - 1, 0);
         }
         /* poc info */
@@ -23,6 +23,7 @@
 #include "rk_type.h"
 #include "h265d_syntax.h"
 #include "vdpu38x_com.h"
+#include "hal_tbls.h"
 
 #define SCALING_LIST_SIZE       (81 * 1360)
 #define RPS_SIZE                (600 * 32)
@@ -143,6 +144,9 @@ extern RK_U8 hal_hevc_diag_scan4x4_x[16];
 extern RK_U8 hal_hevc_diag_scan4x4_y[16];
 extern RK_U8 hal_hevc_diag_scan8x8_x[64];
 extern RK_U8 hal_hevc_diag_scan8x8_y[64];
+/* hal_tbls id of shared h265 tables */
+#define HAL_H265D_TBL_CABAC         0
+
 extern RK_U8 cabac_table[27456];
 
 #ifdef __cplusplus
@@ -15,6 +15,12 @@
 /* before vdpu383 10 buf */
 #define H265D_RCB_BUF_COUNT 11
 
+/* vdpu38x packed sps / pps head is 297 bits, cached per pps id */
+#define H265D_PS_CACHE_CNT  64
+#define H265D_PS_CACHE_LEN  5
+#define H265D_PS_HEAD_INDEX 4
+#define H265D_PS_HEAD_BITS  41
+
 typedef struct H265dRegBuf_t {
     RK_S32    use_flag;
     MppBuffer scaling_list_data;
@@ -36,6 +42,7 @@ typedef struct HalH265dCtx_t {
 
     MppHalCfg       *cfg;
 
+    /* process-wide shared read-only cabac table from hal_tbls */
     MppBuffer       cabac_table_data;
     MppBuffer       scaling_list_data;
     MppBuffer       pps_data;
@@ -72,7 +79,6 @@ typedef struct HalH265dCtx_t {
     /* for vdpu34x */
     MppBuffer       bufs;
     RK_S32          bufs_fd;
-    RK_U32          offset_cabac;
     RK_U32          offset_spspps[VDPU_FAST_REG_SET_CNT];
     RK_U32          offset_rps[VDPU_FAST_REG_SET_CNT];
     RK_U32          offset_sclst[VDPU_FAST_REG_SET_CNT];
@@ -85,6 +91,9 @@ typedef struct HalH265dCtx_t {
     HalBufs         origin_bufs;
     MppBuffer       missing_ref_buf;
     RK_U32          missing_ref_buf_size;
+    /* packed sps / pps head per pps id, valid when ps_gen matches */
+    RK_U32          ps_cache_gen[H265D_PS_CACHE_CNT];
+    RK_U64          ps_cache[H265D_PS_CACHE_CNT][H265D_PS_CACHE_LEN];
 } HalH265dCtx;
 
 typedef struct ScalingList_t {
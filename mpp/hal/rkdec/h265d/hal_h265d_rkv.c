@@ -199,19 +199,13 @@ MPP_RET hal_h265d_rkv_init(void *hal, MppHalCfg *cfg)
         return MPP_ERR_MALLOC;
     }
 
-    ret = mpp_buffer_get(cfg->buf_group, &reg_ctx->cabac_table_data, sizeof(cabac_table));
+    ret = hal_tbl_get(&reg_ctx->cabac_table_data, cfg->dev, MPP_VIDEO_CodingHEVC,
+                      HAL_H265D_TBL_CABAC, cabac_table, sizeof(cabac_table), NULL);
     if (ret) {
         mpp_err("h265d cabac_table get buffer failed\n");
         return ret;
     }
 
-    ret = mpp_buffer_write(reg_ctx->cabac_table_data, 0, (void*)cabac_table, sizeof(cabac_table));
-    if (ret) {
-        mpp_err("h265d write cabac_table data failed\n");
-        return ret;
-    }
-    mpp_buffer_sync_end(reg_ctx->cabac_table_data);
-
     ret = hal_h265d_alloc_res(hal);
     if (ret) {
         mpp_err("hal_h265d_alloc_res failed\n");
@@ -229,7 +223,7 @@ MPP_RET hal_h265d_rkv_deinit(void *hal)
     RK_S32 ret = 0;
     HalH265dCtx *reg_ctx = (HalH265dCtx *)hal;
 
-    ret = mpp_buffer_put(reg_ctx->cabac_table_data);
+    ret = hal_tbl_put(reg_ctx->cabac_table_data, reg_ctx->cfg->dev);
     if (ret) {
         mpp_err("h265d cabac_table free buffer failed\n");
         return ret;
@@ -83,15 +83,13 @@ static const FilterdColBufRatio filterd_fbc_off[CTU][FMT] = {
     {{0, 0}, {15, 16}, {20, 16}, {20, 16}}  //ctu 64
 };
 
-#define CABAC_TAB_ALIGEND_SIZE          (MPP_ALIGN(27456, SZ_4K))
 #define SPSPPS_ALIGNED_SIZE             (MPP_ALIGN(112 * 64, SZ_4K))
 #define RPS_ALIGEND_SIZE                (MPP_ALIGN(400 * 8, SZ_4K))
 #define SCALIST_ALIGNED_SIZE            (MPP_ALIGN(81 * 1360, SZ_4K))
 #define INFO_BUFFER_SIZE                (SPSPPS_ALIGNED_SIZE + RPS_ALIGEND_SIZE + SCALIST_ALIGNED_SIZE)
-#define ALL_BUFFER_SIZE(cnt)            (CABAC_TAB_ALIGEND_SIZE + INFO_BUFFER_SIZE *cnt)
+#define ALL_BUFFER_SIZE(cnt)            (INFO_BUFFER_SIZE *cnt)
 
-#define CABAC_TAB_OFFSET                (0)
-#define SPSPPS_OFFSET(pos)              (CABAC_TAB_OFFSET + CABAC_TAB_ALIGEND_SIZE + (INFO_BUFFER_SIZE * pos))
+#define SPSPPS_OFFSET(pos)              (INFO_BUFFER_SIZE * pos)
 #define RPS_OFFSET(pos)                 (SPSPPS_OFFSET(pos) + SPSPPS_ALIGNED_SIZE)
 #define SCALIST_OFFSET(pos)             (RPS_OFFSET(pos) + RPS_ALIGEND_SIZE)
 
@@ -136,7 +134,6 @@ static MPP_RET hal_h265d_vdpu382_init(void *hal, MppHalCfg *cfg)
         }
 
         reg_ctx->bufs_fd = mpp_buffer_get_fd(reg_ctx->bufs);
-        reg_ctx->offset_cabac = CABAC_TAB_OFFSET;
         for (i = 0; i < max_cnt; i++) {
             reg_ctx->g_buf[i].hw_regs = mpp_calloc_size(void, sizeof(Vdpu382H265dRegSet));
             reg_ctx->offset_spspps[i] = SPSPPS_OFFSET(i);
@@ -152,9 +149,11 @@ static MPP_RET hal_h265d_vdpu382_init(void *hal, MppHalCfg *cfg)
         reg_ctx->sclst_offset = reg_ctx->offset_sclst[0];
     }
 
-    ret = mpp_buffer_write(reg_ctx->bufs, 0, (void*)cabac_table, sizeof(cabac_table));
+    /* shared read-only cabac table */
+    ret = hal_tbl_get(&reg_ctx->cabac_table_data, cfg->dev, MPP_VIDEO_CodingHEVC,
+                      HAL_H265D_TBL_CABAC, cabac_table, sizeof(cabac_table), NULL);
     if (ret) {
-        mpp_err("h265d write cabac_table data failed\n");
+        mpp_err("h265d cabac_table get buffer failed\n");
         return ret;
     }
 
@@ -180,6 +179,9 @@ static MPP_RET hal_h265d_vdpu382_deinit(void *hal)
         reg_ctx->bufs = NULL;
     }
 
+    hal_tbl_put(reg_ctx->cabac_table_data, reg_ctx->cfg->dev);
+    reg_ctx->cabac_table_data = NULL;
+
     loop = (reg_ctx->fast_mode != 0) ? MPP_ARRAY_ELEMS(reg_ctx->rcb_buf) : 1;
     for (i = 0; i < loop; i++) {
         if (reg_ctx->rcb_buf[i]) {
@@ -782,7 +784,7 @@ static MPP_RET hal_h265d_vdpu382_gen_regs(void *hal,  HalTaskInfo *syn)
 #endif
 
     /* cabac table */
-    hw_regs->h265d_addr.reg197_cabactbl_base    = reg_ctx->bufs_fd;
+    hw_regs->h265d_addr.reg197_cabactbl_base    = mpp_buffer_get_fd(reg_ctx->cabac_table_data);
     /* pps */
     hw_regs->h265d_addr.reg161_pps_base         = reg_ctx->bufs_fd;
     hw_regs->h265d_addr.reg163_rps_base         = reg_ctx->bufs_fd;
@@ -0,0 +1,822 @@
+/* SPDX-License-Identifier: Apache-2.0 OR MIT */
+/*
+ * Copyright (c) 2026 Rockchip Electronics Co., Ltd.
+ */
+
+#define MODULE_TAG "hal_h265d_rps_test"
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "mpp_log.h"
+#include "mpp_mem.h"
+#include "mpp_time.h"
+#include "mpp_common.h"
+#include "mpp_bitread.h"
+#include "mpp_bitput.h"
+
+#include "hal_h265d_ctx.h"
+#include "hal_h265d_com.h"
+
+/*
+ * Per slice rps / ref list packing test
+ *
+ * usage: hal_h265d_rps_test [slice count] [loop count] [random pictures]
+ *
+ * The rps packet of hal_h265d_slice_output_rps is compared word by word
+ * with a reference packer which keeps the original per slice ref list
+ * builder and mpp_put_bits layout. The cases cover I / P / B slice mixes,
+ * ref count override, list modification, dependent slices, long-term refs
+ * and randomized pictures. Then a 4K picture with the slice headers of a
+ * broadcast encoder, where all slices share the same ref lists, is timed.
+ */
+#define RPS_TEST_SLICE_SIZE     64
+#define RPS_TEST_HDR_SIZE       48
+#define RPS_TEST_WIDTH          3840
+#define RPS_TEST_HEIGHT         2160
+#define RPS_TEST_DPB_SIZE       6
+
+typedef struct RpsTestBits_t {
+    RK_U8   *buf;
+    RK_U32  pos;
+} RpsTestBits;
+
+typedef struct RpsTestSlice_t {
+    RK_U32  dependent;
+    RK_U32  type;
+    RK_U32  st_sps_flag;
+    /* long-term refs in slice header */
+    RK_U32  nb_lt;
+    RK_U32  override;
+    RK_U32  nb_refs[2];
+    RK_U32  modify[2];
+    RK_U32  entry[2][MAX_REFS];
+} RpsTestSlice;
+
+static void put_bits(RpsTestBits *bits, RK_U32 val, RK_U32 len)
+{
+    while (len--) {
+        if ((val >> len) & 1)
+            bits->buf[bits->pos >> 3] |= 0x80 >> (bits->pos & 7);
+        bits->pos++;
+    }
+}
+
+static void put_ue(RpsTestBits *bits, RK_U32 val)
+{
+    RK_U32 len = 0;
+    RK_U32 tmp = val + 1;
+
+    while (tmp >> (len + 1))
+        len++;
+
+    put_bits(bits, 0, len);
+    put_bits(bits, val + 1, len + 1);
+}
+
+static RK_U32 rand_val(RK_U32 max)
+{
+    return (RK_U32)rand() % (max + 1);
+}
+
+/* original ref list builder of each slice */
+static void ref_slice_rpl(DXVA_PicParams_HEVC *pp, SliceHeader_t *sh, RefPicListTab_t *ref)
+{
+    RK_U8 nb_list = sh->slice_type == B_SLICE ? 2 : 1;
+    RK_U8 bef_nb_refs = 0, aft_nb_refs = 0, lt_cur_nb_refs = 0;
+    RK_S32 cand_lists[3];
+    RK_U8 list_idx;
+    RK_U32 i, j;
+
+    memset(ref, 0, sizeof(RefPicListTab_t));
+
+    for (i = 0; i < 8; i++) {
+        if (pp->RefPicSetStCurrBefore[i] != 0xff)
+            bef_nb_refs++;
+        if (pp->RefPicSetStCurrAfter[i] != 0xff)
+            aft_nb_refs++;
+        if (pp->RefPicSetLtCurr[i] != 0xff)
+            lt_cur_nb_refs++;
+    }
+
+    if (!(bef_nb_refs + aft_nb_refs + lt_cur_nb_refs))
+        return;
+
+    for (list_idx = 0; list_idx < nb_list; list_idx++) {
+        RefPicList_t rpl_tmp;
+        RefPicList_t *rpl = &ref->refPicList[list_idx];
+
+        memset(&rpl_tmp, 0, sizeof(RefPicList_t));
+
+        cand_lists[0] = (list_idx != 0) ? ST_CURR_AFT : ST_CURR_BEF;
+        cand_lists[1] = (list_idx != 0) ? ST_CURR_BEF : ST_CURR_AFT;
+        cand_lists[2] = LT_CURR;
+
+        while ((RK_U32)rpl_tmp.nb_refs < sh->nb_refs[list_idx]) {
+            for (i = 0; i < MPP_ARRAY_ELEMS(cand_lists); i++) {
+                RK_U8 *rps = NULL;
+                RK_U32 nb_refs = 0;
+
+                if (cand_lists[i] == ST_CURR_BEF) {
+                    rps = &pp->RefPicSetStCurrBefore[0];
+                    nb_refs = bef_nb_refs;
+                } else if (cand_lists[i] == ST_CURR_AFT) {
+                    rps = &pp->RefPicSetStCurrAfter[0];
+                    nb_refs = aft_nb_refs;
+                } else {
+                    rps = &pp->RefPicSetLtCurr[0];
+                    nb_refs = lt_cur_nb_refs;
+                }
+                for (j = 0; j < nb_refs && rpl_tmp.nb_refs < MAX_REFS; j++) {
+                    rpl_tmp.dpb_index[rpl_tmp.nb_refs] = rps[j];
+                    rpl_tmp.nb_refs++;
+                }
+            }
+        }
+
+        if (sh->rpl_modification_flag[list_idx]) {
+            for (i = 0; i < sh->nb_refs[list_idx]; i++) {
+                rpl->dpb_index[i] = rpl_tmp.dpb_index[sh->list_entry_lx[list_idx][i]];
+                rpl->nb_refs++;
+            }
+        } else {
+            memcpy(rpl, &rpl_tmp, sizeof(*rpl));
+            rpl->nb_refs = MPP_MIN((RK_U32)rpl->nb_refs, sh->nb_refs[list_idx]);
+        }
+    }
+}
+
+/* original slice header parser and mpp_put_bits packer, returns word count */
+static RK_S32 ref_output_rps(h265d_dxva2_picture_context_t *dxva, RK_U64 *rps_buf)
+{
+    static RK_U8 rps_bit_offset[MAX_SLICES];
+    static RK_U8 rps_bit_offset_st[MAX_SLICES];
+    static RK_U8 slice_nb_rps_poc[MAX_SLICES];
+    static RK_U8 lowdelay_flag[MAX_SLICES];
+    static slice_ref_map_t rps_pic_info[MAX_SLICES][2][15];
+    DXVA_PicParams_HEVC *pp = &dxva->pp;
+    BitReadCtx_t gb_cxt, *gb = &gb_cxt;
+    SliceHeader_t sh;
+    RK_S32 slice_idx = 0;
+    RK_U32 nb_refs = 0;
+    RK_S32 bit_begin;
+    RK_S32 value;
+    RK_U32 nal_type;
+    RK_U32 i, j, k;
+
+    memset(rps_pic_info, 0, sizeof(rps_pic_info));
+    memset(slice_nb_rps_poc, 0, sizeof(slice_nb_rps_poc));
+    memset(rps_bit_offset, 0, sizeof(rps_bit_offset));
+    memset(rps_bit_offset_st, 0, sizeof(rps_bit_offset_st));
+    memset(lowdelay_flag, 0, sizeof(lowdelay_flag));
+
+    for (k = 0; k < dxva->slice_count; k++) {
+        RefPicListTab_t ref;
+
+        memset(&sh, 0, sizeof(SliceHeader_t));
+        mpp_set_bitread_ctx(gb, (RK_U8 *)dxva->bitstream + dxva->slice_short[k].BSNALunitDataLocation,
+                            dxva->slice_short[k].SliceBytesInBuffer);
+        mpp_set_bitread_pseudo_code_type(gb, PSEUDO_CODE_H264_H265);
+
+        READ_ONEBIT(gb, &value);
+        if (value)
+            return -1;
+
+        READ_BITS(gb, 6, &nal_type);
+        if (nal_type > 23)
+            continue;
+
+        SKIP_BITS(gb, 9);
+        READ_ONEBIT(gb, &sh.first_slice_in_pic_flag);
+        if (nal_type >= 16 && nal_type <= 23)
+            READ_ONEBIT(gb, &sh.no_output_of_prior_pics_flag);
+        READ_UE(gb, &sh.pps_id);
+
+        if (!sh.first_slice_in_pic_flag) {
+            RK_S32 log2_min_cb_size = pp->log2_min_luma_coding_block_size_minus3 + 3;
+            RK_S32 log2_ctb_size = log2_min_cb_size + pp->log2_diff_max_min_luma_coding_block_size;
+            RK_S32 width = pp->PicWidthInMinCbsY << log2_min_cb_size;
+            RK_S32 height = pp->PicHeightInMinCbsY << log2_min_cb_size;
+            RK_S32 ctb_width = (width + (1 << log2_ctb_size) - 1) >> log2_ctb_size;
+            RK_S32 ctb_height = (height + (1 << log2_ctb_size) - 1) >> log2_ctb_size;
+
+            if (pp->dependent_slice_segments_enabled_flag)
+                READ_ONEBIT(gb, &sh.dependent_slice_segment_flag);
+
+            READ_BITS(gb, mpp_ceil_log2(ctb_width * ctb_height), &sh.slice_segment_addr);
+
+            if (!sh.dependent_slice_segment_flag)
+                slice_idx++;
+        } else {
+            slice_idx = 0;
+        }
+
+        if (!sh.dependent_slice_segment_flag) {
+            for (i = 0; i < pp->num_extra_slice_header_bits; i++)
+                SKIP_BITS(gb, 1);
+
+            READ_UE(gb, &sh.slice_type);
+
+            if (pp->output_flag_present_flag)
+                READ_ONEBIT(gb, &sh.pic_output_flag);
+
+            if (!IS_IDR(nal_type)) {
+                RK_S32 st_sps_flag;
+
+                READ_BITS(gb, pp->log2_max_pic_order_cnt_lsb_minus4 + 4, &sh.pic_order_cnt_lsb);
+                READ_ONEBIT(gb, &st_sps_flag);
+
+                bit_begin = gb->used_bits;
+                if (!st_sps_flag) {
+                    SKIP_BITS(gb, pp->wNumBitsForShortTermRPSInSlice);
+                } else {
+                    RK_S32 numbits = mpp_ceil_log2(pp->num_short_term_ref_pic_sets);
+                    RK_S32 rps_idx = 0;
+
+                    if (numbits > 0)
+                        READ_BITS(gb, numbits, &rps_idx);
+                }
+
+                rps_bit_offset_st[slice_idx] = gb->used_bits - bit_begin;
+                rps_bit_offset[slice_idx] = rps_bit_offset_st[slice_idx];
+
+                if (pp->long_term_ref_pics_present_flag) {
+                    RK_U32 nb_sps = 0, nb_sh;
+
+                    bit_begin = gb->used_bits;
+                    if (pp->num_long_term_ref_pics_sps > 0)
+                        READ_UE(gb, &nb_sps);
+                    READ_UE(gb, &nb_sh);
+
+                    nb_refs = nb_sh + nb_sps;
+                    for (i = 0; i < nb_refs; i++) {
+                        RK_U8 delta_poc_msb_present;
+
+                        if (i < nb_sps) {
+                            RK_U8 lt_idx_sps = 0;
+
+                            if (pp->num_long_term_ref_pics_sps > 1)
+                                READ_BITS(gb, mpp_ceil_log2(pp->num_long_term_ref_pics_sps), &lt_idx_sps);
+                        } else {
+                            SKIP_BITS(gb, pp->log2_max_pic_order_cnt_lsb_minus4 + 4);
+                            SKIP_BITS(gb, 1);
+                        }
+
+                        READ_ONEBIT(gb, &delta_poc_msb_present);
+                        if (delta_poc_msb_present) {
+                            RK_S32 delta = 0;
+
+                            READ_UE(gb, &delta);
+                        }
+                    }
+                    rps_bit_offset[slice_idx] += gb->used_bits - bit_begin;
+                }
+
+                if (pp->sps_temporal_mvp_enabled_flag)
+                    READ_ONEBIT(gb, &sh.slice_temporal_mvp_enabled_flag);
+            }
+
+            if (pp->sample_adaptive_offset_enabled_flag) {
+                READ_ONEBIT(gb, &sh.slice_sample_adaptive_offset_flag[0]);
+                READ_ONEBIT(gb, &sh.slice_sample_adaptive_offset_flag[1]);
+            }
+
+            if (sh.slice_type == P_SLICE || sh.slice_type == B_SLICE) {
+                sh.nb_refs[L0] = pp->num_ref_idx_l0_default_active_minus1 + 1;
+                if (sh.slice_type == B_SLICE)
+                    sh.nb_refs[L1] = pp->num_ref_idx_l1_default_active_minus1 + 1;
+
+                READ_ONEBIT(gb, &value);
+                if (value) {
+                    READ_UE(gb, &sh.nb_refs[L0]);
+                    sh.nb_refs[L0] += 1;
+                    if (sh.slice_type == B_SLICE) {
+                        READ_UE(gb, &sh.nb_refs[L1]);
+                        sh.nb_refs[L1] += 1;
+                    }
+                }
+
+                nb_refs = 0;
+                for (i = 0; i < MPP_ARRAY_ELEMS(pp->RefPicList); i++) {
+                    if (pp->RefPicList[i].bPicEntry != 0xff)
+                        nb_refs++;
+                }
+
+                if (pp->lists_modification_present_flag && nb_refs > 1) {
+                    READ_ONEBIT(gb, &sh.rpl_modification_flag[0]);
+                    if (sh.rpl_modification_flag[0]) {
+                        for (i = 0; i < sh.nb_refs[L0]; i++)
+                            READ_BITS(gb, mpp_ceil_log2(nb_refs), &sh.list_entry_lx[0][i]);
+                    }
+
+                    if (sh.slice_type == B_SLICE) {
+                        READ_ONEBIT(gb, &sh.rpl_modification_flag[1]);
+                        if (sh.rpl_modification_flag[1])
+                            for (i = 0; i < sh.nb_refs[L1]; i++)
+                                READ_BITS(gb, mpp_ceil_log2(nb_refs), &sh.list_entry_lx[1][i]);
+                    }
+                }
+            }
+        }
+
+        if (!sh.dependent_slice_segment_flag && sh.slice_type != I_SLICE) {
+            RK_U32 nb_list = I_SLICE - sh.slice_type;
+
+            ref_slice_rpl(pp, &sh, &ref);
+            lowdelay_flag[slice_idx] = 1;
+
+            for (j = 0; j < nb_list; j++) {
+                for (i = 0; i < ref.refPicList[j].nb_refs; i++) {
+                    RK_U8 index = ref.refPicList[j].dpb_index[i];
+
+                    if (index != 0xff) {
+                        rps_pic_info[slice_idx][j][i].dpb_index = index;
+                        rps_pic_info[slice_idx][j][i].is_long_term =
+                            pp->RefPicList[index].AssociatedFlag;
+                        if (pp->PicOrderCntValList[index] > pp->CurrPicOrderCntVal)
+                            lowdelay_flag[slice_idx] = 0;
+                    }
+                }
+            }
+
+            slice_nb_rps_poc[slice_idx] = nb_refs;
+        }
+    }
+
+    {
+        RK_S32 nb_slice = slice_idx + 1;
+        BitputCtx_t bp;
+
+        mpp_set_bitput_ctx(&bp, rps_buf, nb_slice * 4 + 1);
+        for (k = 0; k < (RK_U32)nb_slice; k++) {
+            for (j = 0; j < 2; j++) {
+                for (i = 0; i < 15; i++) {
+                    mpp_put_bits(&bp, rps_pic_info[k][j][i].is_long_term, 1);
+                    if (j == 1 && i == 4)
+                        mpp_put_align(&bp, 64, 0);
+                    mpp_put_bits(&bp, rps_pic_info[k][j][i].dpb_index, 4);
+                }
+            }
+            mpp_put_bits(&bp, lowdelay_flag[k], 1);
+            mpp_put_bits(&bp, rps_bit_offset[k], 10);
+            mpp_put_bits(&bp, rps_bit_offset_st[k], 9);
+            mpp_put_bits(&bp, slice_nb_rps_poc[k], 4);
+            mpp_put_align(&bp, 64, 0);
+        }
+
+        return nb_slice * 4;
+    }
+
+__BITREAD_ERR:
+    return -1;
+}
+
+static void init_pp(DXVA_PicParams_HEVC *pp)
+{
+    RK_U32 i;
+
+    memset(pp, 0, sizeof(*pp));
+
+    /* 3840x2160 with 64x64 ctb */
+    pp->log2_min_luma_coding_block_size_minus3 = 0;
+    pp->log2_diff_max_min_luma_coding_block_size = 3;
+    pp->PicWidthInMinCbsY = RPS_TEST_WIDTH / 8;
+    pp->PicHeightInMinCbsY = RPS_TEST_HEIGHT / 8;
+    pp->log2_max_pic_order_cnt_lsb_minus4 = 4;
+    pp->num_short_term_ref_pic_sets = 4;
+    pp->num_ref_idx_l0_default_active_minus1 = 1;
+    pp->num_ref_idx_l1_default_active_minus1 = 0;
+    pp->sps_temporal_mvp_enabled_flag = 1;
+    pp->sample_adaptive_offset_enabled_flag = 1;
+    pp->CurrPicOrderCntVal = 6;
+
+    for (i = 0; i < MPP_ARRAY_ELEMS(pp->RefPicList); i++) {
+        pp->RefPicList[i].bPicEntry = (i < 3) ? i : 0xff;
+        pp->PicOrderCntValList[i] = (i < 3) ? (RK_S32)(i * 4) : 0;
+    }
+    memset(pp->RefPicSetStCurrBefore, 0xff, sizeof(pp->RefPicSetStCurrBefore));
+    memset(pp->RefPicSetStCurrAfter, 0xff, sizeof(pp->RefPicSetStCurrAfter));
+    memset(pp->RefPicSetLtCurr, 0xff, sizeof(pp->RefPicSetLtCurr));
+    pp->RefPicSetStCurrBefore[0] = 1;
+    pp->RefPicSetStCurrBefore[1] = 0;
+    pp->RefPicSetStCurrAfter[0] = 2;
+}
+
+/* random frame rps with at least one ref and random sps / pps flags */
+static void rand_pp(DXVA_PicParams_HEVC *pp)
+{
+    RK_U32 dpb = 1 + rand_val(RPS_TEST_DPB_SIZE - 1);
+    RK_U32 bef = 0, aft = 0, lt = 0;
+    RK_U32 i;
+
+    init_pp(pp);
+
+    pp->num_short_term_ref_pic_sets = 1 + rand_val(7);
+    pp->wNumBitsForShortTermRPSInSlice = rand_val(20);
+    pp->num_ref_idx_l0_default_active_minus1 = rand_val(3);
+    pp->num_ref_idx_l1_default_active_minus1 = rand_val(3);
+    pp->long_term_ref_pics_present_flag = rand_val(1);
+    pp->num_long_term_ref_pics_sps = rand_val(3);
+    pp->dependent_slice_segments_enabled_flag = rand_val(1);
+    pp->lists_modification_present_flag = rand_val(1);
+    pp->output_flag_present_flag = rand_val(1);
+    pp->num_extra_slice_header_bits = rand_val(2);
+    pp->sps_temporal_mvp_enabled_flag = rand_val(1);
+    pp->sample_adaptive_offset_enabled_flag = rand_val(1);
+    pp->CurrPicOrderCntVal = 8;
+
+    memset(pp->RefPicSetStCurrBefore, 0xff, sizeof(pp->RefPicSetStCurrBefore));
+    memset(pp->RefPicSetStCurrAfter, 0xff, sizeof(pp->RefPicSetStCurrAfter));
+    memset(pp->RefPicSetLtCurr, 0xff, sizeof(pp->RefPicSetLtCurr));
+
+    for (i = 0; i < MPP_ARRAY_ELEMS(pp->RefPicList); i++) {
+        pp->RefPicList[i].bPicEntry = 0xff;
+        pp->PicOrderCntValList[i] = 0;
+    }
+
+    for (i = 0; i < dpb; i++) {
+        RK_U32 set = i ? rand_val(2) : 0;
+
+        pp->RefPicList[i].Index7Bits = i;
+        pp->RefPicList[i].AssociatedFlag = (set == 2);
+        pp->PicOrderCntValList[i] = rand_val(16);
+
+        if (set == 0)
+            pp->RefPicSetStCurrBefore[bef++] = i;
+        else if (set == 1)
+            pp->RefPicSetStCurrAfter[aft++] = i;
+        else
+            pp->RefPicSetLtCurr[lt++] = i;
+    }
+}
+
+static RK_U32 count_dpb(DXVA_PicParams_HEVC *pp)
+{
+    RK_U32 cnt = 0;
+    RK_U32 i;
+
+    for (i = 0; i < MPP_ARRAY_ELEMS(pp->RefPicList); i++)
+        if (pp->RefPicList[i].bPicEntry != 0xff)
+            cnt++;
+
+    return cnt;
+}
+
+static void write_slice(DXVA_PicParams_HEVC *pp, RK_U8 *buf, RK_U32 nal_type,
+                        RK_U32 idx, RK_U32 count, RpsTestSlice *s)
+{
+    RK_U32 ctb_count = (RPS_TEST_WIDTH / 64) * (RPS_TEST_HEIGHT / 64 + 1);
+    RK_U32 poc_bits = pp->log2_max_pic_order_cnt_lsb_minus4 + 4;
+    RK_U32 dpb = count_dpb(pp);
+    RpsTestBits bits = { buf, 0 };
+    RK_U32 i, j;
+
+    /* all ones tail avoids start code emulation in the synthetic headers */
+    memset(buf, 0xff, RPS_TEST_SLICE_SIZE);
+    memset(buf, 0, RPS_TEST_HDR_SIZE);
+
+    put_bits(&bits, 0, 1);
+    put_bits(&bits, nal_type, 6);
+    put_bits(&bits, 0, 6);
+    put_bits(&bits, 1, 3);
+
+    put_bits(&bits, !idx, 1);           /* first_slice_segment_in_pic_flag */
+    if (nal_type >= 16 && nal_type <= 23)
+        put_bits(&bits, 0, 1);          /* no_output_of_prior_pics_flag */
+    put_ue(&bits, 0);                   /* pps_id */
+    if (idx) {
+        if (pp->dependent_slice_segments_enabled_flag)
+            put_bits(&bits, s->dependent, 1);
+        put_bits(&bits, idx * ctb_count / count, mpp_ceil_log2(ctb_count));
+    }
+
+    if (!s->dependent) {
+        put_bits(&bits, 0, pp->num_extra_slice_header_bits);
+        put_ue(&bits, s->type);
+        if (pp->output_flag_present_flag)
+            put_bits(&bits, 1, 1);
+
+        if (!IS_IDR(nal_type)) {
+            put_bits(&bits, 8, poc_bits);
+            put_bits(&bits, s->st_sps_flag, 1);
+            if (!s->st_sps_flag)
+                put_bits(&bits, 0x5a5a5 & ((1 << pp->wNumBitsForShortTermRPSInSlice) - 1),
+                         pp->wNumBitsForShortTermRPSInSlice);
+            else
+                put_bits(&bits, 1, mpp_ceil_log2(pp->num_short_term_ref_pic_sets));
+
+            if (pp->long_term_ref_pics_present_flag) {
+                RK_U32 nb_sps = pp->num_long_term_ref_pics_sps ? 1 : 0;
+
+                if (pp->num_long_term_ref_pics_sps)
+                    put_ue(&bits, nb_sps);
+                put_ue(&bits, s->nb_lt);
+
+                for (i = 0; i < nb_sps + s->nb_lt; i++) {
+                    if (i < nb_sps) {
+                        if (pp->num_long_term_ref_pics_sps > 1)
+                            put_bits(&bits, 1, mpp_ceil_log2(pp->num_long_term_ref_pics_sps));
+                    } else {
+                        put_bits(&bits, 3, poc_bits);
+                        put_bits(&bits, 1, 1);
+                    }
+                    /* delta_poc_msb_present_flag with delta 2 */
+                    put_bits(&bits, i & 1, 1);
+                    if (i & 1)
+                        put_ue(&bits, 2);
+                }
+            }
+
+            if (pp->sps_temporal_mvp_enabled_flag)
+                put_bits(&bits, 1, 1);
+        }
+
+        if (pp->sample_adaptive_offset_enabled_flag)
+            put_bits(&bits, 3, 2);
+
+        if (s->type != I_SLICE) {
+            put_bits(&bits, s->override, 1);
+            if (s->override) {
+                put_ue(&bits, s->nb_refs[0] - 1);
+                if (s->type == B_SLICE)
+                    put_ue(&bits, s->nb_refs[1] - 1);
+            }
+
+            if (pp->lists_modification_present_flag && dpb > 1) {
+                for (j = 0; j < (s->type == B_SLICE ? 2U : 1U); j++) {
+                    put_bits(&bits, s->modify[j], 1);
+                    if (s->modify[j])
+                        for (i = 0; i < s->nb_refs[j]; i++)
+                            put_bits(&bits, s->entry[j][i], mpp_ceil_log2(dpb));
+                }
+            }
+        }
+    }
+
+    put_bits(&bits, 1, 1);              /* rbsp tail */
+}
+
+static void rand_slice(DXVA_PicParams_HEVC *pp, RpsTestSlice *s, RK_U32 idx, RK_U32 nal_type)
+{
+    RK_U32 dpb = count_dpb(pp);
+    RK_U32 i, j;
+
+    memset(s, 0, sizeof(*s));
+
+    s->dependent = idx && pp->dependent_slice_segments_enabled_flag && !rand_val(2);
+    s->type = IS_IDR(nal_type) ? I_SLICE : rand_val(2);
+    s->st_sps_flag = rand_val(1);
+    s->nb_lt = rand_val(2);
+    s->override = rand_val(1);
+    s->nb_refs[0] = s->override ? 1 + rand_val(3) :
+                    (RK_U32)pp->num_ref_idx_l0_default_active_minus1 + 1;
+    s->nb_refs[1] = s->override ? 1 + rand_val(3) :
+                    (RK_U32)pp->num_ref_idx_l1_default_active_minus1 + 1;
+
+    for (j = 0; j < 2; j++) {
+        s->modify[j] = rand_val(1);
+        for (i = 0; i < s->nb_refs[j]; i++)
+            s->entry[j][i] = rand_val(MPP_MIN(s->nb_refs[j], 1U << mpp_ceil_log2(dpb)) - 1);
+    }
+}
+
+static void init_strm(h265d_dxva2_picture_context_t *dxva, RK_U8 *strm, RK_U32 count)
+{
+    RK_U32 i;
+
+    for (i = 0; i < count; i++) {
+        dxva->slice_short[i].BSNALunitDataLocation = i * RPS_TEST_SLICE_SIZE;
+        dxva->slice_short[i].SliceBytesInBuffer = RPS_TEST_SLICE_SIZE;
+    }
+
+    dxva->bitstream = strm;
+    dxva->bitstream_size = count * RPS_TEST_SLICE_SIZE;
+    dxva->slice_count = count;
+}
+
+static MPP_RET check_picture(h265d_dxva2_picture_context_t *dxva, RK_U64 *rps,
+                             RK_U64 *ref, const char *name)
+{
+    RK_S32 words;
+    RK_S32 i;
+
+    memset(rps, 0, MAX_SLICES * 4 * sizeof(RK_U64));
+    memset(ref, 0, (MAX_SLICES * 4 + 1) * sizeof(RK_U64));
+
+    words = ref_output_rps(dxva, ref);
+    if (words <= 0) {
+        mpp_err("%s reference packer failed\n", name);
+        return MPP_NOK;
+    }
+
+    if (hal_h265d_slice_output_rps(dxva, rps)) {
+        mpp_err("%s rps output failed\n", name);
+        return MPP_NOK;
+    }
+
+    for (i = 0; i < words; i++) {
+        if (rps[i] != ref[i]) {
+            mpp_err("%s slice %d word %d %016llx expect %016llx\n",
+                    name, i / 4, i % 4, rps[i], ref[i]);
+            return MPP_NOK;
+        }
+    }
+
+    return MPP_OK;
+}
+
+/* fixed slice patterns for the cases of the per slice ref list reuse */
+static MPP_RET test_cases(h265d_dxva2_picture_context_t *dxva, RK_U8 *strm,
+                          RK_U64 *rps, RK_U64 *ref)
+{
+    static const RK_U32 types[] = {
+        I_SLICE, P_SLICE, P_SLICE, B_SLICE, B_SLICE, I_SLICE, P_SLICE, B_SLICE,
+    };
+    RK_U32 count = MPP_ARRAY_ELEMS(types);
+    RpsTestSlice s;
+    RK_U32 i;
+
+    /* I / P / B mix with default and overridden ref counts */
+    init_pp(&dxva->pp);
+    for (i = 0; i < count; i++) {
+        memset(&s, 0, sizeof(s));
+        s.type = types[i];
+        s.st_sps_flag = 1;
+        s.override = i & 1;
+        s.nb_refs[0] = s.override ? 3 : 2;
+        s.nb_refs[1] = s.override ? 2 : 1;
+        write_slice(&dxva->pp, strm + i * RPS_TEST_SLICE_SIZE, 1, i, count, &s);
+    }
+    init_strm(dxva, strm, count);
+    if (check_picture(dxva, rps, ref, "slice type mix"))
+        return MPP_NOK;
+
+    /* list modification, same lists then reordered ones */
+    dxva->pp.lists_modification_present_flag = 1;
+    for (i = 0; i < count; i++) {
+        memset(&s, 0, sizeof(s));
+        s.type = B_SLICE;
+        s.st_sps_flag = 1;
+        s.override = 1;
+        s.nb_refs[0] = 3;
+        s.nb_refs[1] = 2;
+        s.modify[0] = i >= 2;
+        s.modify[1] = i >= 4;
+        s.entry[0][0] = (i >= 6) ? 2 : 1;
+        s.entry[0][1] = 0;
+        s.entry[0][2] = 1;
+        s.entry[1][0] = 1;
+        s.entry[1][1] = (i >= 6) ? 1 : 0;
+        write_slice(&dxva->pp, strm + i * RPS_TEST_SLICE_SIZE, 1, i, count, &s);
+    }
+    if (check_picture(dxva, rps, ref, "list modification"))
+        return MPP_NOK;
+
+    /* dependent slices between independent slices of different types */
+    dxva->pp.lists_modification_present_flag = 0;
+    dxva->pp.dependent_slice_segments_enabled_flag = 1;
+    for (i = 0; i < count; i++) {
+        memset(&s, 0, sizeof(s));
+        s.dependent = i && (i % 3);
+        s.type = (i / 3) ? P_SLICE : B_SLICE;
+        s.st_sps_flag = 1;
+        s.nb_refs[0] = 2;
+        s.nb_refs[1] = 1;
+        write_slice(&dxva->pp, strm + i * RPS_TEST_SLICE_SIZE, 1, i, count, &s);
+    }
+    if (check_picture(dxva, rps, ref, "dependent slice"))
+        return MPP_NOK;
+
+    /* long-term refs in frame rps and slice header */
+    dxva->pp.dependent_slice_segments_enabled_flag = 0;
+    dxva->pp.long_term_ref_pics_present_flag = 1;
+    dxva->pp.RefPicList[2].AssociatedFlag = 1;
+    dxva->pp.RefPicSetStCurrAfter[0] = 0xff;
+    dxva->pp.RefPicSetLtCurr[0] = 2;
+    for (i = 0; i < count; i++) {
+        memset(&s, 0, sizeof(s));
+        s.type = types[i];
+        s.st_sps_flag = i & 1;
+        s.nb_lt = i % 3;
+        s.nb_refs[0] = 2;
+        s.nb_refs[1] = 1;
+        write_slice(&dxva->pp, strm + i * RPS_TEST_SLICE_SIZE, 1, i, count, &s);
+    }
+    if (check_picture(dxva, rps, ref, "long-term ref"))
+        return MPP_NOK;
+
+    return MPP_OK;
+}
+
+static MPP_RET test_random(h265d_dxva2_picture_context_t *dxva, RK_U8 *strm,
+                           RK_U64 *rps, RK_U64 *ref, RK_U32 pictures, RK_U32 max_count)
+{
+    RpsTestSlice s;
+    RK_U32 n, i;
+
+    srand(0x265);
+
+    for (n = 0; n < pictures; n++) {
+        RK_U32 count = 1 + rand_val(max_count - 1);
+        RK_U32 nal_type = rand_val(7) ? 1 : 19;
+
+        rand_pp(&dxva->pp);
+        for (i = 0; i < count; i++) {
+            rand_slice(&dxva->pp, &s, i, nal_type);
+            write_slice(&dxva->pp, strm + i * RPS_TEST_SLICE_SIZE, nal_type, i, count, &s);
+        }
+        init_strm(dxva, strm, count);
+
+        if (check_picture(dxva, rps, ref, "random picture")) {
+            mpp_err("random picture %d of %d slices mismatch\n", n, count);
+            return MPP_NOK;
+        }
+    }
+
+    mpp_log("%d random pictures match\n", pictures);
+
+    return MPP_OK;
+}
+
+static void init_broadcast(h265d_dxva2_picture_context_t *dxva, RK_U8 *strm, RK_U32 count)
+{
+    RpsTestSlice s;
+    RK_U32 i;
+
+    init_pp(&dxva->pp);
+
+    memset(&s, 0, sizeof(s));
+    s.type = B_SLICE;
+    s.st_sps_flag = 1;
+
+    for (i = 0; i < count; i++)
+        write_slice(&dxva->pp, strm + i * RPS_TEST_SLICE_SIZE, 1, i, count, &s);
+
+    init_strm(dxva, strm, count);
+}
+
+int main(int argc, char **argv)
+{
+    h265d_dxva2_picture_context_t *dxva = NULL;
+    RK_U8 *strm = NULL;
+    RK_U64 *rps = NULL;
+    RK_U64 *ref = NULL;
+    RK_U32 count = 68;
+    RK_U32 loop = 1000;
+    RK_U32 pictures = 2000;
+    RK_S64 start, end;
+    RK_U32 i;
+    RK_S32 ret = MPP_NOK;
+
+    if (argc > 1)
+        count = MPP_CLIP3(1, MAX_SLICES, atoi(argv[1]));
+    if (argc > 2)
+        loop = MPP_MAX(atoi(argv[2]), 1);
+    if (argc > 3)
+        pictures = MPP_MAX(atoi(argv[3]), 0);
+
+    mpp_log("hal_h265d_rps_test start %d slices %d loops\n", count, loop);
+
+    dxva = mpp_calloc(h265d_dxva2_picture_context_t, 1);
+    strm = mpp_malloc(RK_U8, MAX_SLICES * RPS_TEST_SLICE_SIZE);
+    rps = mpp_calloc(RK_U64, MAX_SLICES * 4);
+    ref = mpp_calloc(RK_U64, MAX_SLICES * 4 + 1);
+    if (dxva)
+        dxva->slice_short = mpp_calloc(DXVA_Slice_HEVC_Short, MAX_SLICES);
+    if (!dxva || !strm || !rps || !ref || !dxva->slice_short) {
+        mpp_err("failed to malloc test context\n");
+        goto DONE;
+    }
+
+    if (test_cases(dxva, strm, rps, ref))
+        goto DONE;
+
+    if (test_random(dxva, strm, rps, ref, pictures, 32))
+        goto DONE;
+
+    init_broadcast(dxva, strm, count);
+    if (check_picture(dxva, rps, ref, "broadcast"))
+        goto DONE;
+
+    start = mpp_time();
+    for (i = 0; i < loop; i++)
+        hal_h265d_slice_output_rps(dxva, rps);
+    end = mpp_time();
+
+    mpp_log("rps packet %016llx %016llx %016llx %016llx\n",
+            rps[0], rps[1], rps[2], rps[3]);
+    mpp_log("rps output %lld us per picture\n", (end - start) / loop);
+    ret = MPP_OK;
+
+DONE:
+    if (dxva)
+        MPP_FREE(dxva->slice_short);
+    MPP_FREE(dxva);
+    MPP_FREE(strm);
+    MPP_FREE(rps);
+    MPP_FREE(ref);
+
+    mpp_log("hal_h265d_rps_test %s\n", ret ? "failed" : "success");
+
+    return ret;
+}
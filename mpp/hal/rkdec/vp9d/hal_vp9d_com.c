@@ -1959,6 +1959,13 @@ MPP_RET hal_vp9d_prob_kf(void *buf)
     return MPP_OK;
 }
 
+void hal_vp9d_prob_kf_init(void *buf, size_t size)
+{
+    (void)size;
+
+    hal_vp9d_prob_kf(buf);
+}
+
 void hal_vp9d_update_counts(void *buf, void *dxva)
 {
     DXVA_PicParams_VP9 *s = (DXVA_PicParams_VP9*)dxva;
@@ -2018,6 +2025,10 @@ static MPP_RET hal_vp9d_release_res(HalVp9dCtx *hal)
     RK_S32 ret = 0;
     RK_S32 i = 0;
 
+    /* shared key frame probability table */
+    hal_tbl_put(hw_ctx->probe_base, p_hal->cfg->dev);
+    hw_ctx->probe_base = NULL;
+
     if (hw_ctx->prob_default_base) {
         ret = mpp_buffer_put(hw_ctx->prob_default_base);
         if (ret) {
@@ -2091,13 +2102,6 @@ static MPP_RET hal_vp9d_release_res(HalVp9dCtx *hal)
                 return ret;
             }
         }
-        if (hw_ctx->probe_base) {
-            ret = mpp_buffer_put(hw_ctx->probe_base);
-            if (ret) {
-                mpp_err("vp9 probe_base get buffer failed\n");
-                return ret;
-            }
-        }
         if (hw_ctx->count_base) {
             ret = mpp_buffer_put(hw_ctx->count_base);
             if (ret) {
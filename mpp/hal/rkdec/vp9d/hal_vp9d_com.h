@@ -20,6 +20,7 @@
 #include "mpp_env.h"
 
 #include "rk_mpi_cmd.h"
+#include "hal_tbls.h"
 #include "hal_vp9d_ctx.h"
 #include "vp9d_syntax.h"
 #include "vdpu38x_com.h"
@@ -58,6 +59,9 @@ typedef RK_U8 vp9_prob;
 
 #define PROB_SIZE                       4864
 #define PROB_KF_SIZE                    (82 * 16)
+
+/* hal_tbls id of shared vp9 tables */
+#define HAL_VP9D_TBL_PROB_KF            0
 #define COUNT_SIZE                      13208
 
 #define VP9_CTU_SIZE 64
@@ -97,6 +101,7 @@ MPP_RET hal_vp9d_prob_flag_delta(void *buf, void *dxva);
 void hal_vp9d_update_counts(void *buf, void *dxva);
 MPP_RET hal_vp9d_prob_default(void *buf, void *dxva);
 MPP_RET hal_vp9d_prob_kf(void *buf);
+void hal_vp9d_prob_kf_init(void *buf, size_t size);
 void set_tile_offset(RK_S32 *start, RK_S32 *end, RK_S32 idx, RK_S32 log2_n, RK_S32 n);
 MPP_RET vdpu38x_vp9d_uncomp_hdr(HalVp9dCtx *p_hal, DXVA_PicParams_VP9 *pp,
                                 RK_U64 *data, RK_U32 len);
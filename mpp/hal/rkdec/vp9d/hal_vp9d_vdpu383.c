@@ -58,6 +58,14 @@ static MPP_RET hal_vp9d_alloc_res(HalVp9dCtx *hal)
     }
     mpp_buffer_attach_dev(hw_ctx->prob_default_base, cfg->dev);
 
+    /* key frame probability is constant and shared by all sessions */
+    ret = hal_tbl_get(&hw_ctx->probe_base, cfg->dev, MPP_VIDEO_CodingVP9,
+                      HAL_VP9D_TBL_PROB_KF, NULL, PROB_KF_SIZE, hal_vp9d_prob_kf_init);
+    if (ret) {
+        mpp_err("vp9 probe_base get buffer failed\n");
+        return ret;
+    }
+
     ret = mpp_buffer_get(group, &hw_ctx->segid_cur_base, MAX_SEGMAP_SIZE);
     if (ret) {
         mpp_err("vp9 segid_cur_base get buffer failed\n");
@@ -82,13 +90,6 @@ static MPP_RET hal_vp9d_alloc_res(HalVp9dCtx *hal)
                 mpp_err("vp9 global_base get buffer failed\n");
                 return ret;
             }
-            ret = mpp_buffer_get(group,
-                                 &hw_ctx->g_buf[i].probe_base, PROB_KF_SIZE);
-            if (ret) {
-                mpp_err("vp9 probe_base get buffer failed\n");
-                return ret;
-            }
-            mpp_buffer_attach_dev(hw_ctx->g_buf[i].probe_base, cfg->dev);
             ret = mpp_buffer_get(group,
                                  &hw_ctx->g_buf[i].count_base, COUNT_SIZE);
             if (ret) {
@@ -106,13 +107,6 @@ static MPP_RET hal_vp9d_alloc_res(HalVp9dCtx *hal)
         }
         mpp_buffer_attach_dev(hw_ctx->global_base, cfg->dev);
 
-        ret = mpp_buffer_get(group, &hw_ctx->probe_base, PROB_KF_SIZE);
-        if (ret) {
-            mpp_err("vp9 probe_base get buffer failed\n");
-            return ret;
-        }
-        mpp_buffer_attach_dev(hw_ctx->probe_base, cfg->dev);
-
         ret = mpp_buffer_get(group, &hw_ctx->count_base, COUNT_SIZE);
         if (ret) {
             mpp_err("vp9 count_base get buffer failed\n");
@@ -294,7 +288,6 @@ static MPP_RET hal_vp9d_vdpu383_gen_regs(void *hal, HalTaskInfo *task)
             if (!hw_ctx->g_buf[i].use_flag) {
                 task->dec.reg_index = i;
                 hw_ctx->global_base = hw_ctx->g_buf[i].global_base;
-                hw_ctx->probe_base = hw_ctx->g_buf[i].probe_base;
                 hw_ctx->count_base = hw_ctx->g_buf[i].count_base;
                 hw_ctx->hw_regs = hw_ctx->g_buf[i].hw_regs;
                 hw_ctx->g_buf[i].use_flag = 1;
@@ -358,9 +351,6 @@ static MPP_RET hal_vp9d_vdpu383_gen_regs(void *hal, HalTaskInfo *task)
     intraFlag = (!pic_param->frame_type || pic_param->intra_only);
 #if HW_PROB
     // hal_vp9d_prob_flag_delta(mpp_buffer_get_ptr(hw_ctx->probe_base), task->dec.syntax.data);
-    /* init kf_probe */
-    hal_vp9d_prob_kf(mpp_buffer_get_ptr(hw_ctx->probe_base));
-    mpp_buffer_sync_end(hw_ctx->probe_base);
     if (intraFlag) {
         hal_vp9d_prob_default(mpp_buffer_get_ptr(hw_ctx->prob_default_base), task->dec.syntax.data);
         mpp_buffer_sync_end(hw_ctx->prob_default_base);
@@ -400,11 +400,13 @@ static void setup_hal_bufs(HalH264eVepu510Ctx *ctx)
     RK_S32 alignment_w = 64;
     RK_S32 alignment_h = 16;
     RK_S32 aligned_w = MPP_ALIGN(prep->width,  alignment_w);
-    RK_S32 aligned_h = MPP_ALIGN(prep->height, alignment_h) + 16;
-    RK_S32 pixel_buf_fbc_hdr_size = MPP_ALIGN(aligned_w * aligned_h / 64, SZ_8K);
-    RK_S32 pixel_buf_fbc_bdy_size = aligned_w * aligned_h * 3 / 2;
+    /* size for max resolution then resolution switch below it keeps buffers */
+    RK_S32 buf_w = MPP_ALIGN(MPP_MAX(prep->width, prep->max_width), alignment_w);
+    RK_S32 buf_h = MPP_ALIGN(MPP_MAX(prep->height, prep->max_height), alignment_h) + 16;
+    RK_S32 pixel_buf_fbc_hdr_size = MPP_ALIGN(buf_w * buf_h / 64, SZ_8K);
+    RK_S32 pixel_buf_fbc_bdy_size = buf_w * buf_h * 3 / 2;
     RK_S32 pixel_buf_size = pixel_buf_fbc_hdr_size + pixel_buf_fbc_bdy_size;
-    RK_S32 thumb_buf_size = MPP_ALIGN(aligned_w / 64 * aligned_h / 64 * 256, SZ_8K);
+    RK_S32 thumb_buf_size = MPP_ALIGN(buf_w / 64 * buf_h / 64 * 256, SZ_8K);
     RK_S32 old_max_cnt = ctx->max_buf_cnt;
     RK_S32 new_max_cnt = 4;
     MppEncRefCfg ref_cfg = cfg->ref_cfg;
@@ -440,13 +442,18 @@ static void setup_hal_bufs(HalH264eVepu510Ctx *ctx)
         ctx->ext_line_buf_size = 0;
     }
 
-    if ((ctx->pixel_buf_fbc_hdr_size != pixel_buf_fbc_hdr_size) ||
-        (ctx->pixel_buf_fbc_bdy_size != pixel_buf_fbc_bdy_size) ||
-        (ctx->pixel_buf_size != pixel_buf_size) ||
-        (ctx->thumb_buf_size != thumb_buf_size) ||
+    if ((pixel_buf_fbc_hdr_size > ctx->pixel_buf_fbc_hdr_size) ||
+        (pixel_buf_fbc_bdy_size > ctx->pixel_buf_fbc_bdy_size) ||
+        (thumb_buf_size > ctx->thumb_buf_size) ||
         (new_max_cnt > old_max_cnt)) {
         size_t sizes[3];
 
+        /* never shrink so the fbc body offset stays valid for all buffers */
+        pixel_buf_fbc_hdr_size = MPP_MAX(pixel_buf_fbc_hdr_size, ctx->pixel_buf_fbc_hdr_size);
+        pixel_buf_fbc_bdy_size = MPP_MAX(pixel_buf_fbc_bdy_size, ctx->pixel_buf_fbc_bdy_size);
+        pixel_buf_size = pixel_buf_fbc_hdr_size + pixel_buf_fbc_bdy_size;
+        thumb_buf_size = MPP_MAX(thumb_buf_size, ctx->thumb_buf_size);
+
         hal_h264e_dbg_detail("frame size %d -> %d max count %d -> %d\n",
                              ctx->pixel_buf_size, pixel_buf_size,
                              old_max_cnt, new_max_cnt);
@@ -456,7 +463,7 @@ static void setup_hal_bufs(HalH264eVepu510Ctx *ctx)
         /* thumb buffer */
         sizes[1] = thumb_buf_size;
         /* smear buffer */
-        sizes[2] = MPP_ALIGN(aligned_w / 64, 16) * MPP_ALIGN(aligned_h / 16, 16);
+        sizes[2] = MPP_ALIGN(buf_w / 64, 16) * MPP_ALIGN(buf_h / 16, 16);
         new_max_cnt = MPP_MAX(new_max_cnt, old_max_cnt);
 
         hal_bufs_setup(ctx->hw_recn, new_max_cnt, MPP_ARRAY_ELEMS(sizes), sizes);
@@ -307,13 +307,16 @@ static MPP_RET vepu510_h265_setup_hal_bufs(H265eV510HalContext *ctx)
     RK_S32 new_max_cnt = 4;
     RK_S32 alignment = 32;
     RK_S32 aligned_w = MPP_ALIGN(prep->width,  alignment);
+    /* size for max resolution then resolution switch below it keeps buffers */
+    RK_S32 buf_w = MPP_MAX(prep->width, prep->max_width);
+    RK_S32 buf_h = MPP_MAX(prep->height, prep->max_height);
 
     hal_h265e_enter();
 
-    mb_wd64 = (prep->width + 63) / 64;
-    mb_h64 = (prep->height + 63) / 64 + 1;
+    mb_wd64 = (buf_w + 63) / 64;
+    mb_h64 = (buf_h + 63) / 64 + 1;
 
-    frame_size = MPP_ALIGN(prep->width, 16) * MPP_ALIGN(prep->height, 16);
+    frame_size = MPP_ALIGN(buf_w, 16) * MPP_ALIGN(buf_h, 16);
     vepu5xx_set_fmt(fmt, ctx->cfg->prep.format);
     input_fmt = (VepuFmt)fmt->format;
     switch (input_fmt) {
@@ -376,8 +379,8 @@ static MPP_RET vepu510_h265_setup_hal_bufs(H265eV510HalContext *ctx)
 
     if (frame_size > ctx->frame_size || new_max_cnt > old_max_cnt) {
         size_t size[4] = {0};
-        RK_S32 ctu_w = (prep->width + 31) / 32;
-        RK_S32 ctu_h = (prep->height + 31) / 32;
+        RK_S32 ctu_w = (buf_w + 31) / 32;
+        RK_S32 ctu_h = (buf_h + 31) / 32;
 
         hal_bufs_deinit(ctx->dpb_bufs);
         hal_bufs_init(&ctx->dpb_bufs);
@@ -358,13 +358,16 @@ static MPP_RET vepu580_h265_setup_hal_bufs(H265eV580HalContext *ctx)
     MppEncPrepCfg *prep = &ctx->cfg->prep;
     RK_S32 old_max_cnt = ctx->max_buf_cnt;
     RK_S32 new_max_cnt = 4;
+    /* size for max resolution then resolution switch below it keeps buffers */
+    RK_S32 buf_w = MPP_MAX(prep->width, prep->max_width);
+    RK_S32 buf_h = MPP_MAX(prep->height, prep->max_height);
 
     hal_h265e_enter();
 
-    mb_wd64 = (prep->width + 63) / 64;
-    mb_h64 = (prep->height + 63) / 64 + 1;
+    mb_wd64 = (buf_w + 63) / 64;
+    mb_h64 = (buf_h + 63) / 64 + 1;
 
-    frame_size = MPP_ALIGN(prep->width, 16) * MPP_ALIGN(prep->height, 16);
+    frame_size = MPP_ALIGN(buf_w, 16) * MPP_ALIGN(buf_h, 16);
     vepu5xx_set_fmt(fmt, ctx->cfg->prep.format);
 
     if (ref_cfg) {
@@ -78,12 +78,6 @@ typedef struct VdpuAv1dRegCtx_t {
     MppBuffer       tile_buf;
     filtInfo        filt_info[FILT_TYPE_BUT];
 
-    AV1CDFs         *cdfs;
-    Av1MvCDFs       *cdfs_ndvc;
-    AV1CDFs         default_cdfs;
-    Av1MvCDFs       default_cdfs_ndvc;
-    AV1CDFs         cdfs_last[AV1_NUM_REF_FRAMES];
-    Av1MvCDFs       cdfs_last_ndvc[AV1_NUM_REF_FRAMES];
     RK_U32          refresh_frame_flags;
 
     RK_U32          width;
@@ -257,8 +251,6 @@ MPP_RET vdpu_av1d_init(void *hal, MppHalCfg *cfg)
     {
         VdpuAv1dRegCtx *reg_ctx = (VdpuAv1dRegCtx *)p_hal->reg_ctx;
 
-        reg_ctx->cdfs = &reg_ctx->default_cdfs;
-        reg_ctx->cdfs_ndvc = &reg_ctx->default_cdfs_ndvc;
         reg_ctx->tile_transpose = 1;
     }
 
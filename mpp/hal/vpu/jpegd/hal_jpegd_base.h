@@ -23,6 +23,8 @@
 #include "mpp_env.h"
 #include "mpp_device.h"
 
+#include "jpegd_syntax.h"
+
 typedef struct PPInfo_t {
     /* PP parameters */
     RK_U8                  pp_enable; /* 0 - disable; 1 - enable */
@@ -35,6 +37,17 @@ typedef struct PPInfo_t {
     RK_U32                 crop_y;
 } PPInfo;
 
+/* syntax elements which the hardware tables in pTableBase depend on */
+typedef struct JpegdTblKey_t {
+    RK_U32                 tbl_gen;
+    RK_U32                 yuv_mode;
+    RK_U32                 nb_components;
+    RK_U32                 qtable_cnt;
+    RK_U32                 dc_index[MAX_COMPONENTS];
+    RK_U32                 ac_index[MAX_COMPONENTS];
+    RK_U32                 quant_index[MAX_COMPONENTS];
+} JpegdTblKey;
+
 typedef struct JpegdHalCtx {
     MppHalCfg              *cfg;
     void                   *regs;
@@ -52,6 +65,12 @@ typedef struct JpegdHalCtx {
 
     RK_U32                 have_pp;
     PPInfo                 pp_info;
+
+    /* tables in pTableBase are valid for tbl_key */
+    JpegdTblKey            tbl_key;
+    RK_U32                 tbl_valid;
+    /* tables are rewritten for current task and need cache sync */
+    RK_U32                 tbl_dirty;
 } JpegdHalCtx;
 
 extern RK_U32 hal_jpegd_debug;
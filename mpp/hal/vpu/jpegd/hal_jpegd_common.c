@@ -259,6 +259,36 @@ RK_U32 jpegd_vdpu_tail_0xFF_patch(MppBuffer stream, RK_U32 length)
     return length;
 }
 
+/*
+ * Check whether hardware tables need rewrite. Images with the same DQT / DHT
+ * content and table selection reuse the tables written for previous image.
+ */
+RK_U32 jpegd_tbl_need_update(JpegdHalCtx *ctx, JpegdSyntax *syntax)
+{
+    JpegdTblKey key;
+
+    memset(&key, 0, sizeof(key));
+    key.tbl_gen = syntax->tbl_gen;
+    key.yuv_mode = syntax->yuv_mode;
+    key.nb_components = syntax->nb_components;
+    key.qtable_cnt = syntax->qtable_cnt;
+    memcpy(key.dc_index, syntax->dc_index, sizeof(key.dc_index));
+    memcpy(key.ac_index, syntax->ac_index, sizeof(key.ac_index));
+    memcpy(key.quant_index, syntax->quant_index, sizeof(key.quant_index));
+
+    if (ctx->tbl_valid && !memcmp(&key, &ctx->tbl_key, sizeof(key))) {
+        jpegd_dbg_hal("reuse tables of gen %d\n", key.tbl_gen);
+        ctx->tbl_dirty = 0;
+        return 0;
+    }
+
+    ctx->tbl_key = key;
+    ctx->tbl_valid = 1;
+    ctx->tbl_dirty = 1;
+
+    return 1;
+}
+
 void jpegd_write_qp_ac_dc_table(JpegdHalCtx *ctx,
                                 JpegdSyntax*syntax)
 {
@@ -365,9 +365,10 @@ static MPP_RET jpegd_gen_regs(JpegdHalCtx *ctx, JpegdSyntax *syntax)
     regs->reg30_perf_latency_ctrl0.axi_cnt_type = 1;
     regs->reg30_perf_latency_ctrl0.rd_latency_id = 0xa;
 
-    jpegd_vpu7xx_write_htbl(ctx, s);
-
-    jpegd_vpu7xx_write_qtbl(ctx, s);
+    if (jpegd_tbl_need_update(ctx, s)) {
+        jpegd_vpu7xx_write_htbl(ctx, s);
+        jpegd_vpu7xx_write_qtbl(ctx, s);
+    }
 
     jpegd_dbg_func("exit\n");
     return ret;
@@ -437,7 +438,8 @@ static MPP_RET hal_jpegd_rkv_gen_regs(void *hal,  HalTaskInfo *syn)
 
     ret = jpegd_gen_regs(ctx, s);
     mpp_buffer_sync_end(strm_buf);
-    mpp_buffer_sync_end(ctx->pTableBase);
+    if (ctx->tbl_dirty)
+        mpp_buffer_sync_end(ctx->pTableBase);
 
     if (ret != MPP_OK) {
         mpp_err_f("generate registers failed\n");
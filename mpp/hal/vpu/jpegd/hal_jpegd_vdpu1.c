@@ -695,7 +695,8 @@ static MPP_RET jpegd_gen_regs(JpegdHalCtx *ctx, JpegdSyntax *syntax)
     jpegd_write_code_word_number(ctx, s);
 
     /* Create AC/DC/QP tables for hardware */
-    jpegd_write_qp_ac_dc_table(ctx, s);
+    if (jpegd_tbl_need_update(ctx, s))
+        jpegd_write_qp_ac_dc_table(ctx, s);
 
     /* Select which tables the chromas use */
     jpegd_set_chroma_table_id(ctx, s);
@@ -860,7 +861,8 @@ static MPP_RET hal_jpegd_vdpu1_gen_regs(void *hal,  HalTaskInfo *syn)
 
         ret = jpegd_gen_regs(JpegHalCtx, syntax);
         mpp_buffer_sync_end(streambuf);
-        mpp_buffer_sync_end(JpegHalCtx->pTableBase);
+        if (JpegHalCtx->tbl_dirty)
+            mpp_buffer_sync_end(JpegHalCtx->pTableBase);
         if (ret != MPP_OK) {
             mpp_err_f("generate registers failed\n");
             goto RET;
@@ -7,6 +7,8 @@
 #define MPP_H
 
 #include "mpp_queue.h"
+#include "mpp_stats_impl.h"
+#include "mpp_capacity.h"
 #include "mpp_task_impl.h"
 
 #include "mpp_dec.h"
@@ -158,9 +160,15 @@ typedef struct Mpp {
     RK_U32          mEncAyncProc;
     MppIoMode       mIoMode;
     RK_U32          mDisableThread;
+    /* codec thread placement policy */
+    RK_U32          mThreadPlace;
+    RK_S32          mThreadPrio;
 
     /* dump info for debug */
     MppDump         mDump;
+    /* always-on performance statistics */
+    MppStats        mStats;
+    MppLoad         mLoad;
 
     /* kmpp infos */
     Kmpp            *mKmpp;
@@ -6,6 +6,7 @@
 #ifndef MPP_CFG_H
 #define MPP_CFG_H
 
+#include "rk_mpp_cfg.h"
 #include "mpp_internal.h"
 #include "kmpp_obj_impl.h"
 
@@ -40,6 +41,16 @@ extern "C" {
 MPP_RET check_cfg_entry(KmppEntry *node, const char *name, ElemType type,
                         const char *func);
 
+/* pre-resolved key helper shared by enc / dec / sys cfg */
+#define CHECK_CFG_KEY(def, cfg, key, type) \
+    check_cfg_key(def, cfg, key, type, __FUNCTION__)
+
+MPP_RET mpp_cfg_get_key(KmppObjDef def, const char *name, MppCfgKey *key);
+KmppEntry *check_cfg_key(KmppObjDef def, KmppObj cfg, MppCfgKey key, ElemType type,
+                         const char *func);
+MPP_RET mpp_cfg_set_kv(KmppObjDef def, KmppObj cfg, const MppCfgKeyVal *kv,
+                       RK_S32 count, RK_U32 ro_chk, const char *func);
+
 #ifdef  __cplusplus
 }
 #endif
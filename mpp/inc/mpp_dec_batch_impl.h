@@ -0,0 +1,30 @@
+/* SPDX-License-Identifier: Apache-2.0 OR MIT */
+/*
+ * Copyright (c) 2026 Rockchip Electronics Co., Ltd.
+ */
+
+#ifndef MPP_DEC_BATCH_IMPL_H
+#define MPP_DEC_BATCH_IMPL_H
+
+#include "rk_vdec_batch.h"
+
+/*
+ * Queue functions replacing the mpp decoder, so the queue depth and output
+ * order can be checked without decoder hardware. put queues the packet to
+ * be decoded into frame, get blocks until the oldest queued frame is done.
+ */
+typedef MPP_RET (*MppDecBatchPutFunc)(void *ctx, MppPacket packet, MppFrame frame);
+typedef MPP_RET (*MppDecBatchGetFunc)(void *ctx, MppFrame *frame);
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+MPP_RET mpp_dec_batch_init_with(MppDecBatch *ctx, RK_S32 depth, MppDecBatchPutFunc put,
+                                MppDecBatchGetFunc get, void *func_ctx);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* MPP_DEC_BATCH_IMPL_H */
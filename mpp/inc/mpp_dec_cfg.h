@@ -69,6 +69,17 @@ typedef struct MppDecCbCfg_t {
     MppExtCbFunc        frm_rdy_cb;
     MppExtCbCtx         frm_rdy_ctx;
     RK_S32              frm_rdy_cmd;
+
+    /*
+     * notify rows of frame decoded in decode order before display output
+     * arg is the MppFrame with KEY_DEC_ROWS_READY in its meta
+     * NOTE: no hardware reports row progress yet so it is only called once
+     * per frame with full height after hardware done. Frames with decode
+     * error are not notified.
+     */
+    MppExtCbFunc        frm_part_cb;
+    MppExtCbCtx         frm_part_ctx;
+    RK_S32              frm_part_cmd;
 } MppDecCbCfg;
 
 typedef struct MppDecStatusCfg_t {
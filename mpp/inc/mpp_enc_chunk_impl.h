@@ -0,0 +1,30 @@
+/* SPDX-License-Identifier: Apache-2.0 OR MIT */
+/*
+ * Copyright (c) 2026 Rockchip Electronics Co., Ltd.
+ */
+
+#ifndef MPP_ENC_CHUNK_IMPL_H
+#define MPP_ENC_CHUNK_IMPL_H
+
+#include "rk_venc_chunk.h"
+
+/*
+ * Encode function of session idx replacing the mpp encoder, so the chunk
+ * split and output order can be checked without encoder hardware. It is only
+ * called for frames with buffer and returns the packet of the frame.
+ */
+typedef MPP_RET (*MppEncChunkEncFunc)(void *ctx, RK_S32 idx, MppFrame frame,
+                                      MppPacket *packet);
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+MPP_RET mpp_enc_chunk_init_with(MppEncChunk *ctx, RK_S32 sessions, RK_S32 chunk_frames,
+                                MppEncChunkEncFunc func, void *func_ctx);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* MPP_ENC_CHUNK_IMPL_H */
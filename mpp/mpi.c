@@ -11,6 +11,7 @@
 #include "mpp_mem.h"
 #include "mpp_debug.h"
 #include "mpp_common.h"
+#include "mpp_capacity.h"
 
 #include "mpp_sys.h"
 #include "mpp_info.h"
@@ -510,6 +511,15 @@ MPP_RET mpp_check_support_format(MppCtxType type, MppCodingType coding)
     return ret;
 }
 
+MPP_RET mpp_check_capacity(MppCtxType type, MppCodingType coding, RK_U32 width,
+                           RK_U32 height, RK_U32 fps, RK_S32 *load)
+{
+    if (mpp_check_support_format(type, coding))
+        return MPP_NOK;
+
+    return mpp_load_predict(type, coding, width, height, fps, load) ? MPP_NOK : MPP_OK;
+}
+
 void mpp_show_support_format(void)
 {
     RK_U32 i = 0;
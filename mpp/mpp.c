@@ -12,6 +12,7 @@
 
 #include "mpp_mem.h"
 #include "mpp_env.h"
+#include "mpp_lock.h"
 #include "mpp_time.h"
 #include "mpp_impl.h"
 #include "mpp_2str.h"
@@ -60,6 +61,17 @@ static void *list_wraper_frame(void *arg)
     return NULL;
 }
 
+static void mpp_stats_init(Mpp *mpp)
+{
+    static RK_U32 stats_id = 0;
+    char name[32];
+
+    snprintf(name, sizeof(name) - 1, "mpp_stats_%s_%x_%u",
+             (mpp->mType == MPP_CTX_DEC) ? "dec" : "enc", mpp->mCoding,
+             MPP_ADD_FETCH(&stats_id, 1));
+    mpp_stats_get(&mpp->mStats, name);
+}
+
 static RK_S32 check_frm_task_cnt_cap(MppCodingType coding)
 {
     RockchipSocType soc_type = mpp_get_soc_type();
@@ -137,6 +149,9 @@ MPP_RET mpp_ctx_init(Mpp *mpp, MppCtxType type, MppCodingType coding)
     mpp->mType = type;
     mpp->mCoding = coding;
 
+    mpp_stats_init(mpp);
+    mpp_load_get(&mpp->mLoad, type, coding);
+
     /* init kmpp venc */
     if (mpp->mVencInitKcfg) {
         mpp->mKmpp = mpp_calloc(Kmpp, 1);
@@ -349,6 +364,16 @@ void mpp_clear(Mpp *mpp)
     }
 
     mpp_dump_deinit(&mpp->mDump);
+
+    if (mpp->mStats) {
+        mpp_stats_put(mpp->mStats);
+        mpp->mStats = NULL;
+    }
+
+    if (mpp->mLoad) {
+        mpp_load_put(mpp->mLoad);
+        mpp->mLoad = NULL;
+    }
 }
 
 MPP_RET mpp_ctx_destroy(Mpp *mpp)
@@ -813,6 +838,7 @@ MPP_RET mpp_put_frame(Mpp *mpp, MppFrame frame)
         mpp_task_meta_get_frame(mpp->mInputTask, KEY_INPUT_FRAME, &frm_out);
         mpp_assert(frm_out == frame);
     }
+    mpp_stats_add(mpp->mStats, MPP_STATS_CNT_FRM_IN, 1);
 
 RET:
     mpp_stopwatch_record(stopwatch, "put_frame finish");
@@ -879,6 +905,7 @@ MPP_RET mpp_get_packet(Mpp *mpp, MppPacket *packet)
         }
 
         sys_dbg_pts("%p output packet pts %lld\n", mpp, impl->pts);
+        mpp_stats_add(mpp->mStats, MPP_STATS_CNT_PKT_OUT, 1);
     }
 
     // dump output
@@ -913,6 +940,7 @@ MPP_RET mpp_put_frame_async(Mpp *mpp, MppFrame frame)
 
     mpp_list_add_at_tail(mpp->mFrmIn, &frame, sizeof(frame));
     mpp->mFramePutCount++;
+    mpp_stats_add(mpp->mStats, MPP_STATS_CNT_FRM_IN, 1);
 
     mpp_notify_flag(mpp, MPP_INPUT_ENQUEUE);
     mpp_mutex_cond_unlock(&mpp->mFrmIn->cond_lock);
@@ -960,6 +988,7 @@ MPP_RET mpp_get_packet_async(Mpp *mpp, MppPacket *packet)
 
         mpp_list_del_at_head(mpp->mPktOut, &pkt, sizeof(pkt));
         mpp->mPacketGetCount++;
+        mpp_stats_add(mpp->mStats, MPP_STATS_CNT_PKT_OUT, 1);
         mpp_notify_flag(mpp, MPP_OUTPUT_DEQUEUE);
 
         *packet = pkt;
@@ -1295,6 +1324,43 @@ MPP_RET mpp_control_mpp(Mpp *mpp, MpiCmd cmd, MppParam param)
         }
         mpp->mVencInitKcfg = obj;
     } break;
+    case MPP_GET_STATS: {
+        if (!param || !mpp->mStats) {
+            mpp_err_f("ctrl %d invalid param %p stats %p\n", cmd, param, mpp->mStats);
+            return MPP_ERR_VALUE;
+        }
+        ret = mpp_stats_read(mpp->mStats, (MppStatsInfo *)param) ? MPP_NOK : MPP_OK;
+    } break;
+    case MPP_GET_STATS_FD: {
+        if (!param) {
+            mpp_err_f("ctrl %d invalid param %p\n", cmd, param);
+            return MPP_ERR_VALUE;
+        }
+        *((RK_S32 *)param) = mpp_stats_get_fd(mpp->mStats);
+    } break;
+    case MPP_SET_THREAD_PLACE: {
+        mpp->mThreadPlace = (param) ? *((RK_U32 *)param) : 0;
+    } break;
+    case MPP_SET_THREAD_PRIO: {
+        mpp->mThreadPrio = (param) ? *((RK_S32 *)param) : 0;
+    } break;
+    case MPP_GET_THREAD_CPU_TIME: {
+        MppStatsCpuTime *time = (MppStatsCpuTime *)param;
+        RK_S32 i;
+
+        if (!time) {
+            mpp_err_f("ctrl %d invalid param %p\n", cmd, param);
+            return MPP_ERR_VALUE;
+        }
+
+        for (i = 0; i < MPP_STATS_THREAD_BUTT; i++)
+            time->time[i] = -1;
+
+        if (mpp->mDec)
+            mpp_dec_get_cpu_time(mpp->mDec, time);
+        else if (mpp->mEnc)
+            mpp_enc_get_cpu_time(mpp->mEnc, time);
+    } break;
     case MPP_START : {
         mpp_start(mpp);
     } break;
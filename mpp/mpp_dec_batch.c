@@ -0,0 +1,237 @@
+/* SPDX-License-Identifier: Apache-2.0 OR MIT */
+/*
+ * Copyright (c) 2026 Rockchip Electronics Co., Ltd.
+ */
+
+#define MODULE_TAG "mpp_dec_batch"
+
+#include "mpp_mem.h"
+#include "mpp_env.h"
+#include "mpp_debug.h"
+#include "mpp_common.h"
+
+#include "mpp.h"
+#include "mpi_impl.h"
+#include "mpp_dec_batch_impl.h"
+
+#define DEC_BATCH_DBG_FLOW          (0x00000001)
+
+#define dec_batch_dbg(flag, fmt, ...)   mpp_dbg(dec_batch_debug, flag, fmt, ## __VA_ARGS__)
+
+#define dec_batch_dbg_flow(fmt, ...)    dec_batch_dbg(DEC_BATCH_DBG_FLOW, fmt, ## __VA_ARGS__)
+
+#define DEC_BATCH_DEPTH_DEFAULT     4
+
+typedef struct MppDecBatchImpl_t {
+    MppCtx          ctx;
+    MppApi          *mpi;
+    RK_S32          depth;
+
+    /* queue functions replacing the mpp decoder */
+    MppDecBatchPutFunc put_func;
+    MppDecBatchGetFunc get_func;
+    void            *func_ctx;
+} MppDecBatchImpl;
+
+static RK_U32 dec_batch_debug = 0;
+
+static MPP_RET dec_batch_mpp_init(MppDecBatchImpl *p)
+{
+    MppPollType timeout = MPP_POLL_BLOCK;
+    MPP_RET ret;
+
+    ret = mpp_create(&p->ctx, &p->mpi);
+    if (ret) {
+        mpp_err_f("mpp_create failed ret %d\n", ret);
+        return ret;
+    }
+
+    /*
+     * jpeg decoder has one input task by default. Queue depth images and one
+     * more task is reserved by mpp for the eos packet.
+     */
+    ((MpiImpl *)p->ctx)->ctx->mInputTaskCount = p->depth + 1;
+
+    ret = p->mpi->control(p->ctx, MPP_SET_INPUT_TIMEOUT, &timeout);
+    if (!ret)
+        ret = p->mpi->control(p->ctx, MPP_SET_OUTPUT_TIMEOUT, &timeout);
+    if (ret)
+        return ret;
+
+    ret = mpp_init(p->ctx, MPP_CTX_DEC, MPP_VIDEO_CodingMJPEG);
+    if (ret) {
+        mpp_err_f("mpp_init failed ret %d\n", ret);
+        return ret;
+    }
+
+    return MPP_OK;
+}
+
+static MPP_RET dec_batch_init(MppDecBatch *ctx, RK_S32 depth, MppDecBatchPutFunc put,
+                              MppDecBatchGetFunc get, void *func_ctx)
+{
+    MppDecBatchImpl *p = NULL;
+    MPP_RET ret;
+
+    if (!ctx || depth < 0 || depth > MPP_DEC_BATCH_DEPTH_MAX) {
+        mpp_err_f("invalid input ctx %p depth %d\n", ctx, depth);
+        return MPP_ERR_VALUE;
+    }
+
+    mpp_env_get_u32("dec_batch_debug", &dec_batch_debug, 0);
+
+    *ctx = NULL;
+
+    p = mpp_calloc(MppDecBatchImpl, 1);
+    if (!p) {
+        mpp_err_f("failed to malloc context\n");
+        return MPP_ERR_MALLOC;
+    }
+
+    p->depth = depth ? depth : DEC_BATCH_DEPTH_DEFAULT;
+    p->put_func = put;
+    p->get_func = get;
+    p->func_ctx = func_ctx;
+
+    if (!put) {
+        ret = dec_batch_mpp_init(p);
+        if (ret) {
+            mpp_dec_batch_deinit(p);
+            return ret;
+        }
+    }
+
+    dec_batch_dbg_flow("init depth %d\n", p->depth);
+    *ctx = p;
+
+    return MPP_OK;
+}
+
+MPP_RET mpp_dec_batch_init(MppDecBatch *ctx, RK_S32 depth)
+{
+    return dec_batch_init(ctx, depth, NULL, NULL, NULL);
+}
+
+MPP_RET mpp_dec_batch_init_with(MppDecBatch *ctx, RK_S32 depth, MppDecBatchPutFunc put,
+                                MppDecBatchGetFunc get, void *func_ctx)
+{
+    if (!put || !get) {
+        mpp_err_f("invalid queue function put %p get %p\n", put, get);
+        return MPP_ERR_VALUE;
+    }
+
+    return dec_batch_init(ctx, depth, put, get, func_ctx);
+}
+
+MPP_RET mpp_dec_batch_deinit(MppDecBatch ctx)
+{
+    MppDecBatchImpl *p = (MppDecBatchImpl *)ctx;
+
+    if (!p)
+        return MPP_OK;
+
+    if (p->ctx) {
+        mpp_destroy(p->ctx);
+        p->ctx = NULL;
+        p->mpi = NULL;
+    }
+
+    mpp_free(p);
+
+    return MPP_OK;
+}
+
+MPP_RET mpp_dec_batch_control(MppDecBatch ctx, MpiCmd cmd, MppParam param)
+{
+    MppDecBatchImpl *p = (MppDecBatchImpl *)ctx;
+
+    if (!p) {
+        mpp_err_f("invalid NULL input\n");
+        return MPP_ERR_NULL_PTR;
+    }
+
+    if (!p->mpi)
+        return MPP_OK;
+
+    return p->mpi->control(p->ctx, cmd, param);
+}
+
+static MPP_RET dec_batch_put(MppDecBatchImpl *p, MppPacket packet, MppFrame frame)
+{
+    if (p->put_func)
+        return p->put_func(p->func_ctx, packet, frame);
+
+    /* decode into the caller frame, it comes back from get_frame */
+    mpp_meta_set_frame(mpp_packet_get_meta(packet), KEY_OUTPUT_FRAME, frame);
+
+    return p->mpi->decode_put_packet(p->ctx, packet);
+}
+
+static MPP_RET dec_batch_get(MppDecBatchImpl *p, MppFrame *frame)
+{
+    if (p->get_func)
+        return p->get_func(p->func_ctx, frame);
+
+    return p->mpi->decode_get_frame(p->ctx, frame);
+}
+
+MPP_RET mpp_dec_batch_decode(MppDecBatch ctx, MppPacket *packets, MppFrame *frames,
+                             RK_S32 count)
+{
+    MppDecBatchImpl *p = (MppDecBatchImpl *)ctx;
+    MPP_RET ret = MPP_OK;
+    RK_S32 put = 0;
+    RK_S32 done = 0;
+    RK_S32 i;
+
+    if (!p || !packets || !frames || count < 0) {
+        mpp_err_f("invalid input ctx %p packets %p frames %p count %d\n",
+                  p, packets, frames, count);
+        return MPP_ERR_NULL_PTR;
+    }
+
+    for (i = 0; i < count; i++) {
+        if (!packets[i] || !frames[i] || !mpp_packet_get_buffer(packets[i]) ||
+            !mpp_frame_get_buffer(frames[i])) {
+            mpp_err_f("image %d has no packet or frame buffer\n", i);
+            return MPP_ERR_VALUE;
+        }
+    }
+
+    while (done < count) {
+        MppFrame frame = NULL;
+        MPP_RET ret_get;
+
+        /* keep depth images queued to the decoder */
+        while (!ret && put < count && put - done < p->depth) {
+            ret = dec_batch_put(p, packets[put], frames[put]);
+            if (ret) {
+                mpp_err_f("image %d put failed ret %d\n", put, ret);
+                break;
+            }
+            put++;
+        }
+
+        /* put failed and all queued images are done */
+        if (done == put)
+            break;
+
+        ret_get = dec_batch_get(p, &frame);
+        if (ret_get || frame != frames[done]) {
+            /* queued images are lost with the decoder flow */
+            mpp_err_f("image %d get failed ret %d frame %p -> %p\n",
+                      done, ret_get, frames[done], frame);
+            return ret_get ? ret_get : MPP_NOK;
+        }
+
+        dec_batch_dbg_flow("image %d done err %d queued %d\n", done,
+                           mpp_frame_get_errinfo(frame), put - done - 1);
+        done++;
+    }
+
+    /* images not sent to the decoder */
+    for (i = done; i < count; i++)
+        mpp_frame_set_errinfo(frames[i], 1);
+
+    return ret;
+}
@@ -0,0 +1,495 @@
+/* SPDX-License-Identifier: Apache-2.0 OR MIT */
+/*
+ * Copyright (c) 2026 Rockchip Electronics Co., Ltd.
+ */
+
+#define MODULE_TAG "mpp_enc_chunk"
+
+#include <string.h>
+
+#include "mpp_mem.h"
+#include "mpp_env.h"
+#include "mpp_soc.h"
+#include "mpp_list.h"
+#include "mpp_debug.h"
+#include "mpp_common.h"
+#include "mpp_thread.h"
+#include "mpp_frame_impl.h"
+
+#include "rk_venc_cfg.h"
+#include "mpp_enc_chunk_impl.h"
+
+#define ENC_CHUNK_DBG_FLOW          (0x00000001)
+#define ENC_CHUNK_DBG_OUTPUT        (0x00000002)
+
+#define enc_chunk_dbg(flag, fmt, ...) mpp_dbg(enc_chunk_debug, flag, fmt, ## __VA_ARGS__)
+
+#define enc_chunk_dbg_flow(fmt, ...)    enc_chunk_dbg(ENC_CHUNK_DBG_FLOW, fmt, ## __VA_ARGS__)
+#define enc_chunk_dbg_output(fmt, ...)  enc_chunk_dbg(ENC_CHUNK_DBG_OUTPUT, fmt, ## __VA_ARGS__)
+
+typedef struct MppEncChunkImpl_t MppEncChunkImpl;
+
+typedef struct MppEncChunkJob_t {
+    MppFrame        frame;
+    RK_S32          chunk;
+    /* first frame of chunk is encoded as IDR */
+    RK_S32          first;
+    RK_S32          last;
+    RK_S32          eos;
+} MppEncChunkJob;
+
+typedef struct MppEncChunkOut_t {
+    MppPacket       packet;
+    RK_S32          chunk;
+    RK_S32          last;
+    RK_S32          eos;
+} MppEncChunkOut;
+
+typedef struct MppEncChunkSession_t {
+    MppEncChunkImpl *impl;
+    RK_S32          idx;
+
+    MppCtx          ctx;
+    MppApi          *mpi;
+    MppThread       *thd;
+
+    /* MppEncChunkJob protected by thread lock */
+    MppList         *jobs;
+    /* MppEncChunkOut protected by impl cond */
+    MppList         *outs;
+} MppEncChunkSession;
+
+struct MppEncChunkImpl_t {
+    MppCodingType   coding;
+    RK_S32          count;
+    RK_S32          chunk_frames;
+    MppEncChunkSession sessions[MPP_ENC_CHUNK_SESSION_MAX];
+
+    /* encode function replacing the mpp sessions */
+    MppEncChunkEncFunc enc_func;
+    void            *enc_ctx;
+
+    MppMutexCond    cond;
+    /* input frame count and frames queued but not encoded */
+    RK_S32          in_frames;
+    RK_S32          queued;
+    RK_S32          in_eos;
+    /* chunk of next output packet */
+    RK_S32          out_chunk;
+    RK_S32          out_eos;
+};
+
+static RK_U32 enc_chunk_debug = 0;
+
+static RK_S32 enc_chunk_core_num(MppCodingType coding)
+{
+    const MppSocInfo *info = mpp_get_soc_info();
+    RK_S32 index = mpp_coding_to_index(coding);
+    RK_U32 i;
+
+    if (!info || index < 0 || index >= 32)
+        return 1;
+
+    for (i = 0; i < MPP_ARRAY_ELEMS(info->enc_caps); i++) {
+        const MppEncHwCap *cap = info->enc_caps[i];
+
+        if (cap && (cap->cap_coding & (1u << index)))
+            return MPP_MAX(cap->cap_core_num, 1);
+    }
+
+    return 1;
+}
+
+static void enc_chunk_encode(MppEncChunkSession *s, MppEncChunkJob *job)
+{
+    MppEncChunkImpl *p = s->impl;
+    MppEncChunkOut out;
+    MppPacket packet = NULL;
+
+    if (job->first && s->mpi)
+        s->mpi->control(s->ctx, MPP_ENC_SET_IDR_FRAME, NULL);
+
+    if (mpp_frame_get_buffer(job->frame)) {
+        MPP_RET ret;
+
+        if (p->enc_func) {
+            ret = p->enc_func(p->enc_ctx, s->idx, job->frame, &packet);
+        } else {
+            ret = s->mpi->encode_put_frame(s->ctx, job->frame);
+            if (!ret)
+                ret = s->mpi->encode_get_packet(s->ctx, &packet);
+        }
+
+        if (ret)
+            mpp_err_f("session %d chunk %d encode failed ret %d\n", s->idx, job->chunk, ret);
+    }
+
+    /* eos always has a packet for the reader to stop on */
+    if (job->eos) {
+        if (!packet) {
+            mpp_packet_init(&packet, NULL, 0);
+            mpp_packet_set_pts(packet, mpp_frame_get_pts(job->frame));
+        }
+        mpp_packet_set_eos(packet);
+    }
+
+    enc_chunk_dbg_flow("session %d chunk %d pts %lld length %d%s%s\n", s->idx,
+                       job->chunk, mpp_frame_get_pts(job->frame),
+                       packet ? mpp_packet_get_length(packet) : 0,
+                       job->first ? " first" : "", job->last ? " last" : "");
+
+    mpp_frame_deinit(&job->frame);
+
+    out.packet = packet;
+    out.chunk = job->chunk;
+    out.last = job->last;
+    out.eos = job->eos;
+
+    mpp_mutex_cond_lock(&p->cond);
+    mpp_list_add_at_tail(s->outs, &out, sizeof(out));
+    p->queued--;
+    mpp_mutex_cond_broadcast(&p->cond);
+    mpp_mutex_cond_unlock(&p->cond);
+}
+
+static void *enc_chunk_thread(void *arg)
+{
+    MppEncChunkSession *s = (MppEncChunkSession *)arg;
+    MppThread *thd = s->thd;
+    MppEncChunkJob job;
+
+    while (1) {
+        mpp_thread_lock(thd, THREAD_WORK);
+        if (MPP_THREAD_RUNNING != mpp_thread_get_status(thd, THREAD_WORK)) {
+            mpp_thread_unlock(thd, THREAD_WORK);
+            break;
+        }
+
+        if (mpp_list_del_at_head(s->jobs, &job, sizeof(job))) {
+            mpp_thread_wait(thd, THREAD_WORK);
+            mpp_thread_unlock(thd, THREAD_WORK);
+            continue;
+        }
+        mpp_thread_unlock(thd, THREAD_WORK);
+
+        enc_chunk_encode(s, &job);
+    }
+
+    return NULL;
+}
+
+static void enc_chunk_session_deinit(MppEncChunkSession *s)
+{
+    if (s->thd) {
+        mpp_thread_stop(s->thd);
+        mpp_thread_destroy(s->thd);
+        s->thd = NULL;
+    }
+
+    if (s->jobs) {
+        MppEncChunkJob job;
+
+        while (!mpp_list_del_at_head(s->jobs, &job, sizeof(job)))
+            mpp_frame_deinit(&job.frame);
+
+        mpp_list_destroy(s->jobs);
+        s->jobs = NULL;
+    }
+
+    if (s->outs) {
+        MppEncChunkOut out;
+
+        while (!mpp_list_del_at_head(s->outs, &out, sizeof(out)))
+            if (out.packet)
+                mpp_packet_deinit(&out.packet);
+
+        mpp_list_destroy(s->outs);
+        s->outs = NULL;
+    }
+
+    if (s->ctx) {
+        mpp_destroy(s->ctx);
+        s->ctx = NULL;
+        s->mpi = NULL;
+    }
+}
+
+static MPP_RET enc_chunk_session_mpp_init(MppEncChunkSession *s, MppCodingType coding)
+{
+    MppPollType timeout = MPP_POLL_BLOCK;
+    MPP_RET ret;
+
+    ret = mpp_create(&s->ctx, &s->mpi);
+    if (ret) {
+        mpp_err_f("session %d mpp_create failed ret %d\n", s->idx, ret);
+        return ret;
+    }
+
+    ret = s->mpi->control(s->ctx, MPP_SET_OUTPUT_TIMEOUT, &timeout);
+    if (ret)
+        return ret;
+
+    ret = mpp_init(s->ctx, MPP_CTX_ENC, coding);
+    if (ret) {
+        mpp_err_f("session %d mpp_init failed ret %d\n", s->idx, ret);
+        return ret;
+    }
+
+    return MPP_OK;
+}
+
+static MPP_RET enc_chunk_session_init(MppEncChunkSession *s, MppCodingType coding)
+{
+    char name[THREAD_NAME_LEN];
+
+    s->jobs = mpp_list_create(NULL);
+    s->outs = mpp_list_create(NULL);
+    if (!s->jobs || !s->outs)
+        return MPP_ERR_MALLOC;
+
+    if (!s->impl->enc_func) {
+        MPP_RET ret = enc_chunk_session_mpp_init(s, coding);
+
+        if (ret)
+            return ret;
+    }
+
+    snprintf(name, sizeof(name), "mpp_enc_chunk%d", s->idx);
+    s->thd = mpp_thread_create(enc_chunk_thread, s, name);
+    if (!s->thd)
+        return MPP_NOK;
+
+    mpp_thread_start(s->thd);
+
+    return MPP_OK;
+}
+
+static MPP_RET enc_chunk_init(MppEncChunk *ctx, MppCodingType coding,
+                              RK_S32 sessions, RK_S32 chunk_frames,
+                              MppEncChunkEncFunc func, void *func_ctx)
+{
+    MppEncChunkImpl *p = NULL;
+    MPP_RET ret = MPP_OK;
+    RK_S32 i;
+
+    if (!ctx || sessions < 0 || sessions > MPP_ENC_CHUNK_SESSION_MAX || chunk_frames < 2) {
+        mpp_err_f("invalid input ctx %p sessions %d chunk frames %d\n",
+                  ctx, sessions, chunk_frames);
+        return MPP_ERR_VALUE;
+    }
+
+    mpp_env_get_u32("enc_chunk_debug", &enc_chunk_debug, 0);
+
+    *ctx = NULL;
+
+    if (!sessions)
+        sessions = MPP_MIN(enc_chunk_core_num(coding), MPP_ENC_CHUNK_SESSION_MAX);
+
+    p = mpp_calloc(MppEncChunkImpl, 1);
+    if (!p) {
+        mpp_err_f("failed to malloc context\n");
+        return MPP_ERR_MALLOC;
+    }
+
+    p->coding = coding;
+    p->count = sessions;
+    p->chunk_frames = chunk_frames;
+    p->enc_func = func;
+    p->enc_ctx = func_ctx;
+    mpp_mutex_cond_init(&p->cond);
+
+    for (i = 0; i < sessions; i++) {
+        MppEncChunkSession *s = &p->sessions[i];
+
+        s->impl = p;
+        s->idx = i;
+
+        ret = enc_chunk_session_init(s, coding);
+        if (ret)
+            break;
+    }
+
+    if (ret) {
+        mpp_enc_chunk_deinit(p);
+        return ret;
+    }
+
+    enc_chunk_dbg_flow("init coding %d sessions %d chunk frames %d\n",
+                       coding, sessions, chunk_frames);
+    *ctx = p;
+
+    return MPP_OK;
+}
+
+MPP_RET mpp_enc_chunk_init(MppEncChunk *ctx, MppCodingType coding,
+                           RK_S32 sessions, RK_S32 chunk_frames)
+{
+    return enc_chunk_init(ctx, coding, sessions, chunk_frames, NULL, NULL);
+}
+
+MPP_RET mpp_enc_chunk_init_with(MppEncChunk *ctx, RK_S32 sessions, RK_S32 chunk_frames,
+                                MppEncChunkEncFunc func, void *func_ctx)
+{
+    if (!func || !sessions) {
+        mpp_err_f("invalid encode function %p sessions %d\n", func, sessions);
+        return MPP_ERR_VALUE;
+    }
+
+    return enc_chunk_init(ctx, MPP_VIDEO_CodingUnused, sessions, chunk_frames,
+                          func, func_ctx);
+}
+
+MPP_RET mpp_enc_chunk_deinit(MppEncChunk ctx)
+{
+    MppEncChunkImpl *p = (MppEncChunkImpl *)ctx;
+    RK_S32 i;
+
+    if (!p)
+        return MPP_OK;
+
+    for (i = 0; i < p->count; i++)
+        enc_chunk_session_deinit(&p->sessions[i]);
+
+    mpp_mutex_cond_destroy(&p->cond);
+    mpp_free(p);
+
+    return MPP_OK;
+}
+
+MPP_RET mpp_enc_chunk_control(MppEncChunk ctx, MpiCmd cmd, MppParam param)
+{
+    MppEncChunkImpl *p = (MppEncChunkImpl *)ctx;
+    MPP_RET ret = MPP_OK;
+    RK_S32 i;
+
+    if (!p) {
+        mpp_err_f("invalid NULL input\n");
+        return MPP_ERR_NULL_PTR;
+    }
+
+    if (cmd == MPP_ENC_SET_CFG) {
+        RK_S32 gop = 0;
+
+        /* chunk start is a forced IDR, so a gop not dividing chunk leaves a short gop */
+        mpp_enc_cfg_get_s32((MppEncCfg)param, "rc:gop", &gop);
+        if (gop > 0 && p->chunk_frames % gop)
+            mpp_log_f("chunk frames %d is not multiple of gop %d\n", p->chunk_frames, gop);
+    }
+
+    for (i = 0; i < p->count; i++) {
+        MppEncChunkSession *s = &p->sessions[i];
+        MPP_RET ret_tmp;
+
+        if (!s->mpi)
+            continue;
+
+        ret_tmp = s->mpi->control(s->ctx, cmd, param);
+        if (ret_tmp) {
+            mpp_err_f("session %d control %x failed ret %d\n", i, cmd, ret_tmp);
+            ret = ret_tmp;
+        }
+    }
+
+    return ret;
+}
+
+MPP_RET mpp_enc_chunk_put_frame(MppEncChunk ctx, MppFrame frame)
+{
+    MppEncChunkImpl *p = (MppEncChunkImpl *)ctx;
+    MppEncChunkSession *s;
+    MppEncChunkJob job;
+    MppBuffer buffer;
+
+    if (!p || !frame) {
+        mpp_err_f("invalid input ctx %p frame %p\n", p, frame);
+        return MPP_ERR_NULL_PTR;
+    }
+
+    mpp_mutex_cond_lock(&p->cond);
+    if (p->in_eos) {
+        mpp_mutex_cond_unlock(&p->cond);
+        mpp_err_f("put frame after eos\n");
+        return MPP_NOK;
+    }
+
+    /* every session has a full chunk to encode */
+    while (p->queued >= p->count * p->chunk_frames)
+        mpp_mutex_cond_wait(&p->cond);
+
+    job.chunk = p->in_frames / p->chunk_frames;
+    job.first = !(p->in_frames % p->chunk_frames);
+    job.eos = mpp_frame_get_eos(frame);
+    job.last = job.eos || !((p->in_frames + 1) % p->chunk_frames);
+
+    p->in_frames++;
+    p->queued++;
+    p->in_eos = job.eos;
+    mpp_mutex_cond_unlock(&p->cond);
+
+    /* hold the input buffer until the session encodes it */
+    mpp_frame_init(&job.frame);
+    mpp_frame_copy(job.frame, frame);
+    buffer = mpp_frame_get_buffer(frame);
+    if (buffer)
+        mpp_buffer_inc_ref(buffer);
+
+    s = &p->sessions[job.chunk % p->count];
+
+    mpp_thread_lock(s->thd, THREAD_WORK);
+    mpp_list_add_at_tail(s->jobs, &job, sizeof(job));
+    mpp_thread_signal(s->thd, THREAD_WORK);
+    mpp_thread_unlock(s->thd, THREAD_WORK);
+
+    return MPP_OK;
+}
+
+MPP_RET mpp_enc_chunk_get_packet(MppEncChunk ctx, MppPacket *packet, MppPollType timeout)
+{
+    MppEncChunkImpl *p = (MppEncChunkImpl *)ctx;
+    MPP_RET ret = MPP_OK;
+
+    if (!p || !packet) {
+        mpp_err_f("invalid input ctx %p packet %p\n", p, packet);
+        return MPP_ERR_NULL_PTR;
+    }
+
+    *packet = NULL;
+
+    mpp_mutex_cond_lock(&p->cond);
+    while (!p->out_eos) {
+        /* chunks of one session are in order so the head is the current chunk */
+        MppEncChunkSession *s = &p->sessions[p->out_chunk % p->count];
+        MppEncChunkOut out;
+
+        if (!mpp_list_del_at_head(s->outs, &out, sizeof(out))) {
+            mpp_assert(out.chunk == p->out_chunk);
+
+            if (out.last)
+                p->out_chunk++;
+            p->out_eos = out.eos;
+
+            enc_chunk_dbg_output("chunk %d packet %p%s%s\n", out.chunk, out.packet,
+                                 out.last ? " last" : "", out.eos ? " eos" : "");
+
+            /* failed frame has no packet */
+            if (!out.packet)
+                continue;
+
+            *packet = out.packet;
+            break;
+        }
+
+        if (timeout == MPP_POLL_NON_BLOCK)
+            break;
+
+        if (timeout < 0) {
+            mpp_mutex_cond_wait(&p->cond);
+        } else if (mpp_mutex_cond_timedwait(&p->cond, timeout)) {
+            ret = MPP_ERR_TIMEOUT;
+            break;
+        }
+    }
+    mpp_mutex_cond_unlock(&p->cond);
+
+    return ret;
+}
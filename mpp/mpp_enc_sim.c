@@ -0,0 +1,846 @@
+/* SPDX-License-Identifier: Apache-2.0 OR MIT */
+/*
+ * Copyright (c) 2026 Rockchip Electronics Co., Ltd.
+ */
+
+#define MODULE_TAG "mpp_enc_sim"
+
+#include <math.h>
+#include <string.h>
+
+#include "mpp_mem.h"
+#include "mpp_env.h"
+#include "mpp_debug.h"
+#include "mpp_common.h"
+#include "mpp_thread.h"
+
+#include "rk_venc_cfg.h"
+#include "rk_venc_sim.h"
+
+#ifdef HAVE_VPROC_VDPP
+#include "vdpp_api.h"
+#endif
+
+#define ENC_SIM_DBG_FUNC            (0x00000001)
+#define ENC_SIM_DBG_FLOW            (0x00000002)
+#define ENC_SIM_DBG_SCALE           (0x00000004)
+
+#define enc_sim_dbg(flag, fmt, ...) mpp_dbg(enc_sim_debug, flag, fmt, ## __VA_ARGS__)
+#define enc_sim_dbg_f(flag, fmt, ...) mpp_dbg_f(enc_sim_debug, flag, fmt, ## __VA_ARGS__)
+
+#define enc_sim_dbg_func(fmt, ...)  enc_sim_dbg_f(ENC_SIM_DBG_FUNC, fmt, ## __VA_ARGS__)
+#define enc_sim_dbg_flow(fmt, ...)  enc_sim_dbg(ENC_SIM_DBG_FLOW, fmt, ## __VA_ARGS__)
+#define enc_sim_dbg_scale(fmt, ...) enc_sim_dbg(ENC_SIM_DBG_SCALE, fmt, ## __VA_ARGS__)
+
+/* frame level force keys copied to every rung to keep rungs aligned */
+static const MppMetaKey enc_sim_meta_keys[] = {
+    KEY_INPUT_IDR_REQ,
+    KEY_INPUT_PSKIP,
+    KEY_INPUT_PSKIP_NON_REF,
+    KEY_ENC_MARK_LTR,
+    KEY_ENC_USE_LTR,
+};
+
+#define ENC_SIM_META_KEY_CNT        MPP_ARRAY_ELEMS(enc_sim_meta_keys)
+
+/* osd, roi and user data in input coordinates only copied to direct rungs */
+static const MppMetaKey enc_sim_meta_ptr_keys[] = {
+    KEY_OSD_DATA,
+    KEY_OSD_DATA2,
+    KEY_OSD_DATA3,
+    KEY_ROI_DATA,
+    KEY_ROI_DATA2,
+    KEY_JPEG_ROI_DATA,
+    KEY_USER_DATA,
+    KEY_USER_DATAS,
+};
+
+#define ENC_SIM_META_PTR_CNT        MPP_ARRAY_ELEMS(enc_sim_meta_ptr_keys)
+
+typedef struct MppEncSimImpl_t MppEncSimImpl;
+
+typedef struct MppEncSimRungImpl_t {
+    MppEncSimImpl   *sim;
+    RK_S32          idx;
+    MppEncSimRung   cfg;
+
+    MppCtx          ctx;
+    MppApi          *mpi;
+    MppThread       *thd;
+
+    /* output size and stride, scale is needed when it is not the input size */
+    RK_S32          width;
+    RK_S32          height;
+    RK_S32          hor_stride;
+    RK_S32          ver_stride;
+    RK_S32          scale;
+    MppBuffer       buf;
+    /* input size and stride of the scaler setup */
+    RK_S32          src_width;
+    RK_S32          src_height;
+    RK_S32          src_hor_stride;
+    RK_S32          src_ver_stride;
+#ifdef HAVE_VPROC_VDPP
+    VdppComCtx      *vdpp;
+#endif
+
+    /* job of current input frame protected by thread lock */
+    MppFrame        frame;
+    RK_S32          job;
+    MppPacket       packet;
+    MPP_RET         ret;
+} MppEncSimRungImpl;
+
+struct MppEncSimImpl_t {
+    MppCodingType   coding;
+    RK_S32          count;
+    MppEncSimRungImpl rungs[MPP_ENC_SIM_RUNG_MAX];
+
+    /* input info from shared config */
+    RK_S32          width;
+    RK_S32          height;
+    RK_S32          hor_stride;
+    RK_S32          ver_stride;
+    MppFrameFormat  fmt;
+    RK_S32          bps;
+    RK_S32          bps_max;
+    RK_S32          bps_min;
+
+    MppBufferGroup  group;
+
+    /* force keys of current input frame, bit i set when key i is valid */
+    RK_U32          meta_flag;
+    RK_S32          meta_vals[ENC_SIM_META_KEY_CNT];
+    RK_U32          meta_ptr_flag;
+    void            *meta_ptrs[ENC_SIM_META_PTR_CNT];
+
+    /* number of rungs still encoding current frame */
+    MppMutexCond    cond;
+    RK_S32          pending;
+};
+
+static RK_U32 enc_sim_debug = 0;
+
+/* bilinear scale for one plane, pix is 1 for luma and 2 for interleaved chroma */
+static void enc_sim_scale_plane(RK_U8 *dst, RK_S32 dw, RK_S32 dh, RK_S32 ds,
+                                const RK_U8 *src, RK_S32 sw, RK_S32 sh, RK_S32 ss,
+                                RK_S32 pix)
+{
+    RK_S32 step_x = (sw << 16) / dw;
+    RK_S32 step_y = (sh << 16) / dh;
+    RK_S32 x, y, c;
+
+    for (y = 0; y < dh; y++) {
+        /* sample at pixel center */
+        RK_S32 fy = MPP_MAX(y * step_y + (step_y >> 1) - (1 << 15), 0);
+        RK_S32 y0 = MPP_MIN(fy >> 16, sh - 1);
+        RK_S32 y1 = MPP_MIN(y0 + 1, sh - 1);
+        RK_S32 wy = (fy >> 8) & 0xff;
+        const RK_U8 *s0 = src + y0 * ss;
+        const RK_U8 *s1 = src + y1 * ss;
+        RK_U8 *d = dst + y * ds;
+
+        for (x = 0; x < dw; x++) {
+            RK_S32 fx = MPP_MAX(x * step_x + (step_x >> 1) - (1 << 15), 0);
+            RK_S32 x0 = MPP_MIN(fx >> 16, sw - 1);
+            RK_S32 x1 = MPP_MIN(x0 + 1, sw - 1);
+            RK_S32 wx = (fx >> 8) & 0xff;
+
+            for (c = 0; c < pix; c++) {
+                RK_S32 a = s0[x0 * pix + c] * (256 - wx) + s0[x1 * pix + c] * wx;
+                RK_S32 b = s1[x0 * pix + c] * (256 - wx) + s1[x1 * pix + c] * wx;
+
+                d[x * pix + c] = (RK_U8)((a * (256 - wy) + b * wy + (1 << 15)) >> 16);
+            }
+        }
+    }
+}
+
+static MPP_RET enc_sim_scale_cpu(MppEncSimRungImpl *rung, MppFrame src)
+{
+    RK_S32 sw = mpp_frame_get_width(src);
+    RK_S32 sh = mpp_frame_get_height(src);
+    RK_S32 ss = mpp_frame_get_hor_stride(src);
+    RK_S32 sv = mpp_frame_get_ver_stride(src);
+    RK_U8 *sp = (RK_U8 *)mpp_buffer_get_ptr(mpp_frame_get_buffer(src));
+    RK_U8 *dp = (RK_U8 *)mpp_buffer_get_ptr(rung->buf);
+    RK_S32 ds = rung->hor_stride;
+    RK_S32 dv = rung->ver_stride;
+
+    if (!sp || !dp)
+        return MPP_ERR_NULL_PTR;
+
+    enc_sim_scale_plane(dp, rung->width, rung->height, ds, sp, sw, sh, ss, 1);
+    enc_sim_scale_plane(dp + ds * dv, rung->width / 2, rung->height / 2, ds,
+                        sp + ss * sv, sw / 2, sh / 2, ss, 2);
+
+    mpp_buffer_sync_end(rung->buf);
+
+    return MPP_OK;
+}
+
+#ifdef HAVE_VPROC_VDPP
+static void enc_sim_vdpp_deinit(MppEncSimRungImpl *rung)
+{
+    if (rung->vdpp) {
+        rung->vdpp->ops->deinit(rung->vdpp->priv);
+        rockchip_vdpp_api_release_ctx(rung->vdpp);
+        rung->vdpp = NULL;
+    }
+}
+
+/* only vdpp2 and later take source stride and format for zme scaling */
+static void enc_sim_vdpp_init(MppEncSimRungImpl *rung)
+{
+    MppEncSimImpl *sim = rung->sim;
+    VdppComCtx *vdpp = NULL;
+    VdppApiParams params;
+
+    enc_sim_vdpp_deinit(rung);
+
+    if (sim->fmt != MPP_FMT_YUV420SP)
+        return;
+
+    vdpp = rockchip_vdpp_api_alloc_ctx();
+    if (!vdpp)
+        return;
+
+    if (vdpp->ver < 0x200 || vdpp->ops->init(vdpp->priv)) {
+        rockchip_vdpp_api_release_ctx(vdpp);
+        return;
+    }
+
+    memset(&params, 0, sizeof(params));
+    params.ptype = VDPP_PARAM_TYPE_COM2;
+    params.param.com2.sfmt = sim->fmt;
+    params.param.com2.src_width = sim->width;
+    params.param.com2.src_height = sim->height;
+    params.param.com2.src_width_vir = sim->hor_stride;
+    params.param.com2.src_height_vir = sim->ver_stride;
+    params.param.com2.dfmt = VDPP_FMT_YUV420;
+    params.param.com2.dst_width = rung->width;
+    params.param.com2.dst_height = rung->height;
+    params.param.com2.dst_width_vir = rung->hor_stride;
+    params.param.com2.dst_height_vir = rung->ver_stride;
+    vdpp->ops->control(vdpp->priv, VDPP_CMD_SET_COM2_CFG, &params);
+
+    /* scale only, enhancement is disabled after com2 config */
+    memset(&params, 0, sizeof(params));
+    params.ptype = VDPP_PARAM_TYPE_DMSR;
+    params.param.dmsr.enable = 0;
+    vdpp->ops->control(vdpp->priv, VDPP_CMD_SET_DMSR_CFG, &params);
+
+    memset(&params, 0, sizeof(params));
+    params.ptype = VDPP_PARAM_TYPE_ES;
+    params.param.es.es_bEnabledES = 0;
+    vdpp->ops->control(vdpp->priv, VDPP_CMD_SET_ES, &params);
+
+    memset(&params, 0, sizeof(params));
+    params.ptype = VDPP_PARAM_TYPE_SHARP;
+    params.param.sharp.sharp_enable = 0;
+    params.param.sharp.sharp_coloradj_bypass_en = 1;
+    vdpp->ops->control(vdpp->priv, VDPP_CMD_SET_SHARP, &params);
+
+    if (!(vdpp->ops->check_cap(vdpp->priv) & VDPP_CAP_VEP)) {
+        vdpp->ops->deinit(vdpp->priv);
+        rockchip_vdpp_api_release_ctx(vdpp);
+        return;
+    }
+
+    enc_sim_dbg_scale("rung %d scale by vdpp %x\n", rung->idx, vdpp->ver);
+    rung->vdpp = vdpp;
+}
+
+static MPP_RET enc_sim_scale_vdpp(MppEncSimRungImpl *rung, MppFrame src)
+{
+    VdppComCtx *vdpp = rung->vdpp;
+    MppBuffer src_buf = mpp_frame_get_buffer(src);
+    VdppImg img;
+
+    memset(&img, 0, sizeof(img));
+    img.mem_addr = mpp_buffer_get_fd(src_buf);
+    img.uv_addr = img.mem_addr;
+    img.uv_off = mpp_frame_get_hor_stride(src) * mpp_frame_get_ver_stride(src);
+    vdpp->ops->control(vdpp->priv, VDPP_CMD_SET_SRC, &img);
+
+    memset(&img, 0, sizeof(img));
+    img.mem_addr = mpp_buffer_get_fd(rung->buf);
+    img.uv_addr = img.mem_addr;
+    img.uv_off = rung->hor_stride * rung->ver_stride;
+    vdpp->ops->control(vdpp->priv, VDPP_CMD_SET_DST, &img);
+
+    return vdpp->ops->control(vdpp->priv, VDPP_CMD_RUN_SYNC, NULL);
+}
+#endif
+
+static MPP_RET enc_sim_scale(MppEncSimRungImpl *rung, MppFrame src)
+{
+    MppEncSimImpl *sim = rung->sim;
+
+    if (mpp_frame_get_fmt(src) != MPP_FMT_YUV420SP) {
+        mpp_err_f("rung %d scale only supports nv12 input\n", rung->idx);
+        return MPP_NOK;
+    }
+
+#ifdef HAVE_VPROC_VDPP
+    /* vdpp is configured with the size in config */
+    if (rung->vdpp && mpp_frame_get_width(src) == sim->width &&
+        mpp_frame_get_height(src) == sim->height &&
+        mpp_frame_get_hor_stride(src) == sim->hor_stride &&
+        mpp_frame_get_ver_stride(src) == sim->ver_stride &&
+        !enc_sim_scale_vdpp(rung, src))
+        return MPP_OK;
+#endif
+    (void)sim;
+
+    return enc_sim_scale_cpu(rung, src);
+}
+
+/*
+ * Every rung encodes its own frame with the saved force keys. Scaled rungs
+ * wrap the scaled buffer, direct rungs wrap a buffer reference of the input.
+ */
+static MppFrame enc_sim_rung_frame(MppEncSimRungImpl *rung, MppFrame src)
+{
+    MppEncSimImpl *sim = rung->sim;
+    MppBuffer buf = mpp_frame_get_buffer(src);
+    MppFrame frame = NULL;
+    MppMeta meta;
+    RK_U32 i;
+
+    /* eos frame without buffer is passed without scaling */
+    if (rung->scale && buf && enc_sim_scale(rung, src))
+        return NULL;
+
+    mpp_frame_init(&frame);
+    if (!frame)
+        return NULL;
+
+    if (rung->scale && buf) {
+        mpp_frame_set_width(frame, rung->width);
+        mpp_frame_set_height(frame, rung->height);
+        mpp_frame_set_hor_stride(frame, rung->hor_stride);
+        mpp_frame_set_ver_stride(frame, rung->ver_stride);
+        mpp_frame_set_fmt(frame, MPP_FMT_YUV420SP);
+        mpp_frame_set_buffer(frame, rung->buf);
+    } else {
+        mpp_frame_set_width(frame, mpp_frame_get_width(src));
+        mpp_frame_set_height(frame, mpp_frame_get_height(src));
+        mpp_frame_set_hor_stride(frame, mpp_frame_get_hor_stride(src));
+        mpp_frame_set_ver_stride(frame, mpp_frame_get_ver_stride(src));
+        mpp_frame_set_offset_x(frame, mpp_frame_get_offset_x(src));
+        mpp_frame_set_offset_y(frame, mpp_frame_get_offset_y(src));
+        mpp_frame_set_fmt(frame, mpp_frame_get_fmt(src));
+        mpp_frame_set_buffer(frame, buf);
+
+        if (sim->meta_ptr_flag) {
+            meta = mpp_frame_get_meta(frame);
+            for (i = 0; i < ENC_SIM_META_PTR_CNT; i++) {
+                if (sim->meta_ptr_flag & (1 << i))
+                    mpp_meta_set_ptr(meta, enc_sim_meta_ptr_keys[i], sim->meta_ptrs[i]);
+            }
+        }
+    }
+
+    mpp_frame_set_pts(frame, mpp_frame_get_pts(src));
+    mpp_frame_set_dts(frame, mpp_frame_get_dts(src));
+    mpp_frame_set_eos(frame, mpp_frame_get_eos(src));
+
+    if (!sim->meta_flag)
+        return frame;
+
+    meta = mpp_frame_get_meta(frame);
+    for (i = 0; i < ENC_SIM_META_KEY_CNT; i++) {
+        if (sim->meta_flag & (1 << i))
+            mpp_meta_set_s32(meta, enc_sim_meta_keys[i], sim->meta_vals[i]);
+    }
+
+    return frame;
+}
+
+static void enc_sim_rung_encode(MppEncSimRungImpl *rung)
+{
+    MppFrame src = rung->frame;
+    MppFrame frame;
+    MppPacket packet = NULL;
+    MPP_RET ret = MPP_NOK;
+
+    /* each rung prepares its frame in its own thread */
+    frame = enc_sim_rung_frame(rung, src);
+    if (!frame)
+        mpp_err_f("rung %d failed to prepare frame\n", rung->idx);
+
+    if (frame) {
+        ret = rung->mpi->encode_put_frame(rung->ctx, frame);
+        if (!ret)
+            ret = rung->mpi->encode_get_packet(rung->ctx, &packet);
+
+        if (ret)
+            mpp_err_f("rung %d encode failed ret %d\n", rung->idx, ret);
+    }
+
+    enc_sim_dbg_flow("rung %d encoded pts %lld length %d\n", rung->idx,
+                     mpp_frame_get_pts(src), packet ? mpp_packet_get_length(packet) : 0);
+
+    if (frame)
+        mpp_frame_deinit(&frame);
+
+    if (rung->packet)
+        mpp_packet_deinit(&rung->packet);
+
+    rung->packet = packet;
+    rung->ret = ret;
+}
+
+static void *enc_sim_rung_thread(void *arg)
+{
+    MppEncSimRungImpl *rung = (MppEncSimRungImpl *)arg;
+    MppEncSimImpl *sim = rung->sim;
+    MppThread *thd = rung->thd;
+
+    while (1) {
+        mpp_thread_lock(thd, THREAD_WORK);
+        if (MPP_THREAD_RUNNING != mpp_thread_get_status(thd, THREAD_WORK)) {
+            mpp_thread_unlock(thd, THREAD_WORK);
+            break;
+        }
+
+        if (!rung->job) {
+            mpp_thread_wait(thd, THREAD_WORK);
+            mpp_thread_unlock(thd, THREAD_WORK);
+            continue;
+        }
+        mpp_thread_unlock(thd, THREAD_WORK);
+
+        enc_sim_rung_encode(rung);
+
+        mpp_thread_lock(thd, THREAD_WORK);
+        rung->job = 0;
+        mpp_thread_unlock(thd, THREAD_WORK);
+
+        mpp_mutex_cond_lock(&sim->cond);
+        sim->pending--;
+        mpp_mutex_cond_signal(&sim->cond);
+        mpp_mutex_cond_unlock(&sim->cond);
+    }
+
+    return NULL;
+}
+
+static void enc_sim_rung_deinit(MppEncSimRungImpl *rung)
+{
+    if (rung->thd) {
+        mpp_thread_stop(rung->thd);
+        mpp_thread_destroy(rung->thd);
+        rung->thd = NULL;
+    }
+
+#ifdef HAVE_VPROC_VDPP
+    enc_sim_vdpp_deinit(rung);
+#endif
+
+    if (rung->packet)
+        mpp_packet_deinit(&rung->packet);
+
+    if (rung->buf) {
+        mpp_buffer_put(rung->buf);
+        rung->buf = NULL;
+    }
+
+    if (rung->ctx) {
+        mpp_destroy(rung->ctx);
+        rung->ctx = NULL;
+        rung->mpi = NULL;
+    }
+}
+
+static MPP_RET enc_sim_rung_init(MppEncSimRungImpl *rung, MppCodingType coding)
+{
+    MppPollType timeout = MPP_POLL_BLOCK;
+    char name[THREAD_NAME_LEN];
+    MPP_RET ret;
+
+    ret = mpp_create(&rung->ctx, &rung->mpi);
+    if (ret) {
+        mpp_err_f("rung %d mpp_create failed ret %d\n", rung->idx, ret);
+        return ret;
+    }
+
+    /* packet is taken right after the frame is encoded */
+    ret = rung->mpi->control(rung->ctx, MPP_SET_OUTPUT_TIMEOUT, &timeout);
+    if (ret)
+        return ret;
+
+    ret = mpp_init(rung->ctx, MPP_CTX_ENC, coding);
+    if (ret) {
+        mpp_err_f("rung %d mpp_init failed ret %d\n", rung->idx, ret);
+        return ret;
+    }
+
+    snprintf(name, sizeof(name), "mpp_enc_sim%d", rung->idx);
+    rung->thd = mpp_thread_create(enc_sim_rung_thread, rung, name);
+    if (!rung->thd)
+        return MPP_NOK;
+
+    mpp_thread_start(rung->thd);
+
+    return MPP_OK;
+}
+
+MPP_RET mpp_enc_sim_init(MppEncSim *sim, MppCodingType coding,
+                         const MppEncSimRung *rungs, RK_S32 count)
+{
+    MppEncSimImpl *p = NULL;
+    MPP_RET ret = MPP_NOK;
+    RK_S32 i;
+
+    if (!sim || !rungs || count <= 0 || count > MPP_ENC_SIM_RUNG_MAX) {
+        mpp_err_f("invalid input sim %p rungs %p count %d\n", sim, rungs, count);
+        return MPP_ERR_VALUE;
+    }
+
+    mpp_env_get_u32("enc_sim_debug", &enc_sim_debug, 0);
+
+    *sim = NULL;
+
+    p = mpp_calloc(MppEncSimImpl, 1);
+    if (!p) {
+        mpp_err_f("failed to malloc context\n");
+        return MPP_ERR_MALLOC;
+    }
+
+    p->coding = coding;
+    p->count = count;
+    mpp_mutex_cond_init(&p->cond);
+
+    for (i = 0; i < count; i++) {
+        MppEncSimRungImpl *rung = &p->rungs[i];
+
+        rung->sim = p;
+        rung->idx = i;
+        rung->cfg = rungs[i];
+
+        if (rung->cfg.width < 0 || rung->cfg.height < 0 ||
+            (!rung->cfg.width != !rung->cfg.height)) {
+            mpp_err_f("rung %d invalid size %dx%d\n", i, rung->cfg.width, rung->cfg.height);
+            ret = MPP_ERR_VALUE;
+            goto DONE;
+        }
+
+        ret = enc_sim_rung_init(rung, coding);
+        if (ret)
+            goto DONE;
+    }
+
+    ret = mpp_buffer_group_get_internal(&p->group, MPP_BUFFER_TYPE_ION);
+    if (ret) {
+        mpp_err_f("failed to get buffer group ret %d\n", ret);
+        goto DONE;
+    }
+
+    enc_sim_dbg_flow("init coding %d rungs %d\n", coding, count);
+    *sim = p;
+
+DONE:
+    if (ret)
+        mpp_enc_sim_deinit(p);
+
+    return ret;
+}
+
+MPP_RET mpp_enc_sim_deinit(MppEncSim sim)
+{
+    MppEncSimImpl *p = (MppEncSimImpl *)sim;
+    RK_S32 i;
+
+    if (!p)
+        return MPP_OK;
+
+    for (i = 0; i < p->count; i++)
+        enc_sim_rung_deinit(&p->rungs[i]);
+
+    if (p->group) {
+        mpp_buffer_group_put(p->group);
+        p->group = NULL;
+    }
+
+    mpp_mutex_cond_destroy(&p->cond);
+    mpp_free(p);
+
+    return MPP_OK;
+}
+
+static MPP_RET enc_sim_rung_buf(MppEncSimRungImpl *rung, RK_S32 width, RK_S32 height)
+{
+    MppEncSimImpl *sim = rung->sim;
+    size_t size;
+
+    /* size and stride are replaced by the input ones when scale is off */
+    if (rung->buf && width == rung->width && height == rung->height &&
+        rung->hor_stride == MPP_ALIGN(width, 16) &&
+        rung->ver_stride == MPP_ALIGN(height, 16))
+        return MPP_OK;
+
+    rung->width = width;
+    rung->height = height;
+    rung->hor_stride = MPP_ALIGN(width, 16);
+    rung->ver_stride = MPP_ALIGN(height, 16);
+
+    if (rung->buf) {
+        mpp_buffer_put(rung->buf);
+        rung->buf = NULL;
+    }
+
+    size = rung->hor_stride * rung->ver_stride * 3 / 2;
+    mpp_buffer_get(sim->group, &rung->buf, size);
+    if (!rung->buf) {
+        mpp_err_f("rung %d failed to get buffer size %d\n", rung->idx, size);
+        return MPP_ERR_MALLOC;
+    }
+
+    return MPP_OK;
+}
+
+/* setup rung size, scale buffer and scaler from the input size in config */
+static MPP_RET enc_sim_rung_setup(MppEncSimRungImpl *rung)
+{
+    MppEncSimImpl *sim = rung->sim;
+    RK_S32 width = rung->cfg.width ? rung->cfg.width : sim->width;
+    RK_S32 height = rung->cfg.height ? rung->cfg.height : sim->height;
+    MPP_RET ret;
+
+    if (width > sim->width || height > sim->height) {
+        mpp_err_f("rung %d size %dx%d larger than input %dx%d\n",
+                  rung->idx, width, height, sim->width, sim->height);
+        return MPP_ERR_VALUE;
+    }
+
+    rung->scale = width != sim->width || height != sim->height;
+    if (!rung->scale) {
+        rung->width = width;
+        rung->height = height;
+        rung->hor_stride = sim->hor_stride;
+        rung->ver_stride = sim->ver_stride;
+        return MPP_OK;
+    }
+
+    /* scaled frame is nv12 with even size */
+    width = MPP_ALIGN(width, 2);
+    height = MPP_ALIGN(height, 2);
+
+    if (rung->buf && width == rung->width && height == rung->height &&
+        sim->width == rung->src_width && sim->height == rung->src_height &&
+        sim->hor_stride == rung->src_hor_stride &&
+        sim->ver_stride == rung->src_ver_stride)
+        return MPP_OK;
+
+    ret = enc_sim_rung_buf(rung, width, height);
+    if (ret)
+        return ret;
+
+    /* scaler is configured with both input and output size and stride */
+    rung->src_width = sim->width;
+    rung->src_height = sim->height;
+    rung->src_hor_stride = sim->hor_stride;
+    rung->src_ver_stride = sim->ver_stride;
+
+#ifdef HAVE_VPROC_VDPP
+    enc_sim_vdpp_init(rung);
+#endif
+
+    enc_sim_dbg_flow("rung %d scale %dx%d -> %dx%d\n", rung->idx,
+                     sim->width, sim->height, width, height);
+
+    return MPP_OK;
+}
+
+/* bitrate of video grows slower than pixel count */
+static RK_S32 enc_sim_rung_bps(MppEncSimRungImpl *rung, RK_S32 bps)
+{
+    MppEncSimImpl *sim = rung->sim;
+    double ratio;
+
+    if (!rung->scale || bps <= 0)
+        return bps;
+
+    ratio = (double)rung->width * rung->height / (sim->width * sim->height);
+
+    return (RK_S32)(bps * pow(ratio, 0.75));
+}
+
+static MPP_RET enc_sim_set_cfg(MppEncSimImpl *p, MppEncCfg cfg)
+{
+    RK_S32 fmt = 0;
+    MPP_RET ret = MPP_OK;
+    RK_S32 i;
+
+    mpp_enc_cfg_get_s32(cfg, "prep:width", &p->width);
+    mpp_enc_cfg_get_s32(cfg, "prep:height", &p->height);
+    mpp_enc_cfg_get_s32(cfg, "prep:hor_stride", &p->hor_stride);
+    mpp_enc_cfg_get_s32(cfg, "prep:ver_stride", &p->ver_stride);
+    mpp_enc_cfg_get_s32(cfg, "prep:format", &fmt);
+    mpp_enc_cfg_get_s32(cfg, "rc:bps_target", &p->bps);
+    mpp_enc_cfg_get_s32(cfg, "rc:bps_max", &p->bps_max);
+    mpp_enc_cfg_get_s32(cfg, "rc:bps_min", &p->bps_min);
+    p->fmt = (MppFrameFormat)fmt;
+
+    if (p->width <= 0 || p->height <= 0) {
+        mpp_err_f("invalid input size %dx%d\n", p->width, p->height);
+        return MPP_ERR_VALUE;
+    }
+
+    for (i = 0; i < p->count; i++) {
+        MppEncSimRungImpl *rung = &p->rungs[i];
+        RK_S32 bps;
+        MPP_RET ret_tmp;
+
+        ret_tmp = enc_sim_rung_setup(rung);
+        if (ret_tmp) {
+            ret = ret_tmp;
+            continue;
+        }
+
+        bps = rung->cfg.bps_target ? rung->cfg.bps_target : enc_sim_rung_bps(rung, p->bps);
+
+        /* replace size and bitrate of the shared config for this rung */
+        if (rung->scale) {
+            mpp_enc_cfg_set_s32(cfg, "prep:width", rung->width);
+            mpp_enc_cfg_set_s32(cfg, "prep:height", rung->height);
+            mpp_enc_cfg_set_s32(cfg, "prep:hor_stride", rung->hor_stride);
+            mpp_enc_cfg_set_s32(cfg, "prep:ver_stride", rung->ver_stride);
+            mpp_enc_cfg_set_s32(cfg, "prep:format", MPP_FMT_YUV420SP);
+        }
+
+        if (p->bps > 0) {
+            mpp_enc_cfg_set_s32(cfg, "rc:bps_target", bps);
+            mpp_enc_cfg_set_s32(cfg, "rc:bps_max", (RK_S32)((RK_S64)p->bps_max * bps / p->bps));
+            mpp_enc_cfg_set_s32(cfg, "rc:bps_min", (RK_S32)((RK_S64)p->bps_min * bps / p->bps));
+        }
+
+        ret_tmp = rung->mpi->control(rung->ctx, MPP_ENC_SET_CFG, cfg);
+        if (ret_tmp) {
+            mpp_err_f("rung %d set cfg failed ret %d\n", i, ret_tmp);
+            ret = ret_tmp;
+        }
+
+        enc_sim_dbg_flow("rung %d cfg %dx%d bps %d\n", i, rung->width, rung->height, bps);
+    }
+
+    /* restore user config */
+    mpp_enc_cfg_set_s32(cfg, "prep:width", p->width);
+    mpp_enc_cfg_set_s32(cfg, "prep:height", p->height);
+    mpp_enc_cfg_set_s32(cfg, "prep:hor_stride", p->hor_stride);
+    mpp_enc_cfg_set_s32(cfg, "prep:ver_stride", p->ver_stride);
+    mpp_enc_cfg_set_s32(cfg, "prep:format", fmt);
+    mpp_enc_cfg_set_s32(cfg, "rc:bps_target", p->bps);
+    mpp_enc_cfg_set_s32(cfg, "rc:bps_max", p->bps_max);
+    mpp_enc_cfg_set_s32(cfg, "rc:bps_min", p->bps_min);
+
+    return ret;
+}
+
+MPP_RET mpp_enc_sim_control(MppEncSim sim, MpiCmd cmd, MppParam param)
+{
+    MppEncSimImpl *p = (MppEncSimImpl *)sim;
+    MPP_RET ret = MPP_OK;
+    RK_S32 i;
+
+    if (!p) {
+        mpp_err_f("invalid NULL input\n");
+        return MPP_ERR_NULL_PTR;
+    }
+
+    if (cmd == MPP_ENC_SET_CFG)
+        return enc_sim_set_cfg(p, (MppEncCfg)param);
+
+    for (i = 0; i < p->count; i++) {
+        MppEncSimRungImpl *rung = &p->rungs[i];
+        MPP_RET ret_tmp = rung->mpi->control(rung->ctx, cmd, param);
+
+        if (ret_tmp) {
+            mpp_err_f("rung %d control %x failed ret %d\n", i, cmd, ret_tmp);
+            ret = ret_tmp;
+        }
+    }
+
+    return ret;
+}
+
+MPP_RET mpp_enc_sim_encode(MppEncSim sim, MppFrame frame)
+{
+    MppEncSimImpl *p = (MppEncSimImpl *)sim;
+    MPP_RET ret = MPP_OK;
+    RK_S32 i;
+
+    if (!p || !frame) {
+        mpp_err_f("invalid input sim %p frame %p\n", p, frame);
+        return MPP_ERR_NULL_PTR;
+    }
+
+    if (!p->width) {
+        mpp_err_f("MPP_ENC_SET_CFG is required before encoding\n");
+        return MPP_ERR_INIT;
+    }
+
+    /* get is consumed so read the force keys once and set them on every rung */
+    p->meta_flag = 0;
+    p->meta_ptr_flag = 0;
+    if (mpp_frame_has_meta(frame)) {
+        MppMeta meta = mpp_frame_get_meta(frame);
+        RK_U32 k;
+
+        for (k = 0; k < ENC_SIM_META_KEY_CNT; k++) {
+            if (!mpp_meta_get_s32(meta, enc_sim_meta_keys[k], &p->meta_vals[k]))
+                p->meta_flag |= 1 << k;
+        }
+
+        for (k = 0; k < ENC_SIM_META_PTR_CNT; k++) {
+            if (!mpp_meta_get_ptr(meta, enc_sim_meta_ptr_keys[k], &p->meta_ptrs[k]))
+                p->meta_ptr_flag |= 1 << k;
+        }
+    }
+
+    /* submit all rungs together so the hardware jobs are queued back to back */
+    mpp_mutex_cond_lock(&p->cond);
+    for (i = 0; i < p->count; i++) {
+        MppEncSimRungImpl *rung = &p->rungs[i];
+
+        p->pending++;
+        mpp_thread_lock(rung->thd, THREAD_WORK);
+        rung->frame = frame;
+        rung->job = 1;
+        mpp_thread_signal(rung->thd, THREAD_WORK);
+        mpp_thread_unlock(rung->thd, THREAD_WORK);
+    }
+
+    while (p->pending)
+        mpp_mutex_cond_wait(&p->cond);
+    mpp_mutex_cond_unlock(&p->cond);
+
+    for (i = 0; i < p->count; i++) {
+        MppEncSimRungImpl *rung = &p->rungs[i];
+
+        if (rung->ret)
+            ret = rung->ret;
+
+        rung->frame = NULL;
+        rung->ret = MPP_OK;
+    }
+
+    return ret;
+}
+
+MPP_RET mpp_enc_sim_get_packet(MppEncSim sim, RK_S32 idx, MppPacket *packet)
+{
+    MppEncSimImpl *p = (MppEncSimImpl *)sim;
+
+    if (!p || !packet || idx < 0 || idx >= p->count) {
+        mpp_err_f("invalid input sim %p idx %d packet %p\n", p, idx, packet);
+        return MPP_ERR_VALUE;
+    }
+
+    *packet = p->rungs[idx].packet;
+    p->rungs[idx].packet = NULL;
+
+    return MPP_OK;
+}
@@ -0,0 +1,196 @@
+/* SPDX-License-Identifier: Apache-2.0 OR MIT */
+/*
+ * Copyright (c) 2026 Rockchip Electronics Co., Ltd.
+ */
+
+#define MODULE_TAG "mpp_dec_batch_test"
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "mpp_log.h"
+#include "mpp_common.h"
+#include "mpp_buffer.h"
+
+#include "mpp_dec_batch_impl.h"
+
+#define TEST_BUF_SIZE       64
+#define TEST_IMAGES         37
+#define TEST_DEPTH          4
+/* image put fails in the put failure case */
+#define TEST_FAIL_IDX       21
+
+#define TEST_CHECK(cond) \
+    do { \
+        if (!(cond)) { \
+            mpp_err("check %s failed at line %d\n", #cond, __LINE__); \
+            return MPP_NOK; \
+        } \
+    } while (0)
+
+/* fake decoder keeps the queued frames in order */
+typedef struct TestQueue_t {
+    MppFrame        frames[TEST_IMAGES];
+    RK_S32          head;
+    RK_S32          tail;
+    RK_S32          max_queued;
+    RK_S32          fail_idx;
+} TestQueue;
+
+static MppBufferGroup grp = NULL;
+static MppBuffer buf = NULL;
+
+static MPP_RET test_put(void *ctx, MppPacket packet, MppFrame frame)
+{
+    TestQueue *q = (TestQueue *)ctx;
+
+    (void)packet;
+
+    if (q->tail == q->fail_idx)
+        return MPP_NOK;
+
+    q->frames[q->tail++] = frame;
+    q->max_queued = MPP_MAX(q->max_queued, q->tail - q->head);
+
+    return MPP_OK;
+}
+
+static MPP_RET test_get(void *ctx, MppFrame *frame)
+{
+    TestQueue *q = (TestQueue *)ctx;
+
+    if (q->head == q->tail) {
+        *frame = NULL;
+        return MPP_NOK;
+    }
+
+    *frame = q->frames[q->head++];
+
+    return MPP_OK;
+}
+
+static MPP_RET test_run(RK_S32 fail_idx)
+{
+    MppPacket packets[TEST_IMAGES];
+    MppFrame frames[TEST_IMAGES];
+    MppDecBatch batch = NULL;
+    TestQueue q;
+    MPP_RET ret;
+    RK_S32 i;
+
+    mpp_log("case fail image %d\n", fail_idx);
+
+    memset(&q, 0, sizeof(q));
+    q.fail_idx = fail_idx;
+
+    for (i = 0; i < TEST_IMAGES; i++) {
+        mpp_packet_init_with_buffer(&packets[i], buf);
+        mpp_frame_init(&frames[i]);
+        mpp_frame_set_buffer(frames[i], buf);
+    }
+
+    TEST_CHECK(!mpp_dec_batch_init_with(&batch, TEST_DEPTH, test_put, test_get, &q));
+
+    ret = mpp_dec_batch_decode(batch, packets, frames, TEST_IMAGES);
+
+    mpp_dec_batch_deinit(batch);
+
+    TEST_CHECK(q.max_queued == TEST_DEPTH);
+    TEST_CHECK(q.head == q.tail);
+
+    if (fail_idx < 0) {
+        TEST_CHECK(!ret);
+        TEST_CHECK(q.tail == TEST_IMAGES);
+    } else {
+        TEST_CHECK(ret);
+        TEST_CHECK(q.tail == fail_idx);
+    }
+
+    /* only the images not sent have error */
+    for (i = 0; i < TEST_IMAGES; i++)
+        TEST_CHECK(!mpp_frame_get_errinfo(frames[i]) == (i < q.tail));
+
+    for (i = 0; i < TEST_IMAGES; i++) {
+        mpp_packet_deinit(&packets[i]);
+        mpp_frame_deinit(&frames[i]);
+    }
+
+    return MPP_OK;
+}
+
+static MPP_RET test_no_buffer(void)
+{
+    MppPacket packet = NULL;
+    MppFrame frame = NULL;
+    MppDecBatch batch = NULL;
+    TestQueue q;
+    MPP_RET ret;
+
+    memset(&q, 0, sizeof(q));
+    q.fail_idx = -1;
+
+    mpp_packet_init_with_buffer(&packet, buf);
+    mpp_frame_init(&frame);
+
+    TEST_CHECK(!mpp_dec_batch_init_with(&batch, 0, test_put, test_get, &q));
+
+    /* frame without buffer is rejected before any put */
+    ret = mpp_dec_batch_decode(batch, &packet, &frame, 1);
+
+    mpp_dec_batch_deinit(batch);
+    mpp_packet_deinit(&packet);
+    mpp_frame_deinit(&frame);
+
+    TEST_CHECK(ret);
+    TEST_CHECK(!q.tail);
+
+    return MPP_OK;
+}
+
+int main(void)
+{
+    MppBufferInfo info;
+    RK_U8 *mem = NULL;
+    MPP_RET ret = MPP_NOK;
+
+    mpp_log("mpp_dec_batch test start\n");
+
+    /* commit external memory to avoid dependence on platform allocator */
+    mem = malloc(TEST_BUF_SIZE);
+    mpp_buffer_group_get_external(&grp, MPP_BUFFER_TYPE_NORMAL);
+    if (!mem || !grp) {
+        mpp_err("failed to get buffer group\n");
+        goto DONE;
+    }
+
+    memset(&info, 0, sizeof(info));
+    info.type = MPP_BUFFER_TYPE_NORMAL;
+    info.size = TEST_BUF_SIZE;
+    info.ptr = mem;
+    info.fd = -1;
+    mpp_buffer_commit(grp, &info);
+
+    /* all packets and frames reference one buffer, the content is not used */
+    mpp_buffer_get(grp, &buf, TEST_BUF_SIZE);
+    if (!buf) {
+        mpp_err("failed to get buffer\n");
+        goto DONE;
+    }
+
+    ret = test_run(-1);
+    if (!ret)
+        ret = test_run(TEST_FAIL_IDX);
+    if (!ret)
+        ret = test_no_buffer();
+
+DONE:
+    if (buf)
+        mpp_buffer_put(buf);
+    if (grp)
+        mpp_buffer_group_put(grp);
+    if (mem)
+        free(mem);
+
+    mpp_log("mpp_dec_batch test %s\n", ret ? "failed" : "success");
+    return ret;
+}
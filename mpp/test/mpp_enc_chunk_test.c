@@ -0,0 +1,190 @@
+/* SPDX-License-Identifier: Apache-2.0 OR MIT */
+/*
+ * Copyright (c) 2026 Rockchip Electronics Co., Ltd.
+ */
+
+#define MODULE_TAG "mpp_enc_chunk_test"
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "mpp_log.h"
+#include "mpp_time.h"
+#include "mpp_common.h"
+#include "mpp_buffer.h"
+
+#include "mpp_enc_chunk_impl.h"
+
+#define TEST_BUF_SIZE       64
+#define TEST_SESSIONS       3
+#define TEST_CHUNK          4
+/* frame failed in the encoder has no packet */
+#define TEST_FAIL_PTS       5
+/* packet wait timeout in ms */
+#define TEST_TIMEOUT        1000
+
+#define TEST_CHECK(cond) \
+    do { \
+        if (!(cond)) { \
+            mpp_err("check %s failed at line %d\n", #cond, __LINE__); \
+            return MPP_NOK; \
+        } \
+    } while (0)
+
+typedef struct TestCase_t {
+    const char      *name;
+    /* frames with buffer, eos is on the last one when eos_frame is 0 */
+    RK_S32          frames;
+    /* add an eos frame without buffer after the frames */
+    RK_S32          eos_frame;
+} TestCase;
+
+static TestCase test_cases[] = {
+    /* eos frame without buffer starts a new chunk */
+    { "eos frame on chunk start",       TEST_CHUNK * 5,         1 },
+    /* eos on the last frame of a chunk */
+    { "eos on chunk end",               TEST_CHUNK * 4,         0 },
+    /* eos on the first frame of a chunk */
+    { "eos on chunk start",             TEST_CHUNK * 4 + 1,     0 },
+    /* less frames than one chunk */
+    { "eos in first chunk",             TEST_CHUNK - 1,         0 },
+};
+
+static MppBufferGroup grp = NULL;
+static MppBuffer buf = NULL;
+
+/*
+ * Fake encoder returns an empty packet with the frame pts. Sessions finish
+ * at different speed so later chunks are done before the earlier ones.
+ */
+static MPP_RET test_encode(void *ctx, RK_S32 idx, MppFrame frame, MppPacket *packet)
+{
+    RK_S64 pts = mpp_frame_get_pts(frame);
+
+    (void)ctx;
+
+    msleep((TEST_SESSIONS - idx) * 2);
+
+    if (pts == TEST_FAIL_PTS)
+        return MPP_NOK;
+
+    mpp_packet_init(packet, NULL, 0);
+    mpp_packet_set_pts(*packet, pts);
+
+    return MPP_OK;
+}
+
+static MPP_RET test_put(MppEncChunk chunk, RK_S64 pts, RK_U32 eos, RK_U32 has_buf)
+{
+    MppFrame frame = NULL;
+    MPP_RET ret;
+
+    mpp_frame_init(&frame);
+    mpp_frame_set_pts(frame, pts);
+    mpp_frame_set_eos(frame, eos);
+    if (has_buf)
+        mpp_frame_set_buffer(frame, buf);
+
+    ret = mpp_enc_chunk_put_frame(chunk, frame);
+    mpp_frame_deinit(&frame);
+
+    return ret;
+}
+
+static MPP_RET test_run(TestCase *c)
+{
+    MppEncChunk chunk = NULL;
+    MppPacket packet = NULL;
+    RK_S64 pts;
+    RK_S64 expect = 0;
+
+    mpp_log("case %s frames %d eos frame %d\n", c->name, c->frames, c->eos_frame);
+
+    TEST_CHECK(!mpp_enc_chunk_init_with(&chunk, TEST_SESSIONS, TEST_CHUNK,
+                                        test_encode, NULL));
+
+    /* put all frames first so every session has several chunks queued */
+    for (pts = 0; pts < c->frames; pts++)
+        TEST_CHECK(!test_put(chunk, pts, !c->eos_frame && pts == c->frames - 1, 1));
+    if (c->eos_frame)
+        TEST_CHECK(!test_put(chunk, pts, 1, 0));
+
+    /* put after eos is rejected */
+    TEST_CHECK(test_put(chunk, pts + 1, 0, 1));
+
+    while (1) {
+        TEST_CHECK(!mpp_enc_chunk_get_packet(chunk, &packet, (MppPollType)TEST_TIMEOUT));
+        TEST_CHECK(packet);
+
+        if (expect == TEST_FAIL_PTS)
+            expect++;
+
+        TEST_CHECK(mpp_packet_get_pts(packet) == expect);
+        expect++;
+
+        if (mpp_packet_get_eos(packet)) {
+            mpp_packet_deinit(&packet);
+            break;
+        }
+        mpp_packet_deinit(&packet);
+    }
+
+    TEST_CHECK(expect == c->frames + c->eos_frame);
+
+    /* nothing after eos */
+    TEST_CHECK(!mpp_enc_chunk_get_packet(chunk, &packet, MPP_POLL_NON_BLOCK));
+    TEST_CHECK(!packet);
+
+    mpp_enc_chunk_deinit(chunk);
+
+    return MPP_OK;
+}
+
+int main(void)
+{
+    MppBufferInfo info;
+    RK_U8 *mem = NULL;
+    MPP_RET ret = MPP_NOK;
+    RK_U32 i;
+
+    mpp_log("mpp_enc_chunk test start\n");
+
+    /* commit external memory to avoid dependence on platform allocator */
+    mem = malloc(TEST_BUF_SIZE);
+    mpp_buffer_group_get_external(&grp, MPP_BUFFER_TYPE_NORMAL);
+    if (!mem || !grp) {
+        mpp_err("failed to get buffer group\n");
+        goto DONE;
+    }
+
+    memset(&info, 0, sizeof(info));
+    info.type = MPP_BUFFER_TYPE_NORMAL;
+    info.size = TEST_BUF_SIZE;
+    info.ptr = mem;
+    info.fd = -1;
+    mpp_buffer_commit(grp, &info);
+
+    /* all frames reference one buffer, the content is not used */
+    mpp_buffer_get(grp, &buf, TEST_BUF_SIZE);
+    if (!buf) {
+        mpp_err("failed to get buffer\n");
+        goto DONE;
+    }
+
+    for (i = 0; i < MPP_ARRAY_ELEMS(test_cases); i++) {
+        ret = test_run(&test_cases[i]);
+        if (ret)
+            break;
+    }
+
+DONE:
+    if (buf)
+        mpp_buffer_put(buf);
+    if (grp)
+        mpp_buffer_group_put(grp);
+    if (mem)
+        free(mem);
+
+    mpp_log("mpp_enc_chunk test %s\n", ret ? "failed" : "success");
+    return ret;
+}
@@ -0,0 +1,33 @@
+/*
+ * Copyright 2010 Rockchip Electronics S.LSI Co. LTD
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef VERSION_H
+#define VERSION_H
+
+#define	MPP_VERSION             "a4fae1f author: agent          2026-10-18 [user-040] fix: add jpeg batch decode api"
+#define	MPP_VER_HIST_CNT        10
+#define	MPP_VER_HIST_0          "a4fae1f author: agent          2026-10-18 [user-040] fix: add jpeg batch decode api  (HEAD -> master)"
+#define	MPP_VER_HIST_1          "7ccac3b author: agent          2026-10-18 [user-044] fix: print size_t with %zu in the packet chunk error logs"
+#define	MPP_VER_HIST_2          "2afefe4 author: agent          2026-10-18 [user-050] fix: keep the synthetic cbr windows within 20% and skip drops in qp stats"
+#define	MPP_VER_HIST_3          "4506a9e author: agent          2026-10-18 [user-038] fix: add mpp_packet_clr_eoi and test eoi split on h264d/h265d"
+#define	MPP_VER_HIST_4          "a781744 author: agent          2026-10-18 [user-041] fix: check all key values before set_kv applies them"
+#define	MPP_VER_HIST_5          "82e4f9e author: agent          2026-10-18 [user-039] fix: drop the rows argument and test the rows ready callback"
+#define	MPP_VER_HIST_6          "a33e75c author: agent          2026-10-18 [user-030] fix: report cpu time of each codec thread"
+#define	MPP_VER_HIST_7          "d5860ab author: agent          2026-10-18 [user-027] fix: keep the timing histograms always on"
+#define	MPP_VER_HIST_8          "034107c author: agent          2026-10-18 [user-026] fix: trace vproc frame output with the buffer slot index"
+#define	MPP_VER_HIST_9          "26b8eb5 author: agent          2026-10-18 [user-046] fix: give every rung its own frame with the force keys"
+
+#endif /*__VERSION_H__*/
@@ -49,6 +49,7 @@ MPP_RET dec_vproc_stop(MppDecVprocCtx ctx);
 MPP_RET dec_vproc_signal(MppDecVprocCtx ctx);
 MPP_RET dec_vproc_reset(MppDecVprocCtx ctx);
 RK_U32 dec_vproc_get_version(MppDecVprocCtx ctx);
+RK_S64 dec_vproc_get_cpu_time(MppDecVprocCtx ctx);
 MPP_RET dec_vproc_set_mode(MppDecVprocCtx ctx, MppVprocMode mode);
 
 #ifdef __cplusplus
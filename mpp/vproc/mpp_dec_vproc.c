@@ -9,6 +9,7 @@
 
 #include "mpp_env.h"
 #include "mpp_mem.h"
+#include "mpp_trace.h"
 #include "mpp_common.h"
 
 #include "mpp_dec_impl.h"
@@ -90,6 +91,8 @@ typedef struct MppDecVprocCtxImpl_t {
     MppFrame            prev_frm0;
     RK_S32              prev_idx1;
     MppFrame            prev_frm1;
+    // slot index of the frame in process for output trace
+    RK_S32              curr_idx;
     enum IEP2_FF_MODE   pre_ff_mode;
     RK_U32              pd_mode;
     MppBuffer           out_buf0;
@@ -101,7 +104,8 @@ typedef struct MppDecVprocCtxImpl_t {
     MPP_RET (*update_ref)(MppDecVprocCtx *vproc_ctx, MppFrame frm, RK_U32 index);
 } MppDecVprocCtxImpl;
 
-static void dec_vproc_put_frame(Mpp *mpp, MppFrame frame, MppBuffer buf, RK_S64 pts, RK_U32 err)
+static void dec_vproc_put_frame(Mpp *mpp, MppFrame frame, MppBuffer buf, RK_S64 pts, RK_U32 err,
+                                RK_S32 index)
 {
     MppList *list = mpp->mFrmOut;
     MppFrame out = mpp_frame_dup(frame);
@@ -138,6 +142,10 @@ static void dec_vproc_put_frame(Mpp *mpp, MppFrame frame, MppBuffer buf, RK_S64
     mpp_list_add_at_tail(list, &out, sizeof(out));
 
     mpp->mFramePutCount++;
+    mpp_stats_add(mpp->mStats, MPP_STATS_CNT_FRM_OUT, 1);
+    /* deinterlace may output two frames or none per slot processed */
+    if (mpp->mDec)
+        mpp_trace_evt(MPP_TRACE_EVT_FRM_OUT, ((MppDecImpl *)mpp->mDec)->trace_sid, index);
     vproc_dbg_out("Output frame[%d]:poc %d, pts %lld, err 0x%x, dis %x, buf ptr %p\n",
                   mpp->mFramePutCount, mpp_frame_get_poc(out), mpp_frame_get_pts(out),
                   mpp_frame_get_errinfo(frame), mpp_frame_get_discard(frame),
@@ -330,11 +338,11 @@ static MPP_RET dec_vproc_set_dei_v1(MppDecVprocCtx *vproc_ctx, MppFrame frm)
 
         // NOTE: we need to process pts here
         if (mode & MPP_FRAME_FLAG_TOP_FIRST) {
-            dec_vproc_put_frame(mpp, frm, dst0, first_pts, frame_err);
-            dec_vproc_put_frame(mpp, frm, dst1, curr_pts, frame_err);
+            dec_vproc_put_frame(mpp, frm, dst0, first_pts, frame_err, ctx->curr_idx);
+            dec_vproc_put_frame(mpp, frm, dst1, curr_pts, frame_err, ctx->curr_idx);
         } else {
-            dec_vproc_put_frame(mpp, frm, dst1, first_pts, frame_err);
-            dec_vproc_put_frame(mpp, frm, dst0, curr_pts, frame_err);
+            dec_vproc_put_frame(mpp, frm, dst1, first_pts, frame_err, ctx->curr_idx);
+            dec_vproc_put_frame(mpp, frm, dst0, curr_pts, frame_err, ctx->curr_idx);
         }
         ctx->out_buf0 = NULL;
         ctx->out_buf1 = NULL;
@@ -358,7 +366,7 @@ static MPP_RET dec_vproc_set_dei_v1(MppDecVprocCtx *vproc_ctx, MppFrame frm)
 
         // start hardware
         ctx->start_dei((MppDecVprocCtx *)ctx, mode);
-        dec_vproc_put_frame(mpp, frm, dst0, -1, frame_err);
+        dec_vproc_put_frame(mpp, frm, dst0, -1, frame_err, ctx->curr_idx);
         ctx->out_buf0 = NULL;
     }
 
@@ -540,7 +548,7 @@ MPP_RET dec_vproc_output_dei_v2(MppDecVprocCtxImpl *ctx, MppFrame frm, RK_U32 is
     if (is_frm) {
         if (ctx->prev_frm1) {
             vproc_dbg_out("output frame prev1 poc %d\n", mpp_frame_get_poc(ctx->prev_frm1));
-            dec_vproc_put_frame(mpp,  ctx->prev_frm1, NULL, -1, 0);
+            dec_vproc_put_frame(mpp, ctx->prev_frm1, NULL, -1, 0, ctx->prev_idx1);
             if (ctx->prev_idx1 >= 0)
                 mpp_buf_slot_clr_flag(ctx->slots, ctx->prev_idx1, SLOT_QUEUE_USE);
             ctx->prev_idx1 = -1;
@@ -563,7 +571,7 @@ MPP_RET dec_vproc_output_dei_v2(MppDecVprocCtxImpl *ctx, MppFrame frm, RK_U32 is
             if (ctx->dei_info.pd_flag != PD_COMP_FLAG_NON &&
                 ctx->dei_info.pd_types != PD_TYPES_UNKNOWN) {
                 vproc_dbg_out("output at pd mode, frame poc %d\n", mpp_frame_get_poc(frm));
-                dec_vproc_put_frame(mpp, frm, dst0, first_pts, frame_err);
+                dec_vproc_put_frame(mpp, frm, dst0, first_pts, frame_err, ctx->curr_idx);
                 if (vproc_debug & VPROC_DBG_DUMP_OUT)
                     dump_mppbuffer(dst0, "/data/dump/dump_output.yuv", hor_stride, ver_stride);
                 ctx->out_buf0 = NULL;
@@ -588,20 +596,20 @@ MPP_RET dec_vproc_output_dei_v2(MppDecVprocCtxImpl *ctx, MppFrame frm, RK_U32 is
 
             if (is_tff) {
                 vproc_dbg_out("output at I4O2 for tff, frame poc %d\n", mpp_frame_get_poc(frm));
-                dec_vproc_put_frame(mpp, frm, dst0, first_pts, frame_err);
+                dec_vproc_put_frame(mpp, frm, dst0, first_pts, frame_err, ctx->curr_idx);
                 if (vproc_debug & VPROC_DBG_DUMP_OUT)
                     dump_mppbuffer(dst0, "/data/dump/dump_output.yuv", hor_stride, ver_stride);
                 vproc_dbg_out("output at I4O2 for bff, frame poc %d\n", mpp_frame_get_poc(frm));
-                dec_vproc_put_frame(mpp, frm, dst1, curr_pts, frame_err);
+                dec_vproc_put_frame(mpp, frm, dst1, curr_pts, frame_err, ctx->curr_idx);
                 if (vproc_debug & VPROC_DBG_DUMP_OUT)
                     dump_mppbuffer(dst1, "/data/dump/dump_output.yuv", hor_stride, ver_stride);
             } else {
                 vproc_dbg_out("output at I4O2 for bff, frame poc %d\n", mpp_frame_get_poc(frm));
-                dec_vproc_put_frame(mpp, frm, dst1, first_pts, frame_err);
+                dec_vproc_put_frame(mpp, frm, dst1, first_pts, frame_err, ctx->curr_idx);
                 if (vproc_debug & VPROC_DBG_DUMP_OUT)
                     dump_mppbuffer(dst1, "/data/dump/dump_output.yuv", hor_stride, mpp_frame_get_height(frm));
                 vproc_dbg_out("output at I4O2 for tff, frame poc %d\n", mpp_frame_get_poc(frm));
-                dec_vproc_put_frame(mpp, frm, dst0, curr_pts, frame_err);
+                dec_vproc_put_frame(mpp, frm, dst0, curr_pts, frame_err, ctx->curr_idx);
                 if (vproc_debug & VPROC_DBG_DUMP_OUT)
                     dump_mppbuffer(dst0, "/data/dump/dump_output.yuv", hor_stride, mpp_frame_get_height(frm));
             }
@@ -613,7 +621,7 @@ MPP_RET dec_vproc_output_dei_v2(MppDecVprocCtxImpl *ctx, MppFrame frm, RK_U32 is
     case MPP_FRAME_FLAG_IEP_DEI_I2O1:
     case MPP_FRAME_FLAG_IEP_DEI_I4O1: {
         vproc_dbg_out("output at I2O1, frame poc %d\n", mpp_frame_get_poc(frm));
-        dec_vproc_put_frame(mpp, frm, dst0, -1, frame_err);
+        dec_vproc_put_frame(mpp, frm, dst0, -1, frame_err, ctx->curr_idx);
         if (vproc_debug & VPROC_DBG_DUMP_OUT)
             dump_mppbuffer(dst0, "/data/dump/dump_output.yuv", hor_stride, mpp_frame_get_height(frm));
         ctx->out_buf0 = NULL;
@@ -826,7 +834,7 @@ static MPP_RET dec_vproc_update_ref(MppDecVprocCtxImpl *ctx, MppFrame frm, RK_U3
         mpp_frame_init(&frm);
         mpp_frame_set_eos(frm, eos);
         vproc_dbg_out("output at update ref, frame poc %d\n", mpp_frame_get_poc(frm));
-        dec_vproc_put_frame(mpp, frm, NULL, -1, 0);
+        dec_vproc_put_frame(mpp, frm, NULL, -1, 0, index);
         dec_vproc_clr_prev(ctx);
         mpp_frame_deinit(&frm);
     }
@@ -904,7 +912,7 @@ static void *dec_vproc_thread(void *data)
                 mpp_frame_init(&frm);
                 mpp_frame_set_eos(frm, eos);
                 vproc_dbg_out("output at eos, frame poc %d\n", mpp_frame_get_poc(frm));
-                dec_vproc_put_frame(mpp, frm, NULL, -1, 0);
+                dec_vproc_put_frame(mpp, frm, NULL, -1, 0, index);
                 dec_vproc_clr_prev(ctx);
                 mpp_frame_deinit(&frm);
 
@@ -918,7 +926,7 @@ static void *dec_vproc_thread(void *data)
             if (change) {
                 vproc_dbg_status("info change\n");
                 vproc_dbg_out("output at info change, frame poc %d\n", mpp_frame_get_poc(frm));
-                dec_vproc_put_frame(mpp, frm, NULL, -1, 0);
+                dec_vproc_put_frame(mpp, frm, NULL, -1, 0, index);
                 dec_vproc_clr_prev(ctx);
 
                 if (ctx->com_ctx->ops->reset)
@@ -957,6 +965,8 @@ static void *dec_vproc_thread(void *data)
             mpp_assert(tmp == index);
 
             vproc_dbg_status("vproc get buf ready & start process ");
+            mpp_trace_evt(MPP_TRACE_EVT_VPROC_BEG, dec->trace_sid, index);
+            ctx->curr_idx = index;
             if (!ctx->reset && ctx->iep_ctx) {
                 vproc_dbg_in("processing frame poc %d, mode 0x%x, err %x vs %x, buf slot %x, ptr %p\n",
                              mpp_frame_get_poc(frm), mpp_frame_get_mode(frm), mpp_frame_get_errinfo(frm),
@@ -965,6 +975,7 @@ static void *dec_vproc_thread(void *data)
             }
 
             dec_vproc_update_ref(ctx, frm, index, eos);
+            mpp_trace_evt(MPP_TRACE_EVT_VPROC_END, dec->trace_sid, index);
             hal_task_hnd_set_status(task, TASK_IDLE);
             ctx->task_status.val = 0;
             ctx->task_wait.val = 0;
@@ -1000,6 +1011,8 @@ MPP_RET dec_vproc_init(MppDecVprocCtx *ctx, MppDecVprocCfg *cfg)
     p->mpp = (Mpp *)cfg->mpp;
     p->slots = ((MppDecImpl *)p->mpp->mDec)->frame_slots;
     p->thd = mpp_thread_create(dec_vproc_thread, p, "mpp_dec_vproc");
+    mpp_thread_set_policy(p->thd, MPP_THREAD_ROLE_WAIT, p->mpp->mThreadPlace,
+                          p->mpp->mThreadPrio);
     sem_init(&p->reset_sem, 0, 0);
     ret = hal_task_group_init(&p->task_group, TASK_BUTT, 4, sizeof(HalDecVprocTask));
     if (ret) {
@@ -1073,6 +1086,7 @@ MPP_RET dec_vproc_init(MppDecVprocCtx *ctx, MppDecVprocCfg *cfg)
         p->prev_frm0 = NULL;
         p->prev_idx1 = -1;
         p->prev_frm1 = NULL;
+        p->curr_idx = -1;
     }
 
     *ctx = p;
@@ -1092,6 +1106,17 @@ RK_U32 dec_vproc_get_version(MppDecVprocCtx ctx)
     return p->com_ctx->ver;
 }
 
+RK_S64 dec_vproc_get_cpu_time(MppDecVprocCtx ctx)
+{
+    if (NULL == ctx) {
+        mpp_err_f("found NULL input\n");
+        return 0;
+    }
+
+    MppDecVprocCtxImpl *p = (MppDecVprocCtxImpl *)ctx;
+    return mpp_thread_get_cpu_time(p->thd);
+}
+
 MPP_RET dec_vproc_set_mode(MppDecVprocCtx ctx, MppVprocMode mode)
 {
     if (NULL == ctx) {
@@ -57,6 +57,11 @@ typedef struct MppDevMppService_t {
     RK_U32          support_set_info;
     RK_U32          support_set_rcb_info;
     RK_U32          support_hw_irq;
+    RK_U32          support_task_time;
+
+    /* hardware timing of the last polled task */
+    RK_U32          hw_time_valid;
+    MppDevHwTime    hw_time;
 
     pthread_mutex_t     lock_bufs;
     struct list_head    list_bufs;
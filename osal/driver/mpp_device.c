@@ -179,6 +179,9 @@ MPP_RET mpp_dev_ioctl(MppDev ctx, RK_S32 cmd, void *param)
         if (api->cmd_poll)
             ret = api->cmd_poll(impl_ctx, param);
     } break;
+    case MPP_DEV_GET_HW_TIME : {
+        ret = api->get_hw_time ? api->get_hw_time(impl_ctx, param) : MPP_NOK;
+    } break;
     default : {
         mpp_err_f("invalid cmd %d\n", cmd);
     } break;
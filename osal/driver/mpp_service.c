@@ -321,6 +321,8 @@ MPP_RET mpp_service_init(void *ctx, MppClientType type)
     }
     if (MPP_OK == mpp_service_check_cmd_valid(MPP_CMD_POLL_HW_IRQ, p->cap))
         p->support_hw_irq = 1;
+    if (MPP_OK == mpp_service_check_cmd_valid(MPP_CMD_GET_TASK_TIME, p->cap))
+        p->support_task_time = 1;
 
     /* default server fd is the opened client fd */
     p->client_type = type;
@@ -790,6 +792,8 @@ MPP_RET mpp_service_cmd_poll(void *ctx, MppDevPollCfg *cfg)
     MppDevMppService *p = (MppDevMppService *)ctx;
     MPP_RET ret = MPP_OK;
 
+    p->hw_time_valid = 0;
+
     if (p->batch_io) {
         ret = mpp_server_wait_task(ctx, 0);
     } else {
@@ -824,11 +828,37 @@ MPP_RET mpp_service_cmd_poll(void *ctx, MppDevPollCfg *cfg)
                       ret, errno, strerror(errno));
             ret = errno;
         }
+
+        if (!ret && p->support_task_time) {
+            dev_req.cmd = MPP_CMD_GET_TASK_TIME;
+            dev_req.flag = MPP_FLAGS_LAST_MSG;
+            dev_req.size = sizeof(p->hw_time);
+            dev_req.offset = 0;
+            dev_req.data_ptr = REQ_DATA_PTR(&p->hw_time);
+
+            /* old kernel may reject the query then just stop asking */
+            if (mpp_service_ioctl_request(p->server, &dev_req))
+                p->support_task_time = 0;
+            else
+                p->hw_time_valid = 1;
+        }
     }
 
     return ret;
 }
 
+MPP_RET mpp_service_get_hw_time(void *ctx, MppDevHwTime *time)
+{
+    MppDevMppService *p = (MppDevMppService *)ctx;
+
+    if (!time || !p->hw_time_valid)
+        return MPP_NOK;
+
+    *time = p->hw_time;
+
+    return MPP_OK;
+}
+
 const MppDevApi mpp_service_api = {
     "mpp_service",
     sizeof(MppDevMppService),
@@ -851,4 +881,5 @@ const MppDevApi mpp_service_api = {
     mpp_service_detach_fd,
     mpp_service_cmd_send,
     mpp_service_cmd_poll,
+    mpp_service_get_hw_time,
 };
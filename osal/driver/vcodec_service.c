@@ -729,4 +729,5 @@ const MppDevApi vcodec_service_api = {
     NULL,
     vcodec_service_cmd_send,
     vcodec_service_cmd_poll,
+    NULL,
 };
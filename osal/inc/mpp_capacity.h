@@ -0,0 +1,45 @@
+/* SPDX-License-Identifier: Apache-2.0 OR MIT */
+/*
+ * Copyright (c) 2026 Rockchip Electronics Co., Ltd.
+ */
+
+#ifndef MPP_CAPACITY_H
+#define MPP_CAPACITY_H
+
+#include "rk_type.h"
+#include "mpp_err.h"
+
+typedef void* MppLoad;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Hardware capacity estimator
+ *
+ * The throughput of each hardware is modeled in pixel per second from the
+ * soc capability table. Each session registers its load by resolution and
+ * fps and the load of all sessions in this process is summed per hardware.
+ */
+rk_s32 mpp_load_get(MppLoad *load, MppCtxType type, MppCodingType coding);
+rk_s32 mpp_load_put(MppLoad load);
+
+/*
+ * update session load with new resolution and fps, fps 0 for unknown
+ * return rk_nok when the hardware will be overloaded. In strict mode
+ * (env mpp_load_strict) the overloading update is not committed.
+ */
+rk_s32 mpp_load_update(MppLoad load, rk_u32 width, rk_u32 height, rk_u32 fps);
+/* whether overloading config should be rejected by the session */
+rk_s32 mpp_load_is_strict(MppLoad load);
+
+/* predict hardware load in percent after adding a new session */
+rk_s32 mpp_load_predict(MppCtxType type, MppCodingType coding, rk_u32 width,
+                        rk_u32 height, rk_u32 fps, rk_s32 *percent);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* MPP_CAPACITY_H */
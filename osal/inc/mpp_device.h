@@ -40,6 +40,9 @@ typedef enum MppDevIoctlCmd_e {
     MPP_DEV_CMD_SEND,
     MPP_DEV_CMD_POLL,
 
+    /* hardware timing of the last polled task */
+    MPP_DEV_GET_HW_TIME,
+
     MPP_DEV_IOCTL_CMD_BUTT,
 } MppDevIoctlCmd;
 
@@ -123,6 +126,19 @@ typedef struct MppDevPollCfg_t {
     MppDevPollEncSliceInfo slice_info[0];
 } MppDevPollCfg;
 
+/*
+ * for MPP_DEV_GET_HW_TIME
+ * start / end are kernel CLOCK_MONOTONIC time in nanosecond when the task is
+ * started on hardware and when the hardware irq is handled.
+ * cycles is the hardware cycle counter of the task, zero when not supported.
+ */
+typedef struct MppDevHwTime_t {
+    RK_U64  start;
+    RK_U64  end;
+    RK_U32  cycles;
+    RK_U32  reserved;
+} MppDevHwTime;
+
 typedef struct MppDevBufMapNode_t {
     /* data write by buffer function */
     struct list_head    list_buf;
@@ -171,6 +187,9 @@ typedef struct MppDevApi_t {
 
     /* poll cmd from hardware */
     MPP_RET     (*cmd_poll)(void *ctx, MppDevPollCfg *cfg);
+
+    /* read hardware timing of the last polled task */
+    MPP_RET     (*get_hw_time)(void *ctx, MppDevHwTime *time);
 } MppDevApi;
 
 #ifdef __cplusplus
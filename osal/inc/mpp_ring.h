@@ -18,6 +18,7 @@ rk_s32 mpp_ring_get(MppRing *ring, rk_s32 size, const char *name);
 rk_s32 mpp_ring_put(MppRing ring);
 
 void *mpp_ring_get_ptr(MppRing ring);
+rk_s32 mpp_ring_get_fd(MppRing ring);
 /* resize ring buffer to new size */
 void *mpp_ring_resize(MppRing ring, rk_s32 new_size);
 
@@ -78,6 +78,8 @@ typedef enum MppServiceCmdType_e {
     MPP_CMD_RELEASE_FD              = MPP_CMD_CONTROL_BASE + 2,
     MPP_CMD_SEND_CODEC_INFO         = MPP_CMD_CONTROL_BASE + 3,
     MPP_CMD_SET_ERR_REF_HACK        = MPP_CMD_CONTROL_BASE + 4,
+    /* read back hardware timing of the last finished task */
+    MPP_CMD_GET_TASK_TIME           = MPP_CMD_CONTROL_BASE + 5,
     MPP_CMD_CONTROL_BUTT,
 
     MPP_CMD_BUTT,
@@ -73,7 +73,8 @@ typedef struct MppEncHwCap_t {
     rk_u32          cap_8k          : 1;
     rk_u32          cap_hw_osd      : 1;
     rk_u32          cap_hw_roi      : 1;
-    rk_u32          reserved        : 16;
+    rk_u32          cap_core_num    : 3;
+    rk_u32          reserved        : 13;
 } MppEncHwCap;
 
 typedef struct {
@@ -0,0 +1,32 @@
+/* SPDX-License-Identifier: Apache-2.0 OR MIT */
+/*
+ * Copyright (c) 2026 Rockchip Electronics Co., Ltd.
+ */
+
+#ifndef MPP_STATS_IMPL_H
+#define MPP_STATS_IMPL_H
+
+#include "mpp_stats.h"
+
+typedef void* MppStats;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+rk_s32 mpp_stats_get(MppStats *stats, const char *name);
+rk_s32 mpp_stats_put(MppStats stats);
+
+/* lock-free update functions, NULL stats is allowed and ignored */
+void mpp_stats_add(MppStats stats, MppStatsCnt id, rk_u64 val);
+void mpp_stats_record(MppStats stats, MppStatsHist id, rk_s64 val);
+
+rk_s32 mpp_stats_read(MppStats stats, MppStatsInfo *info);
+/* memfd for external scraper, -1 when export is disabled */
+rk_s32 mpp_stats_get_fd(MppStats stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* MPP_STATS_IMPL_H */
@@ -60,6 +60,33 @@ typedef enum MppThreadSignalId_e {
     THREAD_SIGNAL_BUTT,
 } MppThreadSignalId;
 
+/*
+ * Thread placement policy on big.LITTLE soc
+ * Big and little clusters are detected by cpu_capacity or max cpu frequency.
+ * The policy is applied by the new thread itself when it is started.
+ */
+typedef enum MppThreadRole_e {
+    MPP_THREAD_ROLE_DEFAULT,        /* no placement */
+    MPP_THREAD_ROLE_COMPUTE,        /* parser / register generation, prefer big cores */
+    MPP_THREAD_ROLE_WAIT,           /* hardware polling / waiting, prefer little cores */
+    MPP_THREAD_ROLE_BUTT,
+} MppThreadRole;
+
+typedef enum MppThreadPlace_e {
+    MPP_THREAD_PLACE_DEFAULT,       /* follow env mpp_thread_place */
+    MPP_THREAD_PLACE_NONE,          /* keep system default affinity */
+    MPP_THREAD_PLACE_PREFER,        /* run on any core of the preferred cluster */
+    MPP_THREAD_PLACE_PIN,           /* pin to one core of the preferred cluster */
+    MPP_THREAD_PLACE_BUTT,
+} MppThreadPlace;
+
+typedef struct MppThreadPolicy_t {
+    MppThreadRole       role;
+    MppThreadPlace      place;
+    /* 1 ~ 99 for SCHED_FIFO priority, 0 for env mpp_thread_prio, negative for SCHED_OTHER */
+    rk_s32              prio;
+} MppThreadPolicy;
+
 typedef struct MppThread_t {
     pthread_t           thd;
     MppMutexCond        mutex_cond[THREAD_SIGNAL_BUTT];
@@ -67,6 +94,9 @@ typedef struct MppThread_t {
     MppThreadFunc       func;
     char                name[THREAD_NAME_LEN];
     void                *ctx;
+    MppThreadPolicy     policy;
+    /* cpu time in us recorded on thread exit */
+    rk_s64              cpu_time;
 } MppThread;
 
 // Mutex functions
@@ -108,6 +138,10 @@ MppThread *mpp_thread_create(MppThreadFunc func, void *ctx, const char *name);
 void mpp_thread_destroy(MppThread *thread);
 void mpp_thread_start(MppThread *thread);
 void mpp_thread_stop(MppThread *thread);
+/* setup placement policy before mpp_thread_start */
+void mpp_thread_set_policy(MppThread *thread, MppThreadRole role, MppThreadPlace place, rk_s32 prio);
+/* consumed cpu time in us of running or finished thread, -1 on failure */
+rk_s64 mpp_thread_get_cpu_time(MppThread *thread);
 
 
 /*
@@ -158,6 +192,8 @@ rk_s32 mpp_sthd_get_idx(MppSThd thd);
 rk_s32 mpp_sthd_check(MppSThd thd);
 
 void mpp_sthd_setup(MppSThd thd, MppSThdFunc func, void *ctx);
+void mpp_sthd_set_policy(MppSThd thd, MppThreadRole role, MppThreadPlace place, rk_s32 prio);
+rk_s64 mpp_sthd_get_cpu_time(MppSThd thd);
 
 void mpp_sthd_start(MppSThd thd);
 void mpp_sthd_stop(MppSThd thd);
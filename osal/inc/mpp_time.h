@@ -9,6 +9,7 @@
 #include <unistd.h>
 
 #include "mpp_thread.h"
+#include "mpp_stats_impl.h"
 
 #define msleep(x)               usleep((x)*1000)
 
@@ -53,6 +54,13 @@ rk_s64 mpp_clock_get_sum(MppClock clk);
 rk_s64 mpp_clock_get_count(MppClock clk);
 const char *mpp_clock_get_name(MppClock clk);
 
+/*
+ * Attach a stats histogram to clock. Each start / pause interval will be
+ * recorded into the histogram even when the clock is disabled. The clock
+ * sum and count are still only updated when the clock is enabled.
+ */
+void mpp_clock_set_stats(MppClock clk, MppStats stats, MppStatsHist id);
+
 /*
  * MppTimer is for timer with callback function
  * It will provide the ability to repeat doing something until it is
@@ -8,10 +8,45 @@
 
 #include "rk_type.h"
 
+/*
+ * Structured per-frame pipeline event trace
+ *
+ * Each thread records binary events into its own ring buffer without any
+ * lock. The rings are dumped as Chrome / Perfetto trace json on process exit
+ * or by mpp_trace_evt_dump. Recording is enabled by env mpp_trace_evt and the
+ * disabled path only costs one load and one branch.
+ *
+ * env:
+ * mpp_trace_evt        - non-zero to enable event recording
+ * mpp_trace_evt_size   - events per thread ring, rounded up to power of 2
+ * mpp_trace_evt_path   - json output file path on exit
+ */
+typedef enum MppTraceEvt_e {
+    MPP_TRACE_EVT_PKT_IN,       /* input packet taken by parser thread */
+    MPP_TRACE_EVT_PARSE_BEG,
+    MPP_TRACE_EVT_PARSE_END,
+    MPP_TRACE_EVT_REG_GEN_BEG,
+    MPP_TRACE_EVT_REG_GEN_END,
+    MPP_TRACE_EVT_HW_START,     /* task sent to kernel driver */
+    MPP_TRACE_EVT_HW_DONE,      /* task returned from kernel driver */
+    MPP_TRACE_EVT_VPROC_BEG,
+    MPP_TRACE_EVT_VPROC_END,
+    MPP_TRACE_EVT_FRM_OUT,      /* frame pushed to user output queue */
+    MPP_TRACE_EVT_BUTT,
+} MppTraceEvt;
+
 #ifdef __cplusplus
 extern "C" {
 #endif
 
+extern rk_u32 mpp_trace_evt_en;
+
+#define mpp_trace_evt(evt, sid, idx) \
+    do { \
+        if (mpp_trace_evt_en) \
+            mpp_trace_evt_record(evt, sid, idx); \
+    } while (0)
+
 void mpp_trace_begin(const char* name);
 void mpp_trace_end(const char* name);
 void mpp_trace_async_begin(const char* name, rk_s32 cookie);
@@ -19,6 +54,13 @@ void mpp_trace_async_end(const char* name, rk_s32 cookie);
 void mpp_trace_int32(const char* name, rk_s32 value);
 void mpp_trace_int64(const char* name, rk_s64 value);
 
+/* get a new session id for event trace */
+rk_u32 mpp_trace_evt_sid(void);
+void mpp_trace_evt_enable(rk_u32 enable);
+void mpp_trace_evt_record(MppTraceEvt evt, rk_u32 sid, rk_s32 idx);
+/* dump all thread rings to json file, should be called when pipeline is idle */
+rk_s32 mpp_trace_evt_dump(const char *path);
+
 #ifdef __cplusplus
 }
 #endif
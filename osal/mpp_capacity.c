@@ -0,0 +1,250 @@
+/* SPDX-License-Identifier: Apache-2.0 OR MIT */
+/*
+ * Copyright (c) 2026 Rockchip Electronics Co., Ltd.
+ */
+
+#define MODULE_TAG "mpp_capacity"
+
+#include <stdint.h>
+
+#include "mpp_env.h"
+#include "mpp_mem.h"
+#include "mpp_lock.h"
+#include "mpp_soc.h"
+#include "mpp_debug.h"
+#include "mpp_common.h"
+
+#include "mpp_capacity.h"
+
+#define LOAD_DBG_UPDATE         (0x00000001)
+
+#define load_dbg_update(fmt, ...) mpp_dbg_f(mpp_load_debug, LOAD_DBG_UPDATE, fmt, ## __VA_ARGS__)
+
+/* fps used when the session does not know its frame rate, like decoder */
+#define LOAD_DEFAULT_FPS        30
+
+#define PIXEL_RATE(w, h, fps)   ((rk_u64)(w) * (h) * (fps))
+
+typedef struct MppLoadImpl_t {
+    const char          *check;
+    MppCtxType          type;
+    MppCodingType       coding;
+    MppClientType       client;
+    rk_u64              capacity;
+    /* current pixel rate registered to load_sum */
+    rk_u64              rate;
+    /* env mpp_load_strict read on session creation */
+    rk_u32              strict;
+} MppLoadImpl;
+
+static const char *load_name = "mpp_load";
+static rk_u32 mpp_load_debug = 0;
+/* sum of pixel rate of all sessions on each hardware in this process */
+static rk_u64 load_sum[VPU_CLIENT_BUTT];
+
+static MppLoadImpl *get_load(MppLoad load, const char *caller)
+{
+    MppLoadImpl *impl = (MppLoadImpl *)load;
+
+    if (impl && impl->check == load_name)
+        return impl;
+
+    if (impl)
+        mpp_err("invalid load %p at %s\n", load, caller);
+
+    return NULL;
+}
+
+static rk_u32 cap_has_coding(rk_u32 cap, MppCodingType coding)
+{
+    rk_s32 index = mpp_coding_to_index(coding);
+
+    return (index > 0 && index < 32 && (cap & (rk_u32)(1 << index)));
+}
+
+/*
+ * Throughput model from soc capability table
+ * decoder: 8k capable hardware runs 8k@30 per core, 4k capable hardware runs
+ *          4k@60 and the others run 1080p@60. H.264 and older formats run at
+ *          half rate on 8k hardware which is tuned for HEVC / VP9 / AV1.
+ * encoder: 8k capable hardware runs 8k@30 per core, 4k capable hardware runs
+ *          4k@30 and the others run 1080p@30.
+ * env mpp_load_capacity overrides the model in pixel per second.
+ */
+static rk_u64 get_capacity(MppCtxType type, MppCodingType coding, MppClientType *client)
+{
+    const MppSocInfo *info = mpp_get_soc_info();
+    rk_u32 override = 0;
+    rk_u64 capacity = 0;
+    rk_u32 i;
+
+    *client = VPU_CLIENT_BUTT;
+
+    if (!info)
+        return 0;
+
+    if (type == MPP_CTX_DEC) {
+        for (i = 0; i < MPP_ARRAY_ELEMS(info->dec_caps); i++) {
+            const MppDecHwCap *cap = info->dec_caps[i];
+
+            if (!cap || !cap_has_coding(cap->cap_coding, coding))
+                continue;
+
+            if (cap->cap_8k) {
+                capacity = PIXEL_RATE(7680, 4320, 30);
+                if (coding != MPP_VIDEO_CodingHEVC && coding != MPP_VIDEO_CodingVP9 &&
+                    coding != MPP_VIDEO_CodingAV1 && coding != MPP_VIDEO_CodingAVS2)
+                    capacity /= 2;
+            } else if (cap->cap_4k) {
+                capacity = PIXEL_RATE(3840, 2160, 60);
+            } else {
+                capacity = PIXEL_RATE(1920, 1088, 60);
+            }
+
+            capacity *= MPP_MAX(cap->cap_core_num, 1);
+            *client = cap->type;
+            break;
+        }
+    } else if (type == MPP_CTX_ENC) {
+        for (i = 0; i < MPP_ARRAY_ELEMS(info->enc_caps); i++) {
+            const MppEncHwCap *cap = info->enc_caps[i];
+
+            if (!cap || !cap_has_coding(cap->cap_coding, coding))
+                continue;
+
+            if (cap->cap_8k)
+                capacity = PIXEL_RATE(7680, 4320, 30);
+            else if (cap->cap_4k)
+                capacity = PIXEL_RATE(3840, 2160, 30);
+            else
+                capacity = PIXEL_RATE(1920, 1088, 30);
+
+            capacity *= MPP_MAX(cap->cap_core_num, 1);
+            *client = cap->type;
+            break;
+        }
+    }
+
+    mpp_env_get_u32("mpp_load_capacity", &override, 0);
+    if (override && *client < VPU_CLIENT_BUTT)
+        capacity = override;
+
+    return capacity;
+}
+
+static rk_s32 get_percent(rk_u64 rate, rk_u64 capacity)
+{
+    if (!capacity)
+        return 0;
+
+    return (rk_s32)MPP_MIN(rate * 100 / capacity, (rk_u64)INT32_MAX);
+}
+
+rk_s32 mpp_load_get(MppLoad *load, MppCtxType type, MppCodingType coding)
+{
+    MppLoadImpl *impl;
+
+    if (!load) {
+        mpp_err_f("invalid NULL input\n");
+        return rk_nok;
+    }
+
+    *load = NULL;
+
+    mpp_env_get_u32("mpp_load_debug", &mpp_load_debug, 0);
+
+    impl = mpp_calloc(MppLoadImpl, 1);
+    if (!impl) {
+        mpp_err_f("failed to malloc load\n");
+        return rk_nok;
+    }
+
+    impl->check = load_name;
+    impl->type = type;
+    impl->coding = coding;
+    impl->capacity = get_capacity(type, coding, &impl->client);
+    mpp_env_get_u32("mpp_load_strict", &impl->strict, 0);
+
+    *load = impl;
+
+    return rk_ok;
+}
+
+rk_s32 mpp_load_put(MppLoad load)
+{
+    MppLoadImpl *impl = get_load(load, __FUNCTION__);
+
+    if (!impl)
+        return rk_nok;
+
+    if (impl->rate && impl->client < VPU_CLIENT_BUTT)
+        MPP_FETCH_SUB(&load_sum[impl->client], impl->rate);
+
+    impl->check = NULL;
+    mpp_free(impl);
+
+    return rk_ok;
+}
+
+rk_s32 mpp_load_update(MppLoad load, rk_u32 width, rk_u32 height, rk_u32 fps)
+{
+    MppLoadImpl *impl = get_load(load, __FUNCTION__);
+    rk_u64 rate;
+    rk_u64 total;
+
+    if (!impl || impl->client >= VPU_CLIENT_BUTT || !impl->capacity)
+        return rk_ok;
+
+    rate = PIXEL_RATE(width, height, fps ? fps : LOAD_DEFAULT_FPS);
+    total = MPP_ADD_FETCH(&load_sum[impl->client], rate) - impl->rate;
+
+    load_dbg_update("load %p client %d %dx%d@%d total %d%%\n", impl, impl->client,
+                    width, height, fps, get_percent(total, impl->capacity));
+
+    if (total <= impl->capacity) {
+        MPP_FETCH_SUB(&load_sum[impl->client], impl->rate);
+        impl->rate = rate;
+        return rk_ok;
+    }
+
+    if (impl->strict) {
+        MPP_FETCH_SUB(&load_sum[impl->client], rate);
+    } else {
+        MPP_FETCH_SUB(&load_sum[impl->client], impl->rate);
+        impl->rate = rate;
+    }
+
+    mpp_logw("hardware %d overloaded %d%% by %dx%d@%d session\n", impl->client,
+             get_percent(total, impl->capacity), width, height, fps);
+
+    return rk_nok;
+}
+
+rk_s32 mpp_load_is_strict(MppLoad load)
+{
+    MppLoadImpl *impl = get_load(load, __FUNCTION__);
+
+    return impl ? impl->strict : 0;
+}
+
+rk_s32 mpp_load_predict(MppCtxType type, MppCodingType coding, rk_u32 width,
+                        rk_u32 height, rk_u32 fps, rk_s32 *percent)
+{
+    MppClientType client;
+    rk_u64 capacity = get_capacity(type, coding, &client);
+    rk_u64 total;
+
+    if (percent)
+        *percent = 0;
+
+    if (!capacity || client >= VPU_CLIENT_BUTT)
+        return rk_nok;
+
+    total = __atomic_load_n(&load_sum[client], __ATOMIC_RELAXED) +
+            PIXEL_RATE(width, height, fps ? fps : LOAD_DEFAULT_FPS);
+
+    if (percent)
+        *percent = get_percent(total, capacity);
+
+    return (total <= capacity) ? rk_ok : rk_nok;
+}
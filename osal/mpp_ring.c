@@ -221,6 +221,13 @@ void *mpp_ring_get_ptr(MppRing ring)
     return (impl != NULL) ? impl->ptr : NULL;
 }
 
+rk_s32 mpp_ring_get_fd(MppRing ring)
+{
+    MppRingImpl *impl = (MppRingImpl *)ring;
+
+    return (impl != NULL) ? impl->fd : -1;
+}
+
 void *mpp_ring_resize(MppRing ring, rk_s32 new_size)
 {
     MppRingImpl *impl = (MppRingImpl *)ring;
@@ -668,6 +668,7 @@ static const MppEncHwCap vepu58x = {
     .cap_8k             = 1,
     .cap_hw_osd         = 1,
     .cap_hw_roi         = 1,
+    .cap_core_num       = 2,
     .reserved           = 0,
 };
 
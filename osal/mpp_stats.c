@@ -0,0 +1,225 @@
+/* SPDX-License-Identifier: Apache-2.0 OR MIT */
+/*
+ * Copyright (c) 2026 Rockchip Electronics Co., Ltd.
+ */
+
+#define MODULE_TAG "mpp_stats"
+
+#include <stddef.h>
+#include <string.h>
+
+#include "mpp_env.h"
+#include "mpp_mem.h"
+#include "mpp_lock.h"
+#include "mpp_ring.h"
+#include "mpp_debug.h"
+#include "mpp_common.h"
+
+#include "mpp_stats_impl.h"
+
+#define STATS_HIST_SUB_CNT      (1 << MPP_STATS_HIST_SUB_BITS)
+
+typedef struct MppStatsImpl_t {
+    const char          *check;
+    char                name[32];
+    /* memfd backed storage when exported */
+    MppRing             ring;
+    MppStatsInfo        *info;
+    MppStatsInfo        local;
+} MppStatsImpl;
+
+static const char *stats_name = "mpp_stats";
+
+static MppStatsImpl *get_stats(MppStats stats, const char *caller)
+{
+    MppStatsImpl *impl = (MppStatsImpl *)stats;
+
+    if (impl && impl->check == stats_name)
+        return impl;
+
+    if (impl)
+        mpp_err("invalid stats %p at %s\n", stats, caller);
+
+    return NULL;
+}
+
+static rk_u32 stats_hist_idx(rk_u64 val)
+{
+    rk_u32 msb;
+    rk_u32 idx;
+
+    if (val < STATS_HIST_SUB_CNT)
+        return (rk_u32)val;
+
+    msb = 63 - __builtin_clzll(val);
+    idx = (msb - MPP_STATS_HIST_SUB_BITS + 1) * STATS_HIST_SUB_CNT +
+          ((val >> (msb - MPP_STATS_HIST_SUB_BITS)) & (STATS_HIST_SUB_CNT - 1));
+
+    return MPP_MIN(idx, MPP_STATS_HIST_BINS - 1);
+}
+
+/* the first value not included in bin idx */
+static rk_u64 stats_hist_bound(rk_u32 idx)
+{
+    rk_u32 msb;
+    rk_u32 sub;
+
+    idx++;
+    if (idx < STATS_HIST_SUB_CNT)
+        return idx;
+
+    msb = idx / STATS_HIST_SUB_CNT + MPP_STATS_HIST_SUB_BITS - 1;
+    sub = idx % STATS_HIST_SUB_CNT;
+
+    return (rk_u64)(STATS_HIST_SUB_CNT + sub) << (msb - MPP_STATS_HIST_SUB_BITS);
+}
+
+rk_s32 mpp_stats_get(MppStats *stats, const char *name)
+{
+    MppStatsImpl *impl;
+    rk_u32 export = 0;
+
+    if (!stats) {
+        mpp_err_f("invalid NULL input\n");
+        return rk_nok;
+    }
+
+    *stats = NULL;
+
+    impl = mpp_calloc(MppStatsImpl, 1);
+    if (!impl) {
+        mpp_err_f("failed to malloc stats\n");
+        return rk_nok;
+    }
+
+    impl->check = stats_name;
+    snprintf(impl->name, sizeof(impl->name) - 1, "%s", name ? name : stats_name);
+    impl->info = &impl->local;
+
+    mpp_env_get_u32("mpp_stats_export", &export, 0);
+    if (export && !mpp_ring_get(&impl->ring, sizeof(MppStatsInfo), impl->name)) {
+        impl->info = (MppStatsInfo *)mpp_ring_get_ptr(impl->ring);
+        memset(impl->info, 0, sizeof(MppStatsInfo));
+    }
+
+    impl->info->version = MPP_STATS_VERSION;
+    impl->info->size = sizeof(MppStatsInfo);
+
+    *stats = impl;
+
+    return rk_ok;
+}
+
+rk_s32 mpp_stats_put(MppStats stats)
+{
+    MppStatsImpl *impl = get_stats(stats, __FUNCTION__);
+
+    if (!impl)
+        return rk_nok;
+
+    if (impl->ring) {
+        mpp_ring_put(impl->ring);
+        impl->ring = NULL;
+    }
+
+    impl->check = NULL;
+    mpp_free(impl);
+
+    return rk_ok;
+}
+
+void mpp_stats_add(MppStats stats, MppStatsCnt id, rk_u64 val)
+{
+    MppStatsImpl *impl = get_stats(stats, __FUNCTION__);
+
+    if (!impl || id >= MPP_STATS_CNT_BUTT)
+        return;
+
+    MPP_FETCH_ADD(&impl->info->cnt[id], val);
+}
+
+void mpp_stats_record(MppStats stats, MppStatsHist id, rk_s64 val)
+{
+    MppStatsImpl *impl = get_stats(stats, __FUNCTION__);
+    MppStatsHistInfo *hist;
+    rk_u64 v;
+    rk_u64 old;
+
+    if (!impl || id >= MPP_STATS_HIST_BUTT)
+        return;
+
+    hist = &impl->info->hist[id];
+    v = (val > 0) ? (rk_u64)val : 0;
+
+    /* first record initializes min by the count transition */
+    if (!MPP_FETCH_ADD(&hist->count, 1))
+        MPP_BOOL_CAS(&hist->min, 0, v);
+
+    MPP_FETCH_ADD(&hist->sum, v);
+    MPP_FETCH_ADD(&hist->bins[stats_hist_idx(v)], 1);
+
+    old = hist->max;
+    while (v > old && !MPP_BOOL_CAS(&hist->max, old, v))
+        old = hist->max;
+
+    old = hist->min;
+    while (v < old && !MPP_BOOL_CAS(&hist->min, old, v))
+        old = hist->min;
+}
+
+rk_s32 mpp_stats_read(MppStats stats, MppStatsInfo *info)
+{
+    MppStatsImpl *impl = get_stats(stats, __FUNCTION__);
+    rk_u64 *src;
+    rk_u64 *dst;
+    rk_u32 cnt;
+    rk_u32 i;
+
+    if (!impl || !info)
+        return rk_nok;
+
+    info->version = MPP_STATS_VERSION;
+    info->size = sizeof(MppStatsInfo);
+
+    /* all fields after the header are 64bit counters */
+    src = impl->info->cnt;
+    dst = info->cnt;
+    cnt = (sizeof(MppStatsInfo) - offsetof(MppStatsInfo, cnt)) / sizeof(rk_u64);
+
+    for (i = 0; i < cnt; i++)
+        dst[i] = __atomic_load_n(&src[i], __ATOMIC_RELAXED);
+
+    return rk_ok;
+}
+
+rk_s32 mpp_stats_get_fd(MppStats stats)
+{
+    MppStatsImpl *impl = get_stats(stats, __FUNCTION__);
+
+    return (impl && impl->ring) ? mpp_ring_get_fd(impl->ring) : -1;
+}
+
+RK_U64 mpp_stats_hist_percentile(const MppStatsHistInfo *hist, RK_U32 percent)
+{
+    rk_u64 target;
+    rk_u64 sum = 0;
+    rk_u32 i;
+
+    if (!hist || !hist->count)
+        return 0;
+
+    if (percent >= 100)
+        return hist->max;
+
+    target = (hist->count * percent + 99) / 100;
+    if (!target)
+        return hist->min;
+
+    for (i = 0; i < MPP_STATS_HIST_BINS; i++) {
+        sum += hist->bins[i];
+        if (sum >= target)
+            return MPP_MIN(stats_hist_bound(i) - 1, hist->max);
+    }
+
+    return hist->max;
+}
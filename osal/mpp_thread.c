@@ -5,8 +5,12 @@
 
 #define MODULE_TAG "mpp_thread"
 
+#include <sched.h>
+#include <stdio.h>
 #include <string.h>
+#include <time.h>
 
+#include "mpp_env.h"
 #include "mpp_mem.h"
 #include "mpp_lock.h"
 #include "mpp_debug.h"
@@ -14,11 +18,179 @@
 #include "mpp_thread.h"
 
 #define THREAD_DBG_FUNC             (0x00000001)
+#define THREAD_DBG_POLICY           (0x00000002)
+#define THREAD_DBG_CPU_TIME         (0x00000004)
+
+#define THREAD_MAX_CPU              64
 
 static rk_u32 thread_debug = 0;
 
 #define thread_dbg(flag, fmt, ...)  mpp_dbg(thread_debug, flag, fmt, ## __VA_ARGS__)
 
+typedef struct MppThreadTopo_t {
+    rk_s32              cpu_count;
+    /* preferred cpu mask of each role, zero when all cores are the same */
+    rk_u64              mask[MPP_THREAD_ROLE_BUTT];
+    /* round-robin index for pin mode */
+    rk_u32              pin_idx[MPP_THREAD_ROLE_BUTT];
+    /* global default policy from env */
+    rk_u32              env_place;
+    rk_u32              env_prio;
+} MppThreadTopo;
+
+static MppThreadTopo thread_topo;
+static pthread_once_t thread_topo_once = PTHREAD_ONCE_INIT;
+
+static rk_u32 read_cpu_value(rk_s32 cpu, const char *node)
+{
+    char path[128];
+    rk_u32 val = 0;
+    FILE *fp;
+
+    snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu%d/%s", cpu, node);
+    fp = fopen(path, "r");
+    if (fp) {
+        if (fscanf(fp, "%u", &val) != 1)
+            val = 0;
+        fclose(fp);
+    }
+
+    return val;
+}
+
+static void thread_topo_init(void)
+{
+    MppThreadTopo *topo = &thread_topo;
+    rk_u32 value[THREAD_MAX_CPU];
+    rk_u32 max_val = 0;
+    rk_u32 min_val = (rk_u32)(-1);
+    rk_s32 i;
+
+    mpp_env_get_u32("mpp_thread_debug", &thread_debug, 0);
+    mpp_env_get_u32("mpp_thread_place", &topo->env_place, 0);
+    mpp_env_get_u32("mpp_thread_prio", &topo->env_prio, 0);
+
+    topo->cpu_count = MPP_MIN((rk_s32)sysconf(_SC_NPROCESSORS_CONF), THREAD_MAX_CPU);
+
+    /* cpu_capacity is provided by arm64 kernel, otherwise use max frequency */
+    for (i = 0; i < topo->cpu_count; i++) {
+        value[i] = read_cpu_value(i, "cpu_capacity");
+        if (!value[i])
+            value[i] = read_cpu_value(i, "cpufreq/cpuinfo_max_freq");
+        if (!value[i])
+            continue;
+
+        max_val = MPP_MAX(max_val, value[i]);
+        min_val = MPP_MIN(min_val, value[i]);
+    }
+
+    if (!max_val || max_val == min_val)
+        return;
+
+    for (i = 0; i < topo->cpu_count; i++) {
+        if (value[i] == max_val)
+            topo->mask[MPP_THREAD_ROLE_COMPUTE] |= 1ULL << i;
+        if (value[i] == min_val)
+            topo->mask[MPP_THREAD_ROLE_WAIT] |= 1ULL << i;
+    }
+
+    thread_dbg(THREAD_DBG_POLICY, "cpu %d big mask %llx little mask %llx\n",
+               topo->cpu_count, topo->mask[MPP_THREAD_ROLE_COMPUTE],
+               topo->mask[MPP_THREAD_ROLE_WAIT]);
+}
+
+/* called by the new thread itself */
+static void thread_apply_policy(const char *name, MppThreadPolicy *policy)
+{
+    MppThreadTopo *topo = &thread_topo;
+    MppThreadRole role = policy->role;
+    MppThreadPlace place = policy->place;
+    rk_s32 prio = policy->prio;
+
+    pthread_once(&thread_topo_once, thread_topo_init);
+
+    if (role <= MPP_THREAD_ROLE_DEFAULT || role >= MPP_THREAD_ROLE_BUTT)
+        return;
+
+    if (place == MPP_THREAD_PLACE_DEFAULT)
+        place = (MppThreadPlace)topo->env_place;
+    if (!prio)
+        prio = (rk_s32)topo->env_prio;
+
+    if ((place == MPP_THREAD_PLACE_PREFER || place == MPP_THREAD_PLACE_PIN) &&
+        topo->mask[role]) {
+        rk_u64 mask = topo->mask[role];
+        cpu_set_t set;
+        rk_s32 i;
+
+        if (place == MPP_THREAD_PLACE_PIN) {
+            rk_u32 n = MPP_FETCH_ADD(&topo->pin_idx[role], 1) %
+                       __builtin_popcountll(mask);
+
+            /* keep the n-th core of the cluster only */
+            for (i = 0; i < THREAD_MAX_CPU; i++) {
+                if (!(mask & (1ULL << i)))
+                    continue;
+                if (!n) {
+                    mask = 1ULL << i;
+                    break;
+                }
+                n--;
+            }
+        }
+
+        CPU_ZERO(&set);
+        for (i = 0; i < THREAD_MAX_CPU; i++) {
+            if (mask & (1ULL << i))
+                CPU_SET(i, &set);
+        }
+
+        if (sched_setaffinity(0, sizeof(set), &set))
+            mpp_err("thread %s set affinity %llx failed\n", name, mask);
+        else
+            thread_dbg(THREAD_DBG_POLICY, "thread %s role %d affinity %llx\n",
+                       name, role, mask);
+    }
+
+    if (prio > 0) {
+        struct sched_param param;
+
+        param.sched_priority = MPP_MIN(prio, sched_get_priority_max(SCHED_FIFO));
+        /* require CAP_SYS_NICE or RLIMIT_RTPRIO */
+        if (pthread_setschedparam(pthread_self(), SCHED_FIFO, &param))
+            mpp_err("thread %s set SCHED_FIFO priority %d failed\n", name, prio);
+        else
+            thread_dbg(THREAD_DBG_POLICY, "thread %s SCHED_FIFO priority %d\n",
+                       name, param.sched_priority);
+    }
+}
+
+static rk_s64 thread_cpu_time(clockid_t clk)
+{
+    struct timespec ts;
+
+    if (clock_gettime(clk, &ts))
+        return -1;
+
+    return (rk_s64)ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+}
+
+static void *mpp_thread_entry(void *arg)
+{
+    MppThread *thread = (MppThread *)arg;
+    void *ret;
+
+    thread_apply_policy(thread->name, &thread->policy);
+
+    ret = thread->func(thread->ctx);
+
+    thread->cpu_time = thread_cpu_time(CLOCK_THREAD_CPUTIME_ID);
+    thread_dbg(THREAD_DBG_CPU_TIME, "thread %s cpu time %lld us\n",
+               thread->name, thread->cpu_time);
+
+    return ret;
+}
+
 MppThread *mpp_thread_create(MppThreadFunc func, void *ctx, const char *name)
 {
     MppThread *thread = mpp_malloc(MppThread, 1);
@@ -27,6 +199,10 @@ MppThread *mpp_thread_create(MppThreadFunc func, void *ctx, const char *name)
     if (thread) {
         thread->func = func;
         thread->ctx = ctx;
+        thread->policy.role = MPP_THREAD_ROLE_DEFAULT;
+        thread->policy.place = MPP_THREAD_PLACE_DEFAULT;
+        thread->policy.prio = 0;
+        thread->cpu_time = -1;
 
         thread->thd_status[THREAD_WORK] = MPP_THREAD_UNINITED;
         thread->thd_status[THREAD_INPUT] = MPP_THREAD_RUNNING;
@@ -63,7 +239,7 @@ void mpp_thread_start(MppThread *thread)
 
     if (mpp_thread_get_status(thread, THREAD_WORK) == MPP_THREAD_UNINITED) {
         mpp_thread_set_status(thread, MPP_THREAD_RUNNING, THREAD_WORK);
-        if (0 == pthread_create(&thread->thd, &attr, thread->func, thread->ctx)) {
+        if (0 == pthread_create(&thread->thd, &attr, mpp_thread_entry, thread)) {
             int ret = pthread_setname_np(thread->thd, thread->name);
             if (ret) {
                 mpp_err("thread %p setname %s failed\n", thread->func, thread->name);
@@ -97,6 +273,32 @@ void mpp_thread_stop(MppThread *thread)
     }
 }
 
+void mpp_thread_set_policy(MppThread *thread, MppThreadRole role, MppThreadPlace place, rk_s32 prio)
+{
+    if (!thread)
+        return;
+
+    thread->policy.role = role;
+    thread->policy.place = place;
+    thread->policy.prio = prio;
+}
+
+rk_s64 mpp_thread_get_cpu_time(MppThread *thread)
+{
+    clockid_t clk;
+
+    if (!thread)
+        return -1;
+
+    if (mpp_thread_get_status(thread, THREAD_WORK) == MPP_THREAD_UNINITED)
+        return thread->cpu_time;
+
+    if (pthread_getcpuclockid(thread->thd, &clk))
+        return thread->cpu_time;
+
+    return thread_cpu_time(clk);
+}
+
 void mpp_thread_destroy(MppThread *thread)
 {
     if (thread) {
@@ -244,6 +446,10 @@ void mpp_thread_init(MppThread *thread, MppThreadFunc func, void *ctx, const cha
 {
     thread->func = func;
     thread->ctx = ctx;
+    thread->policy.role = MPP_THREAD_ROLE_DEFAULT;
+    thread->policy.place = MPP_THREAD_PLACE_DEFAULT;
+    thread->policy.prio = 0;
+    thread->cpu_time = -1;
     int i;
 
     if (name) {
@@ -306,6 +512,8 @@ typedef struct MppSThdImpl_t {
     pthread_mutex_t lock;
     pthread_cond_t  cond;
     MppSThdCtx      ctx;
+    MppThreadPolicy policy;
+    rk_s64          cpu_time;
 } MppSThdImpl;
 
 typedef struct MppSThdGrpImpl_t {
@@ -347,6 +555,22 @@ static rk_s32 check_sthd(const char *name, MppSThdImpl *thd)
 
 #define CHECK_STHD(thd) check_sthd(__FUNCTION__, (MppSThdImpl *)(thd))
 
+static void *mpp_sthd_entry(void *arg)
+{
+    MppSThdImpl *thd = (MppSThdImpl *)arg;
+    void *ret;
+
+    thread_apply_policy(thd->name, &thd->policy);
+
+    ret = thd->func(&thd->ctx);
+
+    thd->cpu_time = thread_cpu_time(CLOCK_THREAD_CPUTIME_ID);
+    thread_dbg(THREAD_DBG_CPU_TIME, "thread %s cpu time %lld us\n",
+               thd->name, thd->cpu_time);
+
+    return ret;
+}
+
 static void mpp_sthd_init(MppSThdImpl *thd, rk_s32 idx)
 {
     pthread_mutexattr_t attr;
@@ -359,6 +583,7 @@ static void mpp_sthd_init(MppSThdImpl *thd, rk_s32 idx)
     pthread_cond_init(&thd->cond, NULL);
     thd->ctx.thd = thd;
     thd->idx = idx;
+    thd->cpu_time = -1;
 }
 
 static void mpp_sthd_deinit(MppSThdImpl *thd)
@@ -388,7 +613,7 @@ static MPP_RET mpp_sthd_create(MppSThdImpl *thd)
 
     // NOTE: set status to running first
     thd->status = MPP_STHD_RUNNING;
-    if (0 == pthread_create(&thd->thd, &attr, (MppThreadFunc)thd->func, &thd->ctx)) {
+    if (0 == pthread_create(&thd->thd, &attr, mpp_sthd_entry, thd)) {
         ret = (MPP_RET)pthread_setname_np(thd->thd, thd->name);
         if (ret)
             mpp_err("%s %p setname failed\n", thd->thd, thd->func);
@@ -496,6 +721,34 @@ void mpp_sthd_setup(MppSThd thd, MppSThdFunc func, void *ctx)
     CHECK_STHD(impl);
 }
 
+void mpp_sthd_set_policy(MppSThd thd, MppThreadRole role, MppThreadPlace place, rk_s32 prio)
+{
+    MppSThdImpl *impl = (MppSThdImpl *)thd;
+
+    if (CHECK_STHD(impl))
+        return;
+
+    pthread_mutex_lock(&impl->lock);
+    impl->policy.role = role;
+    impl->policy.place = place;
+    impl->policy.prio = prio;
+    pthread_mutex_unlock(&impl->lock);
+}
+
+rk_s64 mpp_sthd_get_cpu_time(MppSThd thd)
+{
+    MppSThdImpl *impl = (MppSThdImpl *)thd;
+    clockid_t clk;
+
+    if (CHECK_STHD(impl))
+        return -1;
+
+    if (impl->status < MPP_STHD_RUNNING || pthread_getcpuclockid(impl->thd, &clk))
+        return impl->cpu_time;
+
+    return thread_cpu_time(clk);
+}
+
 void mpp_sthd_start(MppSThd thd)
 {
     MppSThdImpl *impl = (MppSThdImpl *)thd;
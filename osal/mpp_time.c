@@ -41,6 +41,8 @@ typedef struct MppClockImpl_t {
     rk_s64  time;
     rk_s64  sum;
     rk_s64  count;
+    MppStats stats;
+    MppStatsHist hist;
 } MppClockImpl;
 
 static const char *clock_name = "mpp_clock";
@@ -98,7 +100,8 @@ rk_s64 mpp_clock_start(MppClock clk)
         return 0;
     }
 
-    if (!p->enable)
+    /* attached histogram is always recorded */
+    if (!p->enable && !p->stats)
         return 0;
 
     p->base = mpp_time();
@@ -116,15 +119,20 @@ rk_s64 mpp_clock_pause(MppClock clk)
         return 0;
     }
 
-    if (!p->enable)
+    if (!p->enable && !p->stats)
         return 0;
 
     time = mpp_time();
 
     if (!p->time) {
         // first pause after start
-        p->sum += time - p->base;
-        p->count++;
+        if (p->enable) {
+            p->sum += time - p->base;
+            p->count++;
+        }
+
+        if (p->stats)
+            mpp_stats_record(p->stats, p->hist, time - p->base);
     }
 
     p->time = time;
@@ -184,6 +192,19 @@ const char *mpp_clock_get_name(MppClock clk)
     return p->name;
 }
 
+void mpp_clock_set_stats(MppClock clk, MppStats stats, MppStatsHist id)
+{
+    MppClockImpl *p = (MppClockImpl *)clk;
+
+    if (check_is_mpp_clock(p)) {
+        mpp_err_f("invalid clock %p\n", p);
+        return;
+    }
+
+    p->stats = stats;
+    p->hist = id;
+}
+
 typedef struct MppTimerImpl_t {
     const char          *check;
     char                name[16];
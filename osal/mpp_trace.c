@@ -7,16 +7,33 @@
 
 #include <fcntl.h>
 #include <stdarg.h>
+#include <stdio.h>
+#include <time.h>
+#include <sys/prctl.h>
+#include <sys/syscall.h>
 
+#include "mpp_env.h"
 #include "mpp_log.h"
 #include "mpp_mem.h"
+#include "mpp_list.h"
+#include "mpp_lock.h"
 #include "mpp_common.h"
+#include "mpp_thread.h"
 #include "mpp_singleton.h"
 
 #include "mpp_trace.h"
 
 #define ATRACE_MESSAGE_LENGTH 256
 
+#define TRACE_EVT_RING_SIZE     4096
+#define TRACE_EVT_RING_MAX      64
+
+#ifdef __ANDROID__
+#define TRACE_EVT_PATH          "/data/mpp_trace.json"
+#else
+#define TRACE_EVT_PATH          "/tmp/mpp_trace.json"
+#endif
+
 #define get_srv_trace() \
     ({ \
         MppTraceSrv *__tmp; \
@@ -37,7 +54,171 @@ typedef struct  MppTraceSrv_t {
     rk_s32      fd;
 } MppTraceSrv;
 
+/* 24 bytes binary event record */
+typedef struct MppTraceEvtRec_t {
+    rk_s64              time;
+    rk_u32              evt;
+    rk_u32              sid;
+    rk_s32              idx;
+    rk_u32              reserved;
+} MppTraceEvtRec;
+
+/* single producer ring owned by one thread */
+typedef struct MppTraceEvtRing_t {
+    struct list_head    link;
+    char                name[THREAD_NAME_LEN];
+    rk_s32              tid;
+    rk_s32              alive;
+    rk_u32              mask;
+    rk_u32              wpos;
+    MppTraceEvtRec      *recs;
+} MppTraceEvtRing;
+
+typedef struct MppTraceEvtSrv_t {
+    MppMutex            lock;
+    pthread_key_t       key;
+    struct list_head    rings;
+    rk_s32              ring_cnt;
+    rk_u32              ring_size;
+    rk_u32              sid;
+    rk_u32              dropped;
+    const char          *path;
+} MppTraceEvtSrv;
+
+typedef struct MppTraceEvtInfo_t {
+    const char          *name;
+    const char          *ph;
+} MppTraceEvtInfo;
+
+static const MppTraceEvtInfo trace_evt_info[MPP_TRACE_EVT_BUTT] = {
+    { "pkt_in",     "i" },
+    { "parse",      "B" },
+    { "parse",      "E" },
+    { "reg_gen",    "B" },
+    { "reg_gen",    "E" },
+    { "hw",         "b" },
+    { "hw",         "e" },
+    { "vproc",      "B" },
+    { "vproc",      "E" },
+    { "frm_out",    "i" },
+};
+
 static MppTraceSrv *srv_trace = NULL;
+static MppTraceEvtSrv *srv_evt = NULL;
+rk_u32 mpp_trace_evt_en = 0;
+
+static void trace_evt_ring_retire(void *ctx)
+{
+    MppTraceEvtRing *ring = (MppTraceEvtRing *)ctx;
+
+    if (ring)
+        ring->alive = 0;
+}
+
+static void trace_evt_srv_init(void)
+{
+    MppTraceEvtSrv *srv;
+    rk_u32 size = TRACE_EVT_RING_SIZE;
+    rk_u32 enable = 0;
+
+    mpp_env_get_u32("mpp_trace_evt", &enable, 0);
+    mpp_env_get_u32("mpp_trace_evt_size", &size, TRACE_EVT_RING_SIZE);
+
+    srv = mpp_calloc(MppTraceEvtSrv, 1);
+    if (!srv) {
+        mpp_err_f("failed to allocate event trace service\n");
+        return;
+    }
+
+    if (pthread_key_create(&srv->key, trace_evt_ring_retire)) {
+        mpp_err_f("failed to create event trace key\n");
+        mpp_free(srv);
+        return;
+    }
+
+    if (size < 16)
+        size = 16;
+    /* round up to power of 2 for index masking */
+    while (size & (size - 1))
+        size += size & (~size + 1);
+
+    mpp_mutex_init(&srv->lock);
+    INIT_LIST_HEAD(&srv->rings);
+    srv->ring_size = size;
+    mpp_env_get_str("mpp_trace_evt_path", &srv->path, TRACE_EVT_PATH);
+
+    srv_evt = srv;
+    mpp_trace_evt_en = enable;
+}
+
+static void trace_evt_srv_deinit(void)
+{
+    MppTraceEvtSrv *srv = srv_evt;
+    MppTraceEvtRing *ring, *n;
+
+    if (!srv)
+        return;
+
+    if (mpp_trace_evt_en) {
+        mpp_trace_evt_dump(srv->path);
+        mpp_trace_evt_en = 0;
+    }
+
+    list_for_each_entry_safe(ring, n, &srv->rings, MppTraceEvtRing, link) {
+        list_del_init(&ring->link);
+        mpp_free(ring->recs);
+        mpp_free(ring);
+    }
+
+    pthread_key_delete(srv->key);
+    mpp_mutex_destroy(&srv->lock);
+    mpp_free(srv);
+    srv_evt = NULL;
+}
+
+static MppTraceEvtRing *trace_evt_ring_get(MppTraceEvtSrv *srv)
+{
+    MppTraceEvtRing *ring = NULL;
+    MppTraceEvtRing *pos;
+
+    mpp_mutex_lock(&srv->lock);
+
+    if (srv->ring_cnt < TRACE_EVT_RING_MAX) {
+        ring = mpp_calloc(MppTraceEvtRing, 1);
+        if (ring) {
+            ring->recs = mpp_calloc(MppTraceEvtRec, srv->ring_size);
+            if (!ring->recs)
+                MPP_FREE(ring);
+        }
+        if (ring) {
+            INIT_LIST_HEAD(&ring->link);
+            list_add_tail(&ring->link, &srv->rings);
+            srv->ring_cnt++;
+        }
+    } else {
+        /* too many threads, reuse the ring of an exited thread */
+        list_for_each_entry(pos, &srv->rings, MppTraceEvtRing, link) {
+            if (!pos->alive) {
+                ring = pos;
+                list_move_tail(&ring->link, &srv->rings);
+                break;
+            }
+        }
+    }
+
+    if (ring) {
+        ring->mask = srv->ring_size - 1;
+        ring->wpos = 0;
+        ring->alive = 1;
+        ring->tid = (rk_s32)syscall(SYS_gettid);
+        prctl(PR_GET_NAME, ring->name, 0, 0, 0);
+        ring->name[THREAD_NAME_LEN - 1] = '\0';
+    }
+
+    mpp_mutex_unlock(&srv->lock);
+
+    return ring;
+}
 
 static void mpp_trace_srv_init()
 {
@@ -150,4 +331,126 @@ void mpp_trace_int64(const char* name, RK_S64 value)
         mpp_trace_write(srv->fd, "C|%d|%s|%lld", getpid(), name, value);
 }
 
-MPP_SINGLETON(MPP_SGLN_TRACE, mpp_trace, mpp_trace_srv_init, mpp_trace_srv_deinit)
+rk_u32 mpp_trace_evt_sid(void)
+{
+    MppTraceEvtSrv *srv = srv_evt;
+
+    return srv ? MPP_ADD_FETCH(&srv->sid, 1) : 0;
+}
+
+void mpp_trace_evt_enable(rk_u32 enable)
+{
+    if (srv_evt)
+        mpp_trace_evt_en = enable ? 1 : 0;
+}
+
+void mpp_trace_evt_record(MppTraceEvt evt, rk_u32 sid, rk_s32 idx)
+{
+    MppTraceEvtSrv *srv = srv_evt;
+    MppTraceEvtRing *ring;
+    MppTraceEvtRec *rec;
+    struct timespec ts;
+    rk_u32 pos;
+
+    if (!srv || evt >= MPP_TRACE_EVT_BUTT)
+        return;
+
+    ring = (MppTraceEvtRing *)pthread_getspecific(srv->key);
+    if (!ring) {
+        ring = trace_evt_ring_get(srv);
+        if (!ring) {
+            MPP_FETCH_ADD(&srv->dropped, 1);
+            return;
+        }
+        pthread_setspecific(srv->key, ring);
+    }
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    /* the owner thread is the only writer, publish record by wpos update */
+    pos = ring->wpos;
+    rec = &ring->recs[pos & ring->mask];
+    rec->time = (rk_s64)ts.tv_sec * 1000000000 + ts.tv_nsec;
+    rec->evt = evt;
+    rec->sid = sid;
+    rec->idx = idx;
+    __atomic_store_n(&ring->wpos, pos + 1, __ATOMIC_RELEASE);
+}
+
+rk_s32 mpp_trace_evt_dump(const char *path)
+{
+    MppTraceEvtSrv *srv = srv_evt;
+    MppTraceEvtRing *ring;
+    rk_s32 pid = getpid();
+    rk_s32 first = 1;
+    rk_s32 cnt = 0;
+    FILE *fp;
+
+    if (!srv || !path)
+        return rk_nok;
+
+    fp = fopen(path, "w");
+    if (!fp) {
+        mpp_err_f("failed to open %s\n", path);
+        return rk_nok;
+    }
+
+    fprintf(fp, "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[");
+
+    mpp_mutex_lock(&srv->lock);
+
+    list_for_each_entry(ring, &srv->rings, MppTraceEvtRing, link) {
+        rk_u32 end = __atomic_load_n(&ring->wpos, __ATOMIC_ACQUIRE);
+        rk_u32 start = (end > ring->mask + 1) ? (end - ring->mask - 1) : 0;
+        rk_u32 i;
+
+        fprintf(fp, "%s\n{\"ph\":\"M\",\"name\":\"thread_name\",\"pid\":%d,"
+                "\"tid\":%d,\"args\":{\"name\":\"%s\"}}",
+                first ? "" : ",", pid, ring->tid, ring->name);
+        first = 0;
+
+        for (i = start; i != end; i++) {
+            MppTraceEvtRec *rec = &ring->recs[i & ring->mask];
+            const MppTraceEvtInfo *info = &trace_evt_info[rec->evt];
+
+            fprintf(fp, ",\n{\"ph\":\"%s\",\"name\":\"%s\",\"cat\":\"mpp\","
+                    "\"pid\":%d,\"tid\":%d,\"ts\":%lld.%03lld,"
+                    "\"args\":{\"sid\":%u,\"idx\":%d}",
+                    info->ph, info->name, pid, ring->tid,
+                    rec->time / 1000, rec->time % 1000, rec->sid, rec->idx);
+            /* async hardware span links parser thread and hal thread */
+            if (info->ph[0] == 'b' || info->ph[0] == 'e')
+                fprintf(fp, ",\"id\":\"%u.%d\"", rec->sid, rec->idx);
+            else if (info->ph[0] == 'i')
+                fprintf(fp, ",\"s\":\"t\"");
+            fprintf(fp, "}");
+            cnt++;
+        }
+    }
+
+    if (srv->dropped)
+        mpp_log_f("%u events dropped for too many threads\n", srv->dropped);
+
+    mpp_mutex_unlock(&srv->lock);
+
+    fprintf(fp, "\n]}\n");
+    fclose(fp);
+
+    mpp_log_f("dump %d events to %s\n", cnt, path);
+
+    return rk_ok;
+}
+
+static void mpp_trace_init(void)
+{
+    mpp_trace_srv_init();
+    trace_evt_srv_init();
+}
+
+static void mpp_trace_deinit(void)
+{
+    trace_evt_srv_deinit();
+    mpp_trace_srv_deinit();
+}
+
+MPP_SINGLETON(MPP_SGLN_TRACE, mpp_trace, mpp_trace_init, mpp_trace_deinit)
@@ -0,0 +1,69 @@
+/* SPDX-License-Identifier: Apache-2.0 OR MIT */
+/*
+ * Copyright (c) 2026 Rockchip Electronics Co., Ltd.
+ */
+
+#define MODULE_TAG "mpp_capacity_test"
+
+#include "mpp_log.h"
+#include "mpp_soc.h"
+#include "mpp_capacity.h"
+
+#define MAX_SESSION     64
+
+int main(void)
+{
+    MppLoad loads[MAX_SESSION];
+    rk_s32 percent = 0;
+    rk_s32 before = 0;
+    rk_s32 ret = rk_nok;
+    rk_s32 count = 0;
+    rk_s32 i;
+
+    mpp_log("mpp capacity test start on %s\n", mpp_get_soc_name());
+
+    if (mpp_load_predict(MPP_CTX_DEC, MPP_VIDEO_CodingAVC, 1920, 1080, 30, &before)) {
+        mpp_log("no avc decoder capacity model on this soc\n");
+        return rk_ok;
+    }
+
+    mpp_log("one 1080p30 avc decoder load %d%%\n", before);
+
+    /* add 1080p30 sessions until the hardware is full */
+    for (i = 0; i < MAX_SESSION; i++) {
+        if (mpp_load_predict(MPP_CTX_DEC, MPP_VIDEO_CodingAVC, 1920, 1080, 30, &percent))
+            break;
+
+        mpp_load_get(&loads[i], MPP_CTX_DEC, MPP_VIDEO_CodingAVC);
+        if (mpp_load_update(loads[i], 1920, 1080, 30)) {
+            mpp_err("session %d update overloaded after predict ok\n", i);
+            mpp_load_put(loads[i]);
+            goto DONE;
+        }
+        count++;
+    }
+
+    mpp_log("%d 1080p30 avc decoder sessions admitted, next one load %d%%\n",
+            count, percent);
+
+    /* the next session should overload and the released one should be admitted */
+    if (count && count < MAX_SESSION && percent > 100) {
+        mpp_load_put(loads[--count]);
+        if (!mpp_load_predict(MPP_CTX_DEC, MPP_VIDEO_CodingAVC, 1920, 1080, 30, NULL))
+            ret = rk_ok;
+    }
+
+DONE:
+    for (i = 0; i < count; i++)
+        mpp_load_put(loads[i]);
+
+    if (!ret) {
+        mpp_load_predict(MPP_CTX_DEC, MPP_VIDEO_CodingAVC, 1920, 1080, 30, &percent);
+        if (percent != before)
+            ret = rk_nok;
+    }
+
+    mpp_log("mpp capacity test %s\n", ret ? "failed" : "success");
+
+    return ret;
+}
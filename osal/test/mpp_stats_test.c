@@ -0,0 +1,81 @@
+/* SPDX-License-Identifier: Apache-2.0 OR MIT */
+/*
+ * Copyright (c) 2026 Rockchip Electronics Co., Ltd.
+ */
+
+#define MODULE_TAG "mpp_stats_test"
+
+#include "mpp_log.h"
+#include "mpp_time.h"
+#include "mpp_stats_impl.h"
+
+int main(void)
+{
+    MppStats stats = NULL;
+    MppStatsInfo info;
+    MppStatsHistInfo *hist;
+    MppClock clk;
+    rk_s32 ret = rk_nok;
+    rk_s32 i;
+
+    mpp_log("mpp stats test start\n");
+
+    if (mpp_stats_get(&stats, "mpp_stats_test")) {
+        mpp_err("mpp stats get failed\n");
+        return ret;
+    }
+
+    for (i = 0; i < 1000; i++) {
+        mpp_stats_add(stats, MPP_STATS_CNT_FRM_IN, 1);
+        mpp_stats_add(stats, MPP_STATS_CNT_BYTES_COPY, 64);
+        mpp_stats_record(stats, MPP_STATS_HIST_PARSE, i + 1);
+    }
+
+    clk = mpp_clock_get("stats_clk");
+    /* histogram is recorded on a disabled clock */
+    mpp_clock_set_stats(clk, stats, MPP_STATS_HIST_HW);
+    for (i = 0; i < 4; i++) {
+        mpp_clock_start(clk);
+        msleep(2);
+        mpp_clock_pause(clk);
+    }
+    mpp_clock_put(clk);
+
+    mpp_stats_read(stats, &info);
+    hist = &info.hist[MPP_STATS_HIST_PARSE];
+
+    mpp_log("frm_in %llu bytes_copy %llu\n", info.cnt[MPP_STATS_CNT_FRM_IN],
+            info.cnt[MPP_STATS_CNT_BYTES_COPY]);
+    mpp_log("parse count %llu min %llu max %llu avg %llu p50 %llu p99 %llu\n",
+            hist->count, hist->min, hist->max, hist->sum / hist->count,
+            mpp_stats_hist_percentile(hist, 50),
+            mpp_stats_hist_percentile(hist, 99));
+    mpp_log("hw count %llu avg %llu us\n", info.hist[MPP_STATS_HIST_HW].count,
+            info.hist[MPP_STATS_HIST_HW].sum / info.hist[MPP_STATS_HIST_HW].count);
+
+    do {
+        rk_u64 p50 = mpp_stats_hist_percentile(hist, 50);
+        rk_u64 p99 = mpp_stats_hist_percentile(hist, 99);
+
+        if (info.version != MPP_STATS_VERSION || info.size != sizeof(info))
+            break;
+        if (info.cnt[MPP_STATS_CNT_FRM_IN] != 1000 ||
+            info.cnt[MPP_STATS_CNT_BYTES_COPY] != 64000)
+            break;
+        if (hist->count != 1000 || hist->min != 1 || hist->max != 1000)
+            break;
+        /* log-linear bins keep percentile error under 25% */
+        if (p50 < 500 || p50 > 625 || p99 < 990 || p99 > 1000)
+            break;
+        if (info.hist[MPP_STATS_HIST_HW].count != 4)
+            break;
+
+        ret = rk_ok;
+    } while (0);
+
+    mpp_stats_put(stats);
+
+    mpp_log("mpp stats test %s\n", ret ? "failed" : "success");
+
+    return ret;
+}
@@ -93,6 +93,19 @@ void *mutex_performance_test_loop_1(void *arg)
     return NULL;
 }
 
+void *policy_test_loop(void *arg)
+{
+    volatile RK_U64 sum = 0;
+    RK_S64 start = mpp_time();
+
+    /* burn cpu for about 50ms */
+    while (mpp_time() - start < 50000)
+        sum++;
+
+    (void)arg;
+    return NULL;
+}
+
 void mutex_performance_test_once(void)
 {
     pthread_mutexattr_t attr;
@@ -177,6 +190,24 @@ int main(void)
 
     pthread_attr_destroy(&attr);
 
+    {
+        MppThread *thd = mpp_thread_create(policy_test_loop, NULL, "policy_test");
+        RK_S64 cpu_time;
+
+        mpp_thread_set_policy(thd, MPP_THREAD_ROLE_COMPUTE, MPP_THREAD_PLACE_PREFER, 0);
+        mpp_thread_start(thd);
+        mpp_thread_stop(thd);
+
+        cpu_time = mpp_thread_get_cpu_time(thd);
+        mpp_log("policy thread cpu time %lld us\n", cpu_time);
+        mpp_thread_destroy(thd);
+
+        if (cpu_time < 10000) {
+            mpp_err("invalid thread cpu time %lld\n", cpu_time);
+            return -1;
+        }
+    }
+
     mpp_debug = 0;
     mpp_log("vpu test end\n");
     return 0;
@@ -22,6 +22,27 @@ int main(void)
     mpp_trace_int32("mpp_trace_test int32", 256);
     mpp_trace_int64("mpp_trace_test int64", 100000000);
 
+    {
+        rk_u32 sid = mpp_trace_evt_sid();
+        rk_s32 i;
+
+        mpp_trace_evt_enable(1);
+
+        for (i = 0; i < 8; i++) {
+            mpp_trace_evt(MPP_TRACE_EVT_PKT_IN, sid, i);
+            mpp_trace_evt(MPP_TRACE_EVT_PARSE_BEG, sid, i);
+            mpp_trace_evt(MPP_TRACE_EVT_PARSE_END, sid, i);
+            mpp_trace_evt(MPP_TRACE_EVT_HW_START, sid, i);
+            mpp_trace_evt(MPP_TRACE_EVT_HW_DONE, sid, i);
+            mpp_trace_evt(MPP_TRACE_EVT_FRM_OUT, sid, i);
+        }
+
+        if (mpp_trace_evt_dump("/tmp/mpp_trace_test.json"))
+            mpp_log("mpp trace event dump failed\n");
+
+        mpp_trace_evt_enable(0);
+    }
+
     mpp_log("mpp trace test done\n");
 
     return 0;
@@ -0,0 +1,190 @@
+/* SPDX-License-Identifier: Apache-2.0 OR MIT */
+/*
+ * Copyright (c) 2026 Rockchip Electronics Co., Ltd.
+ */
+
+#define MODULE_TAG "mpi_dec_batch_test"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "rk_mpi.h"
+#include "rk_vdec_batch.h"
+
+#include "mpp_log.h"
+#include "mpp_time.h"
+#include "mpp_common.h"
+
+typedef struct BatchTestCtx_t {
+    const char      *file_in;
+    RK_S32          width;
+    RK_S32          height;
+    RK_S32          images;
+    RK_S32          batch;
+    MppBufferGroup  group;
+    MppBuffer       pkt_buf;
+    size_t          pkt_size;
+    MppFrame        frames[MPP_DEC_BATCH_DEPTH_MAX * 4];
+} BatchTestCtx;
+
+static void batch_test_usage(const char *name)
+{
+    mpp_log("usage: %s -i input.jpg -w width -h height [-n images] [-b batch]\n", name);
+    mpp_log("decodes the jpeg -n times one by one and then in batches of -b\n");
+    mpp_log("images and reports the images per second of both runs\n");
+}
+
+static MPP_RET batch_test_load(BatchTestCtx *ctx)
+{
+    FILE *fp = fopen(ctx->file_in, "rb");
+    MPP_RET ret = MPP_NOK;
+    long size;
+
+    if (!fp) {
+        mpp_err("failed to open input %s\n", ctx->file_in);
+        return MPP_NOK;
+    }
+
+    fseek(fp, 0, SEEK_END);
+    size = ftell(fp);
+    fseek(fp, 0, SEEK_SET);
+
+    if (size > 0 && !mpp_buffer_get(ctx->group, &ctx->pkt_buf, size) &&
+        fread(mpp_buffer_get_ptr(ctx->pkt_buf), 1, size, fp) == (size_t)size) {
+        ctx->pkt_size = size;
+        ret = MPP_OK;
+    } else {
+        mpp_err("failed to read input %s size %ld\n", ctx->file_in, size);
+    }
+
+    fclose(fp);
+
+    return ret;
+}
+
+/* decode all images batch images per call, return elapsed time in us */
+static MPP_RET batch_test_run(BatchTestCtx *ctx, RK_S32 depth, RK_S32 batch,
+                              RK_S64 *elapsed)
+{
+    MppPacket packets[MPP_DEC_BATCH_DEPTH_MAX * 4];
+    MppDecBatch dec = NULL;
+    RK_S32 errors = 0;
+    RK_S32 done = 0;
+    RK_S64 start;
+    MPP_RET ret;
+    RK_S32 i;
+
+    ret = mpp_dec_batch_init(&dec, depth);
+    if (ret)
+        return ret;
+
+    start = mpp_time();
+
+    while (!ret && done < ctx->images) {
+        RK_S32 count = MPP_MIN(batch, ctx->images - done);
+
+        for (i = 0; i < count; i++) {
+            mpp_packet_init_with_buffer(&packets[i], ctx->pkt_buf);
+            mpp_packet_set_length(packets[i], ctx->pkt_size);
+            mpp_frame_set_errinfo(ctx->frames[i], 0);
+        }
+
+        ret = mpp_dec_batch_decode(dec, packets, ctx->frames, count);
+
+        for (i = 0; i < count; i++) {
+            errors += mpp_frame_get_errinfo(ctx->frames[i]) ? 1 : 0;
+            mpp_packet_deinit(&packets[i]);
+        }
+
+        done += count;
+    }
+
+    *elapsed = mpp_time() - start;
+
+    mpp_log("depth %d batch %d images %d errors %d fps %.2f\n", depth, batch,
+            done, errors, *elapsed ? done * 1000000.0 / *elapsed : 0);
+
+    mpp_dec_batch_deinit(dec);
+
+    return ret;
+}
+
+int main(int argc, char **argv)
+{
+    BatchTestCtx ctx;
+    RK_S64 elapsed[2] = { 0 };
+    size_t frm_size;
+    MPP_RET ret = MPP_NOK;
+    RK_S32 i;
+
+    memset(&ctx, 0, sizeof(ctx));
+    ctx.images = 1000;
+    ctx.batch = MPP_DEC_BATCH_DEPTH_MAX;
+
+    for (i = 1; i + 1 < argc; i += 2) {
+        if (!strcmp(argv[i], "-i"))
+            ctx.file_in = argv[i + 1];
+        else if (!strcmp(argv[i], "-w"))
+            ctx.width = atoi(argv[i + 1]);
+        else if (!strcmp(argv[i], "-h"))
+            ctx.height = atoi(argv[i + 1]);
+        else if (!strcmp(argv[i], "-n"))
+            ctx.images = atoi(argv[i + 1]);
+        else if (!strcmp(argv[i], "-b"))
+            ctx.batch = atoi(argv[i + 1]);
+    }
+
+    if (!ctx.file_in || ctx.width <= 0 || ctx.height <= 0 || ctx.images <= 0 ||
+        ctx.batch <= 0 || ctx.batch > (RK_S32)MPP_ARRAY_ELEMS(ctx.frames)) {
+        batch_test_usage(argv[0]);
+        return -1;
+    }
+
+    if (mpp_buffer_group_get_internal(&ctx.group, MPP_BUFFER_TYPE_ION)) {
+        mpp_err("failed to get buffer group\n");
+        return -1;
+    }
+
+    if (batch_test_load(&ctx))
+        goto DONE;
+
+    /* yuv444 output takes three times the aligned size */
+    frm_size = MPP_ALIGN(ctx.width, 16) * MPP_ALIGN(ctx.height, 16) * 3;
+
+    for (i = 0; i < ctx.batch; i++) {
+        MppBuffer buf = NULL;
+
+        if (mpp_buffer_get(ctx.group, &buf, frm_size)) {
+            mpp_err("failed to get frame buffer\n");
+            goto DONE;
+        }
+
+        mpp_frame_init(&ctx.frames[i]);
+        mpp_frame_set_buffer(ctx.frames[i], buf);
+        mpp_buffer_put(buf);
+    }
+
+    /* one image at a time as the mpi advanced mode, then the batch */
+    ret = batch_test_run(&ctx, 1, 1, &elapsed[0]);
+    if (!ret)
+        ret = batch_test_run(&ctx, 0, ctx.batch, &elapsed[1]);
+
+    if (!ret && elapsed[0] && elapsed[1])
+        mpp_log("fps %.2f -> %.2f speedup %.2f\n",
+                ctx.images * 1000000.0 / elapsed[0], ctx.images * 1000000.0 / elapsed[1],
+                (double)elapsed[0] / elapsed[1]);
+
+DONE:
+    for (i = 0; i < ctx.batch && i < (RK_S32)MPP_ARRAY_ELEMS(ctx.frames); i++)
+        if (ctx.frames[i])
+            mpp_frame_deinit(&ctx.frames[i]);
+    if (ctx.pkt_buf)
+        mpp_buffer_put(ctx.pkt_buf);
+    if (ctx.group)
+        mpp_buffer_group_put(ctx.group);
+
+    mpp_log("mpi_dec_batch_test %s\n", ret ? "failed" : "success");
+
+    return ret;
+}
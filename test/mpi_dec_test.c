@@ -44,6 +44,10 @@ typedef struct {
     float           frame_rate;
     RK_S64          elapsed_time;
     RK_S64          delay;
+    /* put to get latency of access unit packet */
+    RK_S64          latency_sum;
+    RK_S64          latency_max;
+    RK_S32          latency_cnt;
     FILE            *fp_verify;
     FrmCrc          checkcrc;
 } MpiDecLoopData;
@@ -87,6 +91,13 @@ static int dec_simple(MpiDecLoopData *data)
     // setup eos flag
     if (pkt_eos)
         mpp_packet_set_eos(packet);
+    // whole access unit packet carries put time in pts for latency check
+    if (slot->eoi) {
+        mpp_packet_set_eoi(packet);
+        mpp_packet_set_pts(packet, mpp_time());
+    } else {
+        mpp_packet_clr_eoi(packet);
+    }
 
     do {
         RK_U32 frm_eos = 0;
@@ -180,6 +191,14 @@ static int dec_simple(MpiDecLoopData *data)
                     if (!data->first_frm)
                         data->first_frm = mpp_time();
 
+                    if (slot->eoi && !discard) {
+                        RK_S64 latency = mpp_time() - mpp_frame_get_pts(frame);
+
+                        data->latency_sum += latency;
+                        data->latency_max = MPP_MAX(data->latency_max, latency);
+                        data->latency_cnt++;
+                    }
+
                     log_len += snprintf(log_buf + log_len, log_size - log_len,
                                         "decode get frame %d", data->frame_count);
 
@@ -400,6 +419,10 @@ void *thread_decode(void *arg)
             data->frame_count, (RK_S64)(data->elapsed_time / 1000),
             (RK_S32)(data->delay / 1000), data->frame_rate);
 
+    if (data->latency_cnt)
+        mpp_log("access unit latency avg %lld us max %lld us\n",
+                data->latency_sum / data->latency_cnt, data->latency_max);
+
     MPP_FREE(data->checkcrc.luma.sum);
     MPP_FREE(data->checkcrc.chroma.sum);
 
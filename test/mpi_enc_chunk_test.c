@@ -0,0 +1,257 @@
+/* SPDX-License-Identifier: Apache-2.0 OR MIT */
+/*
+ * Copyright (c) 2026 Rockchip Electronics Co., Ltd.
+ */
+
+#define MODULE_TAG "mpi_enc_chunk_test"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "rk_mpi.h"
+#include "rk_venc_cfg.h"
+#include "rk_venc_chunk.h"
+
+#include "mpp_log.h"
+#include "mpp_time.h"
+#include "mpp_common.h"
+
+#include "utils.h"
+
+#define CHUNK_TEST_GOP      60
+#define CHUNK_TEST_FPS      30
+#define CHUNK_TEST_BPS      (8 * 1024 * 1024)
+
+typedef struct ChunkTestCtx_t {
+    const char      *file_in;
+    const char      *file_out;
+    MppCodingType   type;
+    RK_S32          width;
+    RK_S32          height;
+    RK_S32          hor_stride;
+    RK_S32          ver_stride;
+    RK_S32          frames;
+    RK_S32          chunk_frames;
+    MppBufferGroup  group;
+} ChunkTestCtx;
+
+static void chunk_test_usage(const char *name)
+{
+    mpp_log("usage: %s -i input.yuv -w width -h height [-t type] [-n frames]\n", name);
+    mpp_log("       [-c chunk frames] [-s sessions] [-o output]\n");
+    mpp_log("input is nv12, encodes with 1 session then with -s sessions and\n");
+    mpp_log("writes the stitched stream of the last run to output\n");
+}
+
+static MPP_RET chunk_test_cfg(ChunkTestCtx *ctx, MppEncChunk chunk)
+{
+    MppEncCfg cfg = NULL;
+    MPP_RET ret;
+
+    mpp_enc_cfg_init(&cfg);
+    mpp_enc_cfg_set_s32(cfg, "prep:width", ctx->width);
+    mpp_enc_cfg_set_s32(cfg, "prep:height", ctx->height);
+    mpp_enc_cfg_set_s32(cfg, "prep:hor_stride", ctx->hor_stride);
+    mpp_enc_cfg_set_s32(cfg, "prep:ver_stride", ctx->ver_stride);
+    mpp_enc_cfg_set_s32(cfg, "prep:format", MPP_FMT_YUV420SP);
+    mpp_enc_cfg_set_s32(cfg, "rc:mode", MPP_ENC_RC_MODE_VBR);
+    mpp_enc_cfg_set_s32(cfg, "rc:bps_target", CHUNK_TEST_BPS);
+    mpp_enc_cfg_set_s32(cfg, "rc:bps_max", CHUNK_TEST_BPS * 17 / 16);
+    mpp_enc_cfg_set_s32(cfg, "rc:bps_min", CHUNK_TEST_BPS / 16);
+    mpp_enc_cfg_set_s32(cfg, "rc:fps_in_num", CHUNK_TEST_FPS);
+    mpp_enc_cfg_set_s32(cfg, "rc:fps_in_denom", 1);
+    mpp_enc_cfg_set_s32(cfg, "rc:fps_out_num", CHUNK_TEST_FPS);
+    mpp_enc_cfg_set_s32(cfg, "rc:fps_out_denom", 1);
+    mpp_enc_cfg_set_s32(cfg, "rc:gop", MPP_MIN(CHUNK_TEST_GOP, ctx->chunk_frames));
+    mpp_enc_cfg_set_s32(cfg, "codec:type", ctx->type);
+
+    ret = mpp_enc_chunk_control(chunk, MPP_ENC_SET_CFG, cfg);
+    mpp_enc_cfg_deinit(cfg);
+
+    return ret;
+}
+
+/* write ready packets, return 1 after the eos packet */
+static RK_S32 chunk_test_drain(MppEncChunk chunk, FILE *fp, RK_S64 *bytes,
+                               MppPollType timeout)
+{
+    MppPacket packet = NULL;
+    RK_S32 eos = 0;
+
+    while (!eos) {
+        mpp_enc_chunk_get_packet(chunk, &packet, timeout);
+        if (!packet)
+            break;
+
+        if (fp)
+            fwrite(mpp_packet_get_pos(packet), 1, mpp_packet_get_length(packet), fp);
+        *bytes += mpp_packet_get_length(packet);
+        eos = mpp_packet_get_eos(packet);
+        mpp_packet_deinit(&packet);
+    }
+
+    return eos;
+}
+
+/* encode the input with sessions, return the frame count and elapsed time in us */
+static MPP_RET chunk_test_run(ChunkTestCtx *ctx, RK_S32 sessions, FILE *fp_out,
+                              RK_S32 *frames, RK_S64 *elapsed)
+{
+    size_t size = ctx->hor_stride * ctx->ver_stride * 3 / 2;
+    MppEncChunk chunk = NULL;
+    FILE *fp_in = NULL;
+    RK_S64 bytes = 0;
+    RK_S64 start;
+    RK_S32 eos = 0;
+    RK_S32 n = 0;
+    MPP_RET ret = MPP_NOK;
+
+    fp_in = fopen(ctx->file_in, "rb");
+    if (!fp_in) {
+        mpp_err("failed to open input %s\n", ctx->file_in);
+        return MPP_NOK;
+    }
+
+    if (mpp_enc_chunk_init(&chunk, ctx->type, sessions, ctx->chunk_frames) ||
+        chunk_test_cfg(ctx, chunk))
+        goto DONE;
+
+    start = mpp_time();
+
+    while (!eos) {
+        MppFrame frame = NULL;
+        MppBuffer buf = NULL;
+
+        /* every frame needs its own buffer as it is held until encoded */
+        if (n < ctx->frames) {
+            mpp_buffer_get(ctx->group, &buf, size);
+            if (!buf) {
+                mpp_err("failed to get input buffer\n");
+                goto DONE;
+            }
+
+            if (read_image(mpp_buffer_get_ptr(buf), fp_in, ctx->width, ctx->height,
+                           ctx->hor_stride, ctx->ver_stride, MPP_FMT_YUV420SP)) {
+                mpp_buffer_put(buf);
+                buf = NULL;
+            }
+        }
+
+        mpp_frame_init(&frame);
+        mpp_frame_set_width(frame, ctx->width);
+        mpp_frame_set_height(frame, ctx->height);
+        mpp_frame_set_hor_stride(frame, ctx->hor_stride);
+        mpp_frame_set_ver_stride(frame, ctx->ver_stride);
+        mpp_frame_set_fmt(frame, MPP_FMT_YUV420SP);
+        mpp_frame_set_pts(frame, n);
+        if (buf) {
+            mpp_frame_set_buffer(frame, buf);
+            n++;
+        } else {
+            /* end of input */
+            mpp_frame_set_eos(frame, 1);
+            eos = 1;
+        }
+
+        ret = mpp_enc_chunk_put_frame(chunk, frame);
+        mpp_frame_deinit(&frame);
+        if (buf)
+            mpp_buffer_put(buf);
+        if (ret)
+            goto DONE;
+
+        chunk_test_drain(chunk, fp_out, &bytes, MPP_POLL_NON_BLOCK);
+    }
+
+    chunk_test_drain(chunk, fp_out, &bytes, MPP_POLL_BLOCK);
+
+    *frames = n;
+    *elapsed = mpp_time() - start;
+
+    mpp_log("sessions %d frames %d chunk %d bytes %lld fps %.2f\n",
+            sessions, n, ctx->chunk_frames, bytes,
+            *elapsed ? n * 1000000.0 / *elapsed : 0);
+
+DONE:
+    mpp_enc_chunk_deinit(chunk);
+    fclose(fp_in);
+
+    return ret;
+}
+
+int main(int argc, char **argv)
+{
+    ChunkTestCtx ctx;
+    RK_S32 sessions = 0;
+    RK_S32 frames[2] = { 0 };
+    RK_S64 elapsed[2] = { 0 };
+    FILE *fp_out = NULL;
+    MPP_RET ret = MPP_NOK;
+    RK_S32 i;
+
+    memset(&ctx, 0, sizeof(ctx));
+    ctx.file_out = "mpi_enc_chunk.bin";
+    ctx.type = MPP_VIDEO_CodingAVC;
+    ctx.frames = 300;
+    ctx.chunk_frames = CHUNK_TEST_GOP;
+
+    for (i = 1; i + 1 < argc; i += 2) {
+        if (!strcmp(argv[i], "-i"))
+            ctx.file_in = argv[i + 1];
+        else if (!strcmp(argv[i], "-w"))
+            ctx.width = atoi(argv[i + 1]);
+        else if (!strcmp(argv[i], "-h"))
+            ctx.height = atoi(argv[i + 1]);
+        else if (!strcmp(argv[i], "-t"))
+            ctx.type = (MppCodingType)atoi(argv[i + 1]);
+        else if (!strcmp(argv[i], "-n"))
+            ctx.frames = atoi(argv[i + 1]);
+        else if (!strcmp(argv[i], "-c"))
+            ctx.chunk_frames = atoi(argv[i + 1]);
+        else if (!strcmp(argv[i], "-s"))
+            sessions = atoi(argv[i + 1]);
+        else if (!strcmp(argv[i], "-o"))
+            ctx.file_out = argv[i + 1];
+    }
+
+    if (!ctx.file_in || ctx.width <= 0 || ctx.height <= 0 || ctx.frames <= 0 ||
+        ctx.chunk_frames < 2 || sessions < 0 || sessions > MPP_ENC_CHUNK_SESSION_MAX) {
+        chunk_test_usage(argv[0]);
+        return -1;
+    }
+
+    ctx.hor_stride = MPP_ALIGN(ctx.width, 16);
+    ctx.ver_stride = MPP_ALIGN(ctx.height, 16);
+
+    if (mpp_buffer_group_get_internal(&ctx.group, MPP_BUFFER_TYPE_ION)) {
+        mpp_err("failed to get buffer group\n");
+        return -1;
+    }
+
+    fp_out = fopen(ctx.file_out, "wb");
+    if (!fp_out) {
+        mpp_err("failed to open output %s\n", ctx.file_out);
+        goto DONE;
+    }
+
+    /* single session baseline, then -s sessions, 0 for the encoder core count */
+    ret = chunk_test_run(&ctx, 1, NULL, &frames[0], &elapsed[0]);
+    if (!ret)
+        ret = chunk_test_run(&ctx, sessions, fp_out, &frames[1], &elapsed[1]);
+
+    if (!ret && elapsed[0] && elapsed[1])
+        mpp_log("fps %.2f -> %.2f speedup %.2f stream %s\n",
+                frames[0] * 1000000.0 / elapsed[0], frames[1] * 1000000.0 / elapsed[1],
+                (double)elapsed[0] / elapsed[1], ctx.file_out);
+
+DONE:
+    if (fp_out)
+        fclose(fp_out);
+    if (ctx.group)
+        mpp_buffer_group_put(ctx.group);
+
+    mpp_log("mpi_enc_chunk_test %s\n", ret ? "failed" : "success");
+
+    return ret;
+}
@@ -0,0 +1,185 @@
+/* SPDX-License-Identifier: Apache-2.0 OR MIT */
+/*
+ * Copyright (c) 2026 Rockchip Electronics Co., Ltd.
+ */
+
+#define MODULE_TAG "mpi_enc_sim_test"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "rk_mpi.h"
+#include "rk_venc_cfg.h"
+#include "rk_venc_sim.h"
+
+#include "mpp_log.h"
+#include "mpp_common.h"
+
+#include "utils.h"
+
+#define SIM_TEST_GOP        60
+#define SIM_TEST_FPS        30
+#define SIM_TEST_BPS        (8 * 1024 * 1024)
+
+/* full size, 2/3 size and 4/9 size ladder such as 1080p / 720p / 480p */
+static MppEncSimRung rungs[] = {
+    { 0, 0, 0 },
+    { 0, 0, 0 },
+    { 0, 0, 0 },
+};
+
+static void sim_test_usage(const char *name)
+{
+    mpp_log("usage: %s -i input.yuv -w width -h height [-t type] [-n frames] [-o prefix]\n", name);
+    mpp_log("input is nv12, output rung N is written to prefix_N.bin\n");
+}
+
+int main(int argc, char **argv)
+{
+    const char *file_in = NULL;
+    const char *prefix = "mpi_enc_sim";
+    MppCodingType type = MPP_VIDEO_CodingAVC;
+    RK_S32 width = 0;
+    RK_S32 height = 0;
+    RK_S32 frames = 60;
+    RK_S32 hor_stride, ver_stride;
+    RK_S32 count = MPP_ARRAY_ELEMS(rungs);
+    FILE *fp_in = NULL;
+    FILE *fp_out[MPP_ARRAY_ELEMS(rungs)] = { NULL };
+    RK_S64 bytes[MPP_ARRAY_ELEMS(rungs)] = { 0 };
+    MppBufferGroup group = NULL;
+    MppBuffer buf = NULL;
+    MppEncSim sim = NULL;
+    MppEncCfg cfg = NULL;
+    MPP_RET ret = MPP_NOK;
+    RK_S32 i, n;
+
+    for (i = 1; i + 1 < argc; i += 2) {
+        if (!strcmp(argv[i], "-i"))
+            file_in = argv[i + 1];
+        else if (!strcmp(argv[i], "-w"))
+            width = atoi(argv[i + 1]);
+        else if (!strcmp(argv[i], "-h"))
+            height = atoi(argv[i + 1]);
+        else if (!strcmp(argv[i], "-t"))
+            type = (MppCodingType)atoi(argv[i + 1]);
+        else if (!strcmp(argv[i], "-n"))
+            frames = atoi(argv[i + 1]);
+        else if (!strcmp(argv[i], "-o"))
+            prefix = argv[i + 1];
+    }
+
+    if (!file_in || width <= 0 || height <= 0) {
+        sim_test_usage(argv[0]);
+        return -1;
+    }
+
+    hor_stride = MPP_ALIGN(width, 16);
+    ver_stride = MPP_ALIGN(height, 16);
+    rungs[1].width = width * 2 / 3;
+    rungs[1].height = height * 2 / 3;
+    rungs[2].width = width * 4 / 9;
+    rungs[2].height = height * 4 / 9;
+
+    fp_in = fopen(file_in, "rb");
+    if (!fp_in) {
+        mpp_err("failed to open input %s\n", file_in);
+        return -1;
+    }
+
+    for (i = 0; i < count; i++) {
+        char name[256];
+
+        snprintf(name, sizeof(name), "%s_%d.bin", prefix, i);
+        fp_out[i] = fopen(name, "wb");
+        if (!fp_out[i]) {
+            mpp_err("failed to open output %s\n", name);
+            goto DONE;
+        }
+    }
+
+    if (mpp_buffer_group_get_internal(&group, MPP_BUFFER_TYPE_ION) ||
+        mpp_buffer_get(group, &buf, hor_stride * ver_stride * 3 / 2)) {
+        mpp_err("failed to get input buffer\n");
+        goto DONE;
+    }
+
+    if (mpp_enc_sim_init(&sim, type, rungs, count))
+        goto DONE;
+
+    mpp_enc_cfg_init(&cfg);
+    mpp_enc_cfg_set_s32(cfg, "prep:width", width);
+    mpp_enc_cfg_set_s32(cfg, "prep:height", height);
+    mpp_enc_cfg_set_s32(cfg, "prep:hor_stride", hor_stride);
+    mpp_enc_cfg_set_s32(cfg, "prep:ver_stride", ver_stride);
+    mpp_enc_cfg_set_s32(cfg, "prep:format", MPP_FMT_YUV420SP);
+    mpp_enc_cfg_set_s32(cfg, "rc:mode", MPP_ENC_RC_MODE_CBR);
+    mpp_enc_cfg_set_s32(cfg, "rc:bps_target", SIM_TEST_BPS);
+    mpp_enc_cfg_set_s32(cfg, "rc:bps_max", SIM_TEST_BPS * 17 / 16);
+    mpp_enc_cfg_set_s32(cfg, "rc:bps_min", SIM_TEST_BPS * 15 / 16);
+    mpp_enc_cfg_set_s32(cfg, "rc:fps_in_num", SIM_TEST_FPS);
+    mpp_enc_cfg_set_s32(cfg, "rc:fps_in_denom", 1);
+    mpp_enc_cfg_set_s32(cfg, "rc:fps_out_num", SIM_TEST_FPS);
+    mpp_enc_cfg_set_s32(cfg, "rc:fps_out_denom", 1);
+    mpp_enc_cfg_set_s32(cfg, "rc:gop", SIM_TEST_GOP);
+    mpp_enc_cfg_set_s32(cfg, "codec:type", type);
+
+    if (mpp_enc_sim_control(sim, MPP_ENC_SET_CFG, cfg))
+        goto DONE;
+
+    for (n = 0; n < frames; n++) {
+        MppFrame frame = NULL;
+
+        if (read_image(mpp_buffer_get_ptr(buf), fp_in, width, height,
+                       hor_stride, ver_stride, MPP_FMT_YUV420SP))
+            break;
+
+        mpp_frame_init(&frame);
+        mpp_frame_set_width(frame, width);
+        mpp_frame_set_height(frame, height);
+        mpp_frame_set_hor_stride(frame, hor_stride);
+        mpp_frame_set_ver_stride(frame, ver_stride);
+        mpp_frame_set_fmt(frame, MPP_FMT_YUV420SP);
+        mpp_frame_set_buffer(frame, buf);
+        mpp_frame_set_pts(frame, n);
+
+        ret = mpp_enc_sim_encode(sim, frame);
+        mpp_frame_deinit(&frame);
+        if (ret)
+            break;
+
+        for (i = 0; i < count; i++) {
+            MppPacket packet = NULL;
+
+            mpp_enc_sim_get_packet(sim, i, &packet);
+            if (!packet)
+                continue;
+
+            fwrite(mpp_packet_get_pos(packet), 1, mpp_packet_get_length(packet), fp_out[i]);
+            bytes[i] += mpp_packet_get_length(packet);
+            mpp_packet_deinit(&packet);
+        }
+    }
+
+    for (i = 0; i < count; i++)
+        mpp_log("rung %d frames %d bps %lld\n", i, n,
+                n ? bytes[i] * 8 * SIM_TEST_FPS / n : 0);
+
+DONE:
+    if (cfg)
+        mpp_enc_cfg_deinit(cfg);
+    mpp_enc_sim_deinit(sim);
+    if (buf)
+        mpp_buffer_put(buf);
+    if (group)
+        mpp_buffer_group_put(group);
+    for (i = 0; i < count; i++)
+        if (fp_out[i])
+            fclose(fp_out[i]);
+    fclose(fp_in);
+
+    mpp_log("mpi_enc_sim_test %s\n", ret ? "failed" : "success");
+
+    return ret;
+}
@@ -40,6 +40,7 @@ typedef enum {
     FILE_NORMAL_TYPE,
     FILE_JPEG_TYPE,
     FILE_IVF_TYPE,
+    FILE_AU_TYPE,
     FILE_BUTT,
 } FileType;
 
@@ -54,6 +55,8 @@ typedef struct FileReader_t {
     char            *buf;
     size_t          buf_size;
     size_t          stuff_size;
+    /* read position in buf for access unit reader */
+    size_t          buf_pos;
     RK_S32          seek_base;
     ReaderFunc      read_func;
 
@@ -139,6 +142,7 @@ static FileBufSlot *read_ivf_file(FileReader data)
     slot->buf = NULL;
     slot->size = read_size;
     slot->eos = eos;
+    slot->eoi = 0;
 
     return slot;
 }
@@ -193,6 +197,113 @@ static FileBufSlot *read_normal_file(FileReader data)
     slot->buf = NULL;
     slot->size  = read_size;
     slot->eos   = eos;
+    slot->eoi   = 0;
+
+    return slot;
+}
+
+/* check whether the nal unit begins a new access unit, nal points after start code */
+static RK_U32 nal_is_au_start(MppCodingType type, const RK_U8 *nal, size_t len, RK_U32 *is_slice)
+{
+    *is_slice = 0;
+
+    if (type == MPP_VIDEO_CodingAVC) {
+        RK_U32 nal_type = nal[0] & 0x1f;
+
+        /* sei / sps / pps / aud / sub sps */
+        if ((nal_type >= 6 && nal_type <= 9) || nal_type == 15)
+            return 1;
+
+        /* slice with first_mb_in_slice equal to 0 */
+        if (nal_type == 1 || nal_type == 5) {
+            *is_slice = 1;
+            return len > 1 && (nal[1] & 0x80);
+        }
+    } else if (type == MPP_VIDEO_CodingHEVC) {
+        RK_U32 nal_type;
+        RK_U32 layer_id;
+
+        if (len < 2)
+            return 0;
+
+        nal_type = (nal[0] >> 1) & 0x3f;
+        layer_id = ((nal[0] & 0x01) << 5) | (nal[1] >> 3);
+        if (layer_id)
+            return 0;
+
+        /* vps / sps / pps / aud / prefix sei */
+        if ((nal_type >= 32 && nal_type <= 35) || nal_type == 39)
+            return 1;
+
+        /* vcl nal with first_slice_segment_in_pic_flag */
+        if (nal_type <= 21) {
+            *is_slice = 1;
+            return len > 2 && (nal[2] & 0x80);
+        }
+    }
+
+    return 0;
+}
+
+/* split annexb stream into access units for latency test like rtp receiver */
+static FileBufSlot *read_au_file(FileReader data)
+{
+    FileReaderImpl *impl = (FileReaderImpl*)data;
+    RK_U8 *buf = (RK_U8 *)impl->buf;
+    size_t size = impl->file_size;
+    size_t start = impl->buf_pos;
+    size_t end = size;
+    size_t pos = start;
+    RK_U32 have_slice = 0;
+    RK_U32 first = 1;
+    FileBufSlot *slot = NULL;
+
+    if (!buf) {
+        impl->buf = mpp_malloc(char, size + 1);
+        if (!impl->buf)
+            return NULL;
+
+        buf = (RK_U8 *)impl->buf;
+        impl->read_size = fread(buf, 1, size, impl->fp_input);
+        impl->read_total = impl->read_size;
+        size = impl->read_size;
+        impl->file_size = size;
+        end = size;
+    }
+
+    while (pos + 3 < size) {
+        RK_U32 is_slice = 0;
+        RK_U32 au_start;
+
+        if (buf[pos] || buf[pos + 1] || buf[pos + 2] != 1) {
+            pos++;
+            continue;
+        }
+
+        au_start = nal_is_au_start(impl->type, buf + pos + 3, size - pos - 3, &is_slice);
+        if (!first && have_slice && au_start) {
+            /* include the leading zero byte of 4 byte start code */
+            end = (pos > start && !buf[pos - 1]) ? pos - 1 : pos;
+            break;
+        }
+
+        have_slice |= is_slice;
+        first = 0;
+        pos += 3;
+    }
+
+    slot = mpp_malloc_size(FileBufSlot, sizeof(FileBufSlot) + (end - start) + impl->stuff_size);
+    if (!slot)
+        return NULL;
+
+    slot->data = (char *)(slot + 1);
+    memcpy(slot->data, buf + start, end - start);
+    impl->buf_pos = end;
+
+    slot->buf   = NULL;
+    slot->size  = end - start;
+    slot->eos   = (end >= size);
+    slot->eoi   = 1;
 
     return slot;
 }
@@ -200,6 +311,10 @@ static FileBufSlot *read_normal_file(FileReader data)
 static void check_file_type(FileReader data, char *file_in, MppCodingType type)
 {
     FileReaderImpl *impl = (FileReaderImpl*)data;
+    RK_U32 reader_au_split = 0;
+
+    mpp_env_get_u32("reader_au_split", &reader_au_split, 0);
+    impl->type = type;
 
     if (strstr(file_in, ".ivf")) {
         impl->file_type     = FILE_IVF_TYPE;
@@ -223,6 +338,14 @@ static void check_file_type(FileReader data, char *file_in, MppCodingType type)
         impl->slot_max      = 1;
         mpp_buffer_group_get_internal(&impl->group, MPP_BUFFER_TYPE_ION);
         mpp_assert(impl->group);
+    } else if ((type == MPP_VIDEO_CodingAVC || type == MPP_VIDEO_CodingHEVC) &&
+               reader_au_split) {
+        impl->file_type     = FILE_AU_TYPE;
+        impl->buf_size      = 0;
+        impl->stuff_size    = 256;
+        impl->seek_base     = 0;
+        impl->read_func     = read_au_file;
+        impl->slot_max      = 1024;     /* preset 1024 file slots */
     } else {
         RK_U32 buf_size = 0;
 
@@ -373,6 +496,7 @@ void reader_deinit(FileReader reader)
         impl->group = NULL;
     }
 
+    MPP_FREE(impl->buf);
     MPP_FREE(impl->slots);
     MPP_FREE(impl);
 }
@@ -98,6 +98,8 @@ typedef struct FileBufSlot_t {
     MppBuffer       buf;
     size_t          size;
     RK_U32          eos;
+    /* slot holds one whole access unit, like packet with rtp marker */
+    RK_U32          eoi;
     char            *data;
 } FileBufSlot;
 
@@ -1035,6 +1035,29 @@ RK_S32 mpi_enc_opt_speed(void *ctx, const char *next)
     return 0;
 }
 
+RK_S32 mpi_enc_opt_pass(void *ctx, const char *next)
+{
+    MppEncTestObjSet* obj_set = (MppEncTestObjSet *)ctx;
+    MpiEncTestArgs *cmd = (MpiEncTestArgs *)obj_set->cmd;
+
+    if (next) {
+        const char *file = strchr(next, ':');
+        size_t len = file ? strnlen(file + 1, MAX_FILE_NAME_LENGTH) : 0;
+
+        cmd->pass = atoi(next);
+        if (cmd->pass >= 1 && cmd->pass <= 2 && len) {
+            MPP_FREE(cmd->file_stats);
+            cmd->file_stats = mpp_calloc(char, len + 1);
+            strncpy(cmd->file_stats, file + 1, len);
+            return 1;
+        }
+    }
+
+    cmd->pass = 0;
+    mpp_err("invalid multi-pass option should be pass:stats_file\n");
+    return 0;
+}
+
 RK_S32 mpi_enc_opt_kmpp(void *ctx, const char *next)
 {
     MppEncTestObjSet* obj_set = (MppEncTestObjSet *)ctx;
@@ -1094,6 +1117,7 @@ static MppOptInfo enc_opts[] = {
     {"lmd",     "lambda idx",           "lambda_idx_p 0~8",                         mpi_enc_opt_lmd},
     {"lmdi",    "lambda i idx",         "lambda_idx_i 0~8",                         mpi_enc_opt_lmdi},
     {"speed",   "enc speed",            "speed mode",                               mpi_enc_opt_speed},
+    {"pass",    "multi-pass",           "pass:stats_file, 1:write stats 2:use stats", mpi_enc_opt_pass},
     {"kmpp",    "kmpp path enable",     "kmpp path enable",                         mpi_enc_opt_kmpp}
 };
 
@@ -1844,6 +1868,11 @@ MPP_RET mpi_enc_cfg_setup(MpiEncTestData *p, MpiEncTestArgs *cmd, MppEncCfg cfg_
         mpp_enc_cfg_set_s32(cfg, "hw:skip_sad", 8);
     }
 
+    if (cmd->pass) {
+        mpp_enc_cfg_set_s32(cfg, "rc:pass", cmd->pass);
+        mpp_enc_cfg_set_ptr(cfg, "rc:stats_file", cmd->file_stats);
+    }
+
     mpp_enc_cfg_set_s32(cfg, "prep:mirroring", cmd->mirroring);
     mpp_enc_cfg_set_s32(cfg, "prep:rotation", cmd->rotation);
     mpp_enc_cfg_set_s32(cfg, "prep:flip", cmd->flip);
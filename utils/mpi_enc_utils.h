@@ -101,6 +101,9 @@ typedef struct MpiEncTestArgs_t {
     RK_S32              lambda_idx_p;
     RK_S32              lambda_idx_i;
     RK_S32              speed;
+    /* -pass multi-pass encoding pass and stats file */
+    RK_S32              pass;
+    char                *file_stats;
     /* -dbe deblur enable flag
      * -dbs deblur strength
      */